@@ -0,0 +1,21 @@
+#ifndef BENCH_UTIL_H
+#define BENCH_UTIL_H
+
+#include <time.h>
+#include <stdint.h>
+
+// Shared by the bench/ programs: CLOCK_MONOTONIC
+// nanos and a sink the optimizer cannot drop
+
+inline uint64_t bench_now_ns() {
+    timespec ts;
+    ::clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + static_cast<uint64_t>(ts.tv_nsec);
+}
+
+inline void bench_keep(uint64_t value) {
+    static volatile uint64_t sink = 0;
+    sink = sink + value;
+}
+
+#endif
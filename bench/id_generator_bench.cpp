@@ -0,0 +1,71 @@
+// ClOrdID throughput of IdGenerator against the
+// snprintf builder it replaced:
+//
+//     id_generator_bench [ids]
+//
+// The target is 10M IDs/s, a rate below it is
+// reported with a nonzero exit.
+
+#include "id_generator.h"
+#include "bench_util.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+const double target_ids_per_sec = 10e6;
+
+// Old make_unique_id: last 11 SendingTime
+// digits, seq and a counter through snprintf
+static size_t snprintf_id(char* out, size_t size, int seq, int counter) {
+    const int written = std::snprintf(out, size, "%s%s%04d%02d", "CL", "01120000123", seq % 10000, counter % 100);
+    return written > 0 ? static_cast<size_t>(written) : 0;
+}
+
+static double ids_per_sec(uint64_t ids, uint64_t elapsed_ns) {
+    return elapsed_ns ? static_cast<double>(ids) * 1e9 / static_cast<double>(elapsed_ns) : 0;
+}
+
+int main(int argc, char** argv) {
+    const uint64_t ids = (argc > 1) ? std::strtoull(argv[1], 0, 10) : 50000000ULL;
+
+    IdGenerator generator;
+    if (!generator.init(1234)) {
+        std::printf("Error: epoch does not fit\n");
+        return 1;
+    }
+
+    char buf[IdGenerator::max_id_len];
+    uint64_t started_ns = bench_now_ns();
+    for (uint64_t i = 0; i < ids; ++i) {
+        const size_t len = generator.next("CL", buf);
+        bench_keep(static_cast<unsigned char>(buf[len - 1]));
+    }
+    const double generator_rate = ids_per_sec(ids, bench_now_ns() - started_ns);
+
+    const std::string last = generator.next("CL");
+    std::printf("Info: IdGenerator base36 %.1fM IDs/s (%llu IDs, last %s)\n", generator_rate / 1e6,
+                static_cast<unsigned long long>(ids), last.c_str());
+
+    generator.init(1234, IdGenerator::base62);
+    started_ns = bench_now_ns();
+    for (uint64_t i = 0; i < ids; ++i) {
+        const size_t len = generator.next("CL", buf);
+        bench_keep(static_cast<unsigned char>(buf[len - 1]));
+    }
+    std::printf("Info: IdGenerator base62 %.1fM IDs/s\n", ids_per_sec(ids, bench_now_ns() - started_ns) / 1e6);
+
+    const uint64_t snprintf_ids = ids / 10;
+    char old_buf[64];
+    started_ns = bench_now_ns();
+    for (uint64_t i = 0; i < snprintf_ids; ++i) {
+        const size_t len = snprintf_id(old_buf, sizeof(old_buf), static_cast<int>(i), static_cast<int>(i));
+        bench_keep(static_cast<unsigned char>(old_buf[len - 1]));
+    }
+    std::printf("Info: snprintf builder %.1fM IDs/s\n", ids_per_sec(snprintf_ids, bench_now_ns() - started_ns) / 1e6);
+
+    if (generator_rate < target_ids_per_sec) {
+        std::printf("Warning: below the %.0fM IDs/s target\n", target_ids_per_sec / 1e6);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,250 @@
+// Book-update latency of MarketDataBooks per
+// 35=W/X message:
+//
+//     market_data_bench [feed]
+//     market_data_bench --write <feed> [messages]
+//
+// feed is raw FIX as received (a session capture,
+// messages back to back); it is framed with
+// FixParser first and only on_message() is timed.
+// Without one a feed is generated: 50 symbols,
+// a 20 level snapshot each, then incrementals of
+// 1-6 entries clustered near the top of book.
+// --write saves that feed for later replays.
+
+#include "market_data.h"
+#include "fix_parser.h"
+#include "bench_util.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <set>
+#include <random>
+#include <algorithm>
+
+const size_t generated_symbols = 50;
+const int generated_levels = 20;
+const size_t default_messages = 300000;
+const int replay_rounds = 3;
+
+static void append_field(std::string& out, int tag, const std::string& value) {
+    out += std::to_string(tag);
+    out += '=';
+    out += value;
+    out += '\x01';
+}
+
+static std::string frame(const std::string& body) {
+    std::string msg = "8=FIX.4.4\x01" "9=" + std::to_string(body.size()) + "\x01" + body;
+
+    unsigned int sum = 0;
+    for (size_t i = 0; i < msg.size(); ++i) {
+        sum += static_cast<unsigned char>(msg[i]);
+    }
+    char checksum[8];
+    std::snprintf(checksum, sizeof(checksum), "%03u", sum % 256);
+    append_field(msg, 10, checksum);
+    return msg;
+}
+
+static std::string header(char msg_type, int seq) {
+    std::string out;
+    append_field(out, 35, std::string(1, msg_type));
+    append_field(out, 34, std::to_string(seq));
+    append_field(out, 49, "EXCHANGE");
+    append_field(out, 56, "CLIENT");
+    append_field(out, 52, "20260101-00:00:00.000");
+    return out;
+}
+
+// Ticks of 0.01 as text
+static std::string price_text(int ticks) {
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "%d.%02d", ticks / 100, ticks % 100);
+    return buf;
+}
+
+struct GeneratedSymbol {
+    std::string name;
+    std::set<int> sides[2];     // live price ticks, bids/offers
+    int64_t rpt_seq;
+};
+
+static void generate_feed(size_t message_count, std::vector<std::string>& messages) {
+    std::mt19937 random(7);
+    std::uniform_int_distribution<int> sizes(1, 999);
+    std::uniform_int_distribution<int> entry_counts(1, 6);
+    std::uniform_int_distribution<int> coin(0, 1);
+    std::uniform_int_distribution<size_t> pick(0, generated_symbols - 1);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    std::exponential_distribution<double> depth_from_top(0.4);
+
+    const int mid = 10000;
+    std::vector<GeneratedSymbol> symbols(generated_symbols);
+    int seq = 1;
+
+    for (size_t s = 0; s < symbols.size(); ++s) {
+        char name[24];
+        std::snprintf(name, sizeof(name), "S%03zu", s);
+        symbols[s].name = name;
+        symbols[s].rpt_seq = 0;
+
+        std::string body = header('W', seq++);
+        append_field(body, 55, symbols[s].name);
+        append_field(body, 83, "0");
+        append_field(body, 268, std::to_string(2 * generated_levels));
+        for (int side = 0; side < 2; ++side) {
+            for (int i = 1; i <= generated_levels; ++i) {
+                const int ticks = side == 0 ? mid - i : mid + i;
+                symbols[s].sides[side].insert(ticks);
+                append_field(body, 269, std::to_string(side));
+                append_field(body, 270, price_text(ticks));
+                append_field(body, 271, std::to_string(sizes(random)));
+            }
+        }
+        messages.push_back(frame(body));
+    }
+
+    while (messages.size() < message_count) {
+        GeneratedSymbol& symbol = symbols[pick(random)];
+        const int entries = entry_counts(random);
+
+        std::string group;
+        for (int e = 0; e < entries; ++e) {
+            const int side = coin(random);
+            std::set<int>& live = symbol.sides[side];
+            const int depth = std::min(static_cast<int>(depth_from_top(random)), generated_levels - 1);
+            const int best = side == 0 ? *live.rbegin() : *live.begin();
+            const int ticks = side == 0 ? best - depth : best + depth;
+
+            char action = '0';
+            if (live.count(ticks) && unit(random) < 0.15 && live.size() > 5) {
+                action = '2';
+                live.erase(ticks);
+            } else if (live.count(ticks)) {
+                action = '1';
+            } else {
+                live.insert(ticks);
+            }
+
+            append_field(group, 279, std::string(1, action));
+            append_field(group, 269, std::to_string(side));
+            append_field(group, 55, symbol.name);
+            append_field(group, 83, std::to_string(++symbol.rpt_seq));
+            append_field(group, 270, price_text(ticks));
+            append_field(group, 271, std::to_string(sizes(random)));
+        }
+
+        std::string body = header('X', seq++);
+        append_field(body, 268, std::to_string(entries));
+        body += group;
+        messages.push_back(frame(body));
+    }
+}
+
+static bool read_feed(const char* path, std::vector<std::string>& messages) {
+    FILE* file = std::fopen(path, "rb");
+    if (!file) {
+        return false;
+    }
+
+    FixParser parser;
+    std::string msg;
+    char chunk[65536];
+    size_t bytes = 0;
+    while ((bytes = std::fread(chunk, 1, sizeof(chunk), file)) > 0) {
+        parser.append_bytes(chunk, bytes);
+        while (parser.read_next_message(msg)) {
+            messages.push_back(msg);
+        }
+    }
+    std::fclose(file);
+    return true;
+}
+
+static bool write_feed(const char* path, const std::vector<std::string>& messages) {
+    FILE* file = std::fopen(path, "wb");
+    if (!file) {
+        return false;
+    }
+
+    bool ok = true;
+    for (size_t i = 0; i < messages.size() && ok; ++i) {
+        ok = std::fwrite(messages[i].data(), 1, messages[i].size(), file) == messages[i].size();
+    }
+    return (std::fclose(file) == 0) && ok;
+}
+
+static uint64_t percentile(const std::vector<uint64_t>& sorted, double fraction) {
+    if (sorted.empty()) return 0;
+    size_t rank = static_cast<size_t>(fraction * static_cast<double>(sorted.size()));
+    if (rank >= sorted.size()) rank = sorted.size() - 1;
+    return sorted[rank];
+}
+
+int main(int argc, char** argv) {
+    std::vector<std::string> messages;
+
+    if (argc >= 3 && std::strcmp(argv[1], "--write") == 0) {
+        const size_t count = (argc > 3) ? static_cast<size_t>(std::strtoull(argv[3], 0, 10)) : default_messages;
+        generate_feed(count, messages);
+        if (!write_feed(argv[2], messages)) {
+            std::printf("Error: cannot write %s\n", argv[2]);
+            return 1;
+        }
+        std::printf("Info: wrote %zu messages to %s\n", messages.size(), argv[2]);
+        return 0;
+    }
+
+    if (argc >= 2) {
+        if (!read_feed(argv[1], messages)) {
+            std::printf("Error: cannot read %s\n", argv[1]);
+            return 1;
+        }
+        std::printf("Info: %zu messages from %s\n", messages.size(), argv[1]);
+    } else {
+        generate_feed(default_messages, messages);
+        std::printf("Info: %zu generated messages, %zu symbols\n", messages.size(), generated_symbols);
+    }
+
+    // Whole feed timed for throughput, then each
+    // message on its own for the distribution
+    // (includes ~20ns of clock reads)
+    for (int round = 0; round < replay_rounds; ++round) {
+        MarketDataBooks books;
+        size_t applied = 0;
+        const uint64_t started_ns = bench_now_ns();
+        for (size_t i = 0; i < messages.size(); ++i) {
+            applied += books.on_message(messages[i]) ? 1 : 0;
+        }
+        const uint64_t elapsed_ns = bench_now_ns() - started_ns;
+
+        const MarketDataCounts& counts = books.counts();
+        std::printf("Info: round %d applied=%zu entries=%llu gaps=%llu %.0f ns/msg %.0f ns/entry %.2fM msg/s\n",
+                    round + 1, applied, static_cast<unsigned long long>(counts.entries),
+                    static_cast<unsigned long long>(counts.gaps),
+                    static_cast<double>(elapsed_ns) / static_cast<double>(messages.size()),
+                    counts.entries ? static_cast<double>(elapsed_ns) / static_cast<double>(counts.entries) : 0.0,
+                    static_cast<double>(messages.size()) * 1e3 / static_cast<double>(elapsed_ns));
+    }
+
+    MarketDataBooks books;
+    std::vector<uint64_t> latencies_ns;
+    latencies_ns.reserve(messages.size());
+    for (size_t i = 0; i < messages.size(); ++i) {
+        const uint64_t started_ns = bench_now_ns();
+        books.on_message(messages[i]);
+        latencies_ns.push_back(bench_now_ns() - started_ns);
+    }
+    std::sort(latencies_ns.begin(), latencies_ns.end());
+
+    std::printf("Info: per message p50=%lluns p99=%lluns p99.9=%lluns max=%lluns\n",
+                static_cast<unsigned long long>(percentile(latencies_ns, 0.50)),
+                static_cast<unsigned long long>(percentile(latencies_ns, 0.99)),
+                static_cast<unsigned long long>(percentile(latencies_ns, 0.999)),
+                static_cast<unsigned long long>(latencies_ns.back()));
+    return 0;
+}
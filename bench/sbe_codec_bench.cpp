@@ -0,0 +1,231 @@
+// SBE against tag=value for the order entry
+// messages of config/sbe_orders.xml:
+//
+//     sbe_codec_bench [schema] [messages]
+//
+// Encode is a NewOrderSingle, typed (fix_encode /
+// SbeEncoder / generated flyweight) and from
+// stamped scenario fields (build_from_fields /
+// sbe_encode_fields). Decode is an ExecutionReport
+// read into its fields (fix44 decode / SbeDecoder
+// / generated flyweight) plus the rendering an
+// encoding=sbe session does on every frame. The
+// flyweight rows need the schema they were
+// generated from.
+
+#include "sbe_codec.h"
+#include "sbe_schema.h"
+#include "fix44_messages.h"
+#include "sbe_orders_messages.h"
+#include "fix_message.h"
+#include "bench_util.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+const uint64_t default_messages = 2000000ULL;
+
+// 2026-01-01 00:00:00 UTC
+const uint64_t transact_time_ns = 1767225600000000000ULL;
+
+static void report(const char* name, uint64_t messages, uint64_t elapsed_ns, size_t bytes) {
+    std::printf("Info: %-34s %7.1f ns/msg %5zu bytes\n", name,
+                static_cast<double>(elapsed_ns) / static_cast<double>(messages), bytes);
+}
+
+static FixMessage::FieldList order_fields() {
+    FixMessage::FieldList fields;
+    fields.push_back(FixMessage::Field(35, "D"));
+    fields.push_back(FixMessage::Field(34, "2"));
+    fields.push_back(FixMessage::Field(49, "CLIENT"));
+    fields.push_back(FixMessage::Field(56, "EXCHANGE"));
+    fields.push_back(FixMessage::Field(52, "20260101-00:00:00.000"));
+    fields.push_back(FixMessage::Field(11, "CL0000000001"));
+    fields.push_back(FixMessage::Field(55, "AAA"));
+    fields.push_back(FixMessage::Field(54, "1"));
+    fields.push_back(FixMessage::Field(40, "2"));
+    fields.push_back(FixMessage::Field(38, "100"));
+    fields.push_back(FixMessage::Field(44, "101.25"));
+    fields.push_back(FixMessage::Field(60, "20260101-00:00:00.000"));
+    return fields;
+}
+
+static FixMessage::FieldList report_fields() {
+    FixMessage::FieldList fields;
+    fields.push_back(FixMessage::Field(35, "8"));
+    fields.push_back(FixMessage::Field(37, "OID0000000001"));
+    fields.push_back(FixMessage::Field(11, "CL0000000001"));
+    fields.push_back(FixMessage::Field(17, "EX0000000001"));
+    fields.push_back(FixMessage::Field(150, "F"));
+    fields.push_back(FixMessage::Field(39, "1"));
+    fields.push_back(FixMessage::Field(55, "AAA"));
+    fields.push_back(FixMessage::Field(54, "1"));
+    fields.push_back(FixMessage::Field(38, "100"));
+    fields.push_back(FixMessage::Field(44, "101.25"));
+    fields.push_back(FixMessage::Field(14, "40"));
+    fields.push_back(FixMessage::Field(151, "60"));
+    fields.push_back(FixMessage::Field(6, "101.25"));
+    return fields;
+}
+
+int main(int argc, char** argv) {
+    const std::string schema_path = (argc > 1) ? argv[1] : "config/sbe_orders.xml";
+    const uint64_t messages = (argc > 2) ? std::strtoull(argv[2], 0, 10) : default_messages;
+
+    SbeSchema schema;
+    std::string error;
+    if (!schema.load(schema_path, error)) {
+        std::printf("Error: %s: %s\n", schema_path.c_str(), error.c_str());
+        return 1;
+    }
+    const SbeMessageLayout* order_layout = schema.find_msg_type("D");
+    if (!order_layout || !schema.find_msg_type("8") || messages == 0) {
+        std::printf("Error: %s has no NewOrderSingle/ExecutionReport\n", schema_path.c_str());
+        return 1;
+    }
+    if (schema.id() != sbe_orders::schema_id ||
+        order_layout->template_id != sbe_orders::NewOrderSingleEncoder::template_id) {
+        std::printf("Error: %s is not the schema of sbe_orders_messages.h\n", schema_path.c_str());
+        return 1;
+    }
+
+    FixMessage fix;
+    fix.set_begin_string("FIX.4.4");
+    fix.set_sender_comp_id("CLIENT");
+    fix.set_target_comp_id("EXCHANGE");
+    const FixTypedHeader header(fix);
+    const std::string sending_time = "20260101-00:00:00.000";
+
+    char sbe_buffer[1024];
+    size_t sbe_size = 0;
+    std::string out;
+    out.reserve(512);
+
+    // Encode, typed
+    fix44::NewOrderSingle order;
+    order.set_cl_ord_id("CL0000000001");
+    order.set_symbol("AAA");
+    order.set_side('1');
+    order.set_ord_type('2');
+    order.set_order_qty(FixDecimal(100, 0));
+    order.set_price(FixDecimal(10125, 2));
+    order.set_transact_time("20260101-00:00:00.000");
+
+    uint64_t started_ns = bench_now_ns();
+    for (uint64_t i = 0; i < messages; ++i) {
+        out.clear();
+        fix_encode(header, order, static_cast<int>(i + 1), sending_time, out);
+        bench_keep(out.size());
+    }
+    report("NewOrderSingle tag=value typed", messages, bench_now_ns() - started_ns, out.size());
+
+    SbeEncoder encoder;
+    started_ns = bench_now_ns();
+    for (uint64_t i = 0; i < messages; ++i) {
+        encoder.wrap(sbe_buffer, sizeof(sbe_buffer), schema, *order_layout);
+        encoder.put_string(11, "CL0000000001", 12);
+        encoder.put_string(55, "AAA", 3);
+        encoder.put_char(54, '1');
+        encoder.put_char(40, '2');
+        encoder.put_decimal(38, FixDecimal(100, 0));
+        encoder.put_decimal(44, FixDecimal(10125, 2));
+        encoder.put_int(60, static_cast<int64_t>(transact_time_ns));
+        bench_keep(encoder.size());
+    }
+    report("NewOrderSingle SBE typed", messages, bench_now_ns() - started_ns, encoder.size());
+
+    sbe_orders::NewOrderSingleEncoder order_flyweight;
+    started_ns = bench_now_ns();
+    for (uint64_t i = 0; i < messages; ++i) {
+        order_flyweight.wrap(sbe_buffer, sizeof(sbe_buffer));
+        order_flyweight.set_cl_ord_id("CL0000000001");
+        order_flyweight.set_symbol("AAA");
+        order_flyweight.set_side('1');
+        order_flyweight.set_ord_type('2');
+        order_flyweight.set_order_qty(FixDecimal(100, 0));
+        order_flyweight.set_price(FixDecimal(10125, 2));
+        order_flyweight.set_transact_time(transact_time_ns);
+        bench_keep(order_flyweight.size());
+    }
+    report("NewOrderSingle SBE generated", messages, bench_now_ns() - started_ns, order_flyweight.size());
+
+    // Encode, scenario fields
+    const FixMessage::FieldList order_list = order_fields();
+    started_ns = bench_now_ns();
+    for (uint64_t i = 0; i < messages; ++i) {
+        out = fix.build_from_fields(order_list);
+        bench_keep(out.size());
+    }
+    report("NewOrderSingle tag=value fields", messages, bench_now_ns() - started_ns, out.size());
+
+    started_ns = bench_now_ns();
+    for (uint64_t i = 0; i < messages; ++i) {
+        if (!sbe_encode_fields(schema, order_list, sbe_buffer, sizeof(sbe_buffer), sbe_size, error)) {
+            std::printf("Error: %s\n", error.c_str());
+            return 1;
+        }
+        bench_keep(sbe_size);
+    }
+    report("NewOrderSingle SBE fields", messages, bench_now_ns() - started_ns, sbe_size);
+
+    // Decode, the same report both ways
+    const FixMessage::FieldList report_list = report_fields();
+    const std::string report_text = fix.build_from_fields(report_list);
+    if (!sbe_encode_fields(schema, report_list, sbe_buffer, sizeof(sbe_buffer), sbe_size, error)) {
+        std::printf("Error: %s\n", error.c_str());
+        return 1;
+    }
+
+    fix44::ExecutionReport execution;
+    started_ns = bench_now_ns();
+    for (uint64_t i = 0; i < messages; ++i) {
+        execution.decode(report_text);
+        bench_keep(static_cast<uint64_t>(execution.cum_qty.mantissa) + execution.order_id.size +
+                   static_cast<uint64_t>(execution.exec_type));
+    }
+    report("ExecutionReport tag=value typed", messages, bench_now_ns() - started_ns, report_text.size());
+
+    SbeDecoder decoder;
+    const char* frame = sbe_buffer + sofh_size;
+    const size_t frame_size = sbe_size - sofh_size;
+    started_ns = bench_now_ns();
+    for (uint64_t i = 0; i < messages; ++i) {
+        decoder.wrap(frame, frame_size, schema);
+        FixDecimal cum_qty;
+        FixDecimal avg_px;
+        const char* order_id = 0;
+        size_t order_id_size = 0;
+        char exec_type = 0;
+        decoder.get_decimal(14, cum_qty);
+        decoder.get_decimal(6, avg_px);
+        decoder.get_string(37, order_id, order_id_size);
+        decoder.get_char(150, exec_type);
+        bench_keep(static_cast<uint64_t>(cum_qty.mantissa + avg_px.mantissa) + order_id_size +
+                   static_cast<uint64_t>(exec_type));
+    }
+    report("ExecutionReport SBE typed", messages, bench_now_ns() - started_ns, sbe_size);
+
+    sbe_orders::ExecutionReportDecoder report_flyweight;
+    started_ns = bench_now_ns();
+    for (uint64_t i = 0; i < messages; ++i) {
+        report_flyweight.wrap(frame, frame_size);
+        FixDecimal cum_qty;
+        FixDecimal avg_px;
+        report_flyweight.cum_qty(cum_qty);
+        report_flyweight.avg_px(avg_px);
+        bench_keep(static_cast<uint64_t>(cum_qty.mantissa + avg_px.mantissa) + report_flyweight.order_id().size +
+                   static_cast<uint64_t>(report_flyweight.exec_type()));
+    }
+    report("ExecutionReport SBE generated", messages, bench_now_ns() - started_ns, sbe_size);
+
+    started_ns = bench_now_ns();
+    for (uint64_t i = 0; i < messages; ++i) {
+        decoder.wrap(frame, frame_size, schema);
+        out.clear();
+        decoder.append_tag_value(out);
+        bench_keep(out.size());
+    }
+    report("ExecutionReport SBE to tag=value", messages, bench_now_ns() - started_ns, out.size());
+    return 0;
+}
@@ -0,0 +1,185 @@
+#ifndef ACCEPTOR_REACTOR_H
+#define ACCEPTOR_REACTOR_H
+
+#include "config_parser.h"
+#include "fix_parser.h"
+#include "fix_message.h"
+
+#include <string>
+#include <vector>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <stdint.h>
+
+// Outbound state of one counterparty, kept
+// across reconnects. While connected only the
+// reactor holding the connection touches it.
+struct AcceptorSession {
+    std::string name;
+    SessionConfig config;
+    FixMessage fix;
+    int outbound_seq;
+    uint64_t next_exec_id;
+    int weight;                         // session_weight
+
+    // Guarded by SessionRegistry::mutex
+    bool connected;
+    int home;                           // reactor index
+
+    // Inbound messages, written by the owning
+    // reactor, read by the rebalancer
+    std::atomic<uint64_t> messages;
+
+    AcceptorSession() : outbound_seq(1), next_exec_id(1), weight(1),
+                        connected(false), home(0), messages(0) {}
+};
+
+// Sessions of every acceptor section, shared by
+// the reactors. Only Logon, close and migration
+// take the lock, messages never do.
+class SessionRegistry {
+public:
+    SessionRegistry();
+    ~SessionRegistry();
+
+    // Sections with a target_comp_id get their
+    // session now, placed by session_weight
+    void configure(const std::vector<SessionConfig>& sections, int reactor_count);
+
+    // At Logon: session for our sender and their
+    // target, marked connected, and its home
+    // reactor. 0 with error set when unknown
+    // or already logged on.
+    AcceptorSession* claim(const std::string& sender, const std::string& target,
+                           int& home, std::string& error);
+    void release(AcceptorSession* session);
+
+    // Home of a session's next connection, set
+    // by the reactor handing the connection off
+    void move(AcceptorSession* session, int reactor);
+
+    // Connected sessions and their total
+    // weight by home reactor
+    void snapshot(std::vector<std::vector<AcceptorSession*> >& by_reactor, std::vector<int>& weights);
+
+private:
+    std::mutex mutex;
+    std::vector<SessionConfig> configs;
+    std::map<std::string, AcceptorSession*> sessions;   // "sender|target"
+    std::vector<int> reactor_weight;                    // placed sessions
+
+    AcceptorSession* create(const SessionConfig& section, const std::string& sender,
+                            const std::string& target, int preferred);
+
+    SessionRegistry(const SessionRegistry&);
+    SessionRegistry& operator=(const SessionRegistry&);
+};
+
+struct AcceptorConnection {
+    int fd;
+    std::string peer;
+    FixParser parser;
+    std::string write_buffer;
+    AcceptorSession* session;           // 0 until Logon
+    uint64_t accepted_ms;
+    uint64_t heartbeat_interval_ms;
+    uint64_t last_send_ms;
+    uint64_t last_recv_ms;
+    uint64_t test_request_sent_ms;
+    int test_request_counter;
+    bool closing;                       // close once write_buffer drains
+    int hand_off_to;                    // reactor after Logon, -1 stays
+
+    AcceptorConnection();
+};
+
+// Counters of one reactor, cumulative
+struct ReactorLoad {
+    uint64_t connections;
+    uint64_t sessions;
+    uint64_t messages_in;
+    uint64_t messages_out;
+    uint64_t busy_ns;                   // not in epoll_wait
+    uint64_t migrated_in;
+};
+
+// One thread with its own epoll set. Owns its
+// connections outright; others hand it connections
+// and migrations through a locked inbox and wake
+// it with an eventfd.
+class AcceptorReactor {
+public:
+    AcceptorReactor(int index, SessionRegistry& registry, uint64_t logon_timeout_ms);
+    ~AcceptorReactor();
+
+    void set_peers(const std::vector<AcceptorReactor*>& all) { reactors = all; }
+
+    bool start();
+
+    // Logs every session out, then joins
+    void stop();
+
+    // Thread-safe
+    void adopt(AcceptorConnection* conn);
+    void migrate(AcceptorSession* session, int to_reactor);
+    ReactorLoad load() const;
+
+private:
+    struct Migration {
+        AcceptorSession* session;
+        int to_reactor;
+    };
+
+    int index;
+    SessionRegistry& registry;
+    std::vector<AcceptorReactor*> reactors;
+    uint64_t logon_timeout_ms;
+
+    int epoll_fd;
+    int wake_fd;
+    std::thread thread;
+    std::atomic<bool> stopping;
+
+    std::mutex inbox_mutex;
+    std::vector<AcceptorConnection*> inbox;
+    std::vector<Migration> migrations;
+
+    std::map<int, AcceptorConnection*> connections;
+
+    // Lines of this reactor, written
+    // out once per loop iteration
+    std::string log;
+
+    std::atomic<uint64_t> connection_count;
+    std::atomic<uint64_t> session_count;
+    std::atomic<uint64_t> messages_in;
+    std::atomic<uint64_t> messages_out;
+    std::atomic<uint64_t> busy_ns;
+    std::atomic<uint64_t> migrated_in;
+
+    void run();
+    void drain_inbox();
+    void add_connection(AcceptorConnection* conn);
+    void hand_off(AcceptorConnection& conn, int to_reactor);
+    bool process(AcceptorConnection& conn);
+    void read_connection(AcceptorConnection& conn);
+    void write_connection(AcceptorConnection& conn);
+    void handle_message(AcceptorConnection& conn, const std::string& msg);
+    void handle_logon(AcceptorConnection& conn, const std::string& msg);
+    void check_timers(uint64_t now_ms);
+    void send(AcceptorConnection& conn, const std::string& msg);
+    void reject(AcceptorConnection& conn, const std::string& msg, const std::string& reason);
+    void close_connection(AcceptorConnection& conn, const char* reason);
+    void logout_all();
+    void set_events(AcceptorConnection& conn);
+    void logf(const char* format, ...);
+    void flush_log();
+    const char* name_of(const AcceptorConnection& conn) const;
+
+    AcceptorReactor(const AcceptorReactor&);
+    AcceptorReactor& operator=(const AcceptorReactor&);
+};
+
+#endif
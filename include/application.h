@@ -2,13 +2,51 @@
 #define APPLICATION_H
 
 #include <string>
+#include <vector>
+#include <deque>
+#include <utility>
+#include <stdint.h>
 #include "socket.h"
+#include "loopback_transport.h"
+#include "inproc_pipe.h"
+#include "sbe_transport.h"
+#include "throttle.h"
+#include "regression_cache.h"
+#include "fix_validator.h"
+#include "instrument_cache.h"
 
 struct AppArgs {
     std::string session_name;
     std::string config_path = "config/config.ini";
     std::string scenario_path = "scenarios";
     bool is_test_mode = false;
+    bool is_simulation = false;     // virtual clock, in-process acceptor
+    int regression_jobs = 1;
+    bool is_verbose = false;
+    RegressionRerun regression_rerun = regression_rerun_all;
+    std::string baseline_path;
+    int baseline_threshold_pct = 20;
+
+    // Set by the sharded runner: the files of
+    // this shard and where to leave its summary
+    std::vector<std::string> scenario_files;
+    std::string shard_summary_path;
+};
+
+// Outbound messages waiting for their kernel
+// TX stamp: (tx key, handler nanos)
+typedef std::deque<std::pair<uint32_t, uint64_t> > TxStampQueue;
+
+// What the send/receive helpers need of the
+// running session besides its socket. Owned by
+// Application, passed down for one run().
+struct SessionContext {
+    OutboundThrottle* throttle;         // null when off, admin borrows tokens
+    TxStampQueue* tx_stamps;            // TX stamps owed
+    FixValidator* validator;            // null when validation=off
+    FixValidationMode validation;
+
+    SessionContext() : throttle(0), tx_stamps(0), validator(0), validation(validation_off) {}
 };
 
 class Application {
@@ -16,7 +54,20 @@ public:
     int run(const AppArgs& args);
 
 private:
-    TcpSocket socket;
+    // Session transport, picked by
+    // the host of the session
+    StreamSocket stream_socket;
+    LoopbackTransport loopback;
+    InprocEndpoint pipe_end;
+
+    // encoding=sbe, wraps either of them
+    SbeSchema sbe_schema;
+    SbeTransport sbe_transport;
+
+    OutboundThrottle throttle;
+    FixValidator validator;
+    InstrumentCache instruments;
+    TxStampQueue tx_stamps;
 };
 
 #endif
@@ -3,9 +3,26 @@
 
 #include <string>
 #include <map>
+#include <vector>
 
 struct SessionConfig {
     std::string name;
+
+    // initiator, or acceptor (see fix_acceptor.h)
+    std::string connection_type = "initiator";
+
+    // Acceptor: venue acks orders,
+    // drop_copy only logs them
+    std::string acceptor_role = "venue";
+
+    // Acceptor: reactor threads of the listening
+    // section, the share of a reactor a session
+    // is placed by, and seconds between
+    // rebalancing rounds (0 = never)
+    int reactor_threads = 1;
+    int session_weight = 1;
+    int rebalance_interval = 5;
+
     std::string host;
     int port = 0;
     std::string begin_string = "FIX.4.4";
@@ -13,6 +30,46 @@ struct SessionConfig {
     std::string target_comp_id;
     int heartbeat_interval = 30;
     bool reset_on_logon = false;
+
+    // Max scenario orders awaiting
+    // an ExecutionReport
+    int max_in_flight = 16;
+
+    // Outbound throttle, see throttle.h
+    std::string throttle_session;
+    std::string throttle_msg_types;
+
+    // Market data subscription (35=V) after the
+    // Logon, comma separated; depth 0 = full book
+    std::string md_symbols;
+    int md_depth = 0;
+
+    // Inbound checks against data_dictionary:
+    // off, warn or reject (35=3), see fix_validator.h
+    std::string validation = "off";
+    std::string data_dictionary = "config/FIX44.xml";
+
+    // Security master kept at instrument_cache
+    // (empty = off), see instrument_cache.h.
+    // instrument_fetch: missing (35=x when the
+    // cache is empty, 35=c for instrument_symbols
+    // not in it), always or never.
+    std::string instrument_cache;
+    std::string instrument_fetch = "missing";
+    std::string instrument_symbols;
+
+    // Wire encoding of an initiator: fix, or sbe
+    // (SOFH framed, order entry only) with the
+    // messages of sbe_schema, see sbe_transport.h
+    std::string encoding = "fix";
+    std::string sbe_schema;
+
+    // SO_TIMESTAMPING: off, software, hardware
+    std::string timestamping = "off";
+
+    // Simulation mode (-S): reply delay
+    // of the in-process acceptor
+    int sim_latency_us = 100;
 };
 
 class ConfigParser {
@@ -20,9 +77,13 @@ public:
     void load(const std::string& path);
     SessionConfig get_session(const std::string& session_name) const;
 
+    // Every [section] in file order
+    std::vector<SessionConfig> get_sessions() const;
+
 private:
     SessionConfig defaults;
     std::map<std::string, SessionConfig> sessions;
+    std::vector<std::string> session_order;
 };
 
 #endif
@@ -21,6 +21,7 @@ static const int fix_tag_ref_msg_type                   = 372;
 static const int fix_tag_sess_rej_reason                = 373;
 static const int fix_tag_clord_id                       = 11;
 static const int fix_tag_order_id                       = 37;
+static const int fix_tag_orig_clord_id                  = 41;
 static const int fix_tag_exec_id                        = 17;
 static const int fix_tag_avg_px                         = 6;
 static const int fix_tag_cum_qty                        = 14;
@@ -39,6 +40,30 @@ static const int fix_tag_order_capacity                 = 528;
 static const int fix_tag_cash_order_qty                 = 544;
 static const int fix_tag_cross_id                       = 548;
 static const int fix_tag_no_sides                       = 552;
+static const int fix_tag_md_req_id                      = 262;
+static const int fix_tag_subscription_request_type      = 263;
+static const int fix_tag_market_depth                   = 264;
+static const int fix_tag_md_update_type                 = 265;
+static const int fix_tag_no_md_entry_types              = 267;
+static const int fix_tag_no_md_entries                  = 268;
+static const int fix_tag_md_entry_type                  = 269;
+static const int fix_tag_md_entry_px                    = 270;
+static const int fix_tag_md_entry_size                  = 271;
+static const int fix_tag_md_update_action               = 279;
+static const int fix_tag_rpt_seq                        = 83;
+static const int fix_tag_no_related_sym                 = 146;
+static const int fix_tag_security_id                    = 48;
+static const int fix_tag_security_id_source             = 22;
+static const int fix_tag_security_type                  = 167;
+static const int fix_tag_currency                       = 15;
+static const int fix_tag_security_req_id                = 320;
+static const int fix_tag_security_response_type         = 323;
+static const int fix_tag_security_trading_status        = 326;
+static const int fix_tag_security_request_result        = 560;
+static const int fix_tag_round_lot                      = 561;
+static const int fix_tag_min_trade_vol                  = 562;
+static const int fix_tag_last_fragment                  = 893;
+static const int fix_tag_min_price_increment            = 969;
 static const int fix_tag_order_classification           = 8060;
 static const int fix_tag_dark_pool_flag                 = 8062;
 
@@ -61,6 +86,7 @@ static inline const char* fix_tag_name(int tag) {
         case fix_tag_sess_rej_reason:               return "SessionRejectReason";
         case fix_tag_clord_id:                      return "ClOrdID";
         case fix_tag_order_id:                      return "OrderID";
+        case fix_tag_orig_clord_id:                 return "OrigClOrdID";
         case fix_tag_exec_id:                       return "ExecID";
         case fix_tag_avg_px:                        return "AvgPx";
         case fix_tag_cum_qty:                       return "CumQty";
@@ -79,6 +105,30 @@ static inline const char* fix_tag_name(int tag) {
         case fix_tag_cash_order_qty:                return "CashOrderQty";
         case fix_tag_cross_id:                      return "CrossID";
         case fix_tag_no_sides:                      return "NoSides";
+        case fix_tag_md_req_id:                     return "MDReqID";
+        case fix_tag_subscription_request_type:     return "SubscriptionRequestType";
+        case fix_tag_market_depth:                  return "MarketDepth";
+        case fix_tag_md_update_type:                return "MDUpdateType";
+        case fix_tag_no_md_entry_types:             return "NoMDEntryTypes";
+        case fix_tag_no_md_entries:                 return "NoMDEntries";
+        case fix_tag_md_entry_type:                 return "MDEntryType";
+        case fix_tag_md_entry_px:                   return "MDEntryPx";
+        case fix_tag_md_entry_size:                 return "MDEntrySize";
+        case fix_tag_md_update_action:              return "MDUpdateAction";
+        case fix_tag_rpt_seq:                       return "RptSeq";
+        case fix_tag_no_related_sym:                return "NoRelatedSym";
+        case fix_tag_security_id:                   return "SecurityID";
+        case fix_tag_security_id_source:            return "SecurityIDSource";
+        case fix_tag_security_type:                 return "SecurityType";
+        case fix_tag_currency:                      return "Currency";
+        case fix_tag_security_req_id:               return "SecurityReqID";
+        case fix_tag_security_response_type:        return "SecurityResponseType";
+        case fix_tag_security_trading_status:       return "SecurityTradingStatus";
+        case fix_tag_security_request_result:       return "SecurityRequestResult";
+        case fix_tag_round_lot:                     return "RoundLot";
+        case fix_tag_min_trade_vol:                 return "MinTradeVol";
+        case fix_tag_last_fragment:                 return "LastFragment";
+        case fix_tag_min_price_increment:           return "MinPriceIncrement";
         case fix_tag_order_classification:          return "OrderClassification";
         case fix_tag_dark_pool_flag:                return "DarkPoolFlag";
         default:                                    return 0;
@@ -0,0 +1,820 @@
+// Generated by fix_codegen from config/FIX44.xml, do not edit.
+// FIX.4.4 application messages, see fix_typed.h.
+
+#ifndef FIX44_MESSAGES_H
+#define FIX44_MESSAGES_H
+
+#include "fix_typed.h"
+
+#include <string>
+#include <cstddef>
+#include <stdint.h>
+
+namespace fix44 {
+
+static const char begin_string[] = "FIX.4.4";
+
+// 35=8
+struct ExecutionReport {
+    static const size_t msg_type_size = 1;
+    static char* put_msg_type(char* pos) { return fix_put_prefix(pos, "35=8\x01"); }
+
+    uint64_t present;
+    FixText order_id;                       // 37 OrderID, required
+    FixText cl_ord_id;                      // 11 ClOrdID
+    FixText orig_cl_ord_id;                 // 41 OrigClOrdID
+    FixText cross_id;                       // 548 CrossID
+    FixText exec_id;                        // 17 ExecID, required
+    char exec_type;                         // 150 ExecType, required
+    char ord_status;                        // 39 OrdStatus, required
+    int64_t ord_rej_reason;                 // 103 OrdRejReason
+    FixText account;                        // 1 Account
+    FixText symbol;                         // 55 Symbol, required
+    FixText security_id;                    // 48 SecurityID
+    FixText security_id_source;             // 22 SecurityIDSource
+    FixText security_type;                  // 167 SecurityType
+    FixText currency;                       // 15 Currency
+    char side;                              // 54 Side, required
+    FixDecimal order_qty;                   // 38 OrderQty
+    char ord_type;                          // 40 OrdType
+    FixDecimal price;                       // 44 Price
+    FixDecimal last_qty;                    // 32 LastQty
+    FixDecimal last_px;                     // 31 LastPx
+    FixDecimal leaves_qty;                  // 151 LeavesQty, required
+    FixDecimal cum_qty;                     // 14 CumQty, required
+    FixDecimal avg_px;                      // 6 AvgPx, required
+    FixText transact_time;                  // 60 TransactTime
+    FixText text;                           // 58 Text
+
+    ExecutionReport() : present(0), exec_type(0), ord_status(0), ord_rej_reason(0), side(0), ord_type(0) {}
+
+    static const uint64_t required_mask = 0x704271ull;
+    bool complete() const { return (present & required_mask) == required_mask; }
+    void clear() { present = 0; }
+
+    void set_order_id(const FixText& value) { order_id = value; present |= (uint64_t(1) << 0); }
+    bool has_order_id() const { return (present & (uint64_t(1) << 0)) != 0; }
+    void set_cl_ord_id(const FixText& value) { cl_ord_id = value; present |= (uint64_t(1) << 1); }
+    bool has_cl_ord_id() const { return (present & (uint64_t(1) << 1)) != 0; }
+    void set_orig_cl_ord_id(const FixText& value) { orig_cl_ord_id = value; present |= (uint64_t(1) << 2); }
+    bool has_orig_cl_ord_id() const { return (present & (uint64_t(1) << 2)) != 0; }
+    void set_cross_id(const FixText& value) { cross_id = value; present |= (uint64_t(1) << 3); }
+    bool has_cross_id() const { return (present & (uint64_t(1) << 3)) != 0; }
+    void set_exec_id(const FixText& value) { exec_id = value; present |= (uint64_t(1) << 4); }
+    bool has_exec_id() const { return (present & (uint64_t(1) << 4)) != 0; }
+    void set_exec_type(char value) { exec_type = value; present |= (uint64_t(1) << 5); }
+    bool has_exec_type() const { return (present & (uint64_t(1) << 5)) != 0; }
+    void set_ord_status(char value) { ord_status = value; present |= (uint64_t(1) << 6); }
+    bool has_ord_status() const { return (present & (uint64_t(1) << 6)) != 0; }
+    void set_ord_rej_reason(int64_t value) { ord_rej_reason = value; present |= (uint64_t(1) << 7); }
+    bool has_ord_rej_reason() const { return (present & (uint64_t(1) << 7)) != 0; }
+    void set_account(const FixText& value) { account = value; present |= (uint64_t(1) << 8); }
+    bool has_account() const { return (present & (uint64_t(1) << 8)) != 0; }
+    void set_symbol(const FixText& value) { symbol = value; present |= (uint64_t(1) << 9); }
+    bool has_symbol() const { return (present & (uint64_t(1) << 9)) != 0; }
+    void set_security_id(const FixText& value) { security_id = value; present |= (uint64_t(1) << 10); }
+    bool has_security_id() const { return (present & (uint64_t(1) << 10)) != 0; }
+    void set_security_id_source(const FixText& value) { security_id_source = value; present |= (uint64_t(1) << 11); }
+    bool has_security_id_source() const { return (present & (uint64_t(1) << 11)) != 0; }
+    void set_security_type(const FixText& value) { security_type = value; present |= (uint64_t(1) << 12); }
+    bool has_security_type() const { return (present & (uint64_t(1) << 12)) != 0; }
+    void set_currency(const FixText& value) { currency = value; present |= (uint64_t(1) << 13); }
+    bool has_currency() const { return (present & (uint64_t(1) << 13)) != 0; }
+    void set_side(char value) { side = value; present |= (uint64_t(1) << 14); }
+    bool has_side() const { return (present & (uint64_t(1) << 14)) != 0; }
+    void set_order_qty(const FixDecimal& value) { order_qty = value; present |= (uint64_t(1) << 15); }
+    bool has_order_qty() const { return (present & (uint64_t(1) << 15)) != 0; }
+    void set_ord_type(char value) { ord_type = value; present |= (uint64_t(1) << 16); }
+    bool has_ord_type() const { return (present & (uint64_t(1) << 16)) != 0; }
+    void set_price(const FixDecimal& value) { price = value; present |= (uint64_t(1) << 17); }
+    bool has_price() const { return (present & (uint64_t(1) << 17)) != 0; }
+    void set_last_qty(const FixDecimal& value) { last_qty = value; present |= (uint64_t(1) << 18); }
+    bool has_last_qty() const { return (present & (uint64_t(1) << 18)) != 0; }
+    void set_last_px(const FixDecimal& value) { last_px = value; present |= (uint64_t(1) << 19); }
+    bool has_last_px() const { return (present & (uint64_t(1) << 19)) != 0; }
+    void set_leaves_qty(const FixDecimal& value) { leaves_qty = value; present |= (uint64_t(1) << 20); }
+    bool has_leaves_qty() const { return (present & (uint64_t(1) << 20)) != 0; }
+    void set_cum_qty(const FixDecimal& value) { cum_qty = value; present |= (uint64_t(1) << 21); }
+    bool has_cum_qty() const { return (present & (uint64_t(1) << 21)) != 0; }
+    void set_avg_px(const FixDecimal& value) { avg_px = value; present |= (uint64_t(1) << 22); }
+    bool has_avg_px() const { return (present & (uint64_t(1) << 22)) != 0; }
+    void set_transact_time(const FixText& value) { transact_time = value; present |= (uint64_t(1) << 23); }
+    bool has_transact_time() const { return (present & (uint64_t(1) << 23)) != 0; }
+    void set_text(const FixText& value) { text = value; present |= (uint64_t(1) << 24); }
+    bool has_text() const { return (present & (uint64_t(1) << 24)) != 0; }
+
+    size_t max_body_size() const;
+    char* write_body(char* pos) const;
+
+    // False on a value that does not parse as
+    // its type. First occurrence wins, tags
+    // outside the message are skipped.
+    bool decode(const char* data, size_t size);
+    bool decode(const std::string& msg) { return decode(msg.data(), msg.size()); }
+};
+
+// 35=9
+struct OrderCancelReject {
+    static const size_t msg_type_size = 1;
+    static char* put_msg_type(char* pos) { return fix_put_prefix(pos, "35=9\x01"); }
+
+    uint64_t present;
+    FixText order_id;                       // 37 OrderID, required
+    FixText cl_ord_id;                      // 11 ClOrdID, required
+    FixText orig_cl_ord_id;                 // 41 OrigClOrdID, required
+    char ord_status;                        // 39 OrdStatus, required
+    char cxl_rej_response_to;               // 434 CxlRejResponseTo, required
+    int64_t cxl_rej_reason;                 // 102 CxlRejReason
+    FixText text;                           // 58 Text
+
+    OrderCancelReject() : present(0), ord_status(0), cxl_rej_response_to(0), cxl_rej_reason(0) {}
+
+    static const uint64_t required_mask = 0x1full;
+    bool complete() const { return (present & required_mask) == required_mask; }
+    void clear() { present = 0; }
+
+    void set_order_id(const FixText& value) { order_id = value; present |= (uint64_t(1) << 0); }
+    bool has_order_id() const { return (present & (uint64_t(1) << 0)) != 0; }
+    void set_cl_ord_id(const FixText& value) { cl_ord_id = value; present |= (uint64_t(1) << 1); }
+    bool has_cl_ord_id() const { return (present & (uint64_t(1) << 1)) != 0; }
+    void set_orig_cl_ord_id(const FixText& value) { orig_cl_ord_id = value; present |= (uint64_t(1) << 2); }
+    bool has_orig_cl_ord_id() const { return (present & (uint64_t(1) << 2)) != 0; }
+    void set_ord_status(char value) { ord_status = value; present |= (uint64_t(1) << 3); }
+    bool has_ord_status() const { return (present & (uint64_t(1) << 3)) != 0; }
+    void set_cxl_rej_response_to(char value) { cxl_rej_response_to = value; present |= (uint64_t(1) << 4); }
+    bool has_cxl_rej_response_to() const { return (present & (uint64_t(1) << 4)) != 0; }
+    void set_cxl_rej_reason(int64_t value) { cxl_rej_reason = value; present |= (uint64_t(1) << 5); }
+    bool has_cxl_rej_reason() const { return (present & (uint64_t(1) << 5)) != 0; }
+    void set_text(const FixText& value) { text = value; present |= (uint64_t(1) << 6); }
+    bool has_text() const { return (present & (uint64_t(1) << 6)) != 0; }
+
+    size_t max_body_size() const;
+    char* write_body(char* pos) const;
+
+    // False on a value that does not parse as
+    // its type. First occurrence wins, tags
+    // outside the message are skipped.
+    bool decode(const char* data, size_t size);
+    bool decode(const std::string& msg) { return decode(msg.data(), msg.size()); }
+};
+
+// 35=D
+struct NewOrderSingle {
+    static const size_t msg_type_size = 1;
+    static char* put_msg_type(char* pos) { return fix_put_prefix(pos, "35=D\x01"); }
+
+    uint64_t present;
+    FixText cl_ord_id;                      // 11 ClOrdID, required
+    FixText account;                        // 1 Account
+    char settl_type;                        // 63 SettlType
+    FixText symbol;                         // 55 Symbol, required
+    FixText security_id;                    // 48 SecurityID
+    FixText security_id_source;             // 22 SecurityIDSource
+    FixText security_type;                  // 167 SecurityType
+    FixText currency;                       // 15 Currency
+    char side;                              // 54 Side, required
+    FixText transact_time;                  // 60 TransactTime, required
+    FixDecimal order_qty;                   // 38 OrderQty
+    FixDecimal cash_order_qty;              // 544 CashOrderQty
+    char ord_type;                          // 40 OrdType, required
+    FixDecimal price;                       // 44 Price
+    char time_in_force;                     // 59 TimeInForce
+    char order_capacity;                    // 528 OrderCapacity
+    char order_classification;              // 8060 OrderClassification
+    char dark_pool_flag;                    // 8062 DarkPoolFlag
+    FixText text;                           // 58 Text
+
+    NewOrderSingle() : present(0), settl_type(0), side(0), ord_type(0), time_in_force(0), order_capacity(0), order_classification(0), dark_pool_flag(0) {}
+
+    static const uint64_t required_mask = 0x1309ull;
+    bool complete() const { return (present & required_mask) == required_mask; }
+    void clear() { present = 0; }
+
+    void set_cl_ord_id(const FixText& value) { cl_ord_id = value; present |= (uint64_t(1) << 0); }
+    bool has_cl_ord_id() const { return (present & (uint64_t(1) << 0)) != 0; }
+    void set_account(const FixText& value) { account = value; present |= (uint64_t(1) << 1); }
+    bool has_account() const { return (present & (uint64_t(1) << 1)) != 0; }
+    void set_settl_type(char value) { settl_type = value; present |= (uint64_t(1) << 2); }
+    bool has_settl_type() const { return (present & (uint64_t(1) << 2)) != 0; }
+    void set_symbol(const FixText& value) { symbol = value; present |= (uint64_t(1) << 3); }
+    bool has_symbol() const { return (present & (uint64_t(1) << 3)) != 0; }
+    void set_security_id(const FixText& value) { security_id = value; present |= (uint64_t(1) << 4); }
+    bool has_security_id() const { return (present & (uint64_t(1) << 4)) != 0; }
+    void set_security_id_source(const FixText& value) { security_id_source = value; present |= (uint64_t(1) << 5); }
+    bool has_security_id_source() const { return (present & (uint64_t(1) << 5)) != 0; }
+    void set_security_type(const FixText& value) { security_type = value; present |= (uint64_t(1) << 6); }
+    bool has_security_type() const { return (present & (uint64_t(1) << 6)) != 0; }
+    void set_currency(const FixText& value) { currency = value; present |= (uint64_t(1) << 7); }
+    bool has_currency() const { return (present & (uint64_t(1) << 7)) != 0; }
+    void set_side(char value) { side = value; present |= (uint64_t(1) << 8); }
+    bool has_side() const { return (present & (uint64_t(1) << 8)) != 0; }
+    void set_transact_time(const FixText& value) { transact_time = value; present |= (uint64_t(1) << 9); }
+    bool has_transact_time() const { return (present & (uint64_t(1) << 9)) != 0; }
+    void set_order_qty(const FixDecimal& value) { order_qty = value; present |= (uint64_t(1) << 10); }
+    bool has_order_qty() const { return (present & (uint64_t(1) << 10)) != 0; }
+    void set_cash_order_qty(const FixDecimal& value) { cash_order_qty = value; present |= (uint64_t(1) << 11); }
+    bool has_cash_order_qty() const { return (present & (uint64_t(1) << 11)) != 0; }
+    void set_ord_type(char value) { ord_type = value; present |= (uint64_t(1) << 12); }
+    bool has_ord_type() const { return (present & (uint64_t(1) << 12)) != 0; }
+    void set_price(const FixDecimal& value) { price = value; present |= (uint64_t(1) << 13); }
+    bool has_price() const { return (present & (uint64_t(1) << 13)) != 0; }
+    void set_time_in_force(char value) { time_in_force = value; present |= (uint64_t(1) << 14); }
+    bool has_time_in_force() const { return (present & (uint64_t(1) << 14)) != 0; }
+    void set_order_capacity(char value) { order_capacity = value; present |= (uint64_t(1) << 15); }
+    bool has_order_capacity() const { return (present & (uint64_t(1) << 15)) != 0; }
+    void set_order_classification(char value) { order_classification = value; present |= (uint64_t(1) << 16); }
+    bool has_order_classification() const { return (present & (uint64_t(1) << 16)) != 0; }
+    void set_dark_pool_flag(char value) { dark_pool_flag = value; present |= (uint64_t(1) << 17); }
+    bool has_dark_pool_flag() const { return (present & (uint64_t(1) << 17)) != 0; }
+    void set_text(const FixText& value) { text = value; present |= (uint64_t(1) << 18); }
+    bool has_text() const { return (present & (uint64_t(1) << 18)) != 0; }
+
+    size_t max_body_size() const;
+    char* write_body(char* pos) const;
+
+    // False on a value that does not parse as
+    // its type. First occurrence wins, tags
+    // outside the message are skipped.
+    bool decode(const char* data, size_t size);
+    bool decode(const std::string& msg) { return decode(msg.data(), msg.size()); }
+};
+
+// 35=F
+struct OrderCancelRequest {
+    static const size_t msg_type_size = 1;
+    static char* put_msg_type(char* pos) { return fix_put_prefix(pos, "35=F\x01"); }
+
+    uint64_t present;
+    FixText orig_cl_ord_id;                 // 41 OrigClOrdID, required
+    FixText order_id;                       // 37 OrderID
+    FixText cl_ord_id;                      // 11 ClOrdID, required
+    FixText symbol;                         // 55 Symbol, required
+    FixText security_id;                    // 48 SecurityID
+    FixText security_id_source;             // 22 SecurityIDSource
+    FixText security_type;                  // 167 SecurityType
+    FixText currency;                       // 15 Currency
+    char side;                              // 54 Side, required
+    FixText transact_time;                  // 60 TransactTime, required
+    FixDecimal order_qty;                   // 38 OrderQty
+    FixText text;                           // 58 Text
+
+    OrderCancelRequest() : present(0), side(0) {}
+
+    static const uint64_t required_mask = 0x30dull;
+    bool complete() const { return (present & required_mask) == required_mask; }
+    void clear() { present = 0; }
+
+    void set_orig_cl_ord_id(const FixText& value) { orig_cl_ord_id = value; present |= (uint64_t(1) << 0); }
+    bool has_orig_cl_ord_id() const { return (present & (uint64_t(1) << 0)) != 0; }
+    void set_order_id(const FixText& value) { order_id = value; present |= (uint64_t(1) << 1); }
+    bool has_order_id() const { return (present & (uint64_t(1) << 1)) != 0; }
+    void set_cl_ord_id(const FixText& value) { cl_ord_id = value; present |= (uint64_t(1) << 2); }
+    bool has_cl_ord_id() const { return (present & (uint64_t(1) << 2)) != 0; }
+    void set_symbol(const FixText& value) { symbol = value; present |= (uint64_t(1) << 3); }
+    bool has_symbol() const { return (present & (uint64_t(1) << 3)) != 0; }
+    void set_security_id(const FixText& value) { security_id = value; present |= (uint64_t(1) << 4); }
+    bool has_security_id() const { return (present & (uint64_t(1) << 4)) != 0; }
+    void set_security_id_source(const FixText& value) { security_id_source = value; present |= (uint64_t(1) << 5); }
+    bool has_security_id_source() const { return (present & (uint64_t(1) << 5)) != 0; }
+    void set_security_type(const FixText& value) { security_type = value; present |= (uint64_t(1) << 6); }
+    bool has_security_type() const { return (present & (uint64_t(1) << 6)) != 0; }
+    void set_currency(const FixText& value) { currency = value; present |= (uint64_t(1) << 7); }
+    bool has_currency() const { return (present & (uint64_t(1) << 7)) != 0; }
+    void set_side(char value) { side = value; present |= (uint64_t(1) << 8); }
+    bool has_side() const { return (present & (uint64_t(1) << 8)) != 0; }
+    void set_transact_time(const FixText& value) { transact_time = value; present |= (uint64_t(1) << 9); }
+    bool has_transact_time() const { return (present & (uint64_t(1) << 9)) != 0; }
+    void set_order_qty(const FixDecimal& value) { order_qty = value; present |= (uint64_t(1) << 10); }
+    bool has_order_qty() const { return (present & (uint64_t(1) << 10)) != 0; }
+    void set_text(const FixText& value) { text = value; present |= (uint64_t(1) << 11); }
+    bool has_text() const { return (present & (uint64_t(1) << 11)) != 0; }
+
+    size_t max_body_size() const;
+    char* write_body(char* pos) const;
+
+    // False on a value that does not parse as
+    // its type. First occurrence wins, tags
+    // outside the message are skipped.
+    bool decode(const char* data, size_t size);
+    bool decode(const std::string& msg) { return decode(msg.data(), msg.size()); }
+};
+
+// 35=G
+struct OrderCancelReplaceRequest {
+    static const size_t msg_type_size = 1;
+    static char* put_msg_type(char* pos) { return fix_put_prefix(pos, "35=G\x01"); }
+
+    uint64_t present;
+    FixText order_id;                       // 37 OrderID
+    FixText orig_cl_ord_id;                 // 41 OrigClOrdID, required
+    FixText cl_ord_id;                      // 11 ClOrdID, required
+    FixText account;                        // 1 Account
+    FixText symbol;                         // 55 Symbol, required
+    FixText security_id;                    // 48 SecurityID
+    FixText security_id_source;             // 22 SecurityIDSource
+    FixText security_type;                  // 167 SecurityType
+    FixText currency;                       // 15 Currency
+    char side;                              // 54 Side, required
+    FixText transact_time;                  // 60 TransactTime, required
+    FixDecimal order_qty;                   // 38 OrderQty
+    char ord_type;                          // 40 OrdType, required
+    FixDecimal price;                       // 44 Price
+    char time_in_force;                     // 59 TimeInForce
+    FixText text;                           // 58 Text
+
+    OrderCancelReplaceRequest() : present(0), side(0), ord_type(0), time_in_force(0) {}
+
+    static const uint64_t required_mask = 0x1616ull;
+    bool complete() const { return (present & required_mask) == required_mask; }
+    void clear() { present = 0; }
+
+    void set_order_id(const FixText& value) { order_id = value; present |= (uint64_t(1) << 0); }
+    bool has_order_id() const { return (present & (uint64_t(1) << 0)) != 0; }
+    void set_orig_cl_ord_id(const FixText& value) { orig_cl_ord_id = value; present |= (uint64_t(1) << 1); }
+    bool has_orig_cl_ord_id() const { return (present & (uint64_t(1) << 1)) != 0; }
+    void set_cl_ord_id(const FixText& value) { cl_ord_id = value; present |= (uint64_t(1) << 2); }
+    bool has_cl_ord_id() const { return (present & (uint64_t(1) << 2)) != 0; }
+    void set_account(const FixText& value) { account = value; present |= (uint64_t(1) << 3); }
+    bool has_account() const { return (present & (uint64_t(1) << 3)) != 0; }
+    void set_symbol(const FixText& value) { symbol = value; present |= (uint64_t(1) << 4); }
+    bool has_symbol() const { return (present & (uint64_t(1) << 4)) != 0; }
+    void set_security_id(const FixText& value) { security_id = value; present |= (uint64_t(1) << 5); }
+    bool has_security_id() const { return (present & (uint64_t(1) << 5)) != 0; }
+    void set_security_id_source(const FixText& value) { security_id_source = value; present |= (uint64_t(1) << 6); }
+    bool has_security_id_source() const { return (present & (uint64_t(1) << 6)) != 0; }
+    void set_security_type(const FixText& value) { security_type = value; present |= (uint64_t(1) << 7); }
+    bool has_security_type() const { return (present & (uint64_t(1) << 7)) != 0; }
+    void set_currency(const FixText& value) { currency = value; present |= (uint64_t(1) << 8); }
+    bool has_currency() const { return (present & (uint64_t(1) << 8)) != 0; }
+    void set_side(char value) { side = value; present |= (uint64_t(1) << 9); }
+    bool has_side() const { return (present & (uint64_t(1) << 9)) != 0; }
+    void set_transact_time(const FixText& value) { transact_time = value; present |= (uint64_t(1) << 10); }
+    bool has_transact_time() const { return (present & (uint64_t(1) << 10)) != 0; }
+    void set_order_qty(const FixDecimal& value) { order_qty = value; present |= (uint64_t(1) << 11); }
+    bool has_order_qty() const { return (present & (uint64_t(1) << 11)) != 0; }
+    void set_ord_type(char value) { ord_type = value; present |= (uint64_t(1) << 12); }
+    bool has_ord_type() const { return (present & (uint64_t(1) << 12)) != 0; }
+    void set_price(const FixDecimal& value) { price = value; present |= (uint64_t(1) << 13); }
+    bool has_price() const { return (present & (uint64_t(1) << 13)) != 0; }
+    void set_time_in_force(char value) { time_in_force = value; present |= (uint64_t(1) << 14); }
+    bool has_time_in_force() const { return (present & (uint64_t(1) << 14)) != 0; }
+    void set_text(const FixText& value) { text = value; present |= (uint64_t(1) << 15); }
+    bool has_text() const { return (present & (uint64_t(1) << 15)) != 0; }
+
+    size_t max_body_size() const;
+    char* write_body(char* pos) const;
+
+    // False on a value that does not parse as
+    // its type. First occurrence wins, tags
+    // outside the message are skipped.
+    bool decode(const char* data, size_t size);
+    bool decode(const std::string& msg) { return decode(msg.data(), msg.size()); }
+};
+
+// 35=s
+struct NewOrderCross {
+    static const size_t msg_type_size = 1;
+    static char* put_msg_type(char* pos) { return fix_put_prefix(pos, "35=s\x01"); }
+
+    uint64_t present;
+    FixText cross_id;                       // 548 CrossID, required
+    int64_t cross_type;                     // 549 CrossType, required
+    int64_t cross_prioritization;           // 550 CrossPrioritization, required
+    int64_t no_sides;                       // 552 NoSides, required
+    FixText no_sides_entries;               // entries after 552, as on the wire
+    FixText symbol;                         // 55 Symbol, required
+    FixText security_id;                    // 48 SecurityID
+    FixText security_id_source;             // 22 SecurityIDSource
+    FixText security_type;                  // 167 SecurityType
+    FixText currency;                       // 15 Currency
+    FixText transact_time;                  // 60 TransactTime, required
+    char ord_type;                          // 40 OrdType, required
+    FixDecimal price;                       // 44 Price
+
+    NewOrderCross() : present(0), cross_type(0), cross_prioritization(0), no_sides(0), ord_type(0) {}
+
+    static const uint64_t required_mask = 0x61full;
+    bool complete() const { return (present & required_mask) == required_mask; }
+    void clear() { present = 0; }
+
+    void set_cross_id(const FixText& value) { cross_id = value; present |= (uint64_t(1) << 0); }
+    bool has_cross_id() const { return (present & (uint64_t(1) << 0)) != 0; }
+    void set_cross_type(int64_t value) { cross_type = value; present |= (uint64_t(1) << 1); }
+    bool has_cross_type() const { return (present & (uint64_t(1) << 1)) != 0; }
+    void set_cross_prioritization(int64_t value) { cross_prioritization = value; present |= (uint64_t(1) << 2); }
+    bool has_cross_prioritization() const { return (present & (uint64_t(1) << 2)) != 0; }
+    void set_no_sides(int64_t count, const FixText& entries) { no_sides = count; no_sides_entries = entries; present |= (uint64_t(1) << 3); }
+    bool has_no_sides() const { return (present & (uint64_t(1) << 3)) != 0; }
+    void set_symbol(const FixText& value) { symbol = value; present |= (uint64_t(1) << 4); }
+    bool has_symbol() const { return (present & (uint64_t(1) << 4)) != 0; }
+    void set_security_id(const FixText& value) { security_id = value; present |= (uint64_t(1) << 5); }
+    bool has_security_id() const { return (present & (uint64_t(1) << 5)) != 0; }
+    void set_security_id_source(const FixText& value) { security_id_source = value; present |= (uint64_t(1) << 6); }
+    bool has_security_id_source() const { return (present & (uint64_t(1) << 6)) != 0; }
+    void set_security_type(const FixText& value) { security_type = value; present |= (uint64_t(1) << 7); }
+    bool has_security_type() const { return (present & (uint64_t(1) << 7)) != 0; }
+    void set_currency(const FixText& value) { currency = value; present |= (uint64_t(1) << 8); }
+    bool has_currency() const { return (present & (uint64_t(1) << 8)) != 0; }
+    void set_transact_time(const FixText& value) { transact_time = value; present |= (uint64_t(1) << 9); }
+    bool has_transact_time() const { return (present & (uint64_t(1) << 9)) != 0; }
+    void set_ord_type(char value) { ord_type = value; present |= (uint64_t(1) << 10); }
+    bool has_ord_type() const { return (present & (uint64_t(1) << 10)) != 0; }
+    void set_price(const FixDecimal& value) { price = value; present |= (uint64_t(1) << 11); }
+    bool has_price() const { return (present & (uint64_t(1) << 11)) != 0; }
+
+    size_t max_body_size() const;
+    char* write_body(char* pos) const;
+
+    // False on a value that does not parse as
+    // its type. First occurrence wins, tags
+    // outside the message are skipped.
+    bool decode(const char* data, size_t size);
+    bool decode(const std::string& msg) { return decode(msg.data(), msg.size()); }
+};
+
+// 35=V
+struct MarketDataRequest {
+    static const size_t msg_type_size = 1;
+    static char* put_msg_type(char* pos) { return fix_put_prefix(pos, "35=V\x01"); }
+
+    uint64_t present;
+    FixText md_req_id;                      // 262 MDReqID, required
+    char subscription_request_type;         // 263 SubscriptionRequestType, required
+    int64_t market_depth;                   // 264 MarketDepth, required
+    int64_t md_update_type;                 // 265 MDUpdateType
+    int64_t no_md_entry_types;              // 267 NoMDEntryTypes, required
+    FixText no_md_entry_types_entries;      // entries after 267, as on the wire
+    int64_t no_related_sym;                 // 146 NoRelatedSym, required
+    FixText no_related_sym_entries;         // entries after 146, as on the wire
+
+    MarketDataRequest() : present(0), subscription_request_type(0), market_depth(0), md_update_type(0), no_md_entry_types(0), no_related_sym(0) {}
+
+    static const uint64_t required_mask = 0x37ull;
+    bool complete() const { return (present & required_mask) == required_mask; }
+    void clear() { present = 0; }
+
+    void set_md_req_id(const FixText& value) { md_req_id = value; present |= (uint64_t(1) << 0); }
+    bool has_md_req_id() const { return (present & (uint64_t(1) << 0)) != 0; }
+    void set_subscription_request_type(char value) { subscription_request_type = value; present |= (uint64_t(1) << 1); }
+    bool has_subscription_request_type() const { return (present & (uint64_t(1) << 1)) != 0; }
+    void set_market_depth(int64_t value) { market_depth = value; present |= (uint64_t(1) << 2); }
+    bool has_market_depth() const { return (present & (uint64_t(1) << 2)) != 0; }
+    void set_md_update_type(int64_t value) { md_update_type = value; present |= (uint64_t(1) << 3); }
+    bool has_md_update_type() const { return (present & (uint64_t(1) << 3)) != 0; }
+    void set_no_md_entry_types(int64_t count, const FixText& entries) { no_md_entry_types = count; no_md_entry_types_entries = entries; present |= (uint64_t(1) << 4); }
+    bool has_no_md_entry_types() const { return (present & (uint64_t(1) << 4)) != 0; }
+    void set_no_related_sym(int64_t count, const FixText& entries) { no_related_sym = count; no_related_sym_entries = entries; present |= (uint64_t(1) << 5); }
+    bool has_no_related_sym() const { return (present & (uint64_t(1) << 5)) != 0; }
+
+    size_t max_body_size() const;
+    char* write_body(char* pos) const;
+
+    // False on a value that does not parse as
+    // its type. First occurrence wins, tags
+    // outside the message are skipped.
+    bool decode(const char* data, size_t size);
+    bool decode(const std::string& msg) { return decode(msg.data(), msg.size()); }
+};
+
+// 35=W
+struct MarketDataSnapshotFullRefresh {
+    static const size_t msg_type_size = 1;
+    static char* put_msg_type(char* pos) { return fix_put_prefix(pos, "35=W\x01"); }
+
+    uint64_t present;
+    FixText md_req_id;                      // 262 MDReqID
+    FixText symbol;                         // 55 Symbol, required
+    FixText security_id;                    // 48 SecurityID
+    FixText security_id_source;             // 22 SecurityIDSource
+    FixText security_type;                  // 167 SecurityType
+    FixText currency;                       // 15 Currency
+    int64_t rpt_seq;                        // 83 RptSeq
+    int64_t no_md_entries;                  // 268 NoMDEntries, required
+    FixText no_md_entries_entries;          // entries after 268, as on the wire
+
+    MarketDataSnapshotFullRefresh() : present(0), rpt_seq(0), no_md_entries(0) {}
+
+    static const uint64_t required_mask = 0x82ull;
+    bool complete() const { return (present & required_mask) == required_mask; }
+    void clear() { present = 0; }
+
+    void set_md_req_id(const FixText& value) { md_req_id = value; present |= (uint64_t(1) << 0); }
+    bool has_md_req_id() const { return (present & (uint64_t(1) << 0)) != 0; }
+    void set_symbol(const FixText& value) { symbol = value; present |= (uint64_t(1) << 1); }
+    bool has_symbol() const { return (present & (uint64_t(1) << 1)) != 0; }
+    void set_security_id(const FixText& value) { security_id = value; present |= (uint64_t(1) << 2); }
+    bool has_security_id() const { return (present & (uint64_t(1) << 2)) != 0; }
+    void set_security_id_source(const FixText& value) { security_id_source = value; present |= (uint64_t(1) << 3); }
+    bool has_security_id_source() const { return (present & (uint64_t(1) << 3)) != 0; }
+    void set_security_type(const FixText& value) { security_type = value; present |= (uint64_t(1) << 4); }
+    bool has_security_type() const { return (present & (uint64_t(1) << 4)) != 0; }
+    void set_currency(const FixText& value) { currency = value; present |= (uint64_t(1) << 5); }
+    bool has_currency() const { return (present & (uint64_t(1) << 5)) != 0; }
+    void set_rpt_seq(int64_t value) { rpt_seq = value; present |= (uint64_t(1) << 6); }
+    bool has_rpt_seq() const { return (present & (uint64_t(1) << 6)) != 0; }
+    void set_no_md_entries(int64_t count, const FixText& entries) { no_md_entries = count; no_md_entries_entries = entries; present |= (uint64_t(1) << 7); }
+    bool has_no_md_entries() const { return (present & (uint64_t(1) << 7)) != 0; }
+
+    size_t max_body_size() const;
+    char* write_body(char* pos) const;
+
+    // False on a value that does not parse as
+    // its type. First occurrence wins, tags
+    // outside the message are skipped.
+    bool decode(const char* data, size_t size);
+    bool decode(const std::string& msg) { return decode(msg.data(), msg.size()); }
+};
+
+// 35=X
+struct MarketDataIncrementalRefresh {
+    static const size_t msg_type_size = 1;
+    static char* put_msg_type(char* pos) { return fix_put_prefix(pos, "35=X\x01"); }
+
+    uint64_t present;
+    FixText md_req_id;                      // 262 MDReqID
+    int64_t no_md_entries;                  // 268 NoMDEntries, required
+    FixText no_md_entries_entries;          // entries after 268, as on the wire
+
+    MarketDataIncrementalRefresh() : present(0), no_md_entries(0) {}
+
+    static const uint64_t required_mask = 0x2ull;
+    bool complete() const { return (present & required_mask) == required_mask; }
+    void clear() { present = 0; }
+
+    void set_md_req_id(const FixText& value) { md_req_id = value; present |= (uint64_t(1) << 0); }
+    bool has_md_req_id() const { return (present & (uint64_t(1) << 0)) != 0; }
+    void set_no_md_entries(int64_t count, const FixText& entries) { no_md_entries = count; no_md_entries_entries = entries; present |= (uint64_t(1) << 1); }
+    bool has_no_md_entries() const { return (present & (uint64_t(1) << 1)) != 0; }
+
+    size_t max_body_size() const;
+    char* write_body(char* pos) const;
+
+    // False on a value that does not parse as
+    // its type. First occurrence wins, tags
+    // outside the message are skipped.
+    bool decode(const char* data, size_t size);
+    bool decode(const std::string& msg) { return decode(msg.data(), msg.size()); }
+};
+
+// 35=c
+struct SecurityDefinitionRequest {
+    static const size_t msg_type_size = 1;
+    static char* put_msg_type(char* pos) { return fix_put_prefix(pos, "35=c\x01"); }
+
+    uint64_t present;
+    FixText security_req_id;                // 320 SecurityReqID, required
+    int64_t security_request_type;          // 321 SecurityRequestType, required
+    FixText symbol;                         // 55 Symbol
+    FixText security_id;                    // 48 SecurityID
+    FixText security_id_source;             // 22 SecurityIDSource
+    FixText security_type;                  // 167 SecurityType
+    FixText currency;                       // 15 Currency
+    char subscription_request_type;         // 263 SubscriptionRequestType
+
+    SecurityDefinitionRequest() : present(0), security_request_type(0), subscription_request_type(0) {}
+
+    static const uint64_t required_mask = 0x3ull;
+    bool complete() const { return (present & required_mask) == required_mask; }
+    void clear() { present = 0; }
+
+    void set_security_req_id(const FixText& value) { security_req_id = value; present |= (uint64_t(1) << 0); }
+    bool has_security_req_id() const { return (present & (uint64_t(1) << 0)) != 0; }
+    void set_security_request_type(int64_t value) { security_request_type = value; present |= (uint64_t(1) << 1); }
+    bool has_security_request_type() const { return (present & (uint64_t(1) << 1)) != 0; }
+    void set_symbol(const FixText& value) { symbol = value; present |= (uint64_t(1) << 2); }
+    bool has_symbol() const { return (present & (uint64_t(1) << 2)) != 0; }
+    void set_security_id(const FixText& value) { security_id = value; present |= (uint64_t(1) << 3); }
+    bool has_security_id() const { return (present & (uint64_t(1) << 3)) != 0; }
+    void set_security_id_source(const FixText& value) { security_id_source = value; present |= (uint64_t(1) << 4); }
+    bool has_security_id_source() const { return (present & (uint64_t(1) << 4)) != 0; }
+    void set_security_type(const FixText& value) { security_type = value; present |= (uint64_t(1) << 5); }
+    bool has_security_type() const { return (present & (uint64_t(1) << 5)) != 0; }
+    void set_currency(const FixText& value) { currency = value; present |= (uint64_t(1) << 6); }
+    bool has_currency() const { return (present & (uint64_t(1) << 6)) != 0; }
+    void set_subscription_request_type(char value) { subscription_request_type = value; present |= (uint64_t(1) << 7); }
+    bool has_subscription_request_type() const { return (present & (uint64_t(1) << 7)) != 0; }
+
+    size_t max_body_size() const;
+    char* write_body(char* pos) const;
+
+    // False on a value that does not parse as
+    // its type. First occurrence wins, tags
+    // outside the message are skipped.
+    bool decode(const char* data, size_t size);
+    bool decode(const std::string& msg) { return decode(msg.data(), msg.size()); }
+};
+
+// 35=d
+struct SecurityDefinition {
+    static const size_t msg_type_size = 1;
+    static char* put_msg_type(char* pos) { return fix_put_prefix(pos, "35=d\x01"); }
+
+    uint64_t present;
+    FixText security_req_id;                // 320 SecurityReqID, required
+    FixText security_response_id;           // 322 SecurityResponseID, required
+    int64_t security_response_type;         // 323 SecurityResponseType, required
+    FixText symbol;                         // 55 Symbol
+    FixText security_id;                    // 48 SecurityID
+    FixText security_id_source;             // 22 SecurityIDSource
+    FixText security_type;                  // 167 SecurityType
+    FixText currency;                       // 15 Currency
+    FixDecimal min_price_increment;         // 969 MinPriceIncrement
+    FixDecimal round_lot;                   // 561 RoundLot
+    FixDecimal min_trade_vol;               // 562 MinTradeVol
+    FixText text;                           // 58 Text
+
+    SecurityDefinition() : present(0), security_response_type(0) {}
+
+    static const uint64_t required_mask = 0x7ull;
+    bool complete() const { return (present & required_mask) == required_mask; }
+    void clear() { present = 0; }
+
+    void set_security_req_id(const FixText& value) { security_req_id = value; present |= (uint64_t(1) << 0); }
+    bool has_security_req_id() const { return (present & (uint64_t(1) << 0)) != 0; }
+    void set_security_response_id(const FixText& value) { security_response_id = value; present |= (uint64_t(1) << 1); }
+    bool has_security_response_id() const { return (present & (uint64_t(1) << 1)) != 0; }
+    void set_security_response_type(int64_t value) { security_response_type = value; present |= (uint64_t(1) << 2); }
+    bool has_security_response_type() const { return (present & (uint64_t(1) << 2)) != 0; }
+    void set_symbol(const FixText& value) { symbol = value; present |= (uint64_t(1) << 3); }
+    bool has_symbol() const { return (present & (uint64_t(1) << 3)) != 0; }
+    void set_security_id(const FixText& value) { security_id = value; present |= (uint64_t(1) << 4); }
+    bool has_security_id() const { return (present & (uint64_t(1) << 4)) != 0; }
+    void set_security_id_source(const FixText& value) { security_id_source = value; present |= (uint64_t(1) << 5); }
+    bool has_security_id_source() const { return (present & (uint64_t(1) << 5)) != 0; }
+    void set_security_type(const FixText& value) { security_type = value; present |= (uint64_t(1) << 6); }
+    bool has_security_type() const { return (present & (uint64_t(1) << 6)) != 0; }
+    void set_currency(const FixText& value) { currency = value; present |= (uint64_t(1) << 7); }
+    bool has_currency() const { return (present & (uint64_t(1) << 7)) != 0; }
+    void set_min_price_increment(const FixDecimal& value) { min_price_increment = value; present |= (uint64_t(1) << 8); }
+    bool has_min_price_increment() const { return (present & (uint64_t(1) << 8)) != 0; }
+    void set_round_lot(const FixDecimal& value) { round_lot = value; present |= (uint64_t(1) << 9); }
+    bool has_round_lot() const { return (present & (uint64_t(1) << 9)) != 0; }
+    void set_min_trade_vol(const FixDecimal& value) { min_trade_vol = value; present |= (uint64_t(1) << 10); }
+    bool has_min_trade_vol() const { return (present & (uint64_t(1) << 10)) != 0; }
+    void set_text(const FixText& value) { text = value; present |= (uint64_t(1) << 11); }
+    bool has_text() const { return (present & (uint64_t(1) << 11)) != 0; }
+
+    size_t max_body_size() const;
+    char* write_body(char* pos) const;
+
+    // False on a value that does not parse as
+    // its type. First occurrence wins, tags
+    // outside the message are skipped.
+    bool decode(const char* data, size_t size);
+    bool decode(const std::string& msg) { return decode(msg.data(), msg.size()); }
+};
+
+// 35=f
+struct SecurityStatus {
+    static const size_t msg_type_size = 1;
+    static char* put_msg_type(char* pos) { return fix_put_prefix(pos, "35=f\x01"); }
+
+    uint64_t present;
+    FixText security_status_req_id;         // 324 SecurityStatusReqID
+    FixText symbol;                         // 55 Symbol, required
+    FixText security_id;                    // 48 SecurityID
+    FixText security_id_source;             // 22 SecurityIDSource
+    FixText security_type;                  // 167 SecurityType
+    FixText currency;                       // 15 Currency
+    int64_t security_trading_status;        // 326 SecurityTradingStatus
+    FixDecimal min_price_increment;         // 969 MinPriceIncrement
+    FixDecimal round_lot;                   // 561 RoundLot
+    FixDecimal min_trade_vol;               // 562 MinTradeVol
+    FixText transact_time;                  // 60 TransactTime
+    FixText text;                           // 58 Text
+
+    SecurityStatus() : present(0), security_trading_status(0) {}
+
+    static const uint64_t required_mask = 0x2ull;
+    bool complete() const { return (present & required_mask) == required_mask; }
+    void clear() { present = 0; }
+
+    void set_security_status_req_id(const FixText& value) { security_status_req_id = value; present |= (uint64_t(1) << 0); }
+    bool has_security_status_req_id() const { return (present & (uint64_t(1) << 0)) != 0; }
+    void set_symbol(const FixText& value) { symbol = value; present |= (uint64_t(1) << 1); }
+    bool has_symbol() const { return (present & (uint64_t(1) << 1)) != 0; }
+    void set_security_id(const FixText& value) { security_id = value; present |= (uint64_t(1) << 2); }
+    bool has_security_id() const { return (present & (uint64_t(1) << 2)) != 0; }
+    void set_security_id_source(const FixText& value) { security_id_source = value; present |= (uint64_t(1) << 3); }
+    bool has_security_id_source() const { return (present & (uint64_t(1) << 3)) != 0; }
+    void set_security_type(const FixText& value) { security_type = value; present |= (uint64_t(1) << 4); }
+    bool has_security_type() const { return (present & (uint64_t(1) << 4)) != 0; }
+    void set_currency(const FixText& value) { currency = value; present |= (uint64_t(1) << 5); }
+    bool has_currency() const { return (present & (uint64_t(1) << 5)) != 0; }
+    void set_security_trading_status(int64_t value) { security_trading_status = value; present |= (uint64_t(1) << 6); }
+    bool has_security_trading_status() const { return (present & (uint64_t(1) << 6)) != 0; }
+    void set_min_price_increment(const FixDecimal& value) { min_price_increment = value; present |= (uint64_t(1) << 7); }
+    bool has_min_price_increment() const { return (present & (uint64_t(1) << 7)) != 0; }
+    void set_round_lot(const FixDecimal& value) { round_lot = value; present |= (uint64_t(1) << 8); }
+    bool has_round_lot() const { return (present & (uint64_t(1) << 8)) != 0; }
+    void set_min_trade_vol(const FixDecimal& value) { min_trade_vol = value; present |= (uint64_t(1) << 9); }
+    bool has_min_trade_vol() const { return (present & (uint64_t(1) << 9)) != 0; }
+    void set_transact_time(const FixText& value) { transact_time = value; present |= (uint64_t(1) << 10); }
+    bool has_transact_time() const { return (present & (uint64_t(1) << 10)) != 0; }
+    void set_text(const FixText& value) { text = value; present |= (uint64_t(1) << 11); }
+    bool has_text() const { return (present & (uint64_t(1) << 11)) != 0; }
+
+    size_t max_body_size() const;
+    char* write_body(char* pos) const;
+
+    // False on a value that does not parse as
+    // its type. First occurrence wins, tags
+    // outside the message are skipped.
+    bool decode(const char* data, size_t size);
+    bool decode(const std::string& msg) { return decode(msg.data(), msg.size()); }
+};
+
+// 35=x
+struct SecurityListRequest {
+    static const size_t msg_type_size = 1;
+    static char* put_msg_type(char* pos) { return fix_put_prefix(pos, "35=x\x01"); }
+
+    uint64_t present;
+    FixText security_req_id;                // 320 SecurityReqID, required
+    int64_t security_list_request_type;     // 559 SecurityListRequestType, required
+    FixText symbol;                         // 55 Symbol
+    FixText security_id;                    // 48 SecurityID
+    FixText security_id_source;             // 22 SecurityIDSource
+    FixText security_type;                  // 167 SecurityType
+    FixText currency;                       // 15 Currency
+    char subscription_request_type;         // 263 SubscriptionRequestType
+
+    SecurityListRequest() : present(0), security_list_request_type(0), subscription_request_type(0) {}
+
+    static const uint64_t required_mask = 0x3ull;
+    bool complete() const { return (present & required_mask) == required_mask; }
+    void clear() { present = 0; }
+
+    void set_security_req_id(const FixText& value) { security_req_id = value; present |= (uint64_t(1) << 0); }
+    bool has_security_req_id() const { return (present & (uint64_t(1) << 0)) != 0; }
+    void set_security_list_request_type(int64_t value) { security_list_request_type = value; present |= (uint64_t(1) << 1); }
+    bool has_security_list_request_type() const { return (present & (uint64_t(1) << 1)) != 0; }
+    void set_symbol(const FixText& value) { symbol = value; present |= (uint64_t(1) << 2); }
+    bool has_symbol() const { return (present & (uint64_t(1) << 2)) != 0; }
+    void set_security_id(const FixText& value) { security_id = value; present |= (uint64_t(1) << 3); }
+    bool has_security_id() const { return (present & (uint64_t(1) << 3)) != 0; }
+    void set_security_id_source(const FixText& value) { security_id_source = value; present |= (uint64_t(1) << 4); }
+    bool has_security_id_source() const { return (present & (uint64_t(1) << 4)) != 0; }
+    void set_security_type(const FixText& value) { security_type = value; present |= (uint64_t(1) << 5); }
+    bool has_security_type() const { return (present & (uint64_t(1) << 5)) != 0; }
+    void set_currency(const FixText& value) { currency = value; present |= (uint64_t(1) << 6); }
+    bool has_currency() const { return (present & (uint64_t(1) << 6)) != 0; }
+    void set_subscription_request_type(char value) { subscription_request_type = value; present |= (uint64_t(1) << 7); }
+    bool has_subscription_request_type() const { return (present & (uint64_t(1) << 7)) != 0; }
+
+    size_t max_body_size() const;
+    char* write_body(char* pos) const;
+
+    // False on a value that does not parse as
+    // its type. First occurrence wins, tags
+    // outside the message are skipped.
+    bool decode(const char* data, size_t size);
+    bool decode(const std::string& msg) { return decode(msg.data(), msg.size()); }
+};
+
+// 35=y
+struct SecurityList {
+    static const size_t msg_type_size = 1;
+    static char* put_msg_type(char* pos) { return fix_put_prefix(pos, "35=y\x01"); }
+
+    uint64_t present;
+    FixText security_req_id;                // 320 SecurityReqID, required
+    FixText security_response_id;           // 322 SecurityResponseID, required
+    int64_t security_request_result;        // 560 SecurityRequestResult, required
+    int64_t tot_no_related_sym;             // 393 TotNoRelatedSym
+    bool last_fragment;                     // 893 LastFragment
+    int64_t no_related_sym;                 // 146 NoRelatedSym
+    FixText no_related_sym_entries;         // entries after 146, as on the wire
+
+    SecurityList() : present(0), security_request_result(0), tot_no_related_sym(0), last_fragment(false), no_related_sym(0) {}
+
+    static const uint64_t required_mask = 0x7ull;
+    bool complete() const { return (present & required_mask) == required_mask; }
+    void clear() { present = 0; }
+
+    void set_security_req_id(const FixText& value) { security_req_id = value; present |= (uint64_t(1) << 0); }
+    bool has_security_req_id() const { return (present & (uint64_t(1) << 0)) != 0; }
+    void set_security_response_id(const FixText& value) { security_response_id = value; present |= (uint64_t(1) << 1); }
+    bool has_security_response_id() const { return (present & (uint64_t(1) << 1)) != 0; }
+    void set_security_request_result(int64_t value) { security_request_result = value; present |= (uint64_t(1) << 2); }
+    bool has_security_request_result() const { return (present & (uint64_t(1) << 2)) != 0; }
+    void set_tot_no_related_sym(int64_t value) { tot_no_related_sym = value; present |= (uint64_t(1) << 3); }
+    bool has_tot_no_related_sym() const { return (present & (uint64_t(1) << 3)) != 0; }
+    void set_last_fragment(bool value) { last_fragment = value; present |= (uint64_t(1) << 4); }
+    bool has_last_fragment() const { return (present & (uint64_t(1) << 4)) != 0; }
+    void set_no_related_sym(int64_t count, const FixText& entries) { no_related_sym = count; no_related_sym_entries = entries; present |= (uint64_t(1) << 5); }
+    bool has_no_related_sym() const { return (present & (uint64_t(1) << 5)) != 0; }
+
+    size_t max_body_size() const;
+    char* write_body(char* pos) const;
+
+    // False on a value that does not parse as
+    // its type. First occurrence wins, tags
+    // outside the message are skipped.
+    bool decode(const char* data, size_t size);
+    bool decode(const std::string& msg) { return decode(msg.data(), msg.size()); }
+};
+
+}
+
+#endif
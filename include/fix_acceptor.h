@@ -0,0 +1,60 @@
+#ifndef FIX_ACCEPTOR_H
+#define FIX_ACCEPTOR_H
+
+#include "config_parser.h"
+#include "acceptor_reactor.h"
+
+#include <string>
+#include <vector>
+#include <map>
+#include <stdint.h>
+
+// connection_type=acceptor: listens on host:port
+// (or host=unix:<path>) and serves every acceptor
+// [section] on the same address. At Logon a
+// connection is bound to the section whose
+// sender_comp_id is the Logon's 56 and
+// target_comp_id its 49; a section with an empty
+// target_comp_id takes any counterparty.
+// acceptor_role=venue acks orders like the
+// simulation acceptor (sim_acceptor.h),
+// acceptor_role=drop_copy only logs them.
+//
+// Sessions run on reactor_threads reactors
+// (acceptor_reactor.h), placed by session_weight.
+// Every rebalance_interval the busiest reactor
+// hands a session to the least busy one.
+// SIGUSR1 prints the per-reactor load,
+// SIGINT/SIGTERM log every session out.
+class FixAcceptor {
+public:
+    FixAcceptor();
+    ~FixAcceptor();
+
+    int run(const SessionConfig& listen_config, const std::vector<SessionConfig>& sections);
+
+private:
+    int listen_fd;
+    int epoll_fd;
+    std::string unix_path;
+    uint64_t logon_timeout_ms;
+    uint64_t rebalance_interval_s;
+    SessionRegistry registry;
+    std::vector<AcceptorReactor*> reactors;
+
+    // Counters at the last rebalance
+    // and the last load report
+    std::map<AcceptorSession*, uint64_t> session_messages;
+    std::vector<ReactorLoad> reported;
+    uint64_t reported_ns;
+
+    bool open_listener(const SessionConfig& listen_config);
+    void accept_connections();
+    void rebalance();
+    void report_load();
+
+    FixAcceptor(const FixAcceptor&);
+    FixAcceptor& operator=(const FixAcceptor&);
+};
+
+#endif
@@ -0,0 +1,53 @@
+#ifndef FIX_DECIMAL_H
+#define FIX_DECIMAL_H
+
+#include <string>
+#include <cstddef>
+#include <stdint.h>
+
+// Fixed-point decimal for Price(44), OrderQty(38),
+// CumQty(14), LeavesQty(151), AvgPx(6)
+// value = mantissa / 10^scale
+// Always kept normalized (no trailing zeros
+// in the fraction) so "100" == "100.00".
+struct FixDecimal {
+    int64_t mantissa;
+    int scale;
+
+    FixDecimal() : mantissa(0), scale(0) {}
+    FixDecimal(int64_t m, int s) : mantissa(m), scale(s) {}
+};
+
+// Max significant digits parse/format handle
+static const int fix_decimal_max_digits = 18;
+
+// Parse "[-]digits[.digits]", both parts non-empty.
+// Returns False on any other character, empty
+// input or more than 18 significant digits
+// (trailing fraction zeros do not count).
+bool fix_decimal_parse(const char* text, size_t len, FixDecimal& value);
+bool fix_decimal_parse(const std::string& text, FixDecimal& value);
+
+// Writes the FIX text form into out (no NUL),
+// returns length. out needs 21 bytes.
+size_t fix_decimal_format(const FixDecimal& value, char* out);
+std::string fix_decimal_to_string(const FixDecimal& value);
+
+// Strip trailing fraction zeros
+void fix_decimal_normalize(FixDecimal& value);
+
+// -1, 0, 1
+int fix_decimal_compare(const FixDecimal& lhs, const FixDecimal& rhs);
+
+// Returns False on overflow
+bool fix_decimal_add(const FixDecimal& lhs, const FixDecimal& rhs, FixDecimal& out);
+bool fix_decimal_sub(const FixDecimal& lhs, const FixDecimal& rhs, FixDecimal& out);
+
+// Integer codecs for Qty-like fields
+bool fix_int_parse(const char* text, size_t len, int64_t& value);
+size_t fix_int_format(int64_t value, char* out);
+
+// Tags carried as decimals
+bool fix_is_decimal_tag(int tag);
+
+#endif
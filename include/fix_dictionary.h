@@ -0,0 +1,110 @@
+#ifndef FIX_DICTIONARY_H
+#define FIX_DICTIONARY_H
+
+#include <string>
+#include <vector>
+#include <cstddef>
+
+// Wire types the codecs and validation care
+// about, the dictionary's type names folded in
+enum FixFieldType {
+    fix_type_string,            // STRING, CURRENCY, EXCHANGE, dates, anything else
+    fix_type_char,              // CHAR
+    fix_type_int,               // INT, SEQNUM, LENGTH, NUMINGROUP
+    fix_type_decimal,           // PRICE, QTY, FLOAT, AMT, PRICEOFFSET, PERCENTAGE
+    fix_type_boolean,           // BOOLEAN, Y or N
+    fix_type_timestamp          // UTCTIMESTAMP
+};
+
+struct FixFieldDef {
+    int tag;
+    std::string name;
+    std::string type_name;      // as written, e.g. "PRICE"
+    FixFieldType type;
+    bool num_in_group;
+    std::vector<std::string> values;   // enum values, empty = any
+
+    FixFieldDef() : tag(0), type(fix_type_string), num_in_group(false) {}
+
+    // True when there are no enum values or
+    // data matches one of them
+    bool allows(const char* data, size_t size) const;
+};
+
+// One field of a message or group entry,
+// components already inlined. group is the
+// index into FixMessageDef::groups when tag
+// is a NumInGroup, -1 otherwise.
+struct FixMemberDef {
+    int tag;
+    bool required;
+    int group;
+
+    FixMemberDef() : tag(0), required(false), group(-1) {}
+    FixMemberDef(int field_tag, bool is_required, int group_index)
+        : tag(field_tag), required(is_required), group(group_index) {}
+};
+
+// Every entry starts with delimiter_tag,
+// the first member of the group
+struct FixGroupDef {
+    int count_tag;
+    int delimiter_tag;
+    std::vector<FixMemberDef> members;
+
+    FixGroupDef() : count_tag(0), delimiter_tag(0) {}
+};
+
+struct FixMessageDef {
+    std::string name;
+    std::string msg_type;
+    bool admin;                         // msgcat="admin"
+    std::vector<FixMemberDef> members;  // body, dictionary order
+    std::vector<FixGroupDef> groups;    // nested groups included
+
+    FixMessageDef() : admin(false) {}
+};
+
+// QuickFIX-style XML data dictionary (FIX44.xml
+// layout): header, trailer, messages, components
+// and fields. Components are inlined into the
+// messages at load; a member of an optional
+// component is never required.
+class FixDictionary {
+public:
+    FixDictionary() {}
+
+    // False with error set on a bad file or
+    // a name with no field/component behind it
+    bool load(const std::string& path, std::string& error);
+    bool load_text(const std::string& xml, std::string& error);
+
+    // "FIX.4.4" from major/minor
+    const std::string& begin_string() const { return begin; }
+
+    const FixFieldDef* field(int tag) const {
+        if (tag <= 0 || static_cast<size_t>(tag) >= by_tag.size() || by_tag[tag] < 0) return 0;
+        return &field_defs[static_cast<size_t>(by_tag[tag])];
+    }
+    const FixFieldDef* field(const std::string& name) const;
+    const FixMessageDef* message(const std::string& msg_type) const;
+
+    const std::vector<FixFieldDef>& fields() const { return field_defs; }
+    const std::vector<FixMessageDef>& messages() const { return message_defs; }
+    // Header and trailer as pseudo messages
+    const FixMessageDef& header() const { return header_def; }
+    const FixMessageDef& trailer() const { return trailer_def; }
+
+    // Highest field tag, for dense tables
+    int max_tag() const { return by_tag.empty() ? 0 : static_cast<int>(by_tag.size()) - 1; }
+
+private:
+    std::string begin;
+    std::vector<FixFieldDef> field_defs;
+    std::vector<int> by_tag;            // tag -> index in field_defs, -1 = unknown
+    std::vector<FixMessageDef> message_defs;
+    FixMessageDef header_def;
+    FixMessageDef trailer_def;
+};
+
+#endif
@@ -0,0 +1,200 @@
+#ifndef FIX_GROUPS_H
+#define FIX_GROUPS_H
+
+#include "fix_dictionary.h"
+#include "fix_typed.h"
+
+#include <string>
+#include <vector>
+#include <functional>
+#include <cstddef>
+#include <stdint.h>
+
+class FixGroupDecoder;
+class FixEntryView;
+
+// Entries of one repeating group instance
+class FixGroupView {
+public:
+    FixGroupView() : decoder(0), index(0) {}
+    FixGroupView(const FixGroupDecoder* owner, size_t group_index) : decoder(owner), index(group_index) {}
+
+    // False when the group is absent
+    bool valid() const { return decoder != 0; }
+
+    // Entries found, declared = the NumInGroup value
+    size_t size() const;
+    int64_t declared() const;
+    FixEntryView entry(size_t i) const;
+
+private:
+    const FixGroupDecoder* decoder;
+    size_t index;
+};
+
+// One group entry: its own fields and the
+// groups nested in it
+class FixEntryView {
+public:
+    FixEntryView() : decoder(0), index(0) {}
+    FixEntryView(const FixGroupDecoder* owner, size_t entry_index) : decoder(owner), index(entry_index) {}
+
+    // First occurrence in this entry,
+    // nested entries not included
+    bool get(int tag, FixText& value) const;
+    FixGroupView group(int count_tag) const;
+
+    // Fields of the entry in wire order,
+    // nested ones included
+    size_t field_count() const;
+    int field_tag(size_t i) const;
+    const FixText& field_value(size_t i) const;
+
+private:
+    const FixGroupDecoder* decoder;
+    size_t index;
+};
+
+// Indexes a whole message by the group layout of
+// its dictionary entry: a field is owned by the
+// message or by the group entry it sits in. An
+// entry starts at the group's delimiter and runs
+// while tags are members of the group. Values
+// point into the decoded bytes, nothing is
+// copied, and the index vectors are reused from
+// one message to the next.
+//
+//     FixGroupDecoder decoder;
+//     decoder.decode(msg.data(), msg.size(), *dictionary.message("y"));
+//     FixGroupView related = decoder.group(146);
+//     for (size_t i = 0; i < related.size(); ++i) related.entry(i).get(55, symbol);
+class FixGroupDecoder {
+public:
+    FixGroupDecoder() : message(0) {}
+
+    // False on a malformed field. def supplies
+    // the groups, tags outside it stay at the top.
+    bool decode(const char* data, size_t size, const FixMessageDef& def);
+
+    // Bytes holding entries of one group of def
+    // only, as the stream decoder hands them over
+    bool decode_entries(const char* data, size_t size, const FixMessageDef& def, const FixGroupDef& group);
+
+    // Top-level fields and groups
+    bool get(int tag, FixText& value) const;
+    FixGroupView group(int count_tag) const;
+
+    // Group decode_entries() filled
+    FixGroupView root() const { return groups.empty() ? FixGroupView() : FixGroupView(this, 0); }
+
+    size_t field_count() const { return fields.size(); }
+
+private:
+    friend class FixGroupView;
+    friend class FixEntryView;
+
+    struct Field {
+        int tag;
+        FixText value;
+        int owner;                  // entry index, -1 = top level
+    };
+
+    struct Group {
+        const FixGroupDef* def;
+        int64_t declared;
+        int owner;                  // entry holding the count tag, -1 = top level
+        size_t first;               // in entry_order
+        size_t count;
+        int current;                // entry being filled, -1 = none yet
+    };
+
+    struct Entry {
+        size_t group;
+        size_t first_field;
+        size_t end_field;           // nested fields included
+        size_t first_group;         // groups nested in it start here
+    };
+
+    const FixMessageDef* message;
+    std::vector<Field> fields;
+    std::vector<Group> groups;
+    std::vector<Entry> entries;
+    std::vector<size_t> entry_order;    // entry indexes sorted by group
+    std::vector<size_t> open;           // groups being walked, innermost last
+
+    bool index(const char* data, size_t size, const FixMessageDef& def, const FixGroupDef* root_group);
+    const FixGroupDef* count_group(const std::vector<FixMemberDef>& members, int tag) const;
+    static bool is_member(const FixGroupDef& group, int tag);
+    FixGroupView find_group(int owner, int count_tag) const;
+};
+
+// End of one streamed message
+struct FixStreamSummary {
+    std::string msg_type;
+    size_t body_length;         // BodyLength(9) as declared
+    uint64_t entries;           // top-level group entries handed out
+    bool checksum_ok;
+    bool length_ok;             // bytes seen match BodyLength
+
+    FixStreamSummary() : body_length(0), entries(0), checksum_ok(false), length_ok(false) {}
+};
+
+// Decodes one message as its bytes arrive, for
+// messages too large to buffer whole (35=y
+// SecurityList, mass quotes). Top-level fields
+// go to the field handler when their SOH
+// arrives; each entry of a top-level group is
+// held only until the next one starts, then
+// goes to the entry handler. Memory is bounded
+// by the largest entry, not the message.
+// Values are valid during the call only.
+class FixStreamDecoder {
+public:
+    typedef std::function<void(int tag, const FixText& value)> FieldHandler;
+    typedef std::function<void(int count_tag, const FixEntryView& entry)> EntryHandler;
+    typedef std::function<void(const FixStreamSummary& summary)> EndHandler;
+
+    // No dictionary = no groups, every
+    // field goes to the field handler
+    explicit FixStreamDecoder(const FixDictionary* dict = 0) : dictionary(dict) { reset(); }
+
+    void on_field(const FieldHandler& handler) { field_handler = handler; }
+    void on_entry(const EntryHandler& handler) { entry_handler = handler; }
+    void on_end(const EndHandler& handler) { end_handler = handler; }
+
+    // Consumes bytes up to the end of the current
+    // message and returns how many; the rest
+    // belongs to the next message
+    size_t feed(const char* data, size_t size);
+
+    // Message finished (10= read) or malformed
+    bool done() const { return finished || broken; }
+    bool failed() const { return broken; }
+
+    // Ready for the next message
+    void reset();
+
+private:
+    const FixDictionary* dictionary;
+    FieldHandler field_handler;
+    EntryHandler entry_handler;
+    EndHandler end_handler;
+
+    std::string partial;                // field split across feeds
+    std::string entry_bytes;            // entry being collected
+    std::vector<int> group_tags;        // members of the open group, nested included
+    const FixMessageDef* message;
+    const FixGroupDef* group;           // open top-level group, 0 = none
+    FixGroupDecoder entry_decoder;
+    FixStreamSummary summary;
+    int field_number;
+    size_t body_bytes;
+    unsigned int sum;
+    bool finished;
+    bool broken;
+
+    bool field(const char* data, size_t size);
+    void flush_entry();
+};
+
+#endif
@@ -3,6 +3,36 @@
 #include <string>
 #include <vector>
 #include <utility>
+#include <cstring>
+#include "fix_decimal.h"
+
+// Body field the caller still owns,
+// copied only when encoded
+struct FixFieldView {
+    int tag;
+    const char* data;
+    size_t size;
+
+    FixFieldView() : tag(0), data(0), size(0) {}
+    FixFieldView(int field_tag, const char* value)
+        : tag(field_tag), data(value), size(std::strlen(value)) {}
+    FixFieldView(int field_tag, const char* value, size_t length)
+        : tag(field_tag), data(value), size(length) {}
+    FixFieldView(int field_tag, const std::string& value)
+        : tag(field_tag), data(value.data()), size(value.size()) {}
+};
+
+// MsgType and body, the header (8/9/34/49/
+// 56/52) and trailer (10) come from encode_view()
+struct FixMessageView {
+    const char* msg_type;
+    const FixFieldView* fields;
+    size_t count;
+
+    FixMessageView() : msg_type(""), fields(0), count(0) {}
+    FixMessageView(const char* type, const FixFieldView* body, size_t body_count)
+        : msg_type(type), fields(body), count(body_count) {}
+};
 
 class FixMessage {
 public:
@@ -51,8 +81,29 @@ public:
                              const std::string& sending_time,
                              const std::string& test) const;
 
+    // 35=3 Reject
+    // 371 left out when ref_tag_id is 0,
+    // 372 when ref_msg_type is empty
+    std::string build_reject(int msg_seq_num,
+                             const std::string& sending_time,
+                             int ref_seq_num, int ref_tag_id,
+                             const std::string& ref_msg_type,
+                             int reason, const std::string& text) const;
+
+    // Appends the encoded message to out. BodyLength
+    // is counted up front, so no temporaries.
+    // Returns False if a CompID is not set.
+    bool encode_view(std::string& out,
+                     const FixMessageView& view,
+                     int msg_seq_num,
+                     const std::string& sending_time) const;
+
     static std::string to_pipe_delimited(const std::string& fix);
 
+    // Price/Qty fields from fixed-point,
+    // formatted without trailing zeros
+    static Field make_decimal_field(int tag, const FixDecimal& value);
+
     // Build a FIX message from already-ordered fields
     // Ignores any 8/9/10 in the file and rebuilds
     std::string build_from_fields(const FieldList& ordered_fields) const;
@@ -71,6 +122,7 @@ private:
 
     static void append_field(std::string& buffer, int tag, const std::string& tag_value);
     static void append_field_int(std::string& buffer, int tag, int tag_value);
+    static void append_field_view(std::string& buffer, int tag, const char* data, size_t size);
 
     static int calculate_checksum(const std::string& data);
 };
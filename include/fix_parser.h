@@ -2,6 +2,11 @@
 #define FIX_PARSER_H
 
 #include <string>
+#include <deque>
+#include <utility>
+#include "transport.h"
+
+class FixStreamDecoder;
 
 class FixParser {
 public:
@@ -11,6 +16,10 @@ public:
     // to the internal buffer
     void append_bytes(const char* data, size_t size);
 
+    // Same as above and remembers the kernel
+    // RX stamp of this chunk
+    void append_bytes(const char* data, size_t size, const SocketTimestamp& stamp);
+
     // It reads ONE complete FIX message from
     // the internal buffer instead of network.
     // Returns True if complete FIX message found
@@ -19,19 +28,49 @@ public:
     // full message yet.
     bool read_next_message(std::string& message);
 
+    // Same as above, stamp is the RX stamp of
+    // the chunk that completed the message
+    // (zero if appended without a stamp).
+    bool read_next_message(std::string& message, SocketTimestamp& stamp);
+
     // Clears/resets internal buffer.
     void reset();
 
+    // Messages over the 1MB BodyLength cap are
+    // fed to decoder as they arrive instead of
+    // being buffered, then framing goes on with
+    // the next one. Without a decoder they stay
+    // unreadable. 0 detaches.
+    void set_oversize_decoder(FixStreamDecoder* decoder) { oversize = decoder; }
+
 private:
     std::string buffer;
 
+    FixStreamDecoder* oversize;
+    bool streaming;             // oversize is mid message
+
+    // Bytes dropped from the front of buffer
+    // since start, used to map stamps to messages
+    size_t stream_offset;
+
+    // (stream end offset of chunk, RX stamp)
+    std::deque<std::pair<size_t, SocketTimestamp> > stamps;
+
+    void discard(size_t count);
+
     // Lookup for BeginString
     // in internal buffer
     bool find_begin_string(size_t& start_pos) const;
 
     // Reads BodyLength(9) from buffer
     // return True if tag 9 is found and valid.
-    bool parse_body_length(size_t start_pos, int& body_length, size_t& end_body_len_field) const;
+    // oversized is set when it is over the cap.
+    bool parse_body_length(size_t start_pos, int& body_length, size_t& end_body_len_field,
+                           bool& oversized) const;
+
+    // Feeds buffered bytes to oversize, true
+    // once its message is done
+    bool stream_oversized();
 };
 
 #endif
@@ -1,17 +1,65 @@
 #ifndef FIX_REGRESSION_H
 #define FIX_REGRESSION_H
 
-#include "socket.h"
+#include "transport.h"
 #include "fix_message.h"
 #include "fix_parser.h"
+#include "id_generator.h"
+#include "throttle.h"
+#include "regression_cache.h"
+#include "regression_latency.h"
 
 #include <string>
+#include <vector>
+#include <utility>
 #include <stdint.h>
 
-bool run_fix_regression(TcpSocket& socket,
+// application.h
+struct SessionContext;
+
+// Pass/fail accounting of one regression run,
+// merged across shards in sharded mode
+struct RegressionSummary {
+    int total_run;
+    int total_passed;
+    int total_failed;
+    int total_cached;       // of total_run, reported from the result cache
+    int latency_flagged;    // scenarios off the --baseline
+    int unmatched;          // business messages no step took: late, unrouted, unused
+    std::vector<std::string> failed_names;
+
+    // scenario file -> ms spent in its scenarios
+    std::vector<std::pair<std::string, uint64_t> > file_ms;
+
+    RegressionSummary() : total_run(0), total_passed(0), total_failed(0), total_cached(0), latency_flagged(0),
+                          unmatched(0) {}
+};
+
+struct RegressionOptions {
+    int max_jobs;       // scenarios run at once on the session
+    bool verbose;       // field table for passing TST steps too
+    RegressionRerun rerun;
+    uint64_t config_hash;   // regression_config_hash() of the session
+    std::string baseline_path;      // latency CSV of an earlier run
+    int baseline_threshold_pct;
+
+    RegressionOptions()
+        : max_jobs(1), verbose(false), rerun(regression_rerun_all), config_hash(0),
+          baseline_threshold_pct(20) {}
+};
+
+// Files of a scenario directory (sorted),
+// or the path itself when it is a file
+std::vector<std::string> list_regression_files(const std::string& scenarios_path);
+
+// Runs the BGN..END scenarios of files, up to
+// options.max_jobs at once on this session. Output is
+// reported per scenario in file order.
+bool run_fix_regression(Transport& socket,
+                        SessionContext& session,
                         FixParser& fix_parser,
                         FixMessage& fix,
-                        const std::string& scenarios_path,
+                        const std::vector<std::string>& files,
                         int& outbound_seq,
                         uint64_t& last_send_ms,
                         const std::string& token_path,
@@ -19,6 +67,15 @@ bool run_fix_regression(TcpSocket& socket,
                         bool& scenarios_sent,
                         bool& scenario_response_started,
                         uint64_t& last_scenario_response_ms,
-                        bool& logout_initiated);
+                        bool& logout_initiated,
+                        IdGenerator& id_generator,
+                        OutboundThrottle& throttle,
+                        const RegressionOptions& options,
+                        RegressionSummary& summary);
+
+// Shard summary file, read back by the
+// parent of a sharded run
+bool save_regression_summary(const std::string& path, const RegressionSummary& summary);
+bool load_regression_summary(const std::string& path, RegressionSummary& summary);
 
 #endif
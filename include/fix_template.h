@@ -2,9 +2,12 @@
 #define FIX_TEMPLATE_H
 
 #include "fix_message.h"
+#include "id_generator.h"
 #include <string>
 #include <stdint.h>
 
+class InstrumentCache;
+
 struct FixTemplateMessage {
     std::string msg_type;
     FixMessage::FieldList fields;
@@ -26,6 +29,16 @@ struct FixTemplateRuntime {
     int msg_seq_num;
     std::string sending_time_utc;
 
+    // ClOrdID/CrossID source, shared
+    // across the session, required
+    IdGenerator* id_generator;
+
+    // Resolves ${TICK_SIZE}, ${ROUND_LOT},
+    // ${MIN_TRADE_VOL}, ${SECURITY_ID},
+    // ${SECURITY_ID_SOURCE} and ${CURRENCY} for
+    // the Symbol(55) of the message, 0 = none
+    const InstrumentCache* instruments;
+
     FixTemplateState state;
 };
 
@@ -34,6 +47,7 @@ bool fix_template_load(
         FixTemplateMessage& template_message
 );
 
+// False when runtime has no id_generator
 bool fix_template_apply(
         FixTemplateRuntime& runtime,
         FixTemplateMessage& template_message
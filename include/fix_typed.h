@@ -0,0 +1,195 @@
+#ifndef FIX_TYPED_H
+#define FIX_TYPED_H
+
+#include "fix_decimal.h"
+#include "fix_message.h"
+
+#include <string>
+#include <cstring>
+#include <cstddef>
+#include <stdint.h>
+
+// Support for the generated message types
+// (fix_codegen, fix44_messages.h): field
+// writers with the tag prefix as literal bytes,
+// a one-field scanner and the header/trailer.
+
+// String field of a typed message, pointing
+// into the caller's string or the decoded
+// message. Nothing is copied.
+struct FixText {
+    const char* data;
+    size_t size;
+
+    FixText() : data(""), size(0) {}
+    FixText(const char* text) : data(text), size(std::strlen(text)) {}
+    FixText(const char* text, size_t length) : data(text), size(length) {}
+    FixText(const std::string& text) : data(text.data()), size(text.size()) {}
+
+    std::string str() const { return std::string(data, size); }
+};
+
+// Widest int / decimal fix_*_format writes
+static const size_t fix_int_max_size = 20;
+static const size_t fix_decimal_max_size = 21;
+
+// "44=" and the like, N is known at compile time
+// so this is a fixed-size copy
+template <size_t N>
+inline char* fix_put_prefix(char* pos, const char (&text)[N]) {
+    std::memcpy(pos, text, N - 1);
+    return pos + N - 1;
+}
+
+// Bytes as they are, no SOH (group entries)
+inline char* fix_put_raw(char* pos, const FixText& value) {
+    std::memcpy(pos, value.data, value.size);
+    return pos + value.size;
+}
+
+inline char* fix_put_text(char* pos, const FixText& value) {
+    pos = fix_put_raw(pos, value);
+    *pos++ = '\x01';
+    return pos;
+}
+
+inline char* fix_put_char(char* pos, char value) {
+    *pos++ = value;
+    *pos++ = '\x01';
+    return pos;
+}
+
+inline char* fix_put_bool(char* pos, bool value) {
+    return fix_put_char(pos, value ? 'Y' : 'N');
+}
+
+inline char* fix_put_int(char* pos, int64_t value) {
+    pos += fix_int_format(value, pos);
+    *pos++ = '\x01';
+    return pos;
+}
+
+inline char* fix_put_decimal(char* pos, const FixDecimal& value) {
+    pos += fix_decimal_format(value, pos);
+    *pos++ = '\x01';
+    return pos;
+}
+
+inline bool fix_get_char(const FixText& text, char& value) {
+    if (text.size != 1) return false;
+    value = text.data[0];
+    return true;
+}
+
+inline bool fix_get_bool(const FixText& text, bool& value) {
+    if (text.size != 1 || (text.data[0] != 'Y' && text.data[0] != 'N')) return false;
+    value = text.data[0] == 'Y';
+    return true;
+}
+
+inline bool fix_get_int(const FixText& text, int64_t& value) {
+    return fix_int_parse(text.data, text.size, value);
+}
+
+inline bool fix_get_decimal(const FixText& text, FixDecimal& value) {
+    return fix_decimal_parse(text.data, text.size, value);
+}
+
+// tag=value<SOH> at pos, pos moves past it.
+// False at end or on a malformed field.
+inline bool fix_next_field(const char*& pos, const char* end, int& tag, FixText& value) {
+    const char* p = pos;
+    int number = 0;
+    while (p < end && *p >= '0' && *p <= '9') {
+        number = number * 10 + (*p - '0');
+        ++p;
+    }
+    if (p == pos || p >= end || *p != '=') return false;
+
+    const char* data = ++p;
+    while (p < end && *p != '\x01') ++p;
+    if (p >= end) return false;
+
+    tag = number;
+    value = FixText(data, static_cast<size_t>(p - data));
+    pos = p + 1;
+    return true;
+}
+
+// Header bytes that do not change per message,
+// built once per session
+struct FixTypedHeader {
+    std::string begin_string;   // "8=FIX.4.4<SOH>9="
+    std::string comp_ids;       // "49=...<SOH>56=...<SOH>"
+
+    FixTypedHeader() {}
+    explicit FixTypedHeader(const FixMessage& fix) {
+        set(fix.get_begin_string(), fix.get_sender_comp_id(), fix.get_target_comp_id());
+    }
+
+    void set(const std::string& begin, const std::string& sender, const std::string& target) {
+        begin_string = "8=" + begin + "\x01" "9=";
+        comp_ids = "49=" + sender + "\x01" "56=" + target + "\x01";
+    }
+};
+
+// Appends one message: 8, 9, 35, 34, 49, 56,
+// 52, the set body fields in dictionary order
+// and 10. The body is written first behind room
+// for 8/9, then 8/9 are placed right before it,
+// so BodyLength is never counted separately.
+// False if the header is not set.
+template <class Message>
+bool fix_encode(const FixTypedHeader& header, const Message& message,
+                int msg_seq_num, const std::string& sending_time, std::string& out) {
+    if (header.comp_ids.empty()) {
+        return false;
+    }
+
+    // 9= takes at most 7 digits, FixParser's cap
+    const size_t head_room = header.begin_string.size() + 8;
+    const size_t max_size = head_room + Message::msg_type_size + 3 + fix_int_max_size + 1 +
+                            header.comp_ids.size() + 3 + sending_time.size() + 1 +
+                            message.max_body_size() + 7;
+
+    const size_t start = out.size();
+    out.resize(start + max_size);
+    char* const base = &out[start];
+    char* const body = base + head_room;
+
+    char* pos = Message::put_msg_type(body);
+    pos = fix_put_prefix(pos, "34=");
+    pos = fix_put_int(pos, msg_seq_num);
+    pos = fix_put_raw(pos, header.comp_ids);
+    pos = fix_put_prefix(pos, "52=");
+    pos = fix_put_text(pos, sending_time);
+    pos = message.write_body(pos);
+
+    char digits[fix_int_max_size + 1];
+    const size_t digit_count = fix_int_format(static_cast<int64_t>(pos - body), digits);
+    char* head = body - (header.begin_string.size() + digit_count + 1);
+    std::memcpy(head, header.begin_string.data(), header.begin_string.size());
+    std::memcpy(head + header.begin_string.size(), digits, digit_count);
+    body[-1] = '\x01';
+
+    if (head != base) {
+        std::memmove(base, head, static_cast<size_t>(pos - head));
+        pos -= head - base;
+    }
+
+    unsigned int sum = 0;
+    for (const char* p = base; p < pos; ++p) {
+        sum += static_cast<unsigned char>(*p);
+    }
+    const unsigned int checksum = sum % 256;
+    pos = fix_put_prefix(pos, "10=");
+    *pos++ = static_cast<char>('0' + checksum / 100);
+    *pos++ = static_cast<char>('0' + checksum / 10 % 10);
+    *pos++ = static_cast<char>('0' + checksum % 10);
+    *pos++ = '\x01';
+
+    out.resize(static_cast<size_t>(pos - out.data()));
+    return true;
+}
+
+#endif
@@ -0,0 +1,107 @@
+#ifndef FIX_VALIDATOR_H
+#define FIX_VALIDATOR_H
+
+#include "fix_dictionary.h"
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <stdint.h>
+
+// validation= in the session config
+enum FixValidationMode {
+    validation_off,
+    validation_warn,            // log and pass the message on
+    validation_reject           // answer with 35=3, drop the message
+};
+
+// off, warn, reject
+bool parse_validation_mode(const std::string& text, FixValidationMode& mode);
+
+// SessionRejectReason(373) values reported
+static const int fix_reject_required_tag_missing    = 1;
+static const int fix_reject_tag_not_defined         = 2;
+static const int fix_reject_undefined_tag           = 3;
+static const int fix_reject_tag_without_value       = 4;
+static const int fix_reject_value_incorrect         = 5;
+static const int fix_reject_incorrect_data_format   = 6;
+static const int fix_reject_invalid_msg_type        = 11;
+static const int fix_reject_tag_appears_twice       = 13;
+static const int fix_reject_tag_out_of_order        = 14;
+static const int fix_reject_group_out_of_order      = 15;
+static const int fix_reject_incorrect_num_in_group  = 16;
+
+// What a Reject (35=3) needs: 45/371/372/373/58
+struct FixValidationError {
+    int reason;
+    int ref_tag;                // 0 = none
+    int ref_seq_num;
+    std::string ref_msg_type;
+    std::string text;
+
+    FixValidationError() : reason(0), ref_tag(0), ref_seq_num(0) {}
+};
+
+// Checks whole messages (8 to 10) against a data
+// dictionary in one pass: tags known and defined
+// for the MsgType, none repeated outside groups,
+// values of the field type and in its enum,
+// required tags present, NumInGroup counts and
+// entries starting with the delimiter. Required
+// fields inside group entries are not checked.
+//
+// The dictionary is compiled at load: tags map to
+// a dense field index, each MsgType to a slot per
+// field and a bitset of its required fields, so
+// the pass does no lookups by name. Not thread
+// safe, one validator per session.
+class FixValidator {
+public:
+    FixValidator() : generation(0) {}
+
+    // False with error set if the dictionary does
+    // not load or a message has more than 64
+    // required fields with the header
+    bool load(const std::string& path, std::string& error);
+    bool build(const FixDictionary& dictionary, std::string& error);
+
+    // True if the message passes, else the first
+    // problem found is in error
+    bool validate(const char* data, size_t size, FixValidationError& error);
+    bool validate(const std::string& msg, FixValidationError& error) {
+        return validate(msg.data(), msg.size(), error);
+    }
+
+    const FixDictionary& get_dictionary() const { return dictionary; }
+
+private:
+    struct Group {
+        int count_tag;
+        int delimiter_tag;
+    };
+
+    struct Rule {
+        std::string msg_type;
+        std::vector<uint16_t> slots;        // field index -> slot_* bits
+        uint64_t required;
+        std::vector<int> required_tags;     // required bit -> tag
+        std::vector<Group> groups;
+    };
+
+    FixDictionary dictionary;
+    std::vector<uint16_t> tag_index;        // tag -> field index, none = 0xFFFF
+    std::vector<uint8_t> field_flags;       // field index -> type and flag_* bits
+    std::vector<Rule> rules;
+    int16_t single_char_rule[256];          // one-byte MsgTypes -> rule, -1 = none
+
+    // Top-level fields seen, by field index;
+    // equal to generation = seen in this message
+    std::vector<uint32_t> seen;
+    uint32_t generation;
+
+    const Rule* find_rule(const char* msg_type, size_t size) const;
+    bool check(const char* data, size_t size, FixValidationError& error);
+    bool add_rule(const FixMessageDef& message, std::string& error);
+};
+
+#endif
@@ -0,0 +1,50 @@
+#ifndef ID_GENERATOR_H
+#define ID_GENERATOR_H
+
+#include <string>
+#include <cstddef>
+#include <stdint.h>
+
+// ClOrdID(11)/CrossID(548) generator
+// PREFIX + EPOCH(4) + COUNTER(8) (eg. CL0001000000A7)
+//
+// EPOCH is the session-unique run number from
+// the token store (next_id_epoch), COUNTER is
+// bumped in place like an odometer, so an ID is
+// one memcpy plus a carry, no snprintf.
+class IdGenerator {
+public:
+    enum Radix {
+        base36 = 36,    // 0-9A-Z, safe for case-insensitive venues
+        base62 = 62     // 0-9A-Za-z
+    };
+
+    static const size_t epoch_width = 4;
+    static const size_t counter_width = 8;
+    static const size_t max_prefix_len = 8;
+
+    // Longest ID next() writes
+    static const size_t max_id_len = max_prefix_len + epoch_width + counter_width;
+
+    IdGenerator();
+
+    // False when session_epoch needs more than
+    // epoch_width digits: the IDs would repeat
+    // those of an earlier run
+    bool init(uint32_t session_epoch, Radix radix = base36);
+
+    // Last epoch init() takes, radix^epoch_width - 1
+    static uint32_t max_epoch(Radix radix);
+
+    // Writes next ID into out (no NUL),
+    // returns length. out needs max_id_len.
+    // prefix longer than max_prefix_len is cut.
+    size_t next(const char* prefix, char* out);
+    std::string next(const char* prefix);
+
+private:
+    int radix;
+    char digits[epoch_width + counter_width];
+};
+
+#endif
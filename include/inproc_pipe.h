@@ -0,0 +1,95 @@
+#ifndef INPROC_PIPE_H
+#define INPROC_PIPE_H
+
+#include "transport.h"
+
+#include <string>
+#include <mutex>
+#include <condition_variable>
+
+// Byte pipe between two threads of one process,
+// for a gateway co-located with the session or a
+// benchmark driving both ends. No kernel, no
+// SimAcceptor: each end is a Transport, the
+// owner of the pipe serves the other one.
+//
+//     InprocPipe pipe;
+//     inproc_register("gw", pipe);
+//     InprocEndpoint gateway;
+//     gateway.connect(pipe, InprocEndpoint::server_side);
+//     // session with host=inproc:gw connects the
+//     // client side, the gateway reads and answers
+//     // through its endpoint on its own thread
+class InprocPipe {
+public:
+    InprocPipe() {}
+
+private:
+    friend class InprocEndpoint;
+
+    // One direction: written under mutex,
+    // readers wait on ready
+    struct Direction {
+        std::mutex mutex;
+        std::condition_variable ready;
+        std::string data;
+        size_t offset;
+        bool closed;
+
+        Direction() : offset(0), closed(false) {}
+    };
+
+    Direction to_server;
+    Direction to_client;
+
+    InprocPipe(const InprocPipe&);
+    InprocPipe& operator=(const InprocPipe&);
+};
+
+// One end of an InprocPipe. Sends never block,
+// receives wait on the peer like a socket with
+// SO_RCVTIMEO. Closing either end closes both
+// directions, the other end then reads 0.
+class InprocEndpoint : public Transport {
+public:
+    enum Side {
+        client_side,    // the session, starts a fresh stream
+        server_side     // the gateway or benchmark peer
+    };
+
+    InprocEndpoint();
+    ~InprocEndpoint();
+
+    bool connect(InprocPipe& pipe, Side side);
+
+    void close();
+    bool is_open() const { return in != 0; }
+    bool send_bytes(const std::string& data);
+    bool set_receive_timeout(int timeout_millis);
+    bool wait_readable(int timeout_millis);
+    int receive_bytes(char* buf, size_t max_len);
+
+private:
+    InprocPipe::Direction* in;
+    InprocPipe::Direction* out;
+    int receive_timeout_ms;
+
+    static void reopen(InprocPipe::Direction& direction);
+    static void shut(InprocPipe::Direction& direction);
+    static bool has_input(const InprocPipe::Direction& direction);
+
+    InprocEndpoint(const InprocEndpoint&);
+    InprocEndpoint& operator=(const InprocEndpoint&);
+};
+
+// Pipes by name for host=inproc:<name>. The owner
+// registers before the session connects and
+// unregisters before the pipe goes away.
+// False when the name is taken.
+bool inproc_register(const std::string& name, InprocPipe& pipe);
+void inproc_unregister(const std::string& name);
+
+// 0 when no pipe has that name
+InprocPipe* inproc_find(const std::string& name);
+
+#endif
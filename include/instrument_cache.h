@@ -0,0 +1,165 @@
+#ifndef INSTRUMENT_CACHE_H
+#define INSTRUMENT_CACHE_H
+
+#include "fix_decimal.h"
+#include "fix_dictionary.h"
+#include "fix_groups.h"
+#include "fix_message.h"
+#include "fix_typed.h"
+
+#include <string>
+#include <vector>
+#include <set>
+#include <cstddef>
+#include <stdint.h>
+
+// InstrumentRecord::known bits
+static const uint32_t instrument_has_security_id        = 1u << 0;
+static const uint32_t instrument_has_security_id_source = 1u << 1;
+static const uint32_t instrument_has_security_type      = 1u << 2;
+static const uint32_t instrument_has_currency           = 1u << 3;
+static const uint32_t instrument_has_tick_size          = 1u << 4;
+static const uint32_t instrument_has_round_lot          = 1u << 5;
+static const uint32_t instrument_has_min_trade_vol      = 1u << 6;
+static const uint32_t instrument_has_trading_status     = 1u << 7;
+
+// One instrument, 128 bytes, stored in the cache
+// file as is. Text is NUL padded, a value that
+// does not fit is left unknown.
+struct InstrumentRecord {
+    char symbol[32];                // Symbol(55)
+    char security_id[24];           // SecurityID(48)
+    char security_id_source[4];     // SecurityIDSource(22)
+    char security_type[8];          // SecurityType(167)
+    char currency[4];               // Currency(15)
+    FixDecimal tick_size;           // MinPriceIncrement(969)
+    FixDecimal round_lot;           // RoundLot(561)
+    FixDecimal min_trade_vol;       // MinTradeVol(562)
+    int32_t trading_status;         // SecurityTradingStatus(326)
+    uint32_t known;                 // instrument_has_* bits
+};
+
+// Security master for the session: Symbol(55) ->
+// InstrumentRecord, filled from SecurityList
+// (35=y), SecurityDefinition (35=d) and
+// SecurityStatus (35=f) and kept on disk between
+// runs.
+//
+// Records are kept sorted by symbol, indexed by
+// an open addressing table of record numbers at
+// most half full, so a lookup is one hash of the
+// symbol, usually one slot and one compare. The
+// file is that layout behind a header:
+//   magic[4] version:u32 record_size:u32
+//   slot_count:u32 count:u64 saved_sec:i64
+//   count x InstrumentRecord, slot_count x u32
+// open() maps it and points into the mapping,
+// only the index is checked. Updates are staged
+// per message and applied by commit(): a known
+// symbol is changed in place, new symbols are
+// merged in one pass, which moves the records to
+// the heap and rebuilds the index. save() writes
+// them back, write-then-rename.
+class InstrumentCache {
+public:
+    InstrumentCache();
+    ~InstrumentCache();
+
+    // Data dictionary for the 35=y group layout
+    bool load_dictionary(const std::string& dictionary_path, std::string& error);
+
+    // Maps path. False with error set when the
+    // file is missing, of another version,
+    // truncated or its index is corrupt; the
+    // cache then starts empty
+    // and save() still writes to path.
+    bool open(const std::string& cache_path, std::string& error);
+    bool save(std::string& error);
+    void close();
+
+    bool is_open() const { return !path.empty(); }
+    size_t size() const { return count; }
+
+    // Changed since open() or save()
+    bool is_dirty() const { return dirty; }
+
+    // 0 when unknown. Valid until an inbound
+    // update adds a symbol.
+    const InstrumentRecord* find(const char* symbol, size_t size) const;
+    const InstrumentRecord* find(const std::string& symbol) const {
+        return find(symbol.data(), symbol.size());
+    }
+
+    // 35=y/d/f, other MsgTypes are ignored.
+    // True if records changed.
+    bool on_message(const std::string& msg);
+
+    // Same for a 35=y too large for the parser,
+    // fed by a FixStreamDecoder
+    void on_stream_field(int tag, const FixText& value);
+    void on_stream_entry(int count_tag, const FixEntryView& entry);
+    bool on_stream_end(const FixStreamSummary& summary);
+
+    // 35=x for all securities and 35=c for one
+    // symbol. SecurityReqID(320) is kept until
+    // its answer arrives.
+    std::string request_list(const FixTypedHeader& header, int msg_seq_num, const std::string& sending_time);
+    std::string request_definition(const FixTypedHeader& header, int msg_seq_num,
+                                   const std::string& sending_time, const std::string& symbol);
+
+    // Requests not answered yet
+    bool awaiting() const { return !open_requests.empty(); }
+    void forget_requests() { open_requests.clear(); }
+
+    // Records merged in by the last commit
+    size_t last_changes() const { return changes; }
+
+    const FixDictionary& get_dictionary() const { return dictionary; }
+
+private:
+    std::string path;
+    FixDictionary dictionary;
+    const FixMessageDef* security_list;
+
+    // Point into the mapping or into
+    // the owned vectors below
+    InstrumentRecord* records;
+    size_t count;
+    uint32_t* slots;                // record index + 1, 0 = empty
+    size_t slot_count;              // power of two
+    int slot_shift;                 // hash >> slot_shift = slot
+
+    void* mapped;
+    size_t mapped_size;
+    bool mapped_writable;
+    std::vector<InstrumentRecord> owned_records;
+    std::vector<uint32_t> owned_slots;
+
+    std::vector<InstrumentRecord> staged;
+    FixGroupDecoder list_decoder;
+    bool dirty;
+    size_t changes;
+
+    std::set<std::string> open_requests;
+    int request_counter;
+
+    // SecurityReqID(320)/LastFragment(893)
+    // of the 35=y being streamed
+    bool stream_list;
+    std::string stream_req_id;
+    bool stream_last;
+
+    void set_slots(uint32_t* table, size_t size);
+    void unmap();
+    void make_writable();
+    size_t locate(const char* symbol, size_t size) const;
+    void stage_entry(const FixEntryView& entry);
+    bool commit();
+    void insert(const std::vector<InstrumentRecord>& added);
+    void answered(const std::string& req_id, bool last);
+
+    InstrumentCache(const InstrumentCache&);
+    InstrumentCache& operator=(const InstrumentCache&);
+};
+
+#endif
@@ -0,0 +1,53 @@
+#ifndef LOOPBACK_TRANSPORT_H
+#define LOOPBACK_TRANSPORT_H
+
+#include "transport.h"
+
+// In-process peer of a LoopbackTransport,
+// see sim_acceptor.h
+class LoopbackPeer {
+public:
+    virtual ~LoopbackPeer() {}
+
+    // Client bytes written at now_ns, the
+    // peer reads them in place
+    virtual void on_client_bytes(const char* data, size_t len, uint64_t now_ns) = 0;
+
+    // When the next reply (or the close) is
+    // due, 0 when nothing is pending
+    virtual uint64_t next_due_ns() const = 0;
+
+    // Copies bytes due by now_ns.
+    // > 0 bytes read
+    //   0 peer closed
+    //  -1 nothing due yet
+    virtual int read_due(char* buf, size_t max_len, uint64_t now_ns) = 0;
+};
+
+// Session to a peer in the same process, no
+// kernel and no copy besides the receive buffer.
+// Waiting sleeps until the next reply or the
+// receive timeout, whichever comes first; on the
+// virtual clock (utils.h) that is a jump.
+class LoopbackTransport : public Transport {
+public:
+    LoopbackTransport();
+
+    bool connect(LoopbackPeer& peer);
+
+    void close();
+    bool is_open() const { return peer != 0; }
+    bool send_bytes(const std::string& data);
+    bool set_receive_timeout(int timeout_millis);
+    bool wait_readable(int timeout_millis);
+    int receive_bytes(char* buf, size_t max_len);
+
+private:
+    LoopbackPeer* peer;
+    int receive_timeout_ms;
+
+    LoopbackTransport(const LoopbackTransport&);
+    LoopbackTransport& operator=(const LoopbackTransport&);
+};
+
+#endif
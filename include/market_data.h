@@ -0,0 +1,112 @@
+#ifndef MARKET_DATA_H
+#define MARKET_DATA_H
+
+#include "fix_decimal.h"
+#include "fix_message.h"
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+#include <unordered_map>
+
+// Prices are compared as integers
+// at this scale, finer ones are dropped
+static const int book_price_scale = 8;
+
+struct BookLevel {
+    int64_t price_key;          // price * 10^book_price_scale
+    FixDecimal price;
+    FixDecimal size;
+};
+
+// Price levels of one side kept worst to
+// best, so the best is at the back and the
+// levels that change most shift the least
+struct BookSide {
+    std::vector<BookLevel> levels;
+
+    size_t depth() const { return levels.size(); }
+
+    // 0 = best, 0 when depth is exceeded
+    const BookLevel* level(size_t depth_index) const {
+        return depth_index < levels.size() ? &levels[levels.size() - 1 - depth_index] : 0;
+    }
+};
+
+// Aggregated (price-level) book of one symbol
+struct MarketDataBook {
+    std::string symbol;
+    BookSide bids;
+    BookSide offers;
+    int64_t rpt_seq;            // last RptSeq(83), -1 = none yet
+    bool stale;                 // gap seen, waiting for a 35=W
+    uint64_t updates;
+
+    MarketDataBook() : rpt_seq(-1), stale(false), updates(0) {}
+};
+
+struct MarketDataCounts {
+    uint64_t snapshots;         // 35=W applied
+    uint64_t incrementals;      // 35=X
+    uint64_t entries;           // NoMDEntries applied
+    uint64_t gaps;              // RptSeq jumped, book went stale
+    uint64_t duplicates;        // RptSeq already applied
+    uint64_t skipped;           // entries for a stale book
+
+    MarketDataCounts() : snapshots(0), incrementals(0), entries(0),
+                         gaps(0), duplicates(0), skipped(0) {}
+};
+
+// Builds books from 35=W snapshots and 35=X
+// incremental refreshes, decoding NoMDEntries(268)
+// in one pass straight into the levels. Bids (269=0)
+// and offers (269=1) are kept, other entry types
+// are counted and dropped. RptSeq(83) is checked
+// per symbol: a gap clears the book and marks it
+// stale until the next snapshot, take_stale()
+// lists the symbols to request one for.
+class MarketDataBooks {
+public:
+    MarketDataBooks() : last_book(0) {}
+
+    // False for other MsgTypes
+    // or a malformed group
+    bool on_message(const std::string& msg);
+
+    const MarketDataBook* find(const std::string& symbol) const;
+    const std::vector<MarketDataBook*>& books() const { return book_list; }
+
+    // Books that went stale since the last
+    // call, each reported once per gap
+    bool take_stale(std::vector<std::string>& symbols);
+
+    const MarketDataCounts& counts() const { return totals; }
+
+    ~MarketDataBooks();
+
+private:
+    std::unordered_map<std::string, MarketDataBook*> by_symbol;
+    std::vector<MarketDataBook*> book_list;
+    std::vector<std::string> newly_stale;
+    MarketDataBook* last_book;  // entries mostly repeat the symbol
+    MarketDataCounts totals;
+
+    MarketDataBook* book_for(const char* symbol, size_t len);
+    void mark_stale(MarketDataBook& book);
+
+    MarketDataBooks(const MarketDataBooks&);
+    MarketDataBooks& operator=(const MarketDataBooks&);
+};
+
+// 35=V MarketDataRequest for bids and offers.
+// subscription_type: '0' snapshot, '1' snapshot
+// and updates; depth 0 = full book.
+std::string build_market_data_request(const FixMessage& fix,
+                                      int msg_seq_num,
+                                      const std::string& sending_time,
+                                      const std::string& md_req_id,
+                                      char subscription_type,
+                                      int depth,
+                                      const std::vector<std::string>& symbols);
+
+#endif
@@ -0,0 +1,129 @@
+#ifndef ORDER_MANAGER_H
+#define ORDER_MANAGER_H
+
+#include "fix_decimal.h"
+
+#include <string>
+#include <vector>
+#include <functional>
+#include <cstddef>
+#include <stdint.h>
+
+static const uint32_t order_none = 0xFFFFFFFFu;
+
+// Longer ClOrdID/OrderID values are
+// refused, symbols are truncated
+static const size_t order_id_capacity = 40;
+static const size_t order_symbol_capacity = 24;
+
+// One order request (D, or the G/F that
+// followed it), fixed size so a slab holds
+// them back to back
+struct OrderState {
+    char clord_id[order_id_capacity];
+    char order_id[order_id_capacity];
+    char symbol[order_symbol_capacity];
+    char side;
+    char ord_status;            // 39, 0 = free entry
+    FixDecimal order_qty;
+    FixDecimal price;
+    FixDecimal cum_qty;
+    FixDecimal leaves_qty;
+    FixDecimal avg_px;
+    uint32_t orig;              // request it replaces/cancels (41)
+    uint32_t next;              // later request on this order
+};
+
+struct OrderCounts {
+    uint64_t live;
+    uint64_t filled;
+    uint64_t canceled;
+    uint64_t rejected;
+    uint64_t expired;
+    uint64_t replaced;          // superseded by a G/F
+    uint64_t cancel_rejects;    // 35=9
+    uint64_t unsolicited;       // 35=8 for an unknown ClOrdID
+
+    OrderCounts() : live(0), filled(0), canceled(0), rejected(0), expired(0),
+                    replaced(0), cancel_rejects(0), unsolicited(0) {}
+};
+
+// Live order state keyed by ClOrdID. The index is
+// an open-addressing table of (hash, entry) pairs,
+// the entries sit in fixed-size slabs and are
+// recycled once the order is done (39=2/4/8/C, or
+// superseded by an accepted replace/cancel).
+// OrigClOrdID(41) links a G/F to the request it
+// follows. Feed every outbound D/G/F and inbound
+// 8/9; each update is O(1).
+class OrderManager {
+public:
+    typedef std::function<void(const OrderState& order)> TerminalHandler;
+
+    explicit OrderManager(size_t expected_orders = 1024);
+    ~OrderManager();
+
+    // D/G/F, other types are ignored.
+    // False on a duplicate or oversized ClOrdID.
+    bool on_outbound(const std::string& msg);
+
+    // 8/9, returns True if it updated an order
+    bool on_inbound(const std::string& msg);
+
+    // Called with the final state just
+    // before an entry is recycled
+    void on_terminal(const TerminalHandler& handler) { terminal = handler; }
+
+    const OrderState* find(const char* clord_id, size_t len) const;
+    const OrderState* find(const std::string& clord_id) const {
+        return find(clord_id.data(), clord_id.size());
+    }
+
+    // Request this one replaced/canceled,
+    // and the one that followed it
+    const OrderState* previous(const OrderState& order) const { return entry_at(order.orig); }
+    const OrderState* following(const OrderState& order) const { return entry_at(order.next); }
+
+    // Every live entry, slab order
+    template <typename Visitor>
+    void for_each(Visitor visit) const {
+        for (size_t i = 0; i < slabs.size(); ++i) {
+            for (size_t j = 0; j < slab_size; ++j) {
+                if (slabs[i][j].ord_status != 0) visit(slabs[i][j]);
+            }
+        }
+    }
+
+    // Copy of every live entry, for
+    // end-of-day reconciliation
+    void snapshot(std::vector<OrderState>& out) const;
+
+    const OrderCounts& counts() const { return totals; }
+
+private:
+    struct Slot {
+        uint32_t hash;
+        uint32_t index;         // order_none = empty
+    };
+
+    static const size_t slab_size = 4096;
+
+    std::vector<Slot> slots;    // power of two
+    size_t used_slots;
+    std::vector<OrderState*> slabs;
+    std::vector<uint32_t> free_entries;
+    OrderCounts totals;
+    TerminalHandler terminal;
+
+    OrderState* entry_at(uint32_t index) const;
+    uint32_t lookup(const char* clord_id, size_t len, uint64_t hash) const;
+    uint32_t insert(const char* clord_id, size_t len);
+    void erase(uint32_t index);
+    void retire(uint32_t index);
+    void grow();
+
+    OrderManager(const OrderManager&);
+    OrderManager& operator=(const OrderManager&);
+};
+
+#endif
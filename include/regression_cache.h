@@ -0,0 +1,46 @@
+#ifndef REGRESSION_CACHE_H
+#define REGRESSION_CACHE_H
+
+#include "config_parser.h"
+
+#include <string>
+#include <stdint.h>
+
+// Regression result cache
+// One file per scenario under results/regression_cache,
+// named by a hash of the BGN..END block and of the venue
+// settings of the session (begin string, target, host,
+// port). Holds outcome, time and report of the last run
+// so an unchanged scenario can be reported without
+// running it. SenderCompID is left out, so the sessions
+// of a sharded run share results.
+
+enum RegressionRerun {
+    regression_rerun_all = 0,       // run everything, refresh the cache
+    regression_rerun_failed = 1,    // skip scenarios with a cached pass
+    regression_rerun_changed = 2    // skip scenarios with any cached result
+};
+
+struct RegressionCacheEntry {
+    bool passed;
+    uint64_t elapsed_ms;
+    std::string report;     // scenario section without its BGN line
+
+    RegressionCacheEntry() : passed(false), elapsed_ms(0) {}
+};
+
+// FNV-1a, chained through seed
+const uint64_t regression_hash_seed = 14695981039346656037ULL;
+uint64_t regression_hash(uint64_t seed, const void* data, size_t len);
+uint64_t regression_hash(uint64_t seed, const std::string& text);
+
+uint64_t regression_config_hash(const SessionConfig& config);
+
+// "all", "failed" or "changed"
+bool parse_regression_rerun(const std::string& text, RegressionRerun& mode);
+
+// False when there is no (readable) result for key
+bool load_regression_result(uint64_t key, RegressionCacheEntry& entry);
+bool save_regression_result(uint64_t key, const RegressionCacheEntry& entry);
+
+#endif
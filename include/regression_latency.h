@@ -0,0 +1,68 @@
+#ifndef REGRESSION_LATENCY_H
+#define REGRESSION_LATENCY_H
+
+#include <string>
+#include <vector>
+#include <map>
+#include <stdint.h>
+
+// SND -> TST round trips of a regression run
+// Each matched TST step records when the order it
+// correlates to was sent and when its response was
+// read (CLOCK_REALTIME nanos). Runs are written as a
+// CSV sidecar of the result log, which later runs
+// take as --baseline.
+
+struct LatencySample {
+    std::string scenario;
+    int step;
+    uint64_t sent_ns;
+    uint64_t received_ns;
+
+    uint64_t latency_us() const {
+        return (received_ns > sent_ns) ? (received_ns - sent_ns) / 1000 : 0;
+    }
+};
+
+struct LatencyStats {
+    size_t count;
+    uint64_t min_us;
+    uint64_t p50_us;
+    uint64_t p99_us;
+    uint64_t max_us;
+
+    LatencyStats() : count(0), min_us(0), p50_us(0), p99_us(0), max_us(0) {}
+};
+
+// Nearest rank percentiles
+LatencyStats latency_stats(std::vector<uint64_t> samples_us);
+
+// "n=.. min=..us p50=..us p99=..us max=..us"
+std::string format_latency_stats(const LatencyStats& stats);
+
+// Power of two buckets, one line per
+// non-empty bucket with a bar
+std::string format_latency_histogram(const std::vector<uint64_t>& samples_us);
+
+// scenario,step,sent_ns,received_ns,latency_us
+bool save_latency_csv(const std::string& path, const std::vector<LatencySample>& samples);
+
+// Scenario -> latencies in us. Header lines are
+// skipped, so shard CSVs can be concatenated.
+bool load_latency_csv(const std::string& path,
+                      std::map<std::string, std::vector<uint64_t> >& by_scenario);
+
+struct LatencyShift {
+    std::string scenario;
+    LatencyStats baseline;
+    LatencyStats current;
+    bool slower;
+};
+
+// Scenarios in both runs whose p50 or p99 moved by
+// more than threshold_pct percent, sorted by name
+std::vector<LatencyShift> compare_latency(const std::map<std::string, std::vector<uint64_t> >& baseline,
+                                          const std::map<std::string, std::vector<uint64_t> >& current,
+                                          int threshold_pct);
+
+#endif
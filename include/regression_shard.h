@@ -0,0 +1,18 @@
+#ifndef REGRESSION_SHARD_H
+#define REGRESSION_SHARD_H
+
+#include "application.h"
+
+#include <string>
+#include <vector>
+
+// Sharded regression: -u f01,f02,f03 -m test
+// Scenario files are spread over the sessions,
+// balanced by their last run time, and each shard
+// runs in its own process on its own connection
+// and token files. Shard summaries are merged
+// into one report.
+int run_sharded_regression(const AppArgs& args,
+                           const std::vector<std::string>& sessions);
+
+#endif
@@ -0,0 +1,178 @@
+#ifndef SBE_CODEC_H
+#define SBE_CODEC_H
+
+#include "sbe_schema.h"
+#include "fix_decimal.h"
+#include "fix_message.h"
+#include "transport.h"
+
+#include <string>
+#include <deque>
+#include <utility>
+#include <cstddef>
+#include <stdint.h>
+
+// Simple Open Framing Header: message length
+// (big-endian, header included) and encoding
+// type, 0x5BE0 = SBE 1.0 little-endian
+static const size_t sofh_size = 6;
+static const uint16_t sofh_sbe_le = 0x5BE0;
+static const size_t sbe_header_size = 8;
+
+// Frames above this are a framing error,
+// same cap as FixParser's BodyLength
+static const size_t sofh_max_frame = 1000000;
+
+// Byte at a time so the wire stays little-endian
+// on any host; compilers fold it into one move
+inline void sbe_store_le(char* out, uint64_t value, size_t size) {
+    for (size_t i = 0; i < size; ++i) {
+        out[i] = static_cast<char>(value >> (8 * i));
+    }
+}
+
+inline uint64_t sbe_load_le(const char* in, size_t size) {
+    uint64_t value = 0;
+    for (size_t i = 0; i < size; ++i) {
+        value |= static_cast<uint64_t>(static_cast<unsigned char>(in[i])) << (8 * i);
+    }
+    return value;
+}
+
+inline int64_t sbe_load_le_signed(const char* in, size_t size) {
+    const uint64_t value = sbe_load_le(in, size);
+    const unsigned shift = static_cast<unsigned>(64 - 8 * size);
+    return static_cast<int64_t>(value << shift) >> shift;
+}
+
+// SOFH fields are big-endian
+inline void sbe_store_be(char* out, uint64_t value, size_t size) {
+    for (size_t i = 0; i < size; ++i) {
+        out[i] = static_cast<char>(value >> (8 * (size - 1 - i)));
+    }
+}
+
+// SBE null values: signed minimum,
+// unsigned maximum
+inline int64_t sbe_int_null(size_t size) {
+    return (size >= 8) ? INT64_MIN : -(static_cast<int64_t>(1) << (8 * size - 1));
+}
+
+inline uint64_t sbe_uint_null(size_t size) {
+    return (size >= 8) ? UINT64_MAX : ((static_cast<uint64_t>(1) << (8 * size)) - 1);
+}
+
+inline bool sbe_int_fits(int64_t value, size_t size) {
+    if (size >= 8) return value != INT64_MIN;
+    const int64_t limit = static_cast<int64_t>(1) << (8 * size - 1);
+    return value > -limit && value < limit;     // minimum is null
+}
+
+// value as a mantissa at a fixed exponent. False
+// when finer than the exponent or out of int64.
+bool sbe_decimal_rescale(const FixDecimal& value, int exponent, int64_t& mantissa);
+
+// mantissa * 10^exponent, normalized.
+// False when it overflows FixDecimal.
+bool sbe_decimal_value(int64_t mantissa, int exponent, FixDecimal& value);
+
+// Writes one framed message into a caller buffer
+// at the fixed offsets of its layout, nothing is
+// allocated. wrap() writes SOFH and header and
+// sets every field to null/zero.
+class SbeEncoder {
+public:
+    SbeEncoder() : buffer(0), block(0), message(0) {}
+
+    // False if the frame does not fit capacity
+    bool wrap(char* out, size_t capacity, const SbeSchema& schema, const SbeMessageLayout& layout);
+
+    // False if the tag is not in the layout,
+    // the kind does not match or the value
+    // does not fit the field
+    bool put_int(int tag, int64_t value);
+    bool put_char(int tag, char value);
+    bool put_string(int tag, const char* data, size_t size);
+    bool put_decimal(int tag, const FixDecimal& value);
+
+    // Value as tag=value text, converted by
+    // the field's kind
+    bool put_text(int tag, const char* data, size_t size);
+
+    // SOFH + header + block
+    size_t size() const;
+
+private:
+    char* buffer;
+    char* block;
+    const SbeMessageLayout* message;
+};
+
+// Reads fields of one SBE message (header
+// onwards, SOFH already stripped) in place
+class SbeDecoder {
+public:
+    SbeDecoder() : block(0), message(0) {}
+
+    // False on a short buffer, another schema or
+    // an unknown template id. A longer blockLength
+    // from a newer version is skipped over.
+    bool wrap(const char* data, size_t size, const SbeSchema& schema);
+
+    const SbeMessageLayout* layout() const { return message; }
+
+    // False if absent from the layout or null
+    bool get_int(int tag, int64_t& value) const;
+    bool get_char(int tag, char& value) const;
+    bool get_string(int tag, const char*& data, size_t& size) const;
+    bool get_decimal(int tag, FixDecimal& value) const;
+
+    // "35=<msg_type>" then every non-null field,
+    // tag=value<SOH>, in layout order
+    void append_tag_value(std::string& out) const;
+
+private:
+    const char* block;
+    const SbeMessageLayout* message;
+
+    bool is_null(const SbeField& field) const;
+};
+
+// SOFH counterpart of FixParser for the receive
+// path: append what the transport read, take out
+// whole frames. A bad header stops framing, the
+// stream cannot be resynchronised.
+class SofhParser {
+public:
+    SofhParser() : stream_offset(0), failed(false) {}
+
+    void append_bytes(const char* data, size_t size);
+    void append_bytes(const char* data, size_t size, const SocketTimestamp& stamp);
+
+    // One SBE message without its SOFH
+    bool read_next_frame(std::string& frame);
+    bool read_next_frame(std::string& frame, SocketTimestamp& stamp);
+
+    bool framing_error() const { return failed; }
+    void reset();
+
+private:
+    std::string buffer;
+    size_t stream_offset;
+    std::deque<std::pair<size_t, SocketTimestamp> > stamps;
+    bool failed;
+
+    void discard(size_t count);
+};
+
+// Scenario fields (fix_template.h) to one framed
+// SBE message, the layout picked by 35. Header
+// and trailer tags are dropped, FIXP carries the
+// sequence; other tags missing from the layout
+// fail the message.
+bool sbe_encode_fields(const SbeSchema& schema,
+                       const FixMessage::FieldList& fields,
+                       char* out, size_t capacity, size_t& size,
+                       std::string& error);
+
+#endif
@@ -0,0 +1,798 @@
+// Generated by sbe_codegen from config/sbe_orders.xml, do not edit.
+// SBE flyweights over caller buffers, see sbe_codec.h.
+
+#ifndef SBE_ORDERS_MESSAGES_H
+#define SBE_ORDERS_MESSAGES_H
+
+#include "sbe_codec.h"
+#include "fix_typed.h"
+
+#include <cstring>
+#include <cstddef>
+#include <stdint.h>
+
+namespace sbe_orders {
+
+static const uint16_t schema_id = 101;
+static const uint16_t schema_version = 1;
+
+// 35=D, template 1
+class NewOrderSingleEncoder {
+public:
+    static const uint16_t template_id = 1;
+    static const uint16_t block_length = 58;
+    static const size_t frame_size = 72;
+
+    NewOrderSingleEncoder() : block(0) {}
+
+    // SOFH, header and a zero block with
+    // optional fields null. False if the
+    // frame does not fit capacity.
+    bool wrap(char* out, size_t capacity) {
+        if (!out || capacity < frame_size) {
+            block = 0;
+            return false;
+        }
+        sbe_store_be(out, frame_size, 4);
+        sbe_store_be(out + 4, sofh_sbe_le, 2);
+        sbe_store_le(out + 6, block_length, 2);
+        sbe_store_le(out + 8, template_id, 2);
+        sbe_store_le(out + 10, schema_id, 2);
+        sbe_store_le(out + 12, schema_version, 2);
+
+        block = out + 14;
+        std::memset(block, 0, block_length);
+        sbe_store_le(block + 42, static_cast<uint64_t>(sbe_int_null(8)), 8);
+        return true;
+    }
+
+    size_t size() const { return block ? frame_size : 0; }
+
+    // 11 ClOrdID, char[20]
+    bool set_cl_ord_id(const FixText& value) {
+        if (value.size > 20) return false;
+        std::memcpy(block + 0, value.data, value.size);
+        std::memset(block + 0 + value.size, 0, 20 - value.size);
+        return true;
+    }
+    // 55 Symbol, char[12]
+    bool set_symbol(const FixText& value) {
+        if (value.size > 12) return false;
+        std::memcpy(block + 20, value.data, value.size);
+        std::memset(block + 20 + value.size, 0, 12 - value.size);
+        return true;
+    }
+    // 54 Side
+    void set_side(char value) { block[32] = value; }
+    // 40 OrdType
+    void set_ord_type(char value) { block[33] = value; }
+    // 38 OrderQty, exponent -4
+    bool set_order_qty(const FixDecimal& value) {
+        int64_t mantissa = 0;
+        if (!sbe_decimal_rescale(value, -4, mantissa) ||
+            !sbe_int_fits(mantissa, 8)) {
+            return false;
+        }
+        sbe_store_le(block + 34, static_cast<uint64_t>(mantissa), 8);
+        return true;
+    }
+    // 44 Price, exponent -9, optional
+    bool set_price(const FixDecimal& value) {
+        int64_t mantissa = 0;
+        if (!sbe_decimal_rescale(value, -9, mantissa) ||
+            !sbe_int_fits(mantissa, 8)) {
+            return false;
+        }
+        sbe_store_le(block + 42, static_cast<uint64_t>(mantissa), 8);
+        return true;
+    }
+    // 60 TransactTime, nanos since epoch
+    void set_transact_time(uint64_t nanos) { sbe_store_le(block + 50, nanos, 8); }
+
+private:
+    char* block;
+};
+
+class NewOrderSingleDecoder {
+public:
+    static const uint16_t template_id = 1;
+    static const uint16_t block_length = 58;
+
+    NewOrderSingleDecoder() : block(0) {}
+
+    // Header onwards, SOFH stripped. False on a
+    // short buffer, another schema or another
+    // template; a longer blockLength from a
+    // newer version is skipped over.
+    bool wrap(const char* data, size_t size) {
+        block = 0;
+        if (!data || size < 8) return false;
+
+        const size_t length = static_cast<size_t>(sbe_load_le(data, 2));
+        if (sbe_load_le(data + 2, 2) != template_id || sbe_load_le(data + 4, 2) != schema_id ||
+            length < block_length || size < 8 + length) {
+            return false;
+        }
+        block = data + 8;
+        return true;
+    }
+
+    // 11 ClOrdID, char[20]
+    FixText cl_ord_id() const {
+        const void* nul = std::memchr(block + 0, '\0', 20);
+        return FixText(block + 0, nul ? static_cast<size_t>(static_cast<const char*>(nul) - (block + 0)) : 20);
+    }
+    // 55 Symbol, char[12]
+    FixText symbol() const {
+        const void* nul = std::memchr(block + 20, '\0', 12);
+        return FixText(block + 20, nul ? static_cast<size_t>(static_cast<const char*>(nul) - (block + 20)) : 12);
+    }
+    // 54 Side
+    char side() const { return block[32]; }
+    // 40 OrdType
+    char ord_type() const { return block[33]; }
+    // 38 OrderQty, exponent -4
+    // False when out of FixDecimal
+    bool order_qty(FixDecimal& value) const {
+        return sbe_decimal_value(sbe_load_le_signed(block + 34, 8), -4, value);
+    }
+    // 44 Price, exponent -9, optional
+    bool has_price() const { return sbe_load_le_signed(block + 42, 8) != sbe_int_null(8); }
+    // False when null or out of FixDecimal
+    bool price(FixDecimal& value) const {
+        return has_price() &&
+               sbe_decimal_value(sbe_load_le_signed(block + 42, 8), -9, value);
+    }
+    // 60 TransactTime, nanos since epoch
+    uint64_t transact_time() const { return sbe_load_le(block + 50, 8); }
+
+private:
+    const char* block;
+};
+
+// 35=F, template 2
+class OrderCancelRequestEncoder {
+public:
+    static const uint16_t template_id = 2;
+    static const uint16_t block_length = 61;
+    static const size_t frame_size = 75;
+
+    OrderCancelRequestEncoder() : block(0) {}
+
+    // SOFH, header and a zero block with
+    // optional fields null. False if the
+    // frame does not fit capacity.
+    bool wrap(char* out, size_t capacity) {
+        if (!out || capacity < frame_size) {
+            block = 0;
+            return false;
+        }
+        sbe_store_be(out, frame_size, 4);
+        sbe_store_be(out + 4, sofh_sbe_le, 2);
+        sbe_store_le(out + 6, block_length, 2);
+        sbe_store_le(out + 8, template_id, 2);
+        sbe_store_le(out + 10, schema_id, 2);
+        sbe_store_le(out + 12, schema_version, 2);
+
+        block = out + 14;
+        std::memset(block, 0, block_length);
+        return true;
+    }
+
+    size_t size() const { return block ? frame_size : 0; }
+
+    // 11 ClOrdID, char[20]
+    bool set_cl_ord_id(const FixText& value) {
+        if (value.size > 20) return false;
+        std::memcpy(block + 0, value.data, value.size);
+        std::memset(block + 0 + value.size, 0, 20 - value.size);
+        return true;
+    }
+    // 41 OrigClOrdID, char[20]
+    bool set_orig_cl_ord_id(const FixText& value) {
+        if (value.size > 20) return false;
+        std::memcpy(block + 20, value.data, value.size);
+        std::memset(block + 20 + value.size, 0, 20 - value.size);
+        return true;
+    }
+    // 55 Symbol, char[12]
+    bool set_symbol(const FixText& value) {
+        if (value.size > 12) return false;
+        std::memcpy(block + 40, value.data, value.size);
+        std::memset(block + 40 + value.size, 0, 12 - value.size);
+        return true;
+    }
+    // 54 Side
+    void set_side(char value) { block[52] = value; }
+    // 60 TransactTime, nanos since epoch
+    void set_transact_time(uint64_t nanos) { sbe_store_le(block + 53, nanos, 8); }
+
+private:
+    char* block;
+};
+
+class OrderCancelRequestDecoder {
+public:
+    static const uint16_t template_id = 2;
+    static const uint16_t block_length = 61;
+
+    OrderCancelRequestDecoder() : block(0) {}
+
+    // Header onwards, SOFH stripped. False on a
+    // short buffer, another schema or another
+    // template; a longer blockLength from a
+    // newer version is skipped over.
+    bool wrap(const char* data, size_t size) {
+        block = 0;
+        if (!data || size < 8) return false;
+
+        const size_t length = static_cast<size_t>(sbe_load_le(data, 2));
+        if (sbe_load_le(data + 2, 2) != template_id || sbe_load_le(data + 4, 2) != schema_id ||
+            length < block_length || size < 8 + length) {
+            return false;
+        }
+        block = data + 8;
+        return true;
+    }
+
+    // 11 ClOrdID, char[20]
+    FixText cl_ord_id() const {
+        const void* nul = std::memchr(block + 0, '\0', 20);
+        return FixText(block + 0, nul ? static_cast<size_t>(static_cast<const char*>(nul) - (block + 0)) : 20);
+    }
+    // 41 OrigClOrdID, char[20]
+    FixText orig_cl_ord_id() const {
+        const void* nul = std::memchr(block + 20, '\0', 20);
+        return FixText(block + 20, nul ? static_cast<size_t>(static_cast<const char*>(nul) - (block + 20)) : 20);
+    }
+    // 55 Symbol, char[12]
+    FixText symbol() const {
+        const void* nul = std::memchr(block + 40, '\0', 12);
+        return FixText(block + 40, nul ? static_cast<size_t>(static_cast<const char*>(nul) - (block + 40)) : 12);
+    }
+    // 54 Side
+    char side() const { return block[52]; }
+    // 60 TransactTime, nanos since epoch
+    uint64_t transact_time() const { return sbe_load_le(block + 53, 8); }
+
+private:
+    const char* block;
+};
+
+// 35=8, template 3
+class ExecutionReportEncoder {
+public:
+    static const uint16_t template_id = 3;
+    static const uint16_t block_length = 135;
+    static const size_t frame_size = 149;
+
+    ExecutionReportEncoder() : block(0) {}
+
+    // SOFH, header and a zero block with
+    // optional fields null. False if the
+    // frame does not fit capacity.
+    bool wrap(char* out, size_t capacity) {
+        if (!out || capacity < frame_size) {
+            block = 0;
+            return false;
+        }
+        sbe_store_be(out, frame_size, 4);
+        sbe_store_be(out + 4, sofh_sbe_le, 2);
+        sbe_store_le(out + 6, block_length, 2);
+        sbe_store_le(out + 8, template_id, 2);
+        sbe_store_le(out + 10, schema_id, 2);
+        sbe_store_le(out + 12, schema_version, 2);
+
+        block = out + 14;
+        std::memset(block, 0, block_length);
+        sbe_store_le(block + 103, static_cast<uint64_t>(sbe_int_null(8)), 8);
+        sbe_store_le(block + 127, static_cast<uint64_t>(sbe_int_null(8)), 8);
+        return true;
+    }
+
+    size_t size() const { return block ? frame_size : 0; }
+
+    // 37 OrderID, char[20]
+    bool set_order_id(const FixText& value) {
+        if (value.size > 20) return false;
+        std::memcpy(block + 0, value.data, value.size);
+        std::memset(block + 0 + value.size, 0, 20 - value.size);
+        return true;
+    }
+    // 11 ClOrdID, char[20]
+    bool set_cl_ord_id(const FixText& value) {
+        if (value.size > 20) return false;
+        std::memcpy(block + 20, value.data, value.size);
+        std::memset(block + 20 + value.size, 0, 20 - value.size);
+        return true;
+    }
+    // 41 OrigClOrdID, char[20]
+    bool set_orig_cl_ord_id(const FixText& value) {
+        if (value.size > 20) return false;
+        std::memcpy(block + 40, value.data, value.size);
+        std::memset(block + 40 + value.size, 0, 20 - value.size);
+        return true;
+    }
+    // 17 ExecID, char[20]
+    bool set_exec_id(const FixText& value) {
+        if (value.size > 20) return false;
+        std::memcpy(block + 60, value.data, value.size);
+        std::memset(block + 60 + value.size, 0, 20 - value.size);
+        return true;
+    }
+    // 150 ExecType
+    void set_exec_type(char value) { block[80] = value; }
+    // 39 OrdStatus
+    void set_ord_status(char value) { block[81] = value; }
+    // 55 Symbol, char[12]
+    bool set_symbol(const FixText& value) {
+        if (value.size > 12) return false;
+        std::memcpy(block + 82, value.data, value.size);
+        std::memset(block + 82 + value.size, 0, 12 - value.size);
+        return true;
+    }
+    // 54 Side
+    void set_side(char value) { block[94] = value; }
+    // 38 OrderQty, exponent -4
+    bool set_order_qty(const FixDecimal& value) {
+        int64_t mantissa = 0;
+        if (!sbe_decimal_rescale(value, -4, mantissa) ||
+            !sbe_int_fits(mantissa, 8)) {
+            return false;
+        }
+        sbe_store_le(block + 95, static_cast<uint64_t>(mantissa), 8);
+        return true;
+    }
+    // 44 Price, exponent -9, optional
+    bool set_price(const FixDecimal& value) {
+        int64_t mantissa = 0;
+        if (!sbe_decimal_rescale(value, -9, mantissa) ||
+            !sbe_int_fits(mantissa, 8)) {
+            return false;
+        }
+        sbe_store_le(block + 103, static_cast<uint64_t>(mantissa), 8);
+        return true;
+    }
+    // 14 CumQty, exponent -4
+    bool set_cum_qty(const FixDecimal& value) {
+        int64_t mantissa = 0;
+        if (!sbe_decimal_rescale(value, -4, mantissa) ||
+            !sbe_int_fits(mantissa, 8)) {
+            return false;
+        }
+        sbe_store_le(block + 111, static_cast<uint64_t>(mantissa), 8);
+        return true;
+    }
+    // 151 LeavesQty, exponent -4
+    bool set_leaves_qty(const FixDecimal& value) {
+        int64_t mantissa = 0;
+        if (!sbe_decimal_rescale(value, -4, mantissa) ||
+            !sbe_int_fits(mantissa, 8)) {
+            return false;
+        }
+        sbe_store_le(block + 119, static_cast<uint64_t>(mantissa), 8);
+        return true;
+    }
+    // 6 AvgPx, exponent -9, optional
+    bool set_avg_px(const FixDecimal& value) {
+        int64_t mantissa = 0;
+        if (!sbe_decimal_rescale(value, -9, mantissa) ||
+            !sbe_int_fits(mantissa, 8)) {
+            return false;
+        }
+        sbe_store_le(block + 127, static_cast<uint64_t>(mantissa), 8);
+        return true;
+    }
+
+private:
+    char* block;
+};
+
+class ExecutionReportDecoder {
+public:
+    static const uint16_t template_id = 3;
+    static const uint16_t block_length = 135;
+
+    ExecutionReportDecoder() : block(0) {}
+
+    // Header onwards, SOFH stripped. False on a
+    // short buffer, another schema or another
+    // template; a longer blockLength from a
+    // newer version is skipped over.
+    bool wrap(const char* data, size_t size) {
+        block = 0;
+        if (!data || size < 8) return false;
+
+        const size_t length = static_cast<size_t>(sbe_load_le(data, 2));
+        if (sbe_load_le(data + 2, 2) != template_id || sbe_load_le(data + 4, 2) != schema_id ||
+            length < block_length || size < 8 + length) {
+            return false;
+        }
+        block = data + 8;
+        return true;
+    }
+
+    // 37 OrderID, char[20]
+    FixText order_id() const {
+        const void* nul = std::memchr(block + 0, '\0', 20);
+        return FixText(block + 0, nul ? static_cast<size_t>(static_cast<const char*>(nul) - (block + 0)) : 20);
+    }
+    // 11 ClOrdID, char[20]
+    FixText cl_ord_id() const {
+        const void* nul = std::memchr(block + 20, '\0', 20);
+        return FixText(block + 20, nul ? static_cast<size_t>(static_cast<const char*>(nul) - (block + 20)) : 20);
+    }
+    // 41 OrigClOrdID, char[20]
+    FixText orig_cl_ord_id() const {
+        const void* nul = std::memchr(block + 40, '\0', 20);
+        return FixText(block + 40, nul ? static_cast<size_t>(static_cast<const char*>(nul) - (block + 40)) : 20);
+    }
+    // 17 ExecID, char[20]
+    FixText exec_id() const {
+        const void* nul = std::memchr(block + 60, '\0', 20);
+        return FixText(block + 60, nul ? static_cast<size_t>(static_cast<const char*>(nul) - (block + 60)) : 20);
+    }
+    // 150 ExecType
+    char exec_type() const { return block[80]; }
+    // 39 OrdStatus
+    char ord_status() const { return block[81]; }
+    // 55 Symbol, char[12]
+    FixText symbol() const {
+        const void* nul = std::memchr(block + 82, '\0', 12);
+        return FixText(block + 82, nul ? static_cast<size_t>(static_cast<const char*>(nul) - (block + 82)) : 12);
+    }
+    // 54 Side
+    char side() const { return block[94]; }
+    // 38 OrderQty, exponent -4
+    // False when out of FixDecimal
+    bool order_qty(FixDecimal& value) const {
+        return sbe_decimal_value(sbe_load_le_signed(block + 95, 8), -4, value);
+    }
+    // 44 Price, exponent -9, optional
+    bool has_price() const { return sbe_load_le_signed(block + 103, 8) != sbe_int_null(8); }
+    // False when null or out of FixDecimal
+    bool price(FixDecimal& value) const {
+        return has_price() &&
+               sbe_decimal_value(sbe_load_le_signed(block + 103, 8), -9, value);
+    }
+    // 14 CumQty, exponent -4
+    // False when out of FixDecimal
+    bool cum_qty(FixDecimal& value) const {
+        return sbe_decimal_value(sbe_load_le_signed(block + 111, 8), -4, value);
+    }
+    // 151 LeavesQty, exponent -4
+    // False when out of FixDecimal
+    bool leaves_qty(FixDecimal& value) const {
+        return sbe_decimal_value(sbe_load_le_signed(block + 119, 8), -4, value);
+    }
+    // 6 AvgPx, exponent -9, optional
+    bool has_avg_px() const { return sbe_load_le_signed(block + 127, 8) != sbe_int_null(8); }
+    // False when null or out of FixDecimal
+    bool avg_px(FixDecimal& value) const {
+        return has_avg_px() &&
+               sbe_decimal_value(sbe_load_le_signed(block + 127, 8), -9, value);
+    }
+
+private:
+    const char* block;
+};
+
+// 35=A, template 4
+class LogonEncoder {
+public:
+    static const uint16_t template_id = 4;
+    static const uint16_t block_length = 4;
+    static const size_t frame_size = 18;
+
+    LogonEncoder() : block(0) {}
+
+    // SOFH, header and a zero block with
+    // optional fields null. False if the
+    // frame does not fit capacity.
+    bool wrap(char* out, size_t capacity) {
+        if (!out || capacity < frame_size) {
+            block = 0;
+            return false;
+        }
+        sbe_store_be(out, frame_size, 4);
+        sbe_store_be(out + 4, sofh_sbe_le, 2);
+        sbe_store_le(out + 6, block_length, 2);
+        sbe_store_le(out + 8, template_id, 2);
+        sbe_store_le(out + 10, schema_id, 2);
+        sbe_store_le(out + 12, schema_version, 2);
+
+        block = out + 14;
+        std::memset(block, 0, block_length);
+        return true;
+    }
+
+    size_t size() const { return block ? frame_size : 0; }
+
+    // 98 EncryptMethod
+    bool set_encrypt_method(uint64_t value) {
+        if (value >= sbe_uint_null(1)) return false;
+        sbe_store_le(block + 0, value, 1);
+        return true;
+    }
+    // 108 HeartBtInt
+    bool set_heart_bt_int(uint64_t value) {
+        if (value >= sbe_uint_null(2)) return false;
+        sbe_store_le(block + 1, value, 2);
+        return true;
+    }
+    // 141 ResetSeqNumFlag
+    void set_reset_seq_num_flag(char value) { block[3] = value; }
+
+private:
+    char* block;
+};
+
+class LogonDecoder {
+public:
+    static const uint16_t template_id = 4;
+    static const uint16_t block_length = 4;
+
+    LogonDecoder() : block(0) {}
+
+    // Header onwards, SOFH stripped. False on a
+    // short buffer, another schema or another
+    // template; a longer blockLength from a
+    // newer version is skipped over.
+    bool wrap(const char* data, size_t size) {
+        block = 0;
+        if (!data || size < 8) return false;
+
+        const size_t length = static_cast<size_t>(sbe_load_le(data, 2));
+        if (sbe_load_le(data + 2, 2) != template_id || sbe_load_le(data + 4, 2) != schema_id ||
+            length < block_length || size < 8 + length) {
+            return false;
+        }
+        block = data + 8;
+        return true;
+    }
+
+    // 98 EncryptMethod
+    uint64_t encrypt_method() const { return sbe_load_le(block + 0, 1); }
+    // 108 HeartBtInt
+    uint64_t heart_bt_int() const { return sbe_load_le(block + 1, 2); }
+    // 141 ResetSeqNumFlag
+    char reset_seq_num_flag() const { return block[3]; }
+
+private:
+    const char* block;
+};
+
+// 35=0, template 5
+class HeartbeatEncoder {
+public:
+    static const uint16_t template_id = 5;
+    static const uint16_t block_length = 20;
+    static const size_t frame_size = 34;
+
+    HeartbeatEncoder() : block(0) {}
+
+    // SOFH, header and a zero block with
+    // optional fields null. False if the
+    // frame does not fit capacity.
+    bool wrap(char* out, size_t capacity) {
+        if (!out || capacity < frame_size) {
+            block = 0;
+            return false;
+        }
+        sbe_store_be(out, frame_size, 4);
+        sbe_store_be(out + 4, sofh_sbe_le, 2);
+        sbe_store_le(out + 6, block_length, 2);
+        sbe_store_le(out + 8, template_id, 2);
+        sbe_store_le(out + 10, schema_id, 2);
+        sbe_store_le(out + 12, schema_version, 2);
+
+        block = out + 14;
+        std::memset(block, 0, block_length);
+        return true;
+    }
+
+    size_t size() const { return block ? frame_size : 0; }
+
+    // 112 TestReqID, char[20]
+    bool set_test_req_id(const FixText& value) {
+        if (value.size > 20) return false;
+        std::memcpy(block + 0, value.data, value.size);
+        std::memset(block + 0 + value.size, 0, 20 - value.size);
+        return true;
+    }
+
+private:
+    char* block;
+};
+
+class HeartbeatDecoder {
+public:
+    static const uint16_t template_id = 5;
+    static const uint16_t block_length = 20;
+
+    HeartbeatDecoder() : block(0) {}
+
+    // Header onwards, SOFH stripped. False on a
+    // short buffer, another schema or another
+    // template; a longer blockLength from a
+    // newer version is skipped over.
+    bool wrap(const char* data, size_t size) {
+        block = 0;
+        if (!data || size < 8) return false;
+
+        const size_t length = static_cast<size_t>(sbe_load_le(data, 2));
+        if (sbe_load_le(data + 2, 2) != template_id || sbe_load_le(data + 4, 2) != schema_id ||
+            length < block_length || size < 8 + length) {
+            return false;
+        }
+        block = data + 8;
+        return true;
+    }
+
+    // 112 TestReqID, char[20]
+    FixText test_req_id() const {
+        const void* nul = std::memchr(block + 0, '\0', 20);
+        return FixText(block + 0, nul ? static_cast<size_t>(static_cast<const char*>(nul) - (block + 0)) : 20);
+    }
+
+private:
+    const char* block;
+};
+
+// 35=1, template 6
+class TestRequestEncoder {
+public:
+    static const uint16_t template_id = 6;
+    static const uint16_t block_length = 20;
+    static const size_t frame_size = 34;
+
+    TestRequestEncoder() : block(0) {}
+
+    // SOFH, header and a zero block with
+    // optional fields null. False if the
+    // frame does not fit capacity.
+    bool wrap(char* out, size_t capacity) {
+        if (!out || capacity < frame_size) {
+            block = 0;
+            return false;
+        }
+        sbe_store_be(out, frame_size, 4);
+        sbe_store_be(out + 4, sofh_sbe_le, 2);
+        sbe_store_le(out + 6, block_length, 2);
+        sbe_store_le(out + 8, template_id, 2);
+        sbe_store_le(out + 10, schema_id, 2);
+        sbe_store_le(out + 12, schema_version, 2);
+
+        block = out + 14;
+        std::memset(block, 0, block_length);
+        return true;
+    }
+
+    size_t size() const { return block ? frame_size : 0; }
+
+    // 112 TestReqID, char[20]
+    bool set_test_req_id(const FixText& value) {
+        if (value.size > 20) return false;
+        std::memcpy(block + 0, value.data, value.size);
+        std::memset(block + 0 + value.size, 0, 20 - value.size);
+        return true;
+    }
+
+private:
+    char* block;
+};
+
+class TestRequestDecoder {
+public:
+    static const uint16_t template_id = 6;
+    static const uint16_t block_length = 20;
+
+    TestRequestDecoder() : block(0) {}
+
+    // Header onwards, SOFH stripped. False on a
+    // short buffer, another schema or another
+    // template; a longer blockLength from a
+    // newer version is skipped over.
+    bool wrap(const char* data, size_t size) {
+        block = 0;
+        if (!data || size < 8) return false;
+
+        const size_t length = static_cast<size_t>(sbe_load_le(data, 2));
+        if (sbe_load_le(data + 2, 2) != template_id || sbe_load_le(data + 4, 2) != schema_id ||
+            length < block_length || size < 8 + length) {
+            return false;
+        }
+        block = data + 8;
+        return true;
+    }
+
+    // 112 TestReqID, char[20]
+    FixText test_req_id() const {
+        const void* nul = std::memchr(block + 0, '\0', 20);
+        return FixText(block + 0, nul ? static_cast<size_t>(static_cast<const char*>(nul) - (block + 0)) : 20);
+    }
+
+private:
+    const char* block;
+};
+
+// 35=5, template 7
+class LogoutEncoder {
+public:
+    static const uint16_t template_id = 7;
+    static const uint16_t block_length = 64;
+    static const size_t frame_size = 78;
+
+    LogoutEncoder() : block(0) {}
+
+    // SOFH, header and a zero block with
+    // optional fields null. False if the
+    // frame does not fit capacity.
+    bool wrap(char* out, size_t capacity) {
+        if (!out || capacity < frame_size) {
+            block = 0;
+            return false;
+        }
+        sbe_store_be(out, frame_size, 4);
+        sbe_store_be(out + 4, sofh_sbe_le, 2);
+        sbe_store_le(out + 6, block_length, 2);
+        sbe_store_le(out + 8, template_id, 2);
+        sbe_store_le(out + 10, schema_id, 2);
+        sbe_store_le(out + 12, schema_version, 2);
+
+        block = out + 14;
+        std::memset(block, 0, block_length);
+        return true;
+    }
+
+    size_t size() const { return block ? frame_size : 0; }
+
+    // 58 Text, char[64]
+    bool set_text(const FixText& value) {
+        if (value.size > 64) return false;
+        std::memcpy(block + 0, value.data, value.size);
+        std::memset(block + 0 + value.size, 0, 64 - value.size);
+        return true;
+    }
+
+private:
+    char* block;
+};
+
+class LogoutDecoder {
+public:
+    static const uint16_t template_id = 7;
+    static const uint16_t block_length = 64;
+
+    LogoutDecoder() : block(0) {}
+
+    // Header onwards, SOFH stripped. False on a
+    // short buffer, another schema or another
+    // template; a longer blockLength from a
+    // newer version is skipped over.
+    bool wrap(const char* data, size_t size) {
+        block = 0;
+        if (!data || size < 8) return false;
+
+        const size_t length = static_cast<size_t>(sbe_load_le(data, 2));
+        if (sbe_load_le(data + 2, 2) != template_id || sbe_load_le(data + 4, 2) != schema_id ||
+            length < block_length || size < 8 + length) {
+            return false;
+        }
+        block = data + 8;
+        return true;
+    }
+
+    // 58 Text, char[64]
+    FixText text() const {
+        const void* nul = std::memchr(block + 0, '\0', 64);
+        return FixText(block + 0, nul ? static_cast<size_t>(static_cast<const char*>(nul) - (block + 0)) : 64);
+    }
+
+private:
+    const char* block;
+};
+
+}
+
+#endif
@@ -0,0 +1,87 @@
+#ifndef SBE_SCHEMA_H
+#define SBE_SCHEMA_H
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <stdint.h>
+
+enum SbeFieldKind {
+    sbe_kind_int,               // int8..int64
+    sbe_kind_uint,              // uint8..uint64
+    sbe_kind_char,              // single char, char enums
+    sbe_kind_string,            // char[length], NUL padded
+    sbe_kind_decimal,           // mantissa + exponent composite
+    sbe_kind_timestamp          // uint64 nanos since epoch, semanticType UTCTimestamp
+};
+
+// One root-block field resolved to its place in
+// the block. id is the FIX tag, as in the FIX
+// SBE schemas.
+struct SbeField {
+    std::string name;
+    int tag;
+    SbeFieldKind kind;
+    size_t offset;
+    size_t size;                // bytes in the block
+    bool optional;              // null value when not set
+
+    // sbe_kind_decimal: mantissa width and either a
+    // constant exponent or the exponent byte after it
+    size_t mantissa_size;
+    bool constant_exponent;
+    int exponent;
+
+    SbeField() : tag(0), kind(sbe_kind_int), offset(0), size(0), optional(false),
+                 mantissa_size(8), constant_exponent(false), exponent(0) {}
+};
+
+struct SbeMessageLayout {
+    std::string name;
+    std::string msg_type;       // semanticType, the FIX MsgType
+    uint16_t template_id;
+    uint16_t block_length;
+    std::vector<SbeField> fields;
+
+    // FIX tag -> index in fields, -1 = not carried
+    std::vector<int> by_tag;
+
+    SbeMessageLayout() : template_id(0), block_length(0) {}
+
+    const SbeField* field(int tag) const {
+        if (tag < 0 || static_cast<size_t>(tag) >= by_tag.size() || by_tag[tag] < 0) return 0;
+        return &fields[static_cast<size_t>(by_tag[tag])];
+    }
+};
+
+// Subset of an SBE 1.0 XML schema: little-endian,
+// the standard 8-byte messageHeader, primitive
+// types, char arrays, enums, UTCTimestamp (uint64
+// nanos) and decimal composites (mantissa +
+// exponent) in the root block. Groups
+// and var data are refused. Every field is
+// resolved to a fixed offset at load, so encoding
+// and decoding (sbe_codec.h) never look names up.
+class SbeSchema {
+public:
+    SbeSchema() : schema_id(0), schema_version(0) {}
+
+    // False with error set on a file
+    // or construct outside the subset
+    bool load(const std::string& path, std::string& error);
+    bool load_text(const std::string& xml, std::string& error);
+
+    const SbeMessageLayout* find_template(uint16_t template_id) const;
+    const SbeMessageLayout* find_msg_type(const std::string& msg_type) const;
+
+    uint16_t id() const { return schema_id; }
+    uint16_t version() const { return schema_version; }
+    const std::vector<SbeMessageLayout>& messages() const { return layouts; }
+
+private:
+    uint16_t schema_id;
+    uint16_t schema_version;
+    std::vector<SbeMessageLayout> layouts;
+};
+
+#endif
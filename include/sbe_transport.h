@@ -0,0 +1,88 @@
+#ifndef SBE_TRANSPORT_H
+#define SBE_TRANSPORT_H
+
+#include "transport.h"
+#include "sbe_codec.h"
+#include "fix_message.h"
+#include "config_parser.h"
+
+#include <string>
+#include <cstddef>
+
+// encoding=sbe: the session keeps speaking tag=value
+// and this translates at the wire. Outbound messages
+// go through sbe_encode_fields() by their 35, inbound
+// bytes through SofhParser and come back as tag=value
+// with a rebuilt header, so parser, scenarios and
+// regression see what a FIX venue would send.
+//
+// There is no FIXP layer: Logon, Heartbeat,
+// TestRequest and Logout go to the venue as the
+// schema's SBE messages with FIX semantics, so the
+// venue answers the Logon itself. A schema without
+// them is refused. ResendRequest, Reject and
+// SequenceReset without a layout are dropped with
+// a warning (sequencing is per connection), other
+// messages without one fail the send.
+class SbeTransport : public Transport {
+public:
+    SbeTransport();
+
+    // False when the schema lacks a session
+    // message, see session_layouts()
+    static bool session_layouts(const SbeSchema& schema, std::string& error);
+
+    // schema must outlive the session.
+    // False as session_layouts().
+    bool connect(Transport& wire, const SbeSchema& schema, const SessionConfig& config);
+
+    void close();
+    bool is_open() const { return wire != 0 && wire->is_open(); }
+    bool send_bytes(const std::string& data);
+    bool set_receive_timeout(int timeout_millis);
+    bool wait_readable(int timeout_millis);
+    int receive_bytes(char* buf, size_t max_len);
+
+    // TX stamps are the wire's, RX stamps
+    // those of the last decoded frame
+    bool enable_timestamping(bool hardware);
+    bool is_timestamping() const { return wire != 0 && wire->is_timestamping(); }
+    bool is_hardware_timestamping() const { return wire != 0 && wire->is_hardware_timestamping(); }
+    const SocketTimestamp& last_rx_timestamp() const { return last_rx; }
+    uint32_t last_tx_key() const { return wire ? wire->last_tx_key() : 0; }
+    bool read_tx_timestamp(uint32_t& tx_key, SocketTimestamp& stamp);
+
+private:
+    Transport* wire;
+    const SbeSchema* schema;
+
+    // Header of what the venue sends,
+    // their CompID first
+    FixMessage venue;
+    int inbound_seq;
+
+    SofhParser frames;
+    SbeDecoder decoder;
+    SocketTimestamp last_rx;
+
+    // Rendered inbound messages,
+    // handed out from pending_offset
+    std::string pending;
+    size_t pending_offset;
+
+    // Reused across calls
+    FixMessage::FieldList outbound;
+    std::string frame;
+    std::string rendered;
+    std::string encoded;
+    char read_buffer[65536];
+
+    bool send_message(const std::string& msg_type);
+    void render_frame(const SocketTimestamp& stamp);
+    void push_inbound(const std::string& body);
+
+    SbeTransport(const SbeTransport&);
+    SbeTransport& operator=(const SbeTransport&);
+};
+
+#endif
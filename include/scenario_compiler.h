@@ -0,0 +1,88 @@
+#ifndef SCENARIO_COMPILER_H
+#define SCENARIO_COMPILER_H
+
+#include "fix_message.h"
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+// Compiled scenario files
+// Each source is compiled once into records of
+// opcode + tag array + value pool and cached as
+// .<name>.fxc next to it (hidden, so scenario
+// directory listings skip it). The cache is keyed
+// by source size and mtime and read through mmap.
+
+enum ScenarioFormat {
+    scenario_format_raw = 0,          // one FIX message per line
+    scenario_format_regression = 1    // BGN/SND/TST/RCV/END | col | payload
+};
+
+enum ScenarioOpcode {
+    scenario_op_raw = 0,
+    scenario_op_bgn = 1,
+    scenario_op_snd = 2,
+    scenario_op_tst = 3,
+    scenario_op_rcv = 4,
+    scenario_op_end = 5,
+    scenario_op_directive = 6       // "@..." line of a generator file, text only
+};
+
+const int scenario_max_clr = 50;
+
+// Field value slots resolved at compile time:
+// literal, clrN (1..scenario_max_clr) or the
+// ${ORG_CLRID} placeholder
+const uint16_t scenario_slot_literal = 0;
+const uint16_t scenario_slot_org_clrid = 0xFFFF;
+const uint16_t scenario_slot_expand = 0xFFFE;      // value holds ${NAME}
+
+struct ScenarioRecord {
+    int opcode;
+    int timeout_ms;         // "timeout=<ms>" of the middle column, 0 = default
+    std::string text;       // BGN/END name, @ directive
+    std::string msg_type;
+    FixMessage::FieldList fields;
+    std::vector<uint16_t> slots;
+};
+
+// Sequential reader over one compiled file
+class ScenarioReader {
+public:
+    ScenarioReader();
+    ~ScenarioReader();
+
+    // Maps the cache of source_path, compiling
+    // it first when missing or stale
+    bool open(const std::string& source_path, ScenarioFormat format);
+    void close();
+
+    bool is_open() const { return data != 0; }
+    uint64_t record_count() const { return records; }
+
+    // File has @ directives (see scenario_generator.h)
+    bool is_generator() const { return generator; }
+
+    bool next(ScenarioRecord& record);
+
+private:
+    const char* data;
+    size_t size;
+    size_t offset;
+    uint64_t records;
+    bool generator;
+    bool is_mapped;
+    std::string buffer;     // used when the cache can't be written
+
+    ScenarioReader(const ScenarioReader&);
+    ScenarioReader& operator=(const ScenarioReader&);
+};
+
+std::string scenario_cache_path(const std::string& source_path);
+
+// Compiles stale caches of files,
+// in parallel across files
+void precompile_scenarios(const std::vector<std::string>& files, ScenarioFormat format);
+
+#endif
@@ -0,0 +1,128 @@
+#ifndef SCENARIO_GENERATOR_H
+#define SCENARIO_GENERATOR_H
+
+#include "scenario_compiler.h"
+#include "fix_decimal.h"
+#include "fix_message.h"
+
+#include <string>
+#include <vector>
+#include <map>
+#include <random>
+#include <stdint.h>
+
+// Streaming RAW scenario source
+// Plain files are passed through record by
+// record. Files with @ directives are small
+// programs expanded lazily, memory does not
+// grow with the repeat counts:
+//
+//   @seed 42
+//   @var SYM = list(AAA,BBB,CCC)       next item per draw, cycling
+//   @var SIDE = choice(1,2)            random item
+//   @var QTY = range(100,1000,100)     next step per draw, cycling
+//   @var PX = uniform(10.00,10.50)     random, scale of the bounds
+//   @var ACCT = ACC01                  constant
+//   @repeat 1000000 i                  ${i} = 1..N, loops nest
+//   8=FIX.4.4|35=D|...|55=${SYM}|54=${SIDE}|38=${QTY}|44=${PX}
+//   @end
+//
+// A variable is drawn once per loop iteration
+// (per message outside loops), so the lines of
+// one iteration see the same values.
+class ScenarioGenerator {
+public:
+    ScenarioGenerator();
+
+    // False when the file can't be read or a
+    // directive is malformed (error printed)
+    bool open(const std::string& source_path);
+    void close();
+    bool is_open() const { return reader.is_open(); }
+
+    bool next(std::string& msg_type, FixMessage::FieldList& fields);
+
+    // Counts loop iterations started, so per
+    // iteration state (${ORG_CLRID}) can reset
+    uint64_t iteration() const { return iterations; }
+
+private:
+    enum VariableKind {
+        variable_constant,
+        variable_list,
+        variable_choice,
+        variable_range,
+        variable_uniform,
+        variable_loop
+    };
+
+    struct Variable {
+        VariableKind kind;
+        std::vector<std::string> items;
+        FixDecimal low;
+        FixDecimal high;
+        FixDecimal step;
+        FixDecimal current;
+        size_t cursor;
+        uint64_t drawn_at;      // draw serial of value
+        std::string value;
+    };
+
+    // Literal text, or a variable
+    // when variable >= 0
+    struct Part {
+        std::string text;
+        int variable;
+    };
+
+    struct Expansion {
+        size_t field;
+        std::vector<Part> parts;
+    };
+
+    enum OpKind { op_message, op_repeat, op_end };
+
+    struct Op {
+        OpKind kind;
+        std::string msg_type;
+        FixMessage::FieldList fields;
+        std::vector<Expansion> expansions;
+        uint64_t count;         // op_repeat
+        int variable;           // op_repeat loop variable, -1 if none
+        size_t match;           // op_repeat <-> op_end
+    };
+
+    struct Frame {
+        size_t start;
+        uint64_t count;
+        uint64_t index;
+        int variable;
+    };
+
+    ScenarioReader reader;
+    ScenarioRecord record;
+    std::string path;
+
+    std::vector<Op> program;
+    std::vector<Variable> variables;
+    std::map<std::string, int> variable_index;
+    std::vector<Frame> frames;
+    size_t pc;
+    uint64_t serial;
+    uint64_t iterations;
+    std::mt19937_64 rng;
+
+    bool load_program();
+    bool parse_directive(const std::string& text, std::vector<size_t>& open_repeats);
+    bool parse_variable(const std::string& name, const std::string& expr);
+    int find_or_add_variable(const std::string& name);
+    bool compile_message(ScenarioRecord& message, Op& op);
+    const std::string& draw(int variable);
+    void set_loop_value(const Frame& frame);
+    bool fail(const std::string& text, const char* reason);
+
+    ScenarioGenerator(const ScenarioGenerator&);
+    ScenarioGenerator& operator=(const ScenarioGenerator&);
+};
+
+#endif
@@ -0,0 +1,107 @@
+#ifndef SCENARIO_SENDER_H
+#define SCENARIO_SENDER_H
+
+#include "config_parser.h"
+#include "fix_message.h"
+#include "fix_template.h"
+#include "id_generator.h"
+#include "scenario_generator.h"
+
+#include <string>
+#include <vector>
+#include <map>
+#include <stdint.h>
+
+// Flow-controlled sender for RAW scenario
+// files. Keeps at most max_in_flight orders
+// outstanding, keyed by CrossID(548) or
+// ClOrdID(11), until an ExecutionReport (35=8),
+// CancelReject (35=9) or Reject (35=3/35=j)
+// for it arrives. Messages without a key hold
+// a slot until they are sent. Files are
+// compiled once and their records (or
+// generated messages, see scenario_generator.h)
+// read lazily.
+class ScenarioSender {
+public:
+    ScenarioSender(const SessionConfig& config,
+                   IdGenerator& id_generator);
+
+    // Lists files (sorted) or takes a
+    // single file path
+    void open(const std::string& scenario_path);
+
+    // Security master for the ${TICK_SIZE}
+    // style placeholders, see fix_template.h
+    void set_instruments(const InstrumentCache* instruments) { runtime.instruments = instruments; }
+
+    // True when the window has room and
+    // there is another line to send, reads
+    // that line ahead
+    bool can_send();
+
+    // True when the window has room
+    bool window_open() const { return outstanding.size() + unsent_keyless < max_in_flight; }
+
+    // Next message with IDs applied, counted
+    // in the window from here. MsgSeqNum(34) is
+    // set when it is actually sent.
+    bool next_message(FixTemplateMessage& message);
+
+    // Records the MsgSeqNum a message went out
+    // with, for Reject (45=RefSeqNum) matching
+    void on_sent(const FixMessage::FieldList& fields, int msg_seq_num);
+
+    // Feed every inbound message,
+    // returns True if it acked an order
+    bool on_inbound(const std::string& inbound_message);
+
+    // All lines sent and nothing outstanding,
+    // known once can_send() ran out of lines
+    bool finished() const;
+
+    size_t in_flight() const { return outstanding.size(); }
+    size_t sent_count() const { return sent; }
+    size_t acked_count() const { return acked; }
+
+    // Monotonic ms of the last send or ack
+    uint64_t last_progress_ms() const { return progress_ms; }
+
+private:
+    IdGenerator& ids;
+    size_t max_in_flight;
+
+    std::vector<std::string> files;
+    size_t file_index;
+    ScenarioGenerator generator;
+    uint64_t generator_iteration;
+    FixTemplateRuntime runtime;
+
+    bool has_pending;
+    bool exhausted;
+    FixTemplateMessage pending;
+
+    // key -> MsgSeqNum (0 until sent),
+    // MsgSeqNum -> key
+    std::map<std::string, int> outstanding;
+    std::map<int, std::string> outstanding_seq;
+
+    // Handed out by next_message() without
+    // 11/548, not yet through on_sent()
+    size_t unsent_keyless;
+
+    size_t sent;
+    size_t acked;
+    uint64_t progress_ms;
+
+    // Reads ahead one message into pending
+    bool load_next();
+    void ack(const std::string& key);
+
+    static std::string order_key(const FixMessage::FieldList& fields);
+
+    ScenarioSender(const ScenarioSender&);
+    ScenarioSender& operator=(const ScenarioSender&);
+};
+
+#endif
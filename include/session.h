@@ -0,0 +1,165 @@
+#ifndef SESSION_H
+#define SESSION_H
+
+#include "config_parser.h"
+#include "fix_message.h"
+#include "fix_typed.h"
+#include "fix_validator.h"
+#include "fix_parser.h"
+#include "socket.h"
+#include "loopback_transport.h"
+#include "inproc_pipe.h"
+#include "utils.h"
+
+#include <string>
+#include <vector>
+#include <functional>
+#include <stdint.h>
+
+// Inbound message handed to the handlers,
+// valid for the duration of the call
+struct FixInbound {
+    const std::string* raw;
+    std::string msg_type;
+    int msg_seq_num;
+    SocketTimestamp rx_stamp;
+
+    FixInbound() : raw(0), msg_seq_num(0) {}
+
+    // First occurrence of tag
+    bool get(int tag, std::string& value) const;
+};
+
+// FIX initiator session for linking fixclient_core
+// into another process. Construct it from a
+// SessionConfig, register handlers per MsgType,
+// connect() and logon(), then call poll() from the
+// owner's loop. Session-level messages (Logon
+// ack, TestRequest, Logout, keepalive) are
+// answered inside poll() before the handlers run.
+// throttle_* is not applied here, see throttle.h.
+//
+//     Session session(config);
+//     session.on("8", on_execution_report);
+//     session.connect();
+//     session.logon();
+//     while (session.poll(10)) { ... session.send(view); }
+class Session {
+public:
+    typedef std::function<void(Session& session, const FixInbound& msg)> Handler;
+
+    enum State {
+        session_disconnected,
+        session_logon_sent,
+        session_active,
+        session_logout_sent,
+        session_closed
+    };
+
+    explicit Session(const SessionConfig& config);
+    ~Session();
+
+    // MsgSeqNum persisted under token_dir as
+    // fixclient does, empty keeps it in memory
+    void set_token_dir(const std::string& dir) { token_dir = dir; }
+
+    // Transport by config.host (socket.h,
+    // transport.h); host=inproc needs the peer,
+    // host=inproc:<name> a registered pipe.
+    // Also False if validation= is set and
+    // data_dictionary does not load.
+    bool connect(LoopbackPeer* peer = 0);
+
+    // Queues the Logon, poll() waits for the ack
+    bool logon();
+
+    // Queues the Logout, poll() returns False
+    // once it is answered or timed out
+    void logout(const std::string& text = "");
+
+    // Handler for one MsgType, replacing an
+    // earlier one. Business messages without a
+    // handler go to on_unhandled().
+    void on(const std::string& msg_type, const Handler& handler);
+    void on_unhandled(const Handler& handler) { unhandled = handler; }
+
+    // Encodes into the outbound queue, nothing is
+    // written until flush() or the next poll().
+    // False before the Logon ack.
+    bool send(const FixMessageView& message);
+
+    // Same for a generated message type
+    // (fix44_messages.h), header bytes precomputed
+    template <class Message>
+    bool send_typed(const Message& message) {
+        if (session_state != session_active) {
+            return false;
+        }
+        if (!fix_encode(typed_header, message, outbound_seq, utils::get_utc_timestamp(), outbound)) {
+            return false;
+        }
+        outbound_seq++;
+        return true;
+    }
+    bool flush();
+
+    // Waits up to timeout_ms for inbound bytes,
+    // dispatches what is complete, keeps the
+    // session alive and flushes the queue.
+    // False once the session is over.
+    bool poll(int timeout_ms);
+
+    void close();
+
+    State state() const { return session_state; }
+    int next_outbound_seq() const { return outbound_seq; }
+    const SessionConfig& get_config() const { return config; }
+    Transport& transport() { return *active; }
+
+private:
+    struct Route {
+        std::string msg_type;
+        Handler handler;
+    };
+
+    SessionConfig config;
+    FixMessage fix;
+    FixTypedHeader typed_header;
+    FixParser parser;
+    StreamSocket stream_socket;
+    LoopbackTransport loopback;
+    InprocEndpoint pipe_end;
+    Transport* active;
+
+    FixValidator validator;
+    FixValidationMode validation;
+
+    State session_state;
+    std::string token_dir;
+    std::string token_path;
+    int outbound_seq;
+    int saved_seq;
+    std::string outbound;
+
+    uint64_t heartbeat_interval_ms;
+    uint64_t last_send_ms;
+    uint64_t last_recv_ms;
+    uint64_t test_request_sent_ms;
+    int test_request_counter;
+    uint64_t state_since_ms;            // logon or logout sent
+
+    // Keyed by the first MsgType byte, multi-byte
+    // types share their slot
+    std::vector<Route> routes[256];
+    Handler unhandled;
+
+    void queue(const std::string& msg);
+    void handle(const std::string& msg, const SocketTimestamp& stamp);
+    void dispatch(const FixInbound& inbound);
+    void check_timers(uint64_t now_ms);
+
+    Session(const Session&);
+    Session& operator=(const Session&);
+};
+
+#endif
@@ -0,0 +1,41 @@
+#ifndef SESSION_ADMIN_H
+#define SESSION_ADMIN_H
+
+#include "fix_message.h"
+
+#include <string>
+#include <stdint.h>
+
+// Session-level handling shared by the initiator
+// (application.cpp) and the acceptor (fix_acceptor.cpp)
+
+// 0/1/2/4/5/A
+bool is_admin_msg_type(const std::string& msg_type);
+
+enum AdminAction {
+    admin_none,         // not a session-level request
+    admin_heartbeat,    // TestRequest: send reply (Heartbeat)
+    admin_logout        // Logout: send reply unless we started it, then stop
+};
+
+AdminAction answer_admin_message(const FixMessage& fix,
+                                 const std::string& msg_type,
+                                 const std::string& inbound_message,
+                                 int msg_seq_num,
+                                 std::string& reply);
+
+enum KeepaliveAction {
+    keepalive_idle,
+    keepalive_heartbeat,        // nothing sent for an interval
+    keepalive_test_request,     // nothing received for an interval
+    keepalive_timeout           // TestRequest unanswered for an interval
+};
+
+// test_request_sent_ms 0 = none pending
+KeepaliveAction check_keepalive(uint64_t now_ms,
+                                uint64_t interval_ms,
+                                uint64_t last_send_ms,
+                                uint64_t last_recv_ms,
+                                uint64_t test_request_sent_ms);
+
+#endif
@@ -0,0 +1,65 @@
+#ifndef SIM_ACCEPTOR_H
+#define SIM_ACCEPTOR_H
+
+#include "loopback_transport.h"
+#include "fix_parser.h"
+#include "fix_message.h"
+#include "config_parser.h"
+
+#include <string>
+#include <deque>
+#include <stdint.h>
+
+// ExecutionReport acking an order request as a
+// venue would: D/s -> New, F -> Canceled, G -> Replaced.
+// OrderID is "O" + ClOrdID (OrigClOrdID for F/G).
+// Returns False for other message types.
+bool build_order_ack(const FixMessage& fix,
+                     const std::string& msg_type,
+                     const std::string& request,
+                     int msg_seq_num,
+                     const std::string& sending_time,
+                     uint64_t exec_id,
+                     std::string& ack);
+
+// Scripted venue for the simulation mode (-S)
+// Answers on the virtual clock, config.sim_latency_us
+// after each request:
+//   A -> A (HeartBtInt echoed)
+//   1 -> 0 (TestReqID echoed)
+//   5 -> 5, then closes
+//   D -> 8 New, F -> 8 Canceled, G -> 8 Replaced
+//   s -> 8 New with the CrossID
+// OrderID is "O" + ClOrdID (OrigClOrdID for F/G),
+// ExecIDs count from 1, so runs are reproducible.
+class SimAcceptor : public LoopbackPeer {
+public:
+    explicit SimAcceptor(const SessionConfig& config);
+
+    void on_client_bytes(const char* data, size_t len, uint64_t now_ns);
+    uint64_t next_due_ns() const;
+    int read_due(char* buf, size_t max_len, uint64_t now_ns);
+
+private:
+    struct Reply {
+        uint64_t due_ns;
+        std::string bytes;      // empty = close
+    };
+
+    FixParser parser;
+    FixMessage fix;             // sender/target of the venue side
+    std::deque<Reply> replies;
+    size_t front_offset;        // bytes of the front reply already read
+    uint64_t latency_ns;
+    int outbound_seq;
+    uint64_t next_exec_id;
+    bool closed;
+
+    void handle(const std::string& msg, uint64_t now_ns);
+    void queue(const std::string& bytes, uint64_t due_ns);
+
+    SimAcceptor(const SimAcceptor&);
+    SimAcceptor& operator=(const SimAcceptor&);
+};
+
+#endif
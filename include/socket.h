@@ -1,30 +1,63 @@
 #ifndef SOCKET_H
 #define SOCKET_H
 
+#include "transport.h"
+
 #include <string>
 #include <cstddef>
+#include <stdint.h>
 
-class TcpSocket {
+// Stream socket to the venue: TCP (IPv4/IPv6,
+// names resolved) or a Unix domain socket
+class StreamSocket : public Transport {
 public:
-    TcpSocket();
-    ~TcpSocket();
+    StreamSocket();
+    ~StreamSocket();
 
     bool connect(const std::string& host, int port);
+    bool connect_unix(const std::string& path);
+
     void close();
+    bool is_open() const { return sock_fd >= 0; }
     bool send_bytes(const std::string& data);
 
-    // Read up to max_len bytes into buffer
-    // > 0 bytes read
-    //   0 peer closed
-    //  -1 error
+    // SO_RCVTIMEO, 0 blocks
+    bool set_receive_timeout(int timeout_millis);
+
+    bool wait_readable(int timeout_millis);
     int receive_bytes(char* buf, size_t max_len);
     int get_fd() const { return sock_fd; }
 
+    // Turn on SO_TIMESTAMPING (software RX/TX,
+    // plus hardware when requested: SIOCSHWTSTAMP
+    // on the interface of the connection, which
+    // needs CAP_NET_ADMIN and a NIC that stamps).
+    // Falls back to software only with a warning.
+    bool enable_timestamping(bool hardware);
+    bool is_timestamping() const { return timestamping; }
+    bool is_hardware_timestamping() const { return hardware_stamps; }
+
+    // RX stamp of the last receive_bytes() call
+    const SocketTimestamp& last_rx_timestamp() const { return last_rx; }
+
+    // TX key of the last byte handed to the kernel
+    // by send_bytes(), matches read_tx_timestamp()
+    uint32_t last_tx_key() const { return tx_bytes - 1; }
+
+    // Non-blocking read of one TX stamp from
+    // the socket error queue.
+    // Returns False when the queue is empty.
+    bool read_tx_timestamp(uint32_t& tx_key, SocketTimestamp& stamp);
+
 private:
     int sock_fd;
-    
-    TcpSocket(const TcpSocket&);
-    TcpSocket& operator=(const TcpSocket&);
+    bool timestamping;
+    bool hardware_stamps;
+    uint32_t tx_bytes;
+    SocketTimestamp last_rx;
+
+    StreamSocket(const StreamSocket&);
+    StreamSocket& operator=(const StreamSocket&);
 };
 
 #endif
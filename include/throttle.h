@@ -0,0 +1,121 @@
+#ifndef THROTTLE_H
+#define THROTTLE_H
+
+#include "config_parser.h"
+#include "fix_message.h"
+
+#include <string>
+#include <deque>
+#include <map>
+#include <stdint.h>
+
+// Token bucket, rate in msgs/sec,
+// burst = bucket size. rate 0 = unlimited.
+class TokenBucket {
+public:
+    TokenBucket();
+
+    void configure(double rate_per_sec, double burst, uint64_t now_ms);
+    bool enabled() const { return rate > 0.0; }
+
+    bool has_token(uint64_t now_ms);
+    void take();
+
+    // Admin messages may borrow,
+    // down to -burst
+    void borrow(uint64_t now_ms);
+
+    // ms until one token is available
+    uint64_t wait_ms(uint64_t now_ms);
+
+private:
+    double rate;
+    double capacity;
+    double tokens;
+    uint64_t last_ms;
+
+    void refill(uint64_t now_ms);
+};
+
+struct ThrottleMetrics {
+    uint64_t queued;
+    uint64_t sent;
+    uint64_t max_depth;
+    uint64_t total_wait_ms;
+    uint64_t max_wait_ms;
+
+    ThrottleMetrics()
+        : queued(0), sent(0), max_depth(0), total_wait_ms(0), max_wait_ms(0) {}
+};
+
+// Outbound venue throttle
+// config.ini:
+//   throttle_session=100/10        rate/burst for all messages
+//   throttle_msg_types=D:50/5,F:20 per MsgType (burst defaults to 1)
+//
+// Business messages are queued un-sequenced and
+// encoded when released, so priority reordering
+// never breaks MsgSeqNum(34) order. A cancel or
+// replace waits while the order it names is still
+// queued. Admin messages bypass the queue and
+// borrow session tokens.
+class OutboundThrottle {
+public:
+    enum Priority {
+        priority_admin = 0,     // 0,1,2,3,4,5,A
+        priority_cancel = 1,    // F, q, u
+        priority_order = 2,     // everything else
+        priority_count = 3
+    };
+
+    struct Pending {
+        std::string msg_type;
+        FixMessage::FieldList fields;
+        uint64_t enqueued_ms;
+    };
+
+    OutboundThrottle();
+
+    static Priority classify(const std::string& msg_type);
+
+    // Returns False on a malformed throttle key
+    bool configure(const SessionConfig& config);
+    bool enabled() const { return is_enabled; }
+
+    void enqueue(const std::string& msg_type,
+                 const FixMessage::FieldList& fields);
+
+    // Releases the highest priority message
+    // whose buckets have a token
+    bool pop_ready(Pending& out);
+
+    // ms until pop_ready can release
+    // something (0 = now or queue empty)
+    uint64_t next_ready_ms();
+
+    // Account an admin message sent
+    // outside the queue
+    void on_admin_sent();
+
+    // Blocks until msg_type may be sent,
+    // for the step-by-step regression path.
+    // Returns ms waited.
+    uint64_t acquire(const std::string& msg_type);
+
+    size_t depth() const;
+    const ThrottleMetrics& metrics() const { return stats; }
+
+private:
+    bool is_enabled;
+    TokenBucket session_bucket;
+    std::map<std::string, TokenBucket> msg_type_buckets;
+    std::deque<Pending> queues[priority_count];
+    ThrottleMetrics stats;
+
+    TokenBucket* find_bucket(const std::string& msg_type);
+    bool can_release(const std::string& msg_type, uint64_t now_ms);
+    bool waits_for_order(const Pending& pending) const;
+    void release(const std::string& msg_type, uint64_t waited_ms);
+};
+
+#endif
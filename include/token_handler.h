@@ -2,6 +2,7 @@
 #define TOKEN_HANDLER_H
 
 #include <string>
+#include <stdint.h>
 
 bool read_token(const std::string& token_dir, 
                 const std::string& sender_comp_id,
@@ -12,4 +13,11 @@ bool read_token(const std::string& token_dir,
 
 bool save_token(const std::string& token_path, int next_seq);
 
+// Session-unique run number for IdGenerator.
+// Bumped and saved on every call so IDs never
+// repeat across restarts (not reset daily).
+bool next_id_epoch(const std::string& token_dir,
+                   const std::string& sender_comp_id,
+                   uint32_t& epoch_out);
+
 #endif
@@ -0,0 +1,82 @@
+#ifndef TRANSPORT_H
+#define TRANSPORT_H
+
+#include <string>
+#include <cstddef>
+#include <stdint.h>
+
+// Kernel packet timestamp (SO_TIMESTAMPING)
+// software_ns is CLOCK_REALTIME in nanos,
+// hardware_ns is the raw NIC clock,
+// 0 when not available.
+struct SocketTimestamp {
+    uint64_t software_ns;
+    uint64_t hardware_ns;
+
+    SocketTimestamp() : software_ns(0), hardware_ns(0) {}
+};
+
+// Byte stream to the venue. The session code only
+// talks to this; StreamSocket (socket.h) covers TCP
+// and Unix domain sockets, LoopbackTransport
+// (loopback_transport.h) the in-process acceptor
+// and InprocEndpoint (inproc_pipe.h) a pipe to
+// another thread of the process.
+class Transport {
+public:
+    virtual ~Transport() {}
+
+    virtual void close() = 0;
+    virtual bool is_open() const = 0;
+    virtual bool send_bytes(const std::string& data) = 0;
+
+    // 0 blocks
+    virtual bool set_receive_timeout(int timeout_millis) = 0;
+
+    // Wait for inbound bytes, at most timeout_millis
+    virtual bool wait_readable(int timeout_millis) = 0;
+
+    // Read up to max_len bytes into buffer
+    // > 0 bytes read
+    //   0 peer closed
+    //  -1 error (errno EAGAIN on timeout)
+    virtual int receive_bytes(char* buf, size_t max_len) = 0;
+
+    // Packet stamps, only kernel sockets have them
+    virtual bool enable_timestamping(bool hardware) { (void)hardware; return false; }
+    virtual bool is_timestamping() const { return false; }
+
+    // The NIC stamps too: hardware_ns is set
+    // and TX stamps come twice, software first
+    virtual bool is_hardware_timestamping() const { return false; }
+
+    // RX stamp of the last receive_bytes() call
+    virtual const SocketTimestamp& last_rx_timestamp() const { return no_timestamp; }
+
+    // TX key of the last byte sent,
+    // matches read_tx_timestamp()
+    virtual uint32_t last_tx_key() const { return 0; }
+
+    // Non-blocking read of one TX stamp.
+    // Returns False when none is queued.
+    virtual bool read_tx_timestamp(uint32_t& tx_key, SocketTimestamp& stamp) {
+        (void)tx_key; (void)stamp;
+        return false;
+    }
+
+protected:
+    SocketTimestamp no_timestamp;
+};
+
+enum TransportKind {
+    transport_tcp,          // host=<name or address>
+    transport_unix,         // host=unix:/run/venue.sock
+    transport_inproc,       // host=inproc, in-process acceptor
+    transport_pipe          // host=inproc:<name>, see inproc_pipe.h
+};
+
+// Kind of a config host value, address is
+// the host, the socket path or the pipe name
+TransportKind parse_transport_host(const std::string& host, std::string& address);
+
+#endif
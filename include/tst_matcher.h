@@ -0,0 +1,78 @@
+#ifndef TST_MATCHER_H
+#define TST_MATCHER_H
+
+#include "fix_message.h"
+#include "fix_decimal.h"
+
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+// Expected fields of a TST step compiled once:
+// entries sorted by tag with their expectation
+// (any / absent / equal / clrN) and bitmaps of
+// the required, absent and ignored tags. A
+// received message is walked once, ignored tags
+// are never looked up, and each other expected
+// field gets a verdict; the reporter formats
+// from the verdicts only when needed.
+class TstMatcher {
+public:
+    enum Expect {
+        expect_any,         // empty or IGNORE
+        expect_absent,      // NONE
+        expect_equal,       // literal value
+        expect_clr          // clrN, value given at match time
+    };
+
+    // Per expected field, in TST order. Value
+    // points into the matched message, ignored
+    // fields are never found.
+    struct Verdict {
+        bool found;
+        bool match;
+        size_t value_pos;
+        size_t value_len;
+    };
+
+    TstMatcher();
+
+    // slots from ScenarioRecord, clrN = 1..n
+    void compile(const FixMessage::FieldList& expected,
+                 const std::vector<uint16_t>& slots);
+
+    bool empty() const { return entries.empty(); }
+
+    // clr_values[n] is the value of clrN.
+    // Returns True when every field matches.
+    bool match(const std::string& msg,
+               const std::string* clr_values,
+               std::vector<Verdict>& verdicts) const;
+
+    struct Entry {
+        int tag;
+        Expect kind;
+        uint16_t slot;
+        size_t field;           // index in the TST line
+        std::string value;
+        bool has_decimal;       // value parsed for Price/Qty tags
+        FixDecimal decimal;
+    };
+
+private:
+    std::vector<Entry> entries;
+    int max_tag;
+
+    // One bit per tag up to max_tag: equal/clrN,
+    // NONE and IGNORE (or empty) expectations
+    std::vector<uint64_t> required;
+    std::vector<uint64_t> absent;
+    std::vector<uint64_t> ignored;
+
+    // Distinct required tags, the walk stops
+    // once all are found and nothing is absent
+    size_t required_tags;
+    bool has_absent;
+};
+
+#endif
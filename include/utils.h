@@ -11,6 +11,27 @@ namespace utils {
 std::string get_utc_timestamp();
 uint64_t get_monotonic_millis();
 
+// CLOCK_REALTIME in nanos, same clock
+// as kernel software packet stamps
+uint64_t get_realtime_nanos();
+
+// SendingTime format of a CLOCK_REALTIME nanos
+std::string format_utc_timestamp(uint64_t realtime_ns);
+
+// Simulation clock: once enabled, all of the above
+// read a virtual time that only moves through
+// advance_clock_to()/sleep_millis(). Waits cost
+// nothing and runs are reproducible.
+void use_virtual_clock(uint64_t start_realtime_ns);
+bool is_virtual_clock();
+
+// No-op on the real clock or when behind
+void advance_clock_to(uint64_t realtime_ns);
+
+// Sleeps, or advances the virtual clock
+void sleep_millis(uint64_t millis);
+void sleep_until_nanos(uint64_t realtime_ns);
+
 std::string to_pipe_delimited(const std::string& fix);
 bool find_tag_value(const std::string& msg, const char* tag_prefix, std::string& value);
 std::string trim(const std::string& str);
@@ -0,0 +1,33 @@
+#ifndef XML_READER_H
+#define XML_READER_H
+
+#include <string>
+#include <map>
+
+// One start or end tag, names without
+// their namespace prefix (sbe:message)
+struct XmlTag {
+    std::string name;
+    std::map<std::string, std::string> attrs;
+    std::string text_before;    // character data since the last tag
+    bool closing;
+    bool self_closing;
+
+    XmlTag() : closing(false), self_closing(false) {}
+
+    std::string attr(const std::string& key) const {
+        std::map<std::string, std::string>::const_iterator it = attrs.find(key);
+        return it == attrs.end() ? std::string() : it->second;
+    }
+};
+
+// Enough XML for schema and dictionary files:
+// tags, attributes and text. Comments, <?...?>
+// and <!...> are skipped, entities are not
+// expanded. False at the end, or with error set.
+bool xml_next_tag(const std::string& xml, size_t& pos, XmlTag& tag, std::string& error);
+
+// Whole file into text
+bool xml_read_file(const std::string& path, std::string& text, std::string& error);
+
+#endif
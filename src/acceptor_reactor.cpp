@@ -0,0 +1,750 @@
+#include "acceptor_reactor.h"
+#include "session_admin.h"
+#include "sim_acceptor.h"
+#include "utils.h"
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+
+static const int max_events = 256;
+static const int tick_ms = 100;
+
+// Past this the counterparty is not
+// reading, drop it instead of buffering
+static const size_t max_write_buffer = 8 * 1024 * 1024;
+
+static std::string session_key(const std::string& sender, const std::string& target) {
+    return sender + "|" + target;
+}
+
+SessionRegistry::SessionRegistry() {}
+
+SessionRegistry::~SessionRegistry() {
+    for (std::map<std::string, AcceptorSession*>::iterator it = sessions.begin(); it != sessions.end(); ++it) {
+        delete it->second;
+    }
+}
+
+static bool heavier_first(const SessionConfig* a, const SessionConfig* b) {
+    return a->session_weight > b->session_weight;
+}
+
+void SessionRegistry::configure(const std::vector<SessionConfig>& sections, int reactor_count) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    configs = sections;
+    reactor_weight.assign(static_cast<size_t>(reactor_count), 0);
+
+    // Heaviest first, each to the
+    // least loaded reactor so far
+    std::vector<const SessionConfig*> fixed;
+    for (size_t i = 0; i < configs.size(); ++i) {
+        if (!configs[i].target_comp_id.empty()) {
+            fixed.push_back(&configs[i]);
+        }
+    }
+    std::stable_sort(fixed.begin(), fixed.end(), heavier_first);
+
+    for (size_t i = 0; i < fixed.size(); ++i) {
+        create(*fixed[i], fixed[i]->sender_comp_id, fixed[i]->target_comp_id, -1);
+    }
+}
+
+AcceptorSession* SessionRegistry::create(const SessionConfig& section, const std::string& sender,
+                                         const std::string& target, int preferred) {
+    AcceptorSession* session = new AcceptorSession();
+    session->name = section.target_comp_id.empty() ? section.name + "/" + target : section.name;
+    session->config = section;
+    session->fix.set_begin_string(section.begin_string);
+    session->fix.set_sender_comp_id(sender);
+    session->fix.set_target_comp_id(target);
+    session->weight = section.session_weight;
+
+    // The reactor that took the Logon, unless
+    // another one carries less weight
+    std::vector<int>::iterator lightest = std::min_element(reactor_weight.begin(), reactor_weight.end());
+    session->home = static_cast<int>(lightest - reactor_weight.begin());
+    if (preferred >= 0 && reactor_weight[static_cast<size_t>(preferred)] == *lightest) {
+        session->home = preferred;
+    }
+    reactor_weight[static_cast<size_t>(session->home)] += session->weight;
+
+    sessions[session_key(sender, target)] = session;
+    return session;
+}
+
+// A catch-all section gets one session
+// per counterparty. home is the calling
+// reactor on entry, the session's on return.
+AcceptorSession* SessionRegistry::claim(const std::string& sender, const std::string& target,
+                                        int& home, std::string& error) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    AcceptorSession* session = 0;
+    std::map<std::string, AcceptorSession*>::iterator found = sessions.find(session_key(sender, target));
+    if (found != sessions.end()) {
+        session = found->second;
+    } else if (!target.empty()) {
+        for (size_t i = 0; i < configs.size(); ++i) {
+            if (configs[i].sender_comp_id == sender && configs[i].target_comp_id.empty()) {
+                session = create(configs[i], sender, target, home);
+                break;
+            }
+        }
+    }
+
+    if (!session) {
+        error = "unknown session " + target + "->" + sender;
+        return 0;
+    }
+    if (session->connected) {
+        error = "session " + session->name + " already logged on";
+        return 0;
+    }
+
+    session->connected = true;
+    home = session->home;
+    return session;
+}
+
+void SessionRegistry::release(AcceptorSession* session) {
+    std::lock_guard<std::mutex> lock(mutex);
+    session->connected = false;
+}
+
+void SessionRegistry::move(AcceptorSession* session, int reactor) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    reactor_weight[static_cast<size_t>(session->home)] -= session->weight;
+    reactor_weight[static_cast<size_t>(reactor)] += session->weight;
+    session->home = reactor;
+}
+
+void SessionRegistry::snapshot(std::vector<std::vector<AcceptorSession*> >& by_reactor,
+                               std::vector<int>& weights) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    by_reactor.assign(reactor_weight.size(), std::vector<AcceptorSession*>());
+    weights.assign(reactor_weight.size(), 0);
+
+    for (std::map<std::string, AcceptorSession*>::iterator it = sessions.begin(); it != sessions.end(); ++it) {
+        AcceptorSession* session = it->second;
+        if (!session->connected) continue;
+
+        by_reactor[static_cast<size_t>(session->home)].push_back(session);
+        weights[static_cast<size_t>(session->home)] += session->weight;
+    }
+}
+
+AcceptorConnection::AcceptorConnection()
+    : fd(-1), session(0), accepted_ms(0), heartbeat_interval_ms(0), last_send_ms(0),
+      last_recv_ms(0), test_request_sent_ms(0), test_request_counter(1), closing(false),
+      hand_off_to(-1) {}
+
+AcceptorReactor::AcceptorReactor(int reactor_index, SessionRegistry& session_registry,
+                                 uint64_t logon_timeout)
+    : index(reactor_index), registry(session_registry), logon_timeout_ms(logon_timeout),
+      epoll_fd(-1), wake_fd(-1), stopping(false), connection_count(0), session_count(0),
+      messages_in(0), messages_out(0), busy_ns(0), migrated_in(0) {}
+
+AcceptorReactor::~AcceptorReactor() {
+    for (std::map<int, AcceptorConnection*>::iterator it = connections.begin(); it != connections.end(); ++it) {
+        ::close(it->first);
+        delete it->second;
+    }
+    for (size_t i = 0; i < inbox.size(); ++i) {
+        ::close(inbox[i]->fd);
+        delete inbox[i];
+    }
+
+    if (wake_fd >= 0) ::close(wake_fd);
+    if (epoll_fd >= 0) ::close(epoll_fd);
+}
+
+bool AcceptorReactor::start() {
+    epoll_fd = ::epoll_create1(0);
+    wake_fd = ::eventfd(0, EFD_NONBLOCK);
+    if (epoll_fd < 0 || wake_fd < 0) {
+        return false;
+    }
+
+    epoll_event event;
+    std::memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN;
+    event.data.fd = wake_fd;
+    if (::epoll_ctl(epoll_fd, EPOLL_CTL_ADD, wake_fd, &event) != 0) {
+        return false;
+    }
+
+    thread = std::thread(&AcceptorReactor::run, this);
+    return true;
+}
+
+void AcceptorReactor::stop() {
+    if (!thread.joinable()) return;
+
+    stopping = true;
+    const uint64_t one = 1;
+    if (::write(wake_fd, &one, sizeof(one)) < 0) {
+        // Still wakes on the next tick
+    }
+    thread.join();
+}
+
+void AcceptorReactor::adopt(AcceptorConnection* conn) {
+    {
+        std::lock_guard<std::mutex> lock(inbox_mutex);
+        inbox.push_back(conn);
+    }
+
+    const uint64_t one = 1;
+    if (::write(wake_fd, &one, sizeof(one)) < 0) {
+        // Counter saturated, a wakeup is pending
+    }
+}
+
+void AcceptorReactor::migrate(AcceptorSession* session, int to_reactor) {
+    Migration migration;
+    migration.session = session;
+    migration.to_reactor = to_reactor;
+    {
+        std::lock_guard<std::mutex> lock(inbox_mutex);
+        migrations.push_back(migration);
+    }
+
+    const uint64_t one = 1;
+    if (::write(wake_fd, &one, sizeof(one)) < 0) {
+        // Counter saturated, a wakeup is pending
+    }
+}
+
+ReactorLoad AcceptorReactor::load() const {
+    ReactorLoad result;
+    result.connections = connection_count.load(std::memory_order_relaxed);
+    result.sessions = session_count.load(std::memory_order_relaxed);
+    result.messages_in = messages_in.load(std::memory_order_relaxed);
+    result.messages_out = messages_out.load(std::memory_order_relaxed);
+    result.busy_ns = busy_ns.load(std::memory_order_relaxed);
+    result.migrated_in = migrated_in.load(std::memory_order_relaxed);
+    return result;
+}
+
+void AcceptorReactor::run() {
+    epoll_event events[max_events];
+    uint64_t last_tick_ms = utils::get_monotonic_millis();
+
+    while (!stopping) {
+        const int count = ::epoll_wait(epoll_fd, events, max_events, tick_ms);
+        const uint64_t started_ns = utils::get_realtime_nanos();
+
+        if (count < 0 && errno != EINTR) {
+            logf("Error: reactor %d epoll_wait failed\n", index);
+            break;
+        }
+
+        for (int i = 0; i < count; ++i) {
+            const int fd = events[i].data.fd;
+            if (fd == wake_fd) {
+                uint64_t wakeups = 0;
+                if (::read(wake_fd, &wakeups, sizeof(wakeups)) < 0) {
+                    // Already drained
+                }
+                drain_inbox();
+                continue;
+            }
+
+            std::map<int, AcceptorConnection*>::iterator found = connections.find(fd);
+            if (found == connections.end()) continue;
+            AcceptorConnection& conn = *found->second;
+
+            if (events[i].events & (EPOLLIN | EPOLLERR | EPOLLHUP)) {
+                read_connection(conn);
+            } else if (events[i].events & EPOLLOUT) {
+                write_connection(conn);
+            }
+        }
+
+        // Keepalive/logon timeouts are
+        // checked at most once per tick
+        const uint64_t now_ms = utils::get_monotonic_millis();
+        if (now_ms - last_tick_ms >= static_cast<uint64_t>(tick_ms)) {
+            check_timers(now_ms);
+            last_tick_ms = now_ms;
+        }
+
+        flush_log();
+        busy_ns.fetch_add(utils::get_realtime_nanos() - started_ns, std::memory_order_relaxed);
+    }
+
+    drain_inbox();
+    logout_all();
+    flush_log();
+}
+
+// Safe point: between epoll rounds, no
+// message of any connection half handled
+void AcceptorReactor::drain_inbox() {
+    std::vector<AcceptorConnection*> adopted;
+    std::vector<Migration> moves;
+    {
+        std::lock_guard<std::mutex> lock(inbox_mutex);
+        adopted.swap(inbox);
+        moves.swap(migrations);
+    }
+
+    // Adopted first, a session that just logged
+    // on may be migrated in the same round
+    for (size_t i = 0; i < adopted.size(); ++i) {
+        add_connection(adopted[i]);
+    }
+
+    // The registry only learns the new home once
+    // the connection is actually handed off, a
+    // session that closed or moved on stays put
+    for (size_t i = 0; i < moves.size(); ++i) {
+        AcceptorConnection* found = 0;
+        for (std::map<int, AcceptorConnection*>::iterator it = connections.begin(); it != connections.end(); ++it) {
+            if (it->second->session == moves[i].session) {
+                found = it->second;
+                break;
+            }
+        }
+
+        if (!found) {
+            logf("Warning: reactor %d has no connection of %s, not moved\n", index,
+                 moves[i].session->name.c_str());
+            continue;
+        }
+        registry.move(moves[i].session, moves[i].to_reactor);
+        hand_off(*found, moves[i].to_reactor);
+    }
+}
+
+void AcceptorReactor::add_connection(AcceptorConnection* conn) {
+    epoll_event event;
+    std::memset(&event, 0, sizeof(event));
+    event.events = conn->write_buffer.empty() ? EPOLLIN : (EPOLLIN | EPOLLOUT);
+    event.data.fd = conn->fd;
+    if (::epoll_ctl(epoll_fd, EPOLL_CTL_ADD, conn->fd, &event) != 0) {
+        logf("Error: reactor %d cannot watch %s\n", index, name_of(*conn));
+        if (conn->session) registry.release(conn->session);
+        ::close(conn->fd);
+        delete conn;
+        return;
+    }
+
+    connections[conn->fd] = conn;
+    connection_count++;
+    if (conn->session) {
+        session_count++;
+        migrated_in++;
+    }
+
+    // Messages parsed off the wire but
+    // not handled before the hand-off
+    if (process(*conn) && conn->closing && conn->write_buffer.empty()) {
+        close_connection(*conn, 0);
+    }
+}
+
+void AcceptorReactor::hand_off(AcceptorConnection& conn, int to_reactor) {
+    ::epoll_ctl(epoll_fd, EPOLL_CTL_DEL, conn.fd, 0);
+    connections.erase(conn.fd);
+    connection_count--;
+    if (conn.session) session_count--;
+
+    conn.hand_off_to = -1;
+    reactors[static_cast<size_t>(to_reactor)]->adopt(&conn);
+}
+
+// False once the connection
+// went to another reactor
+bool AcceptorReactor::process(AcceptorConnection& conn) {
+    std::string msg;
+    while (!conn.closing && conn.parser.read_next_message(msg)) {
+        handle_message(conn, msg);
+
+        if (conn.hand_off_to >= 0 && !conn.closing) {
+            hand_off(conn, conn.hand_off_to);
+            return false;
+        }
+    }
+    return true;
+}
+
+// One read per wakeup so a busy
+// counterparty cannot starve the rest
+void AcceptorReactor::read_connection(AcceptorConnection& conn) {
+    char buffer[65536];
+    const ssize_t bytes_read = ::recv(conn.fd, buffer, sizeof(buffer), 0);
+
+    if (bytes_read == 0) {
+        close_connection(conn, "peer closed");
+        return;
+    }
+    if (bytes_read < 0) {
+        if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) return;
+        close_connection(conn, "receive failed");
+        return;
+    }
+
+    conn.parser.append_bytes(buffer, static_cast<size_t>(bytes_read));
+
+    if (!process(conn)) {
+        return;
+    }
+
+    if (conn.closing && conn.write_buffer.empty()) {
+        close_connection(conn, 0);
+    }
+}
+
+void AcceptorReactor::write_connection(AcceptorConnection& conn) {
+    while (!conn.write_buffer.empty()) {
+        const ssize_t sent = ::send(conn.fd, conn.write_buffer.data(), conn.write_buffer.size(), MSG_NOSIGNAL);
+        if (sent < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK) return;
+            if (errno == EINTR) continue;
+            close_connection(conn, "send failed");
+            return;
+        }
+        conn.write_buffer.erase(0, static_cast<size_t>(sent));
+    }
+
+    if (conn.closing) {
+        close_connection(conn, 0);
+        return;
+    }
+
+    set_events(conn);
+}
+
+void AcceptorReactor::set_events(AcceptorConnection& conn) {
+    epoll_event event;
+    std::memset(&event, 0, sizeof(event));
+    event.events = conn.write_buffer.empty() ? EPOLLIN : (EPOLLIN | EPOLLOUT);
+    event.data.fd = conn.fd;
+    ::epoll_ctl(epoll_fd, EPOLL_CTL_MOD, conn.fd, &event);
+}
+
+// Straight to the socket; what does not fit
+// waits in write_buffer for EPOLLOUT
+void AcceptorReactor::send(AcceptorConnection& conn, const std::string& msg) {
+    logf(">> [%s] %s\n", name_of(conn), utils::to_pipe_delimited(msg).c_str());
+    conn.last_send_ms = utils::get_monotonic_millis();
+    messages_out.fetch_add(1, std::memory_order_relaxed);
+
+    if (!conn.write_buffer.empty()) {
+        conn.write_buffer += msg;
+        if (conn.write_buffer.size() > max_write_buffer) {
+            logf("Error: [%s] slow consumer, dropping\n", name_of(conn));
+            conn.write_buffer.clear();
+            conn.closing = true;
+        }
+        return;
+    }
+
+    size_t offset = 0;
+    while (offset < msg.size()) {
+        const ssize_t sent = ::send(conn.fd, msg.data() + offset, msg.size() - offset, MSG_NOSIGNAL);
+        if (sent < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+
+            // Dropped after the current message
+            conn.closing = true;
+            return;
+        }
+        offset += static_cast<size_t>(sent);
+    }
+
+    if (offset < msg.size()) {
+        conn.write_buffer.assign(msg, offset, std::string::npos);
+        set_events(conn);
+    }
+}
+
+void AcceptorReactor::handle_message(AcceptorConnection& conn, const std::string& msg) {
+    logf("<< [%s] %s\n", name_of(conn), utils::to_pipe_delimited(msg).c_str());
+    messages_in.fetch_add(1, std::memory_order_relaxed);
+
+    conn.last_recv_ms = utils::get_monotonic_millis();
+    conn.test_request_sent_ms = 0;
+
+    std::string msg_type;
+    if (!utils::find_tag_value(msg, "35=", msg_type)) {
+        return;
+    }
+
+    if (!conn.session) {
+        if (msg_type != "A") {
+            reject(conn, msg, "first message must be Logon");
+            return;
+        }
+        handle_logon(conn, msg);
+        return;
+    }
+
+    AcceptorSession& session = *conn.session;
+    session.messages.fetch_add(1, std::memory_order_relaxed);
+
+    if (msg_type == "A") {
+        reject(conn, msg, "already logged on");
+        return;
+    }
+
+    std::string reply;
+    const AdminAction action = answer_admin_message(session.fix, msg_type, msg, session.outbound_seq, reply);
+
+    if (action == admin_heartbeat) {
+        send(conn, reply);
+        session.outbound_seq++;
+        return;
+    }
+
+    if (action == admin_logout) {
+        send(conn, reply);
+        session.outbound_seq++;
+        conn.closing = true;
+        return;
+    }
+
+    if (is_admin_msg_type(msg_type) || session.config.acceptor_role != "venue") {
+        return;
+    }
+
+    std::string ack;
+    if (build_order_ack(session.fix, msg_type, msg, session.outbound_seq, utils::get_utc_timestamp(),
+                        session.next_exec_id, ack)) {
+        send(conn, ack);
+        session.outbound_seq++;
+        session.next_exec_id++;
+    }
+}
+
+// Sessions are looked up at Logon; a session
+// homed on another reactor moves there right
+// after the Logon reply
+void AcceptorReactor::handle_logon(AcceptorConnection& conn, const std::string& msg) {
+    std::string sender;
+    std::string target;
+    utils::find_tag_value(msg, "49=", sender);
+    utils::find_tag_value(msg, "56=", target);
+
+    // Our SenderCompID is their TargetCompID
+    int home = index;
+    std::string error;
+    AcceptorSession* session = registry.claim(target, sender, home, error);
+    if (!session) {
+        reject(conn, msg, error);
+        return;
+    }
+
+    std::string heart_bt_int;
+    utils::find_tag_value(msg, "108=", heart_bt_int);
+    int interval = std::atoi(heart_bt_int.c_str());
+    if (interval <= 0) {
+        interval = session->config.heartbeat_interval;
+    }
+
+    std::string reset_seq_num;
+    utils::find_tag_value(msg, "141=", reset_seq_num);
+    const bool reset = (reset_seq_num == "Y");
+    if (reset) {
+        session->outbound_seq = 1;
+    }
+
+    conn.session = session;
+    conn.heartbeat_interval_ms = static_cast<uint64_t>(interval) * 1000ULL;
+    session_count++;
+
+    logf("Info: [%s] logged on from %s, reactor %d\n", session->name.c_str(), conn.peer.c_str(), home);
+
+    send(conn, session->fix.build_logon(session->outbound_seq, utils::get_utc_timestamp(), interval, reset));
+    session->outbound_seq++;
+
+    if (home != index) {
+        conn.hand_off_to = home;
+    }
+}
+
+// Logout with the reason in 58, from the
+// CompIDs the counterparty sent us
+void AcceptorReactor::reject(AcceptorConnection& conn, const std::string& msg, const std::string& reason) {
+    logf("Error: [%s] %s\n", name_of(conn), reason.c_str());
+
+    std::string begin_string;
+    std::string sender;
+    std::string target;
+    utils::find_tag_value(msg, "8=", begin_string);
+    utils::find_tag_value(msg, "49=", sender);
+    utils::find_tag_value(msg, "56=", target);
+
+    FixMessage fix;
+    fix.set_begin_string(begin_string);
+    fix.set_sender_comp_id(target);
+    fix.set_target_comp_id(sender);
+
+    send(conn, fix.build_logout(1, utils::get_utc_timestamp(), reason));
+    conn.closing = true;
+}
+
+void AcceptorReactor::check_timers(uint64_t now_ms) {
+    std::vector<int> expired;
+
+    for (std::map<int, AcceptorConnection*>::iterator it = connections.begin(); it != connections.end(); ++it) {
+        AcceptorConnection& conn = *it->second;
+        if (conn.closing) continue;
+
+        if (!conn.session) {
+            if (now_ms - conn.accepted_ms >= logon_timeout_ms) {
+                expired.push_back(conn.fd);
+            }
+            continue;
+        }
+
+        const KeepaliveAction keepalive = check_keepalive(now_ms, conn.heartbeat_interval_ms, conn.last_send_ms,
+                                                          conn.last_recv_ms, conn.test_request_sent_ms);
+        AcceptorSession& session = *conn.session;
+
+        if (keepalive == keepalive_timeout) {
+            expired.push_back(conn.fd);
+        } else if (keepalive == keepalive_test_request) {
+            char test_req_id[32];
+            std::snprintf(test_req_id, sizeof(test_req_id), "TR%d", conn.test_request_counter++);
+            send(conn, session.fix.build_test_request(session.outbound_seq, utils::get_utc_timestamp(),
+                                                      test_req_id));
+            session.outbound_seq++;
+            conn.test_request_sent_ms = now_ms;
+        } else if (keepalive == keepalive_heartbeat) {
+            send(conn, session.fix.build_heartbeat(session.outbound_seq, utils::get_utc_timestamp(), ""));
+            session.outbound_seq++;
+        }
+    }
+
+    for (size_t i = 0; i < expired.size(); ++i) {
+        AcceptorConnection& conn = *connections[expired[i]];
+        close_connection(conn, conn.session ? "TestRequest timeout" : "logon timeout");
+    }
+
+    // Sends that failed or hit
+    // the slow consumer limit
+    expired.clear();
+    for (std::map<int, AcceptorConnection*>::iterator it = connections.begin(); it != connections.end(); ++it) {
+        if (it->second->closing && it->second->write_buffer.empty()) {
+            expired.push_back(it->first);
+        }
+    }
+    for (size_t i = 0; i < expired.size(); ++i) {
+        close_connection(*connections[expired[i]], 0);
+    }
+}
+
+void AcceptorReactor::close_connection(AcceptorConnection& conn, const char* reason) {
+    if (reason) {
+        logf("Info: [%s] %s\n", name_of(conn), reason);
+    }
+    if (conn.session) {
+        registry.release(conn.session);
+        session_count--;
+    }
+
+    const int fd = conn.fd;
+    ::epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fd, 0);
+    ::close(fd);
+    connections.erase(fd);
+    connection_count--;
+    delete &conn;
+}
+
+// Logout to every session, then give the
+// sockets a second to drain
+void AcceptorReactor::logout_all() {
+    for (std::map<int, AcceptorConnection*>::iterator it = connections.begin(); it != connections.end(); ++it) {
+        AcceptorConnection& conn = *it->second;
+        if (conn.session && !conn.closing) {
+            AcceptorSession& session = *conn.session;
+            send(conn, session.fix.build_logout(session.outbound_seq, utils::get_utc_timestamp(), ""));
+            session.outbound_seq++;
+        }
+        conn.closing = true;
+    }
+
+    const uint64_t deadline_ms = utils::get_monotonic_millis() + 1000;
+    epoll_event events[max_events];
+
+    while (!connections.empty()) {
+        std::vector<int> drained;
+        for (std::map<int, AcceptorConnection*>::iterator it = connections.begin(); it != connections.end(); ++it) {
+            if (it->second->write_buffer.empty()) {
+                drained.push_back(it->first);
+            }
+        }
+        for (size_t i = 0; i < drained.size(); ++i) {
+            close_connection(*connections[drained[i]], 0);
+        }
+
+        const uint64_t now_ms = utils::get_monotonic_millis();
+        if (connections.empty() || now_ms >= deadline_ms) {
+            break;
+        }
+
+        const int count = ::epoll_wait(epoll_fd, events, max_events, static_cast<int>(deadline_ms - now_ms));
+        for (int i = 0; i < count; ++i) {
+            std::map<int, AcceptorConnection*>::iterator found = connections.find(events[i].data.fd);
+            if (found != connections.end() && (events[i].events & EPOLLOUT)) {
+                write_connection(*found->second);
+            }
+        }
+    }
+}
+
+void AcceptorReactor::logf(const char* format, ...) {
+    char line[4096];
+
+    va_list args;
+    va_start(args, format);
+    const int length = std::vsnprintf(line, sizeof(line), format, args);
+    va_end(args);
+
+    if (length <= 0) return;
+
+    // Long messages: format again
+    // straight into the buffer
+    if (static_cast<size_t>(length) >= sizeof(line)) {
+        const size_t start = log.size();
+        log.resize(start + static_cast<size_t>(length) + 1);
+
+        va_start(args, format);
+        std::vsnprintf(&log[start], static_cast<size_t>(length) + 1, format, args);
+        va_end(args);
+
+        log.resize(start + static_cast<size_t>(length));
+        return;
+    }
+
+    log.append(line, static_cast<size_t>(length));
+}
+
+// One stdio lock per loop iteration
+// instead of one per message
+void AcceptorReactor::flush_log() {
+    if (log.empty()) return;
+
+    std::fwrite(log.data(), 1, log.size(), stdout);
+    std::fflush(stdout);
+    log.clear();
+}
+
+const char* AcceptorReactor::name_of(const AcceptorConnection& conn) const {
+    return conn.session ? conn.session->name.c_str() : conn.peer.c_str();
+}
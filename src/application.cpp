@@ -5,41 +5,135 @@
 #include "fix_template.h"
 #include "token_handler.h"
 #include "utils.h"
+#include "constants.h"
 #include "fix_regression.h"
+#include "id_generator.h"
+#include "scenario_sender.h"
+#include "throttle.h"
+#include "sim_acceptor.h"
+#include "session_admin.h"
+#include "fix_acceptor.h"
+#include "order_manager.h"
+#include "market_data.h"
+#include "fix_groups.h"
 #include <cstdio>
 #include <string>
 #include <cstdint>
-#include <sys/socket.h>
-#include <sys/time.h>
 #include <errno.h>
 #include <sys/stat.h>
 #include <dirent.h>
 #include <vector>
 #include <algorithm>
 #include <fstream>
+#include <deque>
+#include <functional>
 
 const int peer_closed = 0;
 const size_t receive_buffer_size = 4096;
 const int logon_timeout_seconds = 5;
 const int receive_timeout_millis = 200;
-static bool is_running_regression = false;
 
-static bool set_socket_recv_timeout(int sock_fd, int timeout_millis) {
-    timeval tv;
-    tv.tv_sec = timeout_millis / 1000;
-    tv.tv_usec = (timeout_millis % 1000) * 1000;
+// Virtual clock start of the simulation
+// mode, 2026-01-01 00:00:00 UTC
+const uint64_t simulation_start_ns = 1767225600ULL * 1000000000ULL;
+static bool is_running_regression = false;
 
-    const int rc = ::setsockopt(sock_fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
-    return rc == 0;
-}
+// TX stamps owed are at most max_pending_tx_stamps
+// and none older than tx_stamp_timeout_ns: a
+// socket that never stamps must not grow the queue
+const size_t max_pending_tx_stamps = 1024;
+const uint64_t tx_stamp_timeout_ns = 1000000000ULL;
 
 static bool recv_timed_out() {
     return errno == EAGAIN || errno == EWOULDBLOCK;
 }
 
-static bool send_fix_message(TcpSocket& socket,
-                             const std::string& message,
-                             uint64_t& last_send_ms) {
+// nic->kernel: hardware to software RX stamp
+// kernel->parser: RX stamp to framed message
+// parser->handler: framed to handled
+// hardware_ns is the NIC clock, nic->kernel
+// only means something while phc2sys keeps
+// it on CLOCK_REALTIME. A stamp ahead of the
+// later clock read (CLOCK_REALTIME stepped
+// back) is not reported.
+static void report_rx_latency(const SocketTimestamp& stamp,
+                              uint64_t parsed_ns,
+                              uint64_t handled_ns) {
+    if (is_running_regression || stamp.software_ns == 0 || parsed_ns < stamp.software_ns ||
+        handled_ns < parsed_ns) {
+        return;
+    }
+
+    if (stamp.hardware_ns != 0 && stamp.hardware_ns <= stamp.software_ns) {
+        std::printf("   latency nic->kernel=%.1fus kernel->parser=%.1fus parser->handler=%.1fus\n",
+                    static_cast<double>(stamp.software_ns - stamp.hardware_ns) / 1000.0,
+                    static_cast<double>(parsed_ns - stamp.software_ns) / 1000.0,
+                    static_cast<double>(handled_ns - parsed_ns) / 1000.0);
+        return;
+    }
+
+    std::printf("   latency kernel->parser=%.1fus parser->handler=%.1fus\n",
+                static_cast<double>(parsed_ns - stamp.software_ns) / 1000.0,
+                static_cast<double>(handled_ns - parsed_ns) / 1000.0);
+}
+
+static void age_tx_timestamps(TxStampQueue& pending, uint64_t now_ns) {
+    while (!pending.empty() &&
+           (pending.size() > max_pending_tx_stamps || now_ns - pending.front().second > tx_stamp_timeout_ns)) {
+        pending.pop_front();
+    }
+}
+
+// handler->wire: send call to kernel TX stamp
+// handler->nic: send call to NIC TX stamp, the
+// second stamp of a send when the NIC stamps
+static void drain_tx_timestamps(Transport& socket, SessionContext& session) {
+    if (!session.tx_stamps) {
+        return;
+    }
+    TxStampQueue& pending_tx_stamps = *session.tx_stamps;
+    if (!socket.is_timestamping()) {
+        pending_tx_stamps.clear();
+        return;
+    }
+
+    uint32_t tx_key = 0;
+    SocketTimestamp stamp;
+    while (socket.read_tx_timestamp(tx_key, stamp)) {
+        while (!pending_tx_stamps.empty()) {
+            const std::pair<uint32_t, uint64_t> pending = pending_tx_stamps.front();
+
+            // Stamps for earlier sends
+            // never arrived
+            if (static_cast<int32_t>(pending.first - tx_key) < 0) {
+                pending_tx_stamps.pop_front();
+                continue;
+            }
+
+            if (pending.first == tx_key) {
+                const bool from_nic = stamp.hardware_ns != 0;
+                if (from_nic || !socket.is_hardware_timestamping()) {
+                    pending_tx_stamps.pop_front();
+                }
+
+                const uint64_t wire_ns = from_nic ? stamp.hardware_ns : stamp.software_ns;
+                if (!is_running_regression && wire_ns >= pending.second) {
+                    std::printf("   latency handler->%s=%.1fus\n", from_nic ? "nic" : "wire",
+                                static_cast<double>(wire_ns - pending.second) / 1000.0);
+                }
+            }
+            break;
+        }
+    }
+    age_tx_timestamps(pending_tx_stamps, utils::get_realtime_nanos());
+}
+
+// Business messages, already
+// released by the throttle
+static bool send_business_message(Transport& socket,
+                                  SessionContext& session,
+                                  const std::string& message,
+                                  uint64_t& last_send_ms) {
     if (message.empty()) {
         return false;
     }
@@ -48,15 +142,168 @@ static bool send_fix_message(TcpSocket& socket,
         std::printf(">> %s\n", utils::to_pipe_delimited(message).c_str());
     }
 
+    const uint64_t handler_ns = socket.is_timestamping() ? utils::get_realtime_nanos() : 0;
+
     if (!socket.send_bytes(message)) {
         return false;
     }
 
+    if (socket.is_timestamping() && session.tx_stamps) {
+        session.tx_stamps->push_back(std::make_pair(socket.last_tx_key(), handler_ns));
+        age_tx_timestamps(*session.tx_stamps, handler_ns);
+    }
+
     last_send_ms = utils::get_monotonic_millis();
     return true;
 }
 
-static bool process_inbound_message(TcpSocket& socket,
+// Session-level (admin) messages,
+// bypass the throttle queue
+static bool send_fix_message(Transport& socket,
+                             SessionContext& session,
+                             const std::string& message,
+                             uint64_t& last_send_ms) {
+    if (session.throttle) {
+        session.throttle->on_admin_sent();
+    }
+    return send_business_message(socket, session, message, last_send_ms);
+}
+
+// Business messages built outside the queue
+// (market data and security requests), wait
+// for their tokens like a regression step
+static bool send_throttled_message(Transport& socket,
+                                   SessionContext& session,
+                                   const std::string& message,
+                                   uint64_t& last_send_ms) {
+    std::string msg_type;
+    if (session.throttle && utils::find_tag_value(message, "35=", msg_type)) {
+        session.throttle->acquire(msg_type);
+    }
+    return send_business_message(socket, session, message, last_send_ms);
+}
+
+static void report_throttle_metrics(const OutboundThrottle& throttle) {
+    if (!throttle.enabled()) {
+        return;
+    }
+
+    const ThrottleMetrics& metrics = throttle.metrics();
+    std::printf("Info: throttle sent=%llu max_queue_depth=%llu wait_total=%llums wait_max=%llums\n",
+                static_cast<unsigned long long>(metrics.sent),
+                static_cast<unsigned long long>(metrics.max_depth),
+                static_cast<unsigned long long>(metrics.total_wait_ms),
+                static_cast<unsigned long long>(metrics.max_wait_ms));
+}
+
+static void report_order_counts(const OrderManager& orders) {
+    const OrderCounts& counts = orders.counts();
+    if (counts.live + counts.filled + counts.canceled + counts.rejected + counts.expired == 0) {
+        return;
+    }
+
+    std::printf("Info: orders live=%llu filled=%llu canceled=%llu rejected=%llu expired=%llu "
+                "replaced=%llu cancel_rejects=%llu unsolicited=%llu\n",
+                static_cast<unsigned long long>(counts.live),
+                static_cast<unsigned long long>(counts.filled),
+                static_cast<unsigned long long>(counts.canceled),
+                static_cast<unsigned long long>(counts.rejected),
+                static_cast<unsigned long long>(counts.expired),
+                static_cast<unsigned long long>(counts.replaced),
+                static_cast<unsigned long long>(counts.cancel_rejects),
+                static_cast<unsigned long long>(counts.unsolicited));
+}
+
+// md_symbols=AAA,BBB
+static std::vector<std::string> split_symbols(const std::string& list) {
+    std::vector<std::string> symbols;
+    size_t pos = 0;
+    while (pos < list.size()) {
+        size_t end = list.find(',', pos);
+        if (end == std::string::npos) end = list.size();
+
+        const std::string item = utils::trim(list.substr(pos, end - pos));
+        pos = end + 1;
+        if (!item.empty()) symbols.push_back(item);
+    }
+    return symbols;
+}
+
+// Oversized messages skip the business path,
+// only their summary is logged
+static void report_streamed_message(const FixStreamSummary& summary) {
+    std::printf("Info: streamed 35=%s of %zu bytes, %llu entries, checksum %s\n",
+                summary.msg_type.c_str(), summary.body_length,
+                static_cast<unsigned long long>(summary.entries),
+                (summary.checksum_ok && summary.length_ok) ? "ok" : "bad");
+}
+
+// Saved once the startup fetch is answered
+// and at exit, not on every SecurityStatus
+static void save_instruments(InstrumentCache& instruments) {
+    if (!instruments.is_open() || !instruments.is_dirty()) {
+        return;
+    }
+
+    std::string error;
+    if (instruments.save(error)) {
+        std::printf("Info: instrument cache saved, %zu symbols\n", instruments.size());
+    } else {
+        std::printf("Warning: instrument cache: %s\n", error.c_str());
+    }
+}
+
+static void finish_streamed_message(InstrumentCache* instruments, const FixStreamSummary& summary) {
+    report_streamed_message(summary);
+    if (instruments->on_stream_end(summary)) {
+        std::printf("Info: instruments updated=%zu total=%zu\n", instruments->last_changes(), instruments->size());
+    }
+}
+
+static void report_market_data(const MarketDataBooks& books) {
+    const MarketDataCounts& counts = books.counts();
+    if (counts.snapshots + counts.incrementals == 0) {
+        return;
+    }
+
+    std::printf("Info: market data snapshots=%llu incrementals=%llu entries=%llu gaps=%llu "
+                "duplicates=%llu skipped=%llu\n",
+                static_cast<unsigned long long>(counts.snapshots),
+                static_cast<unsigned long long>(counts.incrementals),
+                static_cast<unsigned long long>(counts.entries),
+                static_cast<unsigned long long>(counts.gaps),
+                static_cast<unsigned long long>(counts.duplicates),
+                static_cast<unsigned long long>(counts.skipped));
+
+    for (size_t i = 0; i < books.books().size(); ++i) {
+        const MarketDataBook& book = *books.books()[i];
+        const BookLevel* bid = book.bids.level(0);
+        const BookLevel* offer = book.offers.level(0);
+        std::printf("Info: book %s levels=%zu/%zu bid=%s x %s offer=%s x %s%s\n",
+                    book.symbol.c_str(), book.bids.depth(), book.offers.depth(),
+                    bid ? fix_decimal_to_string(bid->size).c_str() : "-",
+                    bid ? fix_decimal_to_string(bid->price).c_str() : "-",
+                    offer ? fix_decimal_to_string(offer->price).c_str() : "-",
+                    offer ? fix_decimal_to_string(offer->size).c_str() : "-",
+                    book.stale ? " stale" : "");
+    }
+}
+
+// MsgSeqNum(34)/SendingTime(52) at release,
+// queued messages may go out of read order
+static void stamp_header(FixMessage::FieldList& fields, int msg_seq_num) {
+    const std::string now_utc = utils::get_utc_timestamp();
+    for (size_t i = 0; i < fields.size(); ++i) {
+        if (fields[i].first == fix_tag_msg_seq_num) {
+            fields[i].second = std::to_string(msg_seq_num);
+        } else if (fields[i].first == fix_tag_sending_time) {
+            fields[i].second = now_utc;
+        }
+    }
+}
+
+static bool process_inbound_message(Transport& socket,
+                                    SessionContext& session,
                                     FixMessage& fix,
                                     int& outbound_seq,
                                     uint64_t& last_send_ms,
@@ -67,7 +314,9 @@ static bool process_inbound_message(TcpSocket& socket,
                                     bool& scenario_response_started,
                                     uint64_t& last_scenario_response_ms,
                                     bool& logout_initiated,
-                                    const std::string& token_path) {
+                                    const std::string& token_path,
+                                    bool& rejected) {
+    rejected = false;
 
     if (!is_running_regression) {
         std::printf("<< %s\n", utils::to_pipe_delimited(inbound_message).c_str());
@@ -87,26 +336,42 @@ static bool process_inbound_message(TcpSocket& socket,
     // Initiate Logout Handsake
     // after scenario finished
     if (scenarios_sent && !logout_initiated) {
-        const bool is_admin_msg =
-            (msg_type == "0" || msg_type == "1" || msg_type == "2" ||
-             msg_type == "4" || msg_type == "A" || msg_type == "5");
-
-        if (scenarios_sent && !is_admin_msg) {
+        if (scenarios_sent && !is_admin_msg_type(msg_type)) {
             scenario_response_started = true;
             last_scenario_response_ms = utils::get_monotonic_millis();
         }
     }
 
-    // TestRequest (35=1) -> Heartbeat (35=0) with same 112 (if present)
-    if (msg_type == "1") {
-        std::string test_req_id;
-        utils::find_tag_value(inbound_message, "112=", test_req_id);
+    // Business messages only, the session
+    // layer below answers admin ones
+    FixValidationError invalid;
+    if (session.validator && !is_admin_msg_type(msg_type) &&
+        !session.validator->validate(inbound_message, invalid)) {
+        const bool reject = session.validation == validation_reject;
+        std::printf("%s: 35=%s seq %d failed validation: %s\n", reject ? "Error" : "Warning",
+                    msg_type.c_str(), invalid.ref_seq_num, invalid.text.c_str());
+
+        if (reject) {
+            rejected = true;
+            const std::string reject_message = fix.build_reject(outbound_seq, utils::get_utc_timestamp(),
+                                                                invalid.ref_seq_num, invalid.ref_tag,
+                                                                invalid.ref_msg_type, invalid.reason,
+                                                                invalid.text);
+            if (!send_fix_message(socket, session, reject_message, last_send_ms)) {
+                return false;
+            }
+
+            outbound_seq++;
+            save_token(token_path, outbound_seq);
+            return true;
+        }
+    }
 
-        const std::string heartbeat = fix.build_heartbeat(outbound_seq,
-                                                          utils::get_utc_timestamp(),
-                                                          test_req_id);
+    std::string reply;
+    const AdminAction action = answer_admin_message(fix, msg_type, inbound_message, outbound_seq, reply);
 
-        if (!send_fix_message(socket, heartbeat, last_send_ms)) {
+    if (action == admin_heartbeat) {
+        if (!send_fix_message(socket, session, reply, last_send_ms)) {
             return false;
         }
 
@@ -115,14 +380,9 @@ static bool process_inbound_message(TcpSocket& socket,
         return true;
     }
 
-    // Logout (35=5) -> reply Logout and stop
-    if (msg_type == "5") {
+    if (action == admin_logout) {
         if (!logout_initiated) {
-            const std::string logout = fix.build_logout(outbound_seq,
-                                                    utils::get_utc_timestamp(),
-                                                    "");
-
-            send_fix_message(socket, logout, last_send_ms);
+            send_fix_message(socket, session, reply, last_send_ms);
             outbound_seq++;
             save_token(token_path, outbound_seq);
         }
@@ -134,126 +394,8 @@ static bool process_inbound_message(TcpSocket& socket,
     return true;
 }
 
-// load custom
-// RAW FIX messages
-// from template file
-static bool run_scenarios(TcpSocket& socket, FixMessage& fix,
-                          const SessionConfig& config,
-                          const std::string& scenario_path, int& outbound_seq,
-                          uint64_t& last_send_ms, bool& scenarios_sent,
-                          const std::string& token_path) {
-
-    scenarios_sent = false;
-    std::vector<std::string> files;
-
-    DIR* dir = ::opendir(scenario_path.c_str());
-    if (dir) {
-        dirent* entry = 0;
-        while ((entry = ::readdir(dir)) != 0) {
-            const std::string name(entry->d_name);
-            if (name == "." || name == "..") {
-                continue;
-            }
-
-            // Ignore hidden files and folder
-            if (!name.empty() && name[0] == '.') {
-                continue;
-            }
-
-            files.push_back(scenario_path + "/" + name);
-        }
-
-        ::closedir(dir);
-        std::sort(files.begin(), files.end());
-    } else {
-        files.push_back(scenario_path);
-    }
-
-    for (size_t i = 0; i < files.size(); i++) {
-        const std::string& file_path = files[i];
-
-        std::ifstream in(file_path.c_str());
-        if (!in.is_open()) {
-            continue;
-        }
-
-        FixTemplateRuntime runtime;
-        runtime.begin_string = config.begin_string;
-        runtime.sender_comp_id = config.sender_comp_id;
-        runtime.target_comp_id = config.target_comp_id;
-        runtime.msg_seq_num = 0;
-        runtime.sending_time_utc.clear();
-        runtime.state.org_clord_id.clear();
-
-        std::string line;
-        while (std::getline(in, line)) {
-            line = utils::trim(line);
-            if (line.empty() || line[0] == '#') {
-                continue;
-            }
-
-            FixTemplateMessage template_message;
-            template_message.msg_type.clear();
-            template_message.fields.clear();
-
-            // Parse RAW messages
-            size_t pos = 0;
-            while (pos < line.size()) {
-                size_t end = line.find('|', pos);
-                if (end == std::string::npos) {
-                    end = line.size();
-                }
-
-                const std::string field_text = line.substr(pos, end - pos);
-                pos = (end < line.size()) ? (end + 1) : end;
-
-                if (field_text.empty()) {
-                    continue;
-                }
-
-                const size_t eq = field_text.find('=');
-                if (eq == std::string::npos) {
-                    continue;
-                }
-
-                const std::string tag_text = field_text.substr(0, eq);
-                const std::string value_text = field_text.substr(eq + 1);
-
-                const int tag_value = std::atoi(tag_text.c_str());
-                if (tag_value <= 0) {
-                    continue;
-                }
-
-                template_message.fields.push_back(std::make_pair(tag_value, value_text));
-                if (tag_value == 35 && template_message.msg_type.empty()) {
-                    template_message.msg_type = value_text;
-                }
-            }
-
-            if (template_message.fields.empty()) {
-                continue;
-            }
-
-            runtime.msg_seq_num = outbound_seq;
-            runtime.sending_time_utc = utils::get_utc_timestamp();
-
-            fix_template_apply(runtime, template_message);
-            const std::string raw_fix = fix.build_from_fields(template_message.fields);
-
-            if (!send_fix_message(socket, raw_fix, last_send_ms)) {
-                return false;
-            }
-
-            scenarios_sent = true;
-            outbound_seq++;
-            save_token(token_path, outbound_seq);
-        }
-    }
-
-    return true;
-}
-
-bool read_next_business_message(TcpSocket& socket,
+bool read_next_business_message(Transport& socket,
+                               SessionContext& session,
                                FixParser& fix_parser,
                                FixMessage& fix,
                                int& outbound_seq,
@@ -276,12 +418,13 @@ bool read_next_business_message(TcpSocket& socket,
 
         // Drain already-buffered messages
         std::string inbound_message;
+        bool rejected = false;
         while (fix_parser.read_next_message(inbound_message)) {
-            if (!process_inbound_message(socket, fix, outbound_seq, last_send_ms,
+            if (!process_inbound_message(socket, session, fix, outbound_seq, last_send_ms,
                                          inbound_message, logon_accepted, stop_requested,
                                          scenarios_sent, scenario_response_started,
                                          last_scenario_response_ms, logout_initiated,
-                                         token_path)) {
+                                         token_path, rejected)) {
                 return false;
             }
 
@@ -290,16 +433,16 @@ bool read_next_business_message(TcpSocket& socket,
                 return true;
             }
 
+            if (rejected) {
+                continue;
+            }
+
             std::string msg_type;
             if (!utils::find_tag_value(inbound_message, "35=", msg_type)) {
                 continue;
             }
 
-            const bool is_admin_msg =
-                (msg_type == "0" || msg_type == "1" || msg_type == "2" ||
-                 msg_type == "4" || msg_type == "A" || msg_type == "5");
-
-            if (!is_admin_msg) {
+            if (!is_admin_msg_type(msg_type)) {
                 out_message = inbound_message;
                 return true;
             }
@@ -319,7 +462,8 @@ bool read_next_business_message(TcpSocket& socket,
             return false;
         }
 
-        fix_parser.append_bytes(receive_buffer, static_cast<size_t>(bytes_received));
+        fix_parser.append_bytes(receive_buffer, static_cast<size_t>(bytes_received),
+                                socket.last_rx_timestamp());
     }
 
     return true;
@@ -336,26 +480,173 @@ int Application::run(const AppArgs& args) {
         return 1;
     }
 
-    if (!socket.connect(config.host, config.port)) {
+    if (config.connection_type == "acceptor") {
+        if (args.is_test_mode || args.is_simulation) {
+            std::printf("Error: -u/-S need connection_type=initiator\n");
+            return 1;
+        }
+
+        FixAcceptor acceptor;
+        return acceptor.run(config, config_parser.get_sessions());
+    }
+    if (config.connection_type != "initiator") {
+        std::printf("Error: connection_type must be initiator or acceptor\n");
+        return 1;
+    }
+
+    if (!throttle.configure(config)) {
+        std::printf("Error: invalid throttle_session/throttle_msg_types in config\n");
+        return 1;
+    }
+    SessionContext session;
+    session.throttle = throttle.enabled() ? &throttle : 0;
+    tx_stamps.clear();
+    session.tx_stamps = &tx_stamps;
+
+    if (!parse_validation_mode(config.validation, session.validation)) {
+        std::printf("Error: validation must be off, warn or reject in config\n");
+        return 1;
+    }
+    if (session.validation != validation_off) {
+        std::string error;
+        if (!validator.load(config.data_dictionary, error)) {
+            std::printf("Error: data_dictionary %s: %s\n", config.data_dictionary.c_str(), error.c_str());
+            return 1;
+        }
+        session.validator = &validator;
+    }
+
+    // Security master mapped from the last run,
+    // fetched after the Logon when missing
+    if (!config.instrument_cache.empty()) {
+        if (config.instrument_fetch != "missing" && config.instrument_fetch != "always" &&
+            config.instrument_fetch != "never") {
+            std::printf("Error: instrument_fetch must be missing, always or never in config\n");
+            return 1;
+        }
+
+        std::string error;
+        if (!instruments.load_dictionary(config.data_dictionary, error)) {
+            std::printf("Error: data_dictionary %s: %s\n", config.data_dictionary.c_str(), error.c_str());
+            return 1;
+        }
+        if (instruments.open(config.instrument_cache, error)) {
+            std::printf("Info: instrument cache %s, %zu symbols\n", config.instrument_cache.c_str(), instruments.size());
+        } else {
+            std::printf("Info: instrument cache %s: %s, starting empty\n", config.instrument_cache.c_str(), error.c_str());
+        }
+    }
+
+    // encoding=sbe: order entry as SOFH framed
+    // SBE, translated by sbe_transport
+    const bool use_sbe = config.encoding == "sbe";
+    if (config.encoding != "fix" && !use_sbe) {
+        std::printf("Error: encoding must be fix or sbe in config\n");
+        return 1;
+    }
+    if (use_sbe) {
+        if (args.is_simulation) {
+            std::printf("Error: encoding=sbe needs a venue, the -S acceptor speaks tag=value\n");
+            return 1;
+        }
+        if (!config.md_symbols.empty() || !config.instrument_cache.empty()) {
+            std::printf("Error: encoding=sbe is order entry only, md_symbols/instrument_cache need encoding=fix\n");
+            return 1;
+        }
+
+        std::string error;
+        if (!sbe_schema.load(config.sbe_schema, error) ||
+            !SbeTransport::session_layouts(sbe_schema, error)) {
+            std::printf("Error: sbe_schema %s: %s\n", config.sbe_schema.c_str(), error.c_str());
+            return 1;
+        }
+        std::printf("Info: SBE schema %s, id %u version %u, %zu messages\n", config.sbe_schema.c_str(),
+                    static_cast<unsigned>(sbe_schema.id()), static_cast<unsigned>(sbe_schema.version()),
+                    sbe_schema.messages().size());
+    }
+
+    // host=unix:<path>, host=inproc and
+    // host=inproc:<name> pick the other
+    // transports, -S is inproc on the
+    // virtual clock
+    std::string address;
+    const TransportKind transport = args.is_simulation
+        ? transport_inproc : parse_transport_host(config.host, address);
+    Transport& wire = (transport == transport_inproc) ? static_cast<Transport&>(loopback)
+                    : (transport == transport_pipe) ? static_cast<Transport&>(pipe_end)
+                    : static_cast<Transport&>(stream_socket);
+
+    // Simulation: nothing persisted under tokens/
+    SimAcceptor sim_acceptor(config);
+    if (args.is_simulation) {
+        utils::use_virtual_clock(simulation_start_ns);
+    }
+
+    bool connected = false;
+    switch (transport) {
+        case transport_tcp:
+            connected = stream_socket.connect(address, config.port);
+            break;
+        case transport_unix:
+            connected = stream_socket.connect_unix(address);
+            break;
+        case transport_inproc:
+            connected = loopback.connect(sim_acceptor);
+            break;
+        case transport_pipe: {
+            InprocPipe* pipe = inproc_find(address);
+            if (!pipe) {
+                std::printf("Error: no in-process pipe named %s\n", address.c_str());
+            }
+            connected = pipe && pipe_end.connect(*pipe, InprocEndpoint::client_side);
+            break;
+        }
+    }
+
+    if (!connected) {
         std::printf("Error: Connection failed\n");
         return 1;
     }
 
-    std::printf("Info: Connected to %s:%d\n", config.host.c_str(), config.port);
+    if (transport == transport_tcp) {
+        std::printf("Info: Connected to %s:%d\n", address.c_str(), config.port);
+    } else if (transport == transport_unix) {
+        std::printf("Info: Connected to unix:%s\n", address.c_str());
+    } else if (transport == transport_pipe) {
+        std::printf("Info: Connected to inproc:%s\n", address.c_str());
+    } else {
+        std::printf("Info: Connected to the in-process acceptor%s\n",
+                    args.is_simulation ? " (virtual clock)" : "");
+    }
 
-    const int sock_fd = socket.get_fd();
-    if (sock_fd < 0) {
+    // Everything below talks tag=value
+    if (use_sbe && !sbe_transport.connect(wire, sbe_schema, config)) {
+        wire.close();
+        return 1;
+    }
+    Transport& socket = use_sbe ? static_cast<Transport&>(sbe_transport) : wire;
+
+    if (!socket.is_open()) {
         std::printf("Error: invalid socket\n");
         socket.close();
         return 1;
     }
 
-    if (!set_socket_recv_timeout(sock_fd, receive_timeout_millis)) {
+    if (!socket.set_receive_timeout(receive_timeout_millis)) {
         std::printf("Error: failed to set SO_RCVTIMEO\n");
         socket.close();
         return 1;
     }
 
+    if ((transport == transport_tcp || transport == transport_unix) &&
+        (config.timestamping == "software" || config.timestamping == "hardware")) {
+        if (!socket.enable_timestamping(config.timestamping == "hardware")) {
+            std::printf("Error: failed to set SO_TIMESTAMPING\n");
+            socket.close();
+            return 1;
+        }
+    }
+
     FixMessage fix;
     fix.set_begin_string(config.begin_string);
     fix.set_sender_comp_id(config.sender_comp_id);
@@ -363,6 +654,23 @@ int Application::run(const AppArgs& args) {
 
     FixParser fix_parser;
 
+    // Messages over the parser's 1MB cap (a full
+    // SecurityList) are decoded as they arrive,
+    // by group when a dictionary is loaded
+    const FixDictionary* stream_dictionary = session.validator ? &validator.get_dictionary()
+        : instruments.is_open() ? &instruments.get_dictionary() : 0;
+    FixStreamDecoder oversize_decoder(stream_dictionary);
+    if (instruments.is_open()) {
+        using std::placeholders::_1;
+        using std::placeholders::_2;
+        oversize_decoder.on_field(std::bind(&InstrumentCache::on_stream_field, &instruments, _1, _2));
+        oversize_decoder.on_entry(std::bind(&InstrumentCache::on_stream_entry, &instruments, _1, _2));
+        oversize_decoder.on_end(std::bind(finish_streamed_message, &instruments, _1));
+    } else {
+        oversize_decoder.on_end(report_streamed_message);
+    }
+    fix_parser.set_oversize_decoder(&oversize_decoder);
+
     const uint64_t heartbeat_interval_ms =
         static_cast<uint64_t>(config.heartbeat_interval) * 1000ULL;
 
@@ -380,7 +688,8 @@ int Application::run(const AppArgs& args) {
     const std::string now_utc = utils::get_utc_timestamp();
     std::string token_path;
 
-    if (!read_token("tokens",
+    if (!args.is_simulation &&
+        !read_token("tokens",
                     config.sender_comp_id,
                     now_utc,
                     config.reset_on_logon,
@@ -392,6 +701,23 @@ int Application::run(const AppArgs& args) {
         return 1;
     }
 
+    // ClOrdID/CrossID prefix unique
+    // across restarts
+    uint32_t id_epoch = 0;
+    if (!args.is_simulation && !next_id_epoch("tokens", config.sender_comp_id, id_epoch)) {
+        std::printf("ERROR: ID epoch read failed\n");
+        socket.close();
+        return 1;
+    }
+
+    IdGenerator id_generator;
+    if (!id_generator.init(id_epoch)) {
+        std::printf("ERROR: ID epoch %u of %s is past %u, ClOrdIDs would repeat earlier runs\n",
+                    id_epoch, config.sender_comp_id.c_str(), IdGenerator::max_epoch(IdGenerator::base36));
+        socket.close();
+        return 1;
+    }
+
     //scenario logout state
     bool scenarios_sent = false;
     bool logout_initiated = false;
@@ -408,6 +734,10 @@ int Application::run(const AppArgs& args) {
     uint64_t scenario_sent_ms = 0;
     const uint64_t scenario_first_response_timeout_ms = 5000ULL;
 
+    // Scenarios wait this long for the
+    // security master fetch
+    const uint64_t instrument_fetch_timeout_ms = 10000ULL;
+
     char receive_buffer[receive_buffer_size];
 
     // Send Logon
@@ -416,7 +746,7 @@ int Application::run(const AppArgs& args) {
                                               config.heartbeat_interval,
                                               config.reset_on_logon);
 
-    if (!send_fix_message(socket, logon, last_send_ms)) {
+    if (!send_fix_message(socket, session, logon, last_send_ms)) {
         socket.close();
         return 1;
     }
@@ -459,16 +789,18 @@ int Application::run(const AppArgs& args) {
         last_recv_ms = utils::get_monotonic_millis();
         test_request_sent_ms = 0;
 
-        fix_parser.append_bytes(receive_buffer, static_cast<size_t>(bytes_received));
+        fix_parser.append_bytes(receive_buffer, static_cast<size_t>(bytes_received),
+                                socket.last_rx_timestamp());
 
         std::string inbound_message;
         while (fix_parser.read_next_message(inbound_message)) {
             bool stop_requested = false;
+            bool rejected = false;
 
-            if (!process_inbound_message(socket, fix, outbound_seq, last_send_ms,
+            if (!process_inbound_message(socket, session, fix, outbound_seq, last_send_ms,
                                          inbound_message, logon_accepted, stop_requested,
                                          scenarios_sent, scenario_response_started, last_scenario_response_ms,
-                                         logout_initiated, token_path)) {
+                                         logout_initiated, token_path, rejected)) {
                 socket.close();
                 return 1;
             }
@@ -489,13 +821,39 @@ int Application::run(const AppArgs& args) {
     if (args.is_test_mode) {
         is_running_regression = true;
 
-        if (!run_fix_regression(socket, fix_parser, fix,
-                                args.scenario_path,
-                                outbound_seq, last_send_ms, token_path,
-                                logon_accepted, scenarios_sent,
-                                scenario_response_started, last_scenario_response_ms,
-                                logout_initiated)) {
+        const std::vector<std::string> files = args.scenario_files.empty()
+            ? list_regression_files(args.scenario_path)
+            : args.scenario_files;
+
+        RegressionOptions options;
+        options.max_jobs = args.regression_jobs;
+        options.verbose = args.is_verbose;
+        options.rerun = args.regression_rerun;
+        options.config_hash = regression_config_hash(config);
+        if (args.is_simulation) {
+            options.config_hash = regression_hash(options.config_hash, "simulation");
+        }
+        if (use_sbe) {
+            options.config_hash = regression_hash(options.config_hash, "sbe:" + config.sbe_schema);
+        }
+        options.baseline_path = args.baseline_path;
+        options.baseline_threshold_pct = args.baseline_threshold_pct;
+
+        RegressionSummary summary;
+        const bool regression_ok = run_fix_regression(socket, session, fix_parser, fix,
+                                                      files,
+                                                      outbound_seq, last_send_ms, token_path,
+                                                      logon_accepted, scenarios_sent,
+                                                      scenario_response_started, last_scenario_response_ms,
+                                                      logout_initiated, id_generator, throttle,
+                                                      options, summary);
+
+        if (!args.shard_summary_path.empty() &&
+            !save_regression_summary(args.shard_summary_path, summary)) {
+            std::printf("Error: cannot write %s\n", args.shard_summary_path.c_str());
+        }
 
+        if (!regression_ok) {
             is_running_regression = false;
             socket.close();
             return 1;
@@ -503,29 +861,167 @@ int Application::run(const AppArgs& args) {
 
         is_running_regression = false;
     }
-    else { 
-        if (!run_scenarios(socket, fix, config,
-                         args.scenario_path, outbound_seq,
-                         last_send_ms, scenarios_sent, token_path)) {
+
+    // RAW scenarios are sent from the main
+    // loop through the in-flight window
+    ScenarioSender scenario_sender(config, id_generator);
+    if (!args.is_test_mode) {
+        scenario_sender.open(args.scenario_path);
+    }
+
+    // Order state by ClOrdID for
+    // what the RAW scenarios send
+    OrderManager orders;
+
+    // Books from the 35=W/X answering the
+    // subscription, a RptSeq gap asks for
+    // a fresh snapshot of that symbol
+    MarketDataBooks books;
+    const std::vector<std::string> md_symbols = split_symbols(config.md_symbols);
+    int md_request_counter = 1;
+    if (!args.is_test_mode && !md_symbols.empty()) {
+        const std::string md_request = build_market_data_request(fix, outbound_seq, utils::get_utc_timestamp(),
+                                                                 "MD" + std::to_string(md_request_counter++),
+                                                                 '1', config.md_depth, md_symbols);
+        if (!send_throttled_message(socket, session, md_request, last_send_ms)) {
             socket.close();
             return 1;
         }
+
+        outbound_seq++;
+        save_token(token_path, outbound_seq);
     }
 
-    scenario_sent_ms = utils::get_monotonic_millis();
+    // Security master: the whole list when the
+    // cache is empty (or always), else a 35=c per
+    // configured symbol it lacks. Scenarios are
+    // held until the answers are in.
+    bool instruments_fetching = false;
+    const uint64_t instrument_fetch_ms = utils::get_monotonic_millis();
+    if (instruments.is_open()) {
+        scenario_sender.set_instruments(&instruments);
+    }
+    if (!args.is_test_mode && instruments.is_open() && config.instrument_fetch != "never") {
+        const FixTypedHeader typed_header(fix);
+        std::vector<std::string> requests;
+        if (config.instrument_fetch == "always" || instruments.size() == 0) {
+            requests.push_back(instruments.request_list(typed_header, outbound_seq, utils::get_utc_timestamp()));
+        } else {
+            const std::vector<std::string> symbols = split_symbols(config.instrument_symbols);
+            for (size_t i = 0; i < symbols.size(); ++i) {
+                if (!instruments.find(symbols[i])) {
+                    const int msg_seq_num = outbound_seq + static_cast<int>(requests.size());
+                    requests.push_back(instruments.request_definition(typed_header, msg_seq_num,
+                                                                      utils::get_utc_timestamp(), symbols[i]));
+                }
+            }
+        }
+
+        for (size_t i = 0; i < requests.size(); ++i) {
+            if (!send_throttled_message(socket, session, requests[i], last_send_ms)) {
+                socket.close();
+                return 1;
+            }
+
+            outbound_seq++;
+            save_token(token_path, outbound_seq);
+        }
+        instruments_fetching = instruments.awaiting();
+    }
+
+    if (args.is_test_mode) {
+        scenario_sent_ms = utils::get_monotonic_millis();
+    }
 
     // Main loop: keepalive + admin message handling
     logon_accepted = true;
     while (true) {
         const uint64_t now_ms = utils::get_monotonic_millis();
 
+        if (instruments_fetching && !instruments.awaiting()) {
+            std::printf("Info: instrument fetch complete, %zu symbols\n", instruments.size());
+            save_instruments(instruments);
+            instruments_fetching = false;
+        }
+        else if (instruments_fetching && now_ms - instrument_fetch_ms >= instrument_fetch_timeout_ms) {
+            std::printf("Warning: instrument fetch timed out, %zu symbols\n", instruments.size());
+            instruments.forget_requests();
+            instruments_fetching = false;
+        }
+
+        // Queue scenario lines while the in-flight
+        // window has room, send what the throttle
+        // releases
+        if (!args.is_test_mode && !logout_initiated && !instruments_fetching) {
+            while (scenario_sender.can_send()) {
+                FixTemplateMessage template_message;
+                if (scenario_sender.next_message(template_message)) {
+                    throttle.enqueue(template_message.msg_type, template_message.fields);
+                }
+            }
+
+            bool send_failed = false;
+            OutboundThrottle::Pending released;
+            while (throttle.pop_ready(released)) {
+                stamp_header(released.fields, outbound_seq);
+                const std::string raw_fix = fix.build_from_fields(released.fields);
+
+                if (!send_business_message(socket, session, raw_fix, last_send_ms)) {
+                    send_failed = true;
+                    break;
+                }
+
+                scenario_sender.on_sent(released.fields, outbound_seq);
+                orders.on_outbound(raw_fix);
+                if (!scenarios_sent) {
+                    scenario_sent_ms = utils::get_monotonic_millis();
+                }
+                scenarios_sent = true;
+                outbound_seq++;
+                save_token(token_path, outbound_seq);
+            }
+
+            if (send_failed) {
+                break;
+            }
+
+            // No lines at all keeps the
+            // session up as before
+            bool scenarios_done = false;
+            if (scenarios_sent && throttle.depth() == 0 && scenario_sender.finished()) {
+                std::printf("Info: scenarios complete, sent=%zu acked=%zu in %llums\n",
+                            scenario_sender.sent_count(), scenario_sender.acked_count(),
+                            static_cast<unsigned long long>(utils::get_monotonic_millis() - scenario_sent_ms));
+                scenarios_done = true;
+            }
+            else if (scenarios_sent && scenario_sender.in_flight() > 0 &&
+                     utils::get_monotonic_millis() - scenario_sender.last_progress_ms() >=
+                         scenario_first_response_timeout_ms) {
+                std::printf("Error: scenarios stalled, %zu order(s) not acknowledged\n",
+                            scenario_sender.in_flight());
+                scenarios_done = true;
+            }
+
+            if (scenarios_done) {
+                const std::string logout = fix.build_logout(outbound_seq, utils::get_utc_timestamp(), "");
+                if (!send_fix_message(socket, session, logout, last_send_ms)) {
+                    break;
+                }
+
+                outbound_seq++;
+                save_token(token_path, outbound_seq);
+                logout_initiated = true;
+                logout_start_ms = now_ms;
+            }
+        }
+
         // If no business response at all 
-        // after sending scenarios
-        // logout
-        if (!logout_initiated && scenarios_sent && !scenario_response_started) {
-            if (now_ms - scenario_sent_ms >= scenario_first_response_timeout_ms) {
+        // after sending scenarios, or nothing
+        // sent (all results cached), logout
+        if (args.is_test_mode && !logout_initiated && !scenario_response_started) {
+            if (!scenarios_sent || now_ms - scenario_sent_ms >= scenario_first_response_timeout_ms) {
                 const std::string logout = fix.build_logout(outbound_seq, utils::get_utc_timestamp(), "");
-                if (!send_fix_message(socket, logout, last_send_ms)) {
+                if (!send_fix_message(socket, session, logout, last_send_ms)) {
                     break;
                 }
 
@@ -538,11 +1034,11 @@ int Application::run(const AppArgs& args) {
 
         // Check if there is no response
         // initate logout
-        if (!logout_initiated && scenarios_sent && scenario_response_started) {
+        if (args.is_test_mode && !logout_initiated && scenarios_sent && scenario_response_started) {
             if (now_ms - last_scenario_response_ms >= scenario_quiet_ms) {
                 const std::string logout = fix.build_logout(outbound_seq, utils::get_utc_timestamp(), "");
 
-                if (!send_fix_message(socket, logout, last_send_ms)) {
+                if (!send_fix_message(socket, session, logout, last_send_ms)) {
                     break;
                 }
 
@@ -560,40 +1056,40 @@ int Application::run(const AppArgs& args) {
             }
         }
         else {
-            // TestRequest timeout check
-            if (test_request_sent_ms != 0) {
-                if (now_ms - test_request_sent_ms >= heartbeat_interval_ms) {
-                    std::printf("Error: TestRequest timeout\n");
+            const KeepaliveAction keepalive = check_keepalive(now_ms, heartbeat_interval_ms, last_send_ms,
+                                                              last_recv_ms, test_request_sent_ms);
+
+            if (keepalive == keepalive_timeout) {
+                std::printf("Error: TestRequest timeout\n");
+                break;
+            }
+
+            // No inbound for interval -> send TestRequest
+            if (keepalive == keepalive_test_request) {
+                char test_req_id_buf[32];
+                std::snprintf(test_req_id_buf, sizeof(test_req_id_buf), "TR%d", test_request_counter++);
+                const std::string test_req_id(test_req_id_buf);
+
+                const std::string test_request = fix.build_test_request(outbound_seq,
+                                                                        utils::get_utc_timestamp(),
+                                                                        test_req_id);
+
+                if (!send_fix_message(socket, session, test_request, last_send_ms)) {
                     break;
                 }
-            } else {
-                // No inbound for interval -> send TestRequest
-                if (now_ms - last_recv_ms >= heartbeat_interval_ms) {
-                    char test_req_id_buf[32];
-                    std::snprintf(test_req_id_buf, sizeof(test_req_id_buf), "TR%d", test_request_counter++);
-                    const std::string test_req_id(test_req_id_buf);
-
-                    const std::string test_request = fix.build_test_request(outbound_seq,
-                                                                            utils::get_utc_timestamp(),
-                                                                            test_req_id);
-
-                    if (!send_fix_message(socket, test_request, last_send_ms)) {
-                        break;
-                    }
-
-                    outbound_seq++;
-                    save_token(token_path, outbound_seq);
-                    test_request_sent_ms = utils::get_monotonic_millis();
-                }
+
+                outbound_seq++;
+                save_token(token_path, outbound_seq);
+                test_request_sent_ms = utils::get_monotonic_millis();
             }
 
             // No outbound for interval -> send Heartbeat
-            if (now_ms - last_send_ms >= heartbeat_interval_ms) {
+            if (keepalive == keepalive_heartbeat) {
                 const std::string heartbeat = fix.build_heartbeat(outbound_seq,
                                                                   utils::get_utc_timestamp(),
                                                                   "");
 
-                if (!send_fix_message(socket, heartbeat, last_send_ms)) {
+                if (!send_fix_message(socket, session, heartbeat, last_send_ms)) {
                     break;
                 }
 
@@ -602,6 +1098,18 @@ int Application::run(const AppArgs& args) {
             }
         }
 
+        // Don't block past the next
+        // throttle release
+        if (throttle.depth() > 0) {
+            const uint64_t wait_ms = throttle.next_ready_ms();
+            const int timeout_millis = (wait_ms < static_cast<uint64_t>(receive_timeout_millis))
+                ? static_cast<int>(wait_ms) : receive_timeout_millis;
+
+            if (!socket.wait_readable(timeout_millis)) {
+                continue;
+            }
+        }
+
         const int bytes_received = socket.receive_bytes(receive_buffer, sizeof(receive_buffer));
 
         if (bytes_received == peer_closed) {
@@ -620,27 +1128,71 @@ int Application::run(const AppArgs& args) {
         last_recv_ms = utils::get_monotonic_millis();
         test_request_sent_ms = 0;
 
-        fix_parser.append_bytes(receive_buffer, static_cast<size_t>(bytes_received));
+        fix_parser.append_bytes(receive_buffer, static_cast<size_t>(bytes_received),
+                                socket.last_rx_timestamp());
 
         std::string inbound_message;
-        while (fix_parser.read_next_message(inbound_message)) {
+        SocketTimestamp rx_stamp;
+        while (fix_parser.read_next_message(inbound_message, rx_stamp)) {
             bool stop_requested = false;
+            bool rejected = false;
+            const uint64_t parsed_ns = socket.is_timestamping() ? utils::get_realtime_nanos() : 0;
 
-            if (!process_inbound_message(socket, fix, outbound_seq, last_send_ms,
+            if (!process_inbound_message(socket, session, fix, outbound_seq, last_send_ms,
                                          inbound_message, logon_accepted, stop_requested,
                                          scenarios_sent, scenario_response_started, last_scenario_response_ms,
-                                         logout_initiated, token_path)) {
+                                         logout_initiated, token_path, rejected)) {
                 socket.close();
                 return 1;
             }
 
+            if (rejected) {
+                continue;
+            }
+
+            scenario_sender.on_inbound(inbound_message);
+            orders.on_inbound(inbound_message);
+
+            if (instruments.is_open() && instruments.on_message(inbound_message)) {
+                std::printf("Info: instruments updated=%zu total=%zu\n",
+                            instruments.last_changes(), instruments.size());
+            }
+
+            std::vector<std::string> stale_symbols;
+            if (books.on_message(inbound_message) && books.take_stale(stale_symbols)) {
+                const std::string md_request = build_market_data_request(fix, outbound_seq, utils::get_utc_timestamp(),
+                                                                         "MD" + std::to_string(md_request_counter++),
+                                                                         '0', config.md_depth, stale_symbols);
+                if (!send_throttled_message(socket, session, md_request, last_send_ms)) {
+                    socket.close();
+                    return 1;
+                }
+
+                outbound_seq++;
+                save_token(token_path, outbound_seq);
+            }
+
+            if (socket.is_timestamping()) {
+                report_rx_latency(rx_stamp, parsed_ns, utils::get_realtime_nanos());
+            }
+
             if (stop_requested) {
+                report_throttle_metrics(throttle);
+                report_order_counts(orders);
+                report_market_data(books);
+                save_instruments(instruments);
                 socket.close();
                 return 0;
             }
         }
+
+        drain_tx_timestamps(socket, session);
     }
 
+    report_throttle_metrics(throttle);
+    report_order_counts(orders);
+    report_market_data(books);
+    save_instruments(instruments);
     socket.close();
     return 0;
 }
@@ -12,6 +12,7 @@ void ConfigParser::load(const std::string& path) {
     }
 
     sessions.clear();
+    session_order.clear();
     
     std::string section_name = "DEFAULT";
     std::string line;
@@ -53,17 +54,37 @@ void ConfigParser::load(const std::string& path) {
             if (session_config.name.empty()) {
                 session_config = defaults;
                 session_config.name = section_name;
+                session_order.push_back(section_name);
             }
             config = &session_config;
         }
 
-        if (key == "host") config->host = value;
+        if (key == "connection_type") config->connection_type = value;
+        else if (key == "acceptor_role") config->acceptor_role = value;
+        else if (key == "reactor_threads") config->reactor_threads = std::atoi(value.c_str());
+        else if (key == "session_weight") config->session_weight = std::atoi(value.c_str());
+        else if (key == "rebalance_interval") config->rebalance_interval = std::atoi(value.c_str());
+        else if (key == "host") config->host = value;
         else if (key == "port") config->port = std::atoi(value.c_str());
         else if (key == "begin_string") config->begin_string = value;
         else if (key == "sender_comp_id") config->sender_comp_id = value;
         else if (key == "target_comp_id") config->target_comp_id = value;
         else if (key == "heartbeat_interval") config->heartbeat_interval = std::atoi(value.c_str());
         else if (key == "reset_on_logon") config->reset_on_logon = (value == "true");
+        else if (key == "max_in_flight") config->max_in_flight = std::atoi(value.c_str());
+        else if (key == "throttle_session") config->throttle_session = value;
+        else if (key == "throttle_msg_types") config->throttle_msg_types = value;
+        else if (key == "md_symbols") config->md_symbols = value;
+        else if (key == "md_depth") config->md_depth = std::atoi(value.c_str());
+        else if (key == "validation") config->validation = value;
+        else if (key == "data_dictionary") config->data_dictionary = value;
+        else if (key == "instrument_cache") config->instrument_cache = value;
+        else if (key == "instrument_fetch") config->instrument_fetch = value;
+        else if (key == "instrument_symbols") config->instrument_symbols = value;
+        else if (key == "encoding") config->encoding = value;
+        else if (key == "sbe_schema") config->sbe_schema = value;
+        else if (key == "timestamping") config->timestamping = value;
+        else if (key == "sim_latency_us") config->sim_latency_us = std::atoi(value.c_str());
     }
 }
 
@@ -74,3 +95,11 @@ SessionConfig ConfigParser::get_session(const std::string& session_name) const {
     }
     return found->second;
 }
+
+std::vector<SessionConfig> ConfigParser::get_sessions() const {
+    std::vector<SessionConfig> result;
+    for (size_t i = 0; i < session_order.size(); ++i) {
+        result.push_back(sessions.find(session_order[i])->second);
+    }
+    return result;
+}
@@ -0,0 +1,1982 @@
+// Generated by fix_codegen from config/FIX44.xml, do not edit.
+// FIX.4.4 application messages, see fix_typed.h.
+
+#include "fix44_messages.h"
+
+namespace fix44 {
+
+size_t ExecutionReport::max_body_size() const {
+    size_t size = 221;
+    if (present & (uint64_t(1) << 0)) size += 4 + order_id.size;
+    if (present & (uint64_t(1) << 1)) size += 4 + cl_ord_id.size;
+    if (present & (uint64_t(1) << 2)) size += 4 + orig_cl_ord_id.size;
+    if (present & (uint64_t(1) << 3)) size += 5 + cross_id.size;
+    if (present & (uint64_t(1) << 4)) size += 4 + exec_id.size;
+    if (present & (uint64_t(1) << 8)) size += 3 + account.size;
+    if (present & (uint64_t(1) << 9)) size += 4 + symbol.size;
+    if (present & (uint64_t(1) << 10)) size += 4 + security_id.size;
+    if (present & (uint64_t(1) << 11)) size += 4 + security_id_source.size;
+    if (present & (uint64_t(1) << 12)) size += 5 + security_type.size;
+    if (present & (uint64_t(1) << 13)) size += 4 + currency.size;
+    if (present & (uint64_t(1) << 23)) size += 4 + transact_time.size;
+    if (present & (uint64_t(1) << 24)) size += 4 + text.size;
+    return size;
+}
+
+char* ExecutionReport::write_body(char* pos) const {
+    if (present & (uint64_t(1) << 0)) {
+        pos = fix_put_prefix(pos, "37=");
+        pos = fix_put_text(pos, order_id);
+    }
+    if (present & (uint64_t(1) << 1)) {
+        pos = fix_put_prefix(pos, "11=");
+        pos = fix_put_text(pos, cl_ord_id);
+    }
+    if (present & (uint64_t(1) << 2)) {
+        pos = fix_put_prefix(pos, "41=");
+        pos = fix_put_text(pos, orig_cl_ord_id);
+    }
+    if (present & (uint64_t(1) << 3)) {
+        pos = fix_put_prefix(pos, "548=");
+        pos = fix_put_text(pos, cross_id);
+    }
+    if (present & (uint64_t(1) << 4)) {
+        pos = fix_put_prefix(pos, "17=");
+        pos = fix_put_text(pos, exec_id);
+    }
+    if (present & (uint64_t(1) << 5)) {
+        pos = fix_put_prefix(pos, "150=");
+        pos = fix_put_char(pos, exec_type);
+    }
+    if (present & (uint64_t(1) << 6)) {
+        pos = fix_put_prefix(pos, "39=");
+        pos = fix_put_char(pos, ord_status);
+    }
+    if (present & (uint64_t(1) << 7)) {
+        pos = fix_put_prefix(pos, "103=");
+        pos = fix_put_int(pos, ord_rej_reason);
+    }
+    if (present & (uint64_t(1) << 8)) {
+        pos = fix_put_prefix(pos, "1=");
+        pos = fix_put_text(pos, account);
+    }
+    if (present & (uint64_t(1) << 9)) {
+        pos = fix_put_prefix(pos, "55=");
+        pos = fix_put_text(pos, symbol);
+    }
+    if (present & (uint64_t(1) << 10)) {
+        pos = fix_put_prefix(pos, "48=");
+        pos = fix_put_text(pos, security_id);
+    }
+    if (present & (uint64_t(1) << 11)) {
+        pos = fix_put_prefix(pos, "22=");
+        pos = fix_put_text(pos, security_id_source);
+    }
+    if (present & (uint64_t(1) << 12)) {
+        pos = fix_put_prefix(pos, "167=");
+        pos = fix_put_text(pos, security_type);
+    }
+    if (present & (uint64_t(1) << 13)) {
+        pos = fix_put_prefix(pos, "15=");
+        pos = fix_put_text(pos, currency);
+    }
+    if (present & (uint64_t(1) << 14)) {
+        pos = fix_put_prefix(pos, "54=");
+        pos = fix_put_char(pos, side);
+    }
+    if (present & (uint64_t(1) << 15)) {
+        pos = fix_put_prefix(pos, "38=");
+        pos = fix_put_decimal(pos, order_qty);
+    }
+    if (present & (uint64_t(1) << 16)) {
+        pos = fix_put_prefix(pos, "40=");
+        pos = fix_put_char(pos, ord_type);
+    }
+    if (present & (uint64_t(1) << 17)) {
+        pos = fix_put_prefix(pos, "44=");
+        pos = fix_put_decimal(pos, price);
+    }
+    if (present & (uint64_t(1) << 18)) {
+        pos = fix_put_prefix(pos, "32=");
+        pos = fix_put_decimal(pos, last_qty);
+    }
+    if (present & (uint64_t(1) << 19)) {
+        pos = fix_put_prefix(pos, "31=");
+        pos = fix_put_decimal(pos, last_px);
+    }
+    if (present & (uint64_t(1) << 20)) {
+        pos = fix_put_prefix(pos, "151=");
+        pos = fix_put_decimal(pos, leaves_qty);
+    }
+    if (present & (uint64_t(1) << 21)) {
+        pos = fix_put_prefix(pos, "14=");
+        pos = fix_put_decimal(pos, cum_qty);
+    }
+    if (present & (uint64_t(1) << 22)) {
+        pos = fix_put_prefix(pos, "6=");
+        pos = fix_put_decimal(pos, avg_px);
+    }
+    if (present & (uint64_t(1) << 23)) {
+        pos = fix_put_prefix(pos, "60=");
+        pos = fix_put_text(pos, transact_time);
+    }
+    if (present & (uint64_t(1) << 24)) {
+        pos = fix_put_prefix(pos, "58=");
+        pos = fix_put_text(pos, text);
+    }
+    return pos;
+}
+
+bool ExecutionReport::decode(const char* data, size_t size) {
+    present = 0;
+    const char* pos = data;
+    const char* const end = data + size;
+    int tag = 0;
+    FixText value;
+
+    while (fix_next_field(pos, end, tag, value)) {
+        switch (tag) {
+            case 37:
+                if (present & (uint64_t(1) << 0)) break;
+                order_id = value;
+                present |= (uint64_t(1) << 0);
+                break;
+            case 11:
+                if (present & (uint64_t(1) << 1)) break;
+                cl_ord_id = value;
+                present |= (uint64_t(1) << 1);
+                break;
+            case 41:
+                if (present & (uint64_t(1) << 2)) break;
+                orig_cl_ord_id = value;
+                present |= (uint64_t(1) << 2);
+                break;
+            case 548:
+                if (present & (uint64_t(1) << 3)) break;
+                cross_id = value;
+                present |= (uint64_t(1) << 3);
+                break;
+            case 17:
+                if (present & (uint64_t(1) << 4)) break;
+                exec_id = value;
+                present |= (uint64_t(1) << 4);
+                break;
+            case 150:
+                if (present & (uint64_t(1) << 5)) break;
+                if (!fix_get_char(value, exec_type)) return false;
+                present |= (uint64_t(1) << 5);
+                break;
+            case 39:
+                if (present & (uint64_t(1) << 6)) break;
+                if (!fix_get_char(value, ord_status)) return false;
+                present |= (uint64_t(1) << 6);
+                break;
+            case 103:
+                if (present & (uint64_t(1) << 7)) break;
+                if (!fix_get_int(value, ord_rej_reason)) return false;
+                present |= (uint64_t(1) << 7);
+                break;
+            case 1:
+                if (present & (uint64_t(1) << 8)) break;
+                account = value;
+                present |= (uint64_t(1) << 8);
+                break;
+            case 55:
+                if (present & (uint64_t(1) << 9)) break;
+                symbol = value;
+                present |= (uint64_t(1) << 9);
+                break;
+            case 48:
+                if (present & (uint64_t(1) << 10)) break;
+                security_id = value;
+                present |= (uint64_t(1) << 10);
+                break;
+            case 22:
+                if (present & (uint64_t(1) << 11)) break;
+                security_id_source = value;
+                present |= (uint64_t(1) << 11);
+                break;
+            case 167:
+                if (present & (uint64_t(1) << 12)) break;
+                security_type = value;
+                present |= (uint64_t(1) << 12);
+                break;
+            case 15:
+                if (present & (uint64_t(1) << 13)) break;
+                currency = value;
+                present |= (uint64_t(1) << 13);
+                break;
+            case 54:
+                if (present & (uint64_t(1) << 14)) break;
+                if (!fix_get_char(value, side)) return false;
+                present |= (uint64_t(1) << 14);
+                break;
+            case 38:
+                if (present & (uint64_t(1) << 15)) break;
+                if (!fix_get_decimal(value, order_qty)) return false;
+                present |= (uint64_t(1) << 15);
+                break;
+            case 40:
+                if (present & (uint64_t(1) << 16)) break;
+                if (!fix_get_char(value, ord_type)) return false;
+                present |= (uint64_t(1) << 16);
+                break;
+            case 44:
+                if (present & (uint64_t(1) << 17)) break;
+                if (!fix_get_decimal(value, price)) return false;
+                present |= (uint64_t(1) << 17);
+                break;
+            case 32:
+                if (present & (uint64_t(1) << 18)) break;
+                if (!fix_get_decimal(value, last_qty)) return false;
+                present |= (uint64_t(1) << 18);
+                break;
+            case 31:
+                if (present & (uint64_t(1) << 19)) break;
+                if (!fix_get_decimal(value, last_px)) return false;
+                present |= (uint64_t(1) << 19);
+                break;
+            case 151:
+                if (present & (uint64_t(1) << 20)) break;
+                if (!fix_get_decimal(value, leaves_qty)) return false;
+                present |= (uint64_t(1) << 20);
+                break;
+            case 14:
+                if (present & (uint64_t(1) << 21)) break;
+                if (!fix_get_decimal(value, cum_qty)) return false;
+                present |= (uint64_t(1) << 21);
+                break;
+            case 6:
+                if (present & (uint64_t(1) << 22)) break;
+                if (!fix_get_decimal(value, avg_px)) return false;
+                present |= (uint64_t(1) << 22);
+                break;
+            case 60:
+                if (present & (uint64_t(1) << 23)) break;
+                transact_time = value;
+                present |= (uint64_t(1) << 23);
+                break;
+            case 58:
+                if (present & (uint64_t(1) << 24)) break;
+                text = value;
+                present |= (uint64_t(1) << 24);
+                break;
+            default:
+                break;
+        }
+    }
+    return pos == end;
+}
+
+size_t OrderCancelReject::max_body_size() const {
+    size_t size = 36;
+    if (present & (uint64_t(1) << 0)) size += 4 + order_id.size;
+    if (present & (uint64_t(1) << 1)) size += 4 + cl_ord_id.size;
+    if (present & (uint64_t(1) << 2)) size += 4 + orig_cl_ord_id.size;
+    if (present & (uint64_t(1) << 6)) size += 4 + text.size;
+    return size;
+}
+
+char* OrderCancelReject::write_body(char* pos) const {
+    if (present & (uint64_t(1) << 0)) {
+        pos = fix_put_prefix(pos, "37=");
+        pos = fix_put_text(pos, order_id);
+    }
+    if (present & (uint64_t(1) << 1)) {
+        pos = fix_put_prefix(pos, "11=");
+        pos = fix_put_text(pos, cl_ord_id);
+    }
+    if (present & (uint64_t(1) << 2)) {
+        pos = fix_put_prefix(pos, "41=");
+        pos = fix_put_text(pos, orig_cl_ord_id);
+    }
+    if (present & (uint64_t(1) << 3)) {
+        pos = fix_put_prefix(pos, "39=");
+        pos = fix_put_char(pos, ord_status);
+    }
+    if (present & (uint64_t(1) << 4)) {
+        pos = fix_put_prefix(pos, "434=");
+        pos = fix_put_char(pos, cxl_rej_response_to);
+    }
+    if (present & (uint64_t(1) << 5)) {
+        pos = fix_put_prefix(pos, "102=");
+        pos = fix_put_int(pos, cxl_rej_reason);
+    }
+    if (present & (uint64_t(1) << 6)) {
+        pos = fix_put_prefix(pos, "58=");
+        pos = fix_put_text(pos, text);
+    }
+    return pos;
+}
+
+bool OrderCancelReject::decode(const char* data, size_t size) {
+    present = 0;
+    const char* pos = data;
+    const char* const end = data + size;
+    int tag = 0;
+    FixText value;
+
+    while (fix_next_field(pos, end, tag, value)) {
+        switch (tag) {
+            case 37:
+                if (present & (uint64_t(1) << 0)) break;
+                order_id = value;
+                present |= (uint64_t(1) << 0);
+                break;
+            case 11:
+                if (present & (uint64_t(1) << 1)) break;
+                cl_ord_id = value;
+                present |= (uint64_t(1) << 1);
+                break;
+            case 41:
+                if (present & (uint64_t(1) << 2)) break;
+                orig_cl_ord_id = value;
+                present |= (uint64_t(1) << 2);
+                break;
+            case 39:
+                if (present & (uint64_t(1) << 3)) break;
+                if (!fix_get_char(value, ord_status)) return false;
+                present |= (uint64_t(1) << 3);
+                break;
+            case 434:
+                if (present & (uint64_t(1) << 4)) break;
+                if (!fix_get_char(value, cxl_rej_response_to)) return false;
+                present |= (uint64_t(1) << 4);
+                break;
+            case 102:
+                if (present & (uint64_t(1) << 5)) break;
+                if (!fix_get_int(value, cxl_rej_reason)) return false;
+                present |= (uint64_t(1) << 5);
+                break;
+            case 58:
+                if (present & (uint64_t(1) << 6)) break;
+                text = value;
+                present |= (uint64_t(1) << 6);
+                break;
+            default:
+                break;
+        }
+    }
+    return pos == end;
+}
+
+size_t NewOrderSingle::max_body_size() const {
+    size_t size = 116;
+    if (present & (uint64_t(1) << 0)) size += 4 + cl_ord_id.size;
+    if (present & (uint64_t(1) << 1)) size += 3 + account.size;
+    if (present & (uint64_t(1) << 3)) size += 4 + symbol.size;
+    if (present & (uint64_t(1) << 4)) size += 4 + security_id.size;
+    if (present & (uint64_t(1) << 5)) size += 4 + security_id_source.size;
+    if (present & (uint64_t(1) << 6)) size += 5 + security_type.size;
+    if (present & (uint64_t(1) << 7)) size += 4 + currency.size;
+    if (present & (uint64_t(1) << 9)) size += 4 + transact_time.size;
+    if (present & (uint64_t(1) << 18)) size += 4 + text.size;
+    return size;
+}
+
+char* NewOrderSingle::write_body(char* pos) const {
+    if (present & (uint64_t(1) << 0)) {
+        pos = fix_put_prefix(pos, "11=");
+        pos = fix_put_text(pos, cl_ord_id);
+    }
+    if (present & (uint64_t(1) << 1)) {
+        pos = fix_put_prefix(pos, "1=");
+        pos = fix_put_text(pos, account);
+    }
+    if (present & (uint64_t(1) << 2)) {
+        pos = fix_put_prefix(pos, "63=");
+        pos = fix_put_char(pos, settl_type);
+    }
+    if (present & (uint64_t(1) << 3)) {
+        pos = fix_put_prefix(pos, "55=");
+        pos = fix_put_text(pos, symbol);
+    }
+    if (present & (uint64_t(1) << 4)) {
+        pos = fix_put_prefix(pos, "48=");
+        pos = fix_put_text(pos, security_id);
+    }
+    if (present & (uint64_t(1) << 5)) {
+        pos = fix_put_prefix(pos, "22=");
+        pos = fix_put_text(pos, security_id_source);
+    }
+    if (present & (uint64_t(1) << 6)) {
+        pos = fix_put_prefix(pos, "167=");
+        pos = fix_put_text(pos, security_type);
+    }
+    if (present & (uint64_t(1) << 7)) {
+        pos = fix_put_prefix(pos, "15=");
+        pos = fix_put_text(pos, currency);
+    }
+    if (present & (uint64_t(1) << 8)) {
+        pos = fix_put_prefix(pos, "54=");
+        pos = fix_put_char(pos, side);
+    }
+    if (present & (uint64_t(1) << 9)) {
+        pos = fix_put_prefix(pos, "60=");
+        pos = fix_put_text(pos, transact_time);
+    }
+    if (present & (uint64_t(1) << 10)) {
+        pos = fix_put_prefix(pos, "38=");
+        pos = fix_put_decimal(pos, order_qty);
+    }
+    if (present & (uint64_t(1) << 11)) {
+        pos = fix_put_prefix(pos, "544=");
+        pos = fix_put_decimal(pos, cash_order_qty);
+    }
+    if (present & (uint64_t(1) << 12)) {
+        pos = fix_put_prefix(pos, "40=");
+        pos = fix_put_char(pos, ord_type);
+    }
+    if (present & (uint64_t(1) << 13)) {
+        pos = fix_put_prefix(pos, "44=");
+        pos = fix_put_decimal(pos, price);
+    }
+    if (present & (uint64_t(1) << 14)) {
+        pos = fix_put_prefix(pos, "59=");
+        pos = fix_put_char(pos, time_in_force);
+    }
+    if (present & (uint64_t(1) << 15)) {
+        pos = fix_put_prefix(pos, "528=");
+        pos = fix_put_char(pos, order_capacity);
+    }
+    if (present & (uint64_t(1) << 16)) {
+        pos = fix_put_prefix(pos, "8060=");
+        pos = fix_put_char(pos, order_classification);
+    }
+    if (present & (uint64_t(1) << 17)) {
+        pos = fix_put_prefix(pos, "8062=");
+        pos = fix_put_char(pos, dark_pool_flag);
+    }
+    if (present & (uint64_t(1) << 18)) {
+        pos = fix_put_prefix(pos, "58=");
+        pos = fix_put_text(pos, text);
+    }
+    return pos;
+}
+
+bool NewOrderSingle::decode(const char* data, size_t size) {
+    present = 0;
+    const char* pos = data;
+    const char* const end = data + size;
+    int tag = 0;
+    FixText value;
+
+    while (fix_next_field(pos, end, tag, value)) {
+        switch (tag) {
+            case 11:
+                if (present & (uint64_t(1) << 0)) break;
+                cl_ord_id = value;
+                present |= (uint64_t(1) << 0);
+                break;
+            case 1:
+                if (present & (uint64_t(1) << 1)) break;
+                account = value;
+                present |= (uint64_t(1) << 1);
+                break;
+            case 63:
+                if (present & (uint64_t(1) << 2)) break;
+                if (!fix_get_char(value, settl_type)) return false;
+                present |= (uint64_t(1) << 2);
+                break;
+            case 55:
+                if (present & (uint64_t(1) << 3)) break;
+                symbol = value;
+                present |= (uint64_t(1) << 3);
+                break;
+            case 48:
+                if (present & (uint64_t(1) << 4)) break;
+                security_id = value;
+                present |= (uint64_t(1) << 4);
+                break;
+            case 22:
+                if (present & (uint64_t(1) << 5)) break;
+                security_id_source = value;
+                present |= (uint64_t(1) << 5);
+                break;
+            case 167:
+                if (present & (uint64_t(1) << 6)) break;
+                security_type = value;
+                present |= (uint64_t(1) << 6);
+                break;
+            case 15:
+                if (present & (uint64_t(1) << 7)) break;
+                currency = value;
+                present |= (uint64_t(1) << 7);
+                break;
+            case 54:
+                if (present & (uint64_t(1) << 8)) break;
+                if (!fix_get_char(value, side)) return false;
+                present |= (uint64_t(1) << 8);
+                break;
+            case 60:
+                if (present & (uint64_t(1) << 9)) break;
+                transact_time = value;
+                present |= (uint64_t(1) << 9);
+                break;
+            case 38:
+                if (present & (uint64_t(1) << 10)) break;
+                if (!fix_get_decimal(value, order_qty)) return false;
+                present |= (uint64_t(1) << 10);
+                break;
+            case 544:
+                if (present & (uint64_t(1) << 11)) break;
+                if (!fix_get_decimal(value, cash_order_qty)) return false;
+                present |= (uint64_t(1) << 11);
+                break;
+            case 40:
+                if (present & (uint64_t(1) << 12)) break;
+                if (!fix_get_char(value, ord_type)) return false;
+                present |= (uint64_t(1) << 12);
+                break;
+            case 44:
+                if (present & (uint64_t(1) << 13)) break;
+                if (!fix_get_decimal(value, price)) return false;
+                present |= (uint64_t(1) << 13);
+                break;
+            case 59:
+                if (present & (uint64_t(1) << 14)) break;
+                if (!fix_get_char(value, time_in_force)) return false;
+                present |= (uint64_t(1) << 14);
+                break;
+            case 528:
+                if (present & (uint64_t(1) << 15)) break;
+                if (!fix_get_char(value, order_capacity)) return false;
+                present |= (uint64_t(1) << 15);
+                break;
+            case 8060:
+                if (present & (uint64_t(1) << 16)) break;
+                if (!fix_get_char(value, order_classification)) return false;
+                present |= (uint64_t(1) << 16);
+                break;
+            case 8062:
+                if (present & (uint64_t(1) << 17)) break;
+                if (!fix_get_char(value, dark_pool_flag)) return false;
+                present |= (uint64_t(1) << 17);
+                break;
+            case 58:
+                if (present & (uint64_t(1) << 18)) break;
+                text = value;
+                present |= (uint64_t(1) << 18);
+                break;
+            default:
+                break;
+        }
+    }
+    return pos == end;
+}
+
+size_t OrderCancelRequest::max_body_size() const {
+    size_t size = 30;
+    if (present & (uint64_t(1) << 0)) size += 4 + orig_cl_ord_id.size;
+    if (present & (uint64_t(1) << 1)) size += 4 + order_id.size;
+    if (present & (uint64_t(1) << 2)) size += 4 + cl_ord_id.size;
+    if (present & (uint64_t(1) << 3)) size += 4 + symbol.size;
+    if (present & (uint64_t(1) << 4)) size += 4 + security_id.size;
+    if (present & (uint64_t(1) << 5)) size += 4 + security_id_source.size;
+    if (present & (uint64_t(1) << 6)) size += 5 + security_type.size;
+    if (present & (uint64_t(1) << 7)) size += 4 + currency.size;
+    if (present & (uint64_t(1) << 9)) size += 4 + transact_time.size;
+    if (present & (uint64_t(1) << 11)) size += 4 + text.size;
+    return size;
+}
+
+char* OrderCancelRequest::write_body(char* pos) const {
+    if (present & (uint64_t(1) << 0)) {
+        pos = fix_put_prefix(pos, "41=");
+        pos = fix_put_text(pos, orig_cl_ord_id);
+    }
+    if (present & (uint64_t(1) << 1)) {
+        pos = fix_put_prefix(pos, "37=");
+        pos = fix_put_text(pos, order_id);
+    }
+    if (present & (uint64_t(1) << 2)) {
+        pos = fix_put_prefix(pos, "11=");
+        pos = fix_put_text(pos, cl_ord_id);
+    }
+    if (present & (uint64_t(1) << 3)) {
+        pos = fix_put_prefix(pos, "55=");
+        pos = fix_put_text(pos, symbol);
+    }
+    if (present & (uint64_t(1) << 4)) {
+        pos = fix_put_prefix(pos, "48=");
+        pos = fix_put_text(pos, security_id);
+    }
+    if (present & (uint64_t(1) << 5)) {
+        pos = fix_put_prefix(pos, "22=");
+        pos = fix_put_text(pos, security_id_source);
+    }
+    if (present & (uint64_t(1) << 6)) {
+        pos = fix_put_prefix(pos, "167=");
+        pos = fix_put_text(pos, security_type);
+    }
+    if (present & (uint64_t(1) << 7)) {
+        pos = fix_put_prefix(pos, "15=");
+        pos = fix_put_text(pos, currency);
+    }
+    if (present & (uint64_t(1) << 8)) {
+        pos = fix_put_prefix(pos, "54=");
+        pos = fix_put_char(pos, side);
+    }
+    if (present & (uint64_t(1) << 9)) {
+        pos = fix_put_prefix(pos, "60=");
+        pos = fix_put_text(pos, transact_time);
+    }
+    if (present & (uint64_t(1) << 10)) {
+        pos = fix_put_prefix(pos, "38=");
+        pos = fix_put_decimal(pos, order_qty);
+    }
+    if (present & (uint64_t(1) << 11)) {
+        pos = fix_put_prefix(pos, "58=");
+        pos = fix_put_text(pos, text);
+    }
+    return pos;
+}
+
+bool OrderCancelRequest::decode(const char* data, size_t size) {
+    present = 0;
+    const char* pos = data;
+    const char* const end = data + size;
+    int tag = 0;
+    FixText value;
+
+    while (fix_next_field(pos, end, tag, value)) {
+        switch (tag) {
+            case 41:
+                if (present & (uint64_t(1) << 0)) break;
+                orig_cl_ord_id = value;
+                present |= (uint64_t(1) << 0);
+                break;
+            case 37:
+                if (present & (uint64_t(1) << 1)) break;
+                order_id = value;
+                present |= (uint64_t(1) << 1);
+                break;
+            case 11:
+                if (present & (uint64_t(1) << 2)) break;
+                cl_ord_id = value;
+                present |= (uint64_t(1) << 2);
+                break;
+            case 55:
+                if (present & (uint64_t(1) << 3)) break;
+                symbol = value;
+                present |= (uint64_t(1) << 3);
+                break;
+            case 48:
+                if (present & (uint64_t(1) << 4)) break;
+                security_id = value;
+                present |= (uint64_t(1) << 4);
+                break;
+            case 22:
+                if (present & (uint64_t(1) << 5)) break;
+                security_id_source = value;
+                present |= (uint64_t(1) << 5);
+                break;
+            case 167:
+                if (present & (uint64_t(1) << 6)) break;
+                security_type = value;
+                present |= (uint64_t(1) << 6);
+                break;
+            case 15:
+                if (present & (uint64_t(1) << 7)) break;
+                currency = value;
+                present |= (uint64_t(1) << 7);
+                break;
+            case 54:
+                if (present & (uint64_t(1) << 8)) break;
+                if (!fix_get_char(value, side)) return false;
+                present |= (uint64_t(1) << 8);
+                break;
+            case 60:
+                if (present & (uint64_t(1) << 9)) break;
+                transact_time = value;
+                present |= (uint64_t(1) << 9);
+                break;
+            case 38:
+                if (present & (uint64_t(1) << 10)) break;
+                if (!fix_get_decimal(value, order_qty)) return false;
+                present |= (uint64_t(1) << 10);
+                break;
+            case 58:
+                if (present & (uint64_t(1) << 11)) break;
+                text = value;
+                present |= (uint64_t(1) << 11);
+                break;
+            default:
+                break;
+        }
+    }
+    return pos == end;
+}
+
+size_t OrderCancelReplaceRequest::max_body_size() const {
+    size_t size = 65;
+    if (present & (uint64_t(1) << 0)) size += 4 + order_id.size;
+    if (present & (uint64_t(1) << 1)) size += 4 + orig_cl_ord_id.size;
+    if (present & (uint64_t(1) << 2)) size += 4 + cl_ord_id.size;
+    if (present & (uint64_t(1) << 3)) size += 3 + account.size;
+    if (present & (uint64_t(1) << 4)) size += 4 + symbol.size;
+    if (present & (uint64_t(1) << 5)) size += 4 + security_id.size;
+    if (present & (uint64_t(1) << 6)) size += 4 + security_id_source.size;
+    if (present & (uint64_t(1) << 7)) size += 5 + security_type.size;
+    if (present & (uint64_t(1) << 8)) size += 4 + currency.size;
+    if (present & (uint64_t(1) << 10)) size += 4 + transact_time.size;
+    if (present & (uint64_t(1) << 15)) size += 4 + text.size;
+    return size;
+}
+
+char* OrderCancelReplaceRequest::write_body(char* pos) const {
+    if (present & (uint64_t(1) << 0)) {
+        pos = fix_put_prefix(pos, "37=");
+        pos = fix_put_text(pos, order_id);
+    }
+    if (present & (uint64_t(1) << 1)) {
+        pos = fix_put_prefix(pos, "41=");
+        pos = fix_put_text(pos, orig_cl_ord_id);
+    }
+    if (present & (uint64_t(1) << 2)) {
+        pos = fix_put_prefix(pos, "11=");
+        pos = fix_put_text(pos, cl_ord_id);
+    }
+    if (present & (uint64_t(1) << 3)) {
+        pos = fix_put_prefix(pos, "1=");
+        pos = fix_put_text(pos, account);
+    }
+    if (present & (uint64_t(1) << 4)) {
+        pos = fix_put_prefix(pos, "55=");
+        pos = fix_put_text(pos, symbol);
+    }
+    if (present & (uint64_t(1) << 5)) {
+        pos = fix_put_prefix(pos, "48=");
+        pos = fix_put_text(pos, security_id);
+    }
+    if (present & (uint64_t(1) << 6)) {
+        pos = fix_put_prefix(pos, "22=");
+        pos = fix_put_text(pos, security_id_source);
+    }
+    if (present & (uint64_t(1) << 7)) {
+        pos = fix_put_prefix(pos, "167=");
+        pos = fix_put_text(pos, security_type);
+    }
+    if (present & (uint64_t(1) << 8)) {
+        pos = fix_put_prefix(pos, "15=");
+        pos = fix_put_text(pos, currency);
+    }
+    if (present & (uint64_t(1) << 9)) {
+        pos = fix_put_prefix(pos, "54=");
+        pos = fix_put_char(pos, side);
+    }
+    if (present & (uint64_t(1) << 10)) {
+        pos = fix_put_prefix(pos, "60=");
+        pos = fix_put_text(pos, transact_time);
+    }
+    if (present & (uint64_t(1) << 11)) {
+        pos = fix_put_prefix(pos, "38=");
+        pos = fix_put_decimal(pos, order_qty);
+    }
+    if (present & (uint64_t(1) << 12)) {
+        pos = fix_put_prefix(pos, "40=");
+        pos = fix_put_char(pos, ord_type);
+    }
+    if (present & (uint64_t(1) << 13)) {
+        pos = fix_put_prefix(pos, "44=");
+        pos = fix_put_decimal(pos, price);
+    }
+    if (present & (uint64_t(1) << 14)) {
+        pos = fix_put_prefix(pos, "59=");
+        pos = fix_put_char(pos, time_in_force);
+    }
+    if (present & (uint64_t(1) << 15)) {
+        pos = fix_put_prefix(pos, "58=");
+        pos = fix_put_text(pos, text);
+    }
+    return pos;
+}
+
+bool OrderCancelReplaceRequest::decode(const char* data, size_t size) {
+    present = 0;
+    const char* pos = data;
+    const char* const end = data + size;
+    int tag = 0;
+    FixText value;
+
+    while (fix_next_field(pos, end, tag, value)) {
+        switch (tag) {
+            case 37:
+                if (present & (uint64_t(1) << 0)) break;
+                order_id = value;
+                present |= (uint64_t(1) << 0);
+                break;
+            case 41:
+                if (present & (uint64_t(1) << 1)) break;
+                orig_cl_ord_id = value;
+                present |= (uint64_t(1) << 1);
+                break;
+            case 11:
+                if (present & (uint64_t(1) << 2)) break;
+                cl_ord_id = value;
+                present |= (uint64_t(1) << 2);
+                break;
+            case 1:
+                if (present & (uint64_t(1) << 3)) break;
+                account = value;
+                present |= (uint64_t(1) << 3);
+                break;
+            case 55:
+                if (present & (uint64_t(1) << 4)) break;
+                symbol = value;
+                present |= (uint64_t(1) << 4);
+                break;
+            case 48:
+                if (present & (uint64_t(1) << 5)) break;
+                security_id = value;
+                present |= (uint64_t(1) << 5);
+                break;
+            case 22:
+                if (present & (uint64_t(1) << 6)) break;
+                security_id_source = value;
+                present |= (uint64_t(1) << 6);
+                break;
+            case 167:
+                if (present & (uint64_t(1) << 7)) break;
+                security_type = value;
+                present |= (uint64_t(1) << 7);
+                break;
+            case 15:
+                if (present & (uint64_t(1) << 8)) break;
+                currency = value;
+                present |= (uint64_t(1) << 8);
+                break;
+            case 54:
+                if (present & (uint64_t(1) << 9)) break;
+                if (!fix_get_char(value, side)) return false;
+                present |= (uint64_t(1) << 9);
+                break;
+            case 60:
+                if (present & (uint64_t(1) << 10)) break;
+                transact_time = value;
+                present |= (uint64_t(1) << 10);
+                break;
+            case 38:
+                if (present & (uint64_t(1) << 11)) break;
+                if (!fix_get_decimal(value, order_qty)) return false;
+                present |= (uint64_t(1) << 11);
+                break;
+            case 40:
+                if (present & (uint64_t(1) << 12)) break;
+                if (!fix_get_char(value, ord_type)) return false;
+                present |= (uint64_t(1) << 12);
+                break;
+            case 44:
+                if (present & (uint64_t(1) << 13)) break;
+                if (!fix_get_decimal(value, price)) return false;
+                present |= (uint64_t(1) << 13);
+                break;
+            case 59:
+                if (present & (uint64_t(1) << 14)) break;
+                if (!fix_get_char(value, time_in_force)) return false;
+                present |= (uint64_t(1) << 14);
+                break;
+            case 58:
+                if (present & (uint64_t(1) << 15)) break;
+                text = value;
+                present |= (uint64_t(1) << 15);
+                break;
+            default:
+                break;
+        }
+    }
+    return pos == end;
+}
+
+size_t NewOrderCross::max_body_size() const {
+    size_t size = 105;
+    if (present & (uint64_t(1) << 0)) size += 5 + cross_id.size;
+    if (present & (uint64_t(1) << 3)) size += no_sides_entries.size;
+    if (present & (uint64_t(1) << 4)) size += 4 + symbol.size;
+    if (present & (uint64_t(1) << 5)) size += 4 + security_id.size;
+    if (present & (uint64_t(1) << 6)) size += 4 + security_id_source.size;
+    if (present & (uint64_t(1) << 7)) size += 5 + security_type.size;
+    if (present & (uint64_t(1) << 8)) size += 4 + currency.size;
+    if (present & (uint64_t(1) << 9)) size += 4 + transact_time.size;
+    return size;
+}
+
+char* NewOrderCross::write_body(char* pos) const {
+    if (present & (uint64_t(1) << 0)) {
+        pos = fix_put_prefix(pos, "548=");
+        pos = fix_put_text(pos, cross_id);
+    }
+    if (present & (uint64_t(1) << 1)) {
+        pos = fix_put_prefix(pos, "549=");
+        pos = fix_put_int(pos, cross_type);
+    }
+    if (present & (uint64_t(1) << 2)) {
+        pos = fix_put_prefix(pos, "550=");
+        pos = fix_put_int(pos, cross_prioritization);
+    }
+    if (present & (uint64_t(1) << 3)) {
+        pos = fix_put_prefix(pos, "552=");
+        pos = fix_put_int(pos, no_sides);
+        pos = fix_put_raw(pos, no_sides_entries);
+    }
+    if (present & (uint64_t(1) << 4)) {
+        pos = fix_put_prefix(pos, "55=");
+        pos = fix_put_text(pos, symbol);
+    }
+    if (present & (uint64_t(1) << 5)) {
+        pos = fix_put_prefix(pos, "48=");
+        pos = fix_put_text(pos, security_id);
+    }
+    if (present & (uint64_t(1) << 6)) {
+        pos = fix_put_prefix(pos, "22=");
+        pos = fix_put_text(pos, security_id_source);
+    }
+    if (present & (uint64_t(1) << 7)) {
+        pos = fix_put_prefix(pos, "167=");
+        pos = fix_put_text(pos, security_type);
+    }
+    if (present & (uint64_t(1) << 8)) {
+        pos = fix_put_prefix(pos, "15=");
+        pos = fix_put_text(pos, currency);
+    }
+    if (present & (uint64_t(1) << 9)) {
+        pos = fix_put_prefix(pos, "60=");
+        pos = fix_put_text(pos, transact_time);
+    }
+    if (present & (uint64_t(1) << 10)) {
+        pos = fix_put_prefix(pos, "40=");
+        pos = fix_put_char(pos, ord_type);
+    }
+    if (present & (uint64_t(1) << 11)) {
+        pos = fix_put_prefix(pos, "44=");
+        pos = fix_put_decimal(pos, price);
+    }
+    return pos;
+}
+
+static bool new_order_cross_no_sides_member(int tag) {
+    switch (tag) {
+        case 54:
+        case 11:
+        case 1:
+        case 38:
+        case 528:
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool NewOrderCross::decode(const char* data, size_t size) {
+    present = 0;
+    const char* pos = data;
+    const char* const end = data + size;
+    int tag = 0;
+    FixText value;
+    int group = 0;                  // entries being walked, 1-based
+
+    while (fix_next_field(pos, end, tag, value)) {
+        if (group != 0) {
+            if (group == 1 && new_order_cross_no_sides_member(tag)) {
+                no_sides_entries.size = static_cast<size_t>(pos - no_sides_entries.data);
+                continue;
+            }
+            group = 0;
+        }
+
+        switch (tag) {
+            case 548:
+                if (present & (uint64_t(1) << 0)) break;
+                cross_id = value;
+                present |= (uint64_t(1) << 0);
+                break;
+            case 549:
+                if (present & (uint64_t(1) << 1)) break;
+                if (!fix_get_int(value, cross_type)) return false;
+                present |= (uint64_t(1) << 1);
+                break;
+            case 550:
+                if (present & (uint64_t(1) << 2)) break;
+                if (!fix_get_int(value, cross_prioritization)) return false;
+                present |= (uint64_t(1) << 2);
+                break;
+            case 552:
+                if (present & (uint64_t(1) << 3)) break;
+                if (!fix_get_int(value, no_sides)) return false;
+                present |= (uint64_t(1) << 3);
+                no_sides_entries = FixText(pos, 0);
+                group = 1;
+                break;
+            case 55:
+                if (present & (uint64_t(1) << 4)) break;
+                symbol = value;
+                present |= (uint64_t(1) << 4);
+                break;
+            case 48:
+                if (present & (uint64_t(1) << 5)) break;
+                security_id = value;
+                present |= (uint64_t(1) << 5);
+                break;
+            case 22:
+                if (present & (uint64_t(1) << 6)) break;
+                security_id_source = value;
+                present |= (uint64_t(1) << 6);
+                break;
+            case 167:
+                if (present & (uint64_t(1) << 7)) break;
+                security_type = value;
+                present |= (uint64_t(1) << 7);
+                break;
+            case 15:
+                if (present & (uint64_t(1) << 8)) break;
+                currency = value;
+                present |= (uint64_t(1) << 8);
+                break;
+            case 60:
+                if (present & (uint64_t(1) << 9)) break;
+                transact_time = value;
+                present |= (uint64_t(1) << 9);
+                break;
+            case 40:
+                if (present & (uint64_t(1) << 10)) break;
+                if (!fix_get_char(value, ord_type)) return false;
+                present |= (uint64_t(1) << 10);
+                break;
+            case 44:
+                if (present & (uint64_t(1) << 11)) break;
+                if (!fix_get_decimal(value, price)) return false;
+                present |= (uint64_t(1) << 11);
+                break;
+            default:
+                break;
+        }
+    }
+    return pos == end;
+}
+
+size_t MarketDataRequest::max_body_size() const {
+    size_t size = 106;
+    if (present & (uint64_t(1) << 0)) size += 5 + md_req_id.size;
+    if (present & (uint64_t(1) << 4)) size += no_md_entry_types_entries.size;
+    if (present & (uint64_t(1) << 5)) size += no_related_sym_entries.size;
+    return size;
+}
+
+char* MarketDataRequest::write_body(char* pos) const {
+    if (present & (uint64_t(1) << 0)) {
+        pos = fix_put_prefix(pos, "262=");
+        pos = fix_put_text(pos, md_req_id);
+    }
+    if (present & (uint64_t(1) << 1)) {
+        pos = fix_put_prefix(pos, "263=");
+        pos = fix_put_char(pos, subscription_request_type);
+    }
+    if (present & (uint64_t(1) << 2)) {
+        pos = fix_put_prefix(pos, "264=");
+        pos = fix_put_int(pos, market_depth);
+    }
+    if (present & (uint64_t(1) << 3)) {
+        pos = fix_put_prefix(pos, "265=");
+        pos = fix_put_int(pos, md_update_type);
+    }
+    if (present & (uint64_t(1) << 4)) {
+        pos = fix_put_prefix(pos, "267=");
+        pos = fix_put_int(pos, no_md_entry_types);
+        pos = fix_put_raw(pos, no_md_entry_types_entries);
+    }
+    if (present & (uint64_t(1) << 5)) {
+        pos = fix_put_prefix(pos, "146=");
+        pos = fix_put_int(pos, no_related_sym);
+        pos = fix_put_raw(pos, no_related_sym_entries);
+    }
+    return pos;
+}
+
+static bool market_data_request_no_md_entry_types_member(int tag) {
+    switch (tag) {
+        case 269:
+            return true;
+        default:
+            return false;
+    }
+}
+
+static bool market_data_request_no_related_sym_member(int tag) {
+    switch (tag) {
+        case 55:
+        case 48:
+        case 22:
+        case 167:
+        case 15:
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool MarketDataRequest::decode(const char* data, size_t size) {
+    present = 0;
+    const char* pos = data;
+    const char* const end = data + size;
+    int tag = 0;
+    FixText value;
+    int group = 0;                  // entries being walked, 1-based
+
+    while (fix_next_field(pos, end, tag, value)) {
+        if (group != 0) {
+            if (group == 1 && market_data_request_no_md_entry_types_member(tag)) {
+                no_md_entry_types_entries.size = static_cast<size_t>(pos - no_md_entry_types_entries.data);
+                continue;
+            }
+            if (group == 2 && market_data_request_no_related_sym_member(tag)) {
+                no_related_sym_entries.size = static_cast<size_t>(pos - no_related_sym_entries.data);
+                continue;
+            }
+            group = 0;
+        }
+
+        switch (tag) {
+            case 262:
+                if (present & (uint64_t(1) << 0)) break;
+                md_req_id = value;
+                present |= (uint64_t(1) << 0);
+                break;
+            case 263:
+                if (present & (uint64_t(1) << 1)) break;
+                if (!fix_get_char(value, subscription_request_type)) return false;
+                present |= (uint64_t(1) << 1);
+                break;
+            case 264:
+                if (present & (uint64_t(1) << 2)) break;
+                if (!fix_get_int(value, market_depth)) return false;
+                present |= (uint64_t(1) << 2);
+                break;
+            case 265:
+                if (present & (uint64_t(1) << 3)) break;
+                if (!fix_get_int(value, md_update_type)) return false;
+                present |= (uint64_t(1) << 3);
+                break;
+            case 267:
+                if (present & (uint64_t(1) << 4)) break;
+                if (!fix_get_int(value, no_md_entry_types)) return false;
+                present |= (uint64_t(1) << 4);
+                no_md_entry_types_entries = FixText(pos, 0);
+                group = 1;
+                break;
+            case 146:
+                if (present & (uint64_t(1) << 5)) break;
+                if (!fix_get_int(value, no_related_sym)) return false;
+                present |= (uint64_t(1) << 5);
+                no_related_sym_entries = FixText(pos, 0);
+                group = 2;
+                break;
+            default:
+                break;
+        }
+    }
+    return pos == end;
+}
+
+size_t MarketDataSnapshotFullRefresh::max_body_size() const {
+    size_t size = 49;
+    if (present & (uint64_t(1) << 0)) size += 5 + md_req_id.size;
+    if (present & (uint64_t(1) << 1)) size += 4 + symbol.size;
+    if (present & (uint64_t(1) << 2)) size += 4 + security_id.size;
+    if (present & (uint64_t(1) << 3)) size += 4 + security_id_source.size;
+    if (present & (uint64_t(1) << 4)) size += 5 + security_type.size;
+    if (present & (uint64_t(1) << 5)) size += 4 + currency.size;
+    if (present & (uint64_t(1) << 7)) size += no_md_entries_entries.size;
+    return size;
+}
+
+char* MarketDataSnapshotFullRefresh::write_body(char* pos) const {
+    if (present & (uint64_t(1) << 0)) {
+        pos = fix_put_prefix(pos, "262=");
+        pos = fix_put_text(pos, md_req_id);
+    }
+    if (present & (uint64_t(1) << 1)) {
+        pos = fix_put_prefix(pos, "55=");
+        pos = fix_put_text(pos, symbol);
+    }
+    if (present & (uint64_t(1) << 2)) {
+        pos = fix_put_prefix(pos, "48=");
+        pos = fix_put_text(pos, security_id);
+    }
+    if (present & (uint64_t(1) << 3)) {
+        pos = fix_put_prefix(pos, "22=");
+        pos = fix_put_text(pos, security_id_source);
+    }
+    if (present & (uint64_t(1) << 4)) {
+        pos = fix_put_prefix(pos, "167=");
+        pos = fix_put_text(pos, security_type);
+    }
+    if (present & (uint64_t(1) << 5)) {
+        pos = fix_put_prefix(pos, "15=");
+        pos = fix_put_text(pos, currency);
+    }
+    if (present & (uint64_t(1) << 6)) {
+        pos = fix_put_prefix(pos, "83=");
+        pos = fix_put_int(pos, rpt_seq);
+    }
+    if (present & (uint64_t(1) << 7)) {
+        pos = fix_put_prefix(pos, "268=");
+        pos = fix_put_int(pos, no_md_entries);
+        pos = fix_put_raw(pos, no_md_entries_entries);
+    }
+    return pos;
+}
+
+static bool market_data_snapshot_full_refresh_no_md_entries_member(int tag) {
+    switch (tag) {
+        case 269:
+        case 270:
+        case 271:
+        case 290:
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool MarketDataSnapshotFullRefresh::decode(const char* data, size_t size) {
+    present = 0;
+    const char* pos = data;
+    const char* const end = data + size;
+    int tag = 0;
+    FixText value;
+    int group = 0;                  // entries being walked, 1-based
+
+    while (fix_next_field(pos, end, tag, value)) {
+        if (group != 0) {
+            if (group == 1 && market_data_snapshot_full_refresh_no_md_entries_member(tag)) {
+                no_md_entries_entries.size = static_cast<size_t>(pos - no_md_entries_entries.data);
+                continue;
+            }
+            group = 0;
+        }
+
+        switch (tag) {
+            case 262:
+                if (present & (uint64_t(1) << 0)) break;
+                md_req_id = value;
+                present |= (uint64_t(1) << 0);
+                break;
+            case 55:
+                if (present & (uint64_t(1) << 1)) break;
+                symbol = value;
+                present |= (uint64_t(1) << 1);
+                break;
+            case 48:
+                if (present & (uint64_t(1) << 2)) break;
+                security_id = value;
+                present |= (uint64_t(1) << 2);
+                break;
+            case 22:
+                if (present & (uint64_t(1) << 3)) break;
+                security_id_source = value;
+                present |= (uint64_t(1) << 3);
+                break;
+            case 167:
+                if (present & (uint64_t(1) << 4)) break;
+                security_type = value;
+                present |= (uint64_t(1) << 4);
+                break;
+            case 15:
+                if (present & (uint64_t(1) << 5)) break;
+                currency = value;
+                present |= (uint64_t(1) << 5);
+                break;
+            case 83:
+                if (present & (uint64_t(1) << 6)) break;
+                if (!fix_get_int(value, rpt_seq)) return false;
+                present |= (uint64_t(1) << 6);
+                break;
+            case 268:
+                if (present & (uint64_t(1) << 7)) break;
+                if (!fix_get_int(value, no_md_entries)) return false;
+                present |= (uint64_t(1) << 7);
+                no_md_entries_entries = FixText(pos, 0);
+                group = 1;
+                break;
+            default:
+                break;
+        }
+    }
+    return pos == end;
+}
+
+size_t MarketDataIncrementalRefresh::max_body_size() const {
+    size_t size = 25;
+    if (present & (uint64_t(1) << 0)) size += 5 + md_req_id.size;
+    if (present & (uint64_t(1) << 1)) size += no_md_entries_entries.size;
+    return size;
+}
+
+char* MarketDataIncrementalRefresh::write_body(char* pos) const {
+    if (present & (uint64_t(1) << 0)) {
+        pos = fix_put_prefix(pos, "262=");
+        pos = fix_put_text(pos, md_req_id);
+    }
+    if (present & (uint64_t(1) << 1)) {
+        pos = fix_put_prefix(pos, "268=");
+        pos = fix_put_int(pos, no_md_entries);
+        pos = fix_put_raw(pos, no_md_entries_entries);
+    }
+    return pos;
+}
+
+static bool market_data_incremental_refresh_no_md_entries_member(int tag) {
+    switch (tag) {
+        case 279:
+        case 269:
+        case 55:
+        case 48:
+        case 22:
+        case 167:
+        case 15:
+        case 83:
+        case 270:
+        case 271:
+        case 290:
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool MarketDataIncrementalRefresh::decode(const char* data, size_t size) {
+    present = 0;
+    const char* pos = data;
+    const char* const end = data + size;
+    int tag = 0;
+    FixText value;
+    int group = 0;                  // entries being walked, 1-based
+
+    while (fix_next_field(pos, end, tag, value)) {
+        if (group != 0) {
+            if (group == 1 && market_data_incremental_refresh_no_md_entries_member(tag)) {
+                no_md_entries_entries.size = static_cast<size_t>(pos - no_md_entries_entries.data);
+                continue;
+            }
+            group = 0;
+        }
+
+        switch (tag) {
+            case 262:
+                if (present & (uint64_t(1) << 0)) break;
+                md_req_id = value;
+                present |= (uint64_t(1) << 0);
+                break;
+            case 268:
+                if (present & (uint64_t(1) << 1)) break;
+                if (!fix_get_int(value, no_md_entries)) return false;
+                present |= (uint64_t(1) << 1);
+                no_md_entries_entries = FixText(pos, 0);
+                group = 1;
+                break;
+            default:
+                break;
+        }
+    }
+    return pos == end;
+}
+
+size_t SecurityDefinitionRequest::max_body_size() const {
+    size_t size = 31;
+    if (present & (uint64_t(1) << 0)) size += 5 + security_req_id.size;
+    if (present & (uint64_t(1) << 2)) size += 4 + symbol.size;
+    if (present & (uint64_t(1) << 3)) size += 4 + security_id.size;
+    if (present & (uint64_t(1) << 4)) size += 4 + security_id_source.size;
+    if (present & (uint64_t(1) << 5)) size += 5 + security_type.size;
+    if (present & (uint64_t(1) << 6)) size += 4 + currency.size;
+    return size;
+}
+
+char* SecurityDefinitionRequest::write_body(char* pos) const {
+    if (present & (uint64_t(1) << 0)) {
+        pos = fix_put_prefix(pos, "320=");
+        pos = fix_put_text(pos, security_req_id);
+    }
+    if (present & (uint64_t(1) << 1)) {
+        pos = fix_put_prefix(pos, "321=");
+        pos = fix_put_int(pos, security_request_type);
+    }
+    if (present & (uint64_t(1) << 2)) {
+        pos = fix_put_prefix(pos, "55=");
+        pos = fix_put_text(pos, symbol);
+    }
+    if (present & (uint64_t(1) << 3)) {
+        pos = fix_put_prefix(pos, "48=");
+        pos = fix_put_text(pos, security_id);
+    }
+    if (present & (uint64_t(1) << 4)) {
+        pos = fix_put_prefix(pos, "22=");
+        pos = fix_put_text(pos, security_id_source);
+    }
+    if (present & (uint64_t(1) << 5)) {
+        pos = fix_put_prefix(pos, "167=");
+        pos = fix_put_text(pos, security_type);
+    }
+    if (present & (uint64_t(1) << 6)) {
+        pos = fix_put_prefix(pos, "15=");
+        pos = fix_put_text(pos, currency);
+    }
+    if (present & (uint64_t(1) << 7)) {
+        pos = fix_put_prefix(pos, "263=");
+        pos = fix_put_char(pos, subscription_request_type);
+    }
+    return pos;
+}
+
+bool SecurityDefinitionRequest::decode(const char* data, size_t size) {
+    present = 0;
+    const char* pos = data;
+    const char* const end = data + size;
+    int tag = 0;
+    FixText value;
+
+    while (fix_next_field(pos, end, tag, value)) {
+        switch (tag) {
+            case 320:
+                if (present & (uint64_t(1) << 0)) break;
+                security_req_id = value;
+                present |= (uint64_t(1) << 0);
+                break;
+            case 321:
+                if (present & (uint64_t(1) << 1)) break;
+                if (!fix_get_int(value, security_request_type)) return false;
+                present |= (uint64_t(1) << 1);
+                break;
+            case 55:
+                if (present & (uint64_t(1) << 2)) break;
+                symbol = value;
+                present |= (uint64_t(1) << 2);
+                break;
+            case 48:
+                if (present & (uint64_t(1) << 3)) break;
+                security_id = value;
+                present |= (uint64_t(1) << 3);
+                break;
+            case 22:
+                if (present & (uint64_t(1) << 4)) break;
+                security_id_source = value;
+                present |= (uint64_t(1) << 4);
+                break;
+            case 167:
+                if (present & (uint64_t(1) << 5)) break;
+                security_type = value;
+                present |= (uint64_t(1) << 5);
+                break;
+            case 15:
+                if (present & (uint64_t(1) << 6)) break;
+                currency = value;
+                present |= (uint64_t(1) << 6);
+                break;
+            case 263:
+                if (present & (uint64_t(1) << 7)) break;
+                if (!fix_get_char(value, subscription_request_type)) return false;
+                present |= (uint64_t(1) << 7);
+                break;
+            default:
+                break;
+        }
+    }
+    return pos == end;
+}
+
+size_t SecurityDefinition::max_body_size() const {
+    size_t size = 103;
+    if (present & (uint64_t(1) << 0)) size += 5 + security_req_id.size;
+    if (present & (uint64_t(1) << 1)) size += 5 + security_response_id.size;
+    if (present & (uint64_t(1) << 3)) size += 4 + symbol.size;
+    if (present & (uint64_t(1) << 4)) size += 4 + security_id.size;
+    if (present & (uint64_t(1) << 5)) size += 4 + security_id_source.size;
+    if (present & (uint64_t(1) << 6)) size += 5 + security_type.size;
+    if (present & (uint64_t(1) << 7)) size += 4 + currency.size;
+    if (present & (uint64_t(1) << 11)) size += 4 + text.size;
+    return size;
+}
+
+char* SecurityDefinition::write_body(char* pos) const {
+    if (present & (uint64_t(1) << 0)) {
+        pos = fix_put_prefix(pos, "320=");
+        pos = fix_put_text(pos, security_req_id);
+    }
+    if (present & (uint64_t(1) << 1)) {
+        pos = fix_put_prefix(pos, "322=");
+        pos = fix_put_text(pos, security_response_id);
+    }
+    if (present & (uint64_t(1) << 2)) {
+        pos = fix_put_prefix(pos, "323=");
+        pos = fix_put_int(pos, security_response_type);
+    }
+    if (present & (uint64_t(1) << 3)) {
+        pos = fix_put_prefix(pos, "55=");
+        pos = fix_put_text(pos, symbol);
+    }
+    if (present & (uint64_t(1) << 4)) {
+        pos = fix_put_prefix(pos, "48=");
+        pos = fix_put_text(pos, security_id);
+    }
+    if (present & (uint64_t(1) << 5)) {
+        pos = fix_put_prefix(pos, "22=");
+        pos = fix_put_text(pos, security_id_source);
+    }
+    if (present & (uint64_t(1) << 6)) {
+        pos = fix_put_prefix(pos, "167=");
+        pos = fix_put_text(pos, security_type);
+    }
+    if (present & (uint64_t(1) << 7)) {
+        pos = fix_put_prefix(pos, "15=");
+        pos = fix_put_text(pos, currency);
+    }
+    if (present & (uint64_t(1) << 8)) {
+        pos = fix_put_prefix(pos, "969=");
+        pos = fix_put_decimal(pos, min_price_increment);
+    }
+    if (present & (uint64_t(1) << 9)) {
+        pos = fix_put_prefix(pos, "561=");
+        pos = fix_put_decimal(pos, round_lot);
+    }
+    if (present & (uint64_t(1) << 10)) {
+        pos = fix_put_prefix(pos, "562=");
+        pos = fix_put_decimal(pos, min_trade_vol);
+    }
+    if (present & (uint64_t(1) << 11)) {
+        pos = fix_put_prefix(pos, "58=");
+        pos = fix_put_text(pos, text);
+    }
+    return pos;
+}
+
+bool SecurityDefinition::decode(const char* data, size_t size) {
+    present = 0;
+    const char* pos = data;
+    const char* const end = data + size;
+    int tag = 0;
+    FixText value;
+
+    while (fix_next_field(pos, end, tag, value)) {
+        switch (tag) {
+            case 320:
+                if (present & (uint64_t(1) << 0)) break;
+                security_req_id = value;
+                present |= (uint64_t(1) << 0);
+                break;
+            case 322:
+                if (present & (uint64_t(1) << 1)) break;
+                security_response_id = value;
+                present |= (uint64_t(1) << 1);
+                break;
+            case 323:
+                if (present & (uint64_t(1) << 2)) break;
+                if (!fix_get_int(value, security_response_type)) return false;
+                present |= (uint64_t(1) << 2);
+                break;
+            case 55:
+                if (present & (uint64_t(1) << 3)) break;
+                symbol = value;
+                present |= (uint64_t(1) << 3);
+                break;
+            case 48:
+                if (present & (uint64_t(1) << 4)) break;
+                security_id = value;
+                present |= (uint64_t(1) << 4);
+                break;
+            case 22:
+                if (present & (uint64_t(1) << 5)) break;
+                security_id_source = value;
+                present |= (uint64_t(1) << 5);
+                break;
+            case 167:
+                if (present & (uint64_t(1) << 6)) break;
+                security_type = value;
+                present |= (uint64_t(1) << 6);
+                break;
+            case 15:
+                if (present & (uint64_t(1) << 7)) break;
+                currency = value;
+                present |= (uint64_t(1) << 7);
+                break;
+            case 969:
+                if (present & (uint64_t(1) << 8)) break;
+                if (!fix_get_decimal(value, min_price_increment)) return false;
+                present |= (uint64_t(1) << 8);
+                break;
+            case 561:
+                if (present & (uint64_t(1) << 9)) break;
+                if (!fix_get_decimal(value, round_lot)) return false;
+                present |= (uint64_t(1) << 9);
+                break;
+            case 562:
+                if (present & (uint64_t(1) << 10)) break;
+                if (!fix_get_decimal(value, min_trade_vol)) return false;
+                present |= (uint64_t(1) << 10);
+                break;
+            case 58:
+                if (present & (uint64_t(1) << 11)) break;
+                text = value;
+                present |= (uint64_t(1) << 11);
+                break;
+            default:
+                break;
+        }
+    }
+    return pos == end;
+}
+
+size_t SecurityStatus::max_body_size() const {
+    size_t size = 103;
+    if (present & (uint64_t(1) << 0)) size += 5 + security_status_req_id.size;
+    if (present & (uint64_t(1) << 1)) size += 4 + symbol.size;
+    if (present & (uint64_t(1) << 2)) size += 4 + security_id.size;
+    if (present & (uint64_t(1) << 3)) size += 4 + security_id_source.size;
+    if (present & (uint64_t(1) << 4)) size += 5 + security_type.size;
+    if (present & (uint64_t(1) << 5)) size += 4 + currency.size;
+    if (present & (uint64_t(1) << 10)) size += 4 + transact_time.size;
+    if (present & (uint64_t(1) << 11)) size += 4 + text.size;
+    return size;
+}
+
+char* SecurityStatus::write_body(char* pos) const {
+    if (present & (uint64_t(1) << 0)) {
+        pos = fix_put_prefix(pos, "324=");
+        pos = fix_put_text(pos, security_status_req_id);
+    }
+    if (present & (uint64_t(1) << 1)) {
+        pos = fix_put_prefix(pos, "55=");
+        pos = fix_put_text(pos, symbol);
+    }
+    if (present & (uint64_t(1) << 2)) {
+        pos = fix_put_prefix(pos, "48=");
+        pos = fix_put_text(pos, security_id);
+    }
+    if (present & (uint64_t(1) << 3)) {
+        pos = fix_put_prefix(pos, "22=");
+        pos = fix_put_text(pos, security_id_source);
+    }
+    if (present & (uint64_t(1) << 4)) {
+        pos = fix_put_prefix(pos, "167=");
+        pos = fix_put_text(pos, security_type);
+    }
+    if (present & (uint64_t(1) << 5)) {
+        pos = fix_put_prefix(pos, "15=");
+        pos = fix_put_text(pos, currency);
+    }
+    if (present & (uint64_t(1) << 6)) {
+        pos = fix_put_prefix(pos, "326=");
+        pos = fix_put_int(pos, security_trading_status);
+    }
+    if (present & (uint64_t(1) << 7)) {
+        pos = fix_put_prefix(pos, "969=");
+        pos = fix_put_decimal(pos, min_price_increment);
+    }
+    if (present & (uint64_t(1) << 8)) {
+        pos = fix_put_prefix(pos, "561=");
+        pos = fix_put_decimal(pos, round_lot);
+    }
+    if (present & (uint64_t(1) << 9)) {
+        pos = fix_put_prefix(pos, "562=");
+        pos = fix_put_decimal(pos, min_trade_vol);
+    }
+    if (present & (uint64_t(1) << 10)) {
+        pos = fix_put_prefix(pos, "60=");
+        pos = fix_put_text(pos, transact_time);
+    }
+    if (present & (uint64_t(1) << 11)) {
+        pos = fix_put_prefix(pos, "58=");
+        pos = fix_put_text(pos, text);
+    }
+    return pos;
+}
+
+bool SecurityStatus::decode(const char* data, size_t size) {
+    present = 0;
+    const char* pos = data;
+    const char* const end = data + size;
+    int tag = 0;
+    FixText value;
+
+    while (fix_next_field(pos, end, tag, value)) {
+        switch (tag) {
+            case 324:
+                if (present & (uint64_t(1) << 0)) break;
+                security_status_req_id = value;
+                present |= (uint64_t(1) << 0);
+                break;
+            case 55:
+                if (present & (uint64_t(1) << 1)) break;
+                symbol = value;
+                present |= (uint64_t(1) << 1);
+                break;
+            case 48:
+                if (present & (uint64_t(1) << 2)) break;
+                security_id = value;
+                present |= (uint64_t(1) << 2);
+                break;
+            case 22:
+                if (present & (uint64_t(1) << 3)) break;
+                security_id_source = value;
+                present |= (uint64_t(1) << 3);
+                break;
+            case 167:
+                if (present & (uint64_t(1) << 4)) break;
+                security_type = value;
+                present |= (uint64_t(1) << 4);
+                break;
+            case 15:
+                if (present & (uint64_t(1) << 5)) break;
+                currency = value;
+                present |= (uint64_t(1) << 5);
+                break;
+            case 326:
+                if (present & (uint64_t(1) << 6)) break;
+                if (!fix_get_int(value, security_trading_status)) return false;
+                present |= (uint64_t(1) << 6);
+                break;
+            case 969:
+                if (present & (uint64_t(1) << 7)) break;
+                if (!fix_get_decimal(value, min_price_increment)) return false;
+                present |= (uint64_t(1) << 7);
+                break;
+            case 561:
+                if (present & (uint64_t(1) << 8)) break;
+                if (!fix_get_decimal(value, round_lot)) return false;
+                present |= (uint64_t(1) << 8);
+                break;
+            case 562:
+                if (present & (uint64_t(1) << 9)) break;
+                if (!fix_get_decimal(value, min_trade_vol)) return false;
+                present |= (uint64_t(1) << 9);
+                break;
+            case 60:
+                if (present & (uint64_t(1) << 10)) break;
+                transact_time = value;
+                present |= (uint64_t(1) << 10);
+                break;
+            case 58:
+                if (present & (uint64_t(1) << 11)) break;
+                text = value;
+                present |= (uint64_t(1) << 11);
+                break;
+            default:
+                break;
+        }
+    }
+    return pos == end;
+}
+
+size_t SecurityListRequest::max_body_size() const {
+    size_t size = 31;
+    if (present & (uint64_t(1) << 0)) size += 5 + security_req_id.size;
+    if (present & (uint64_t(1) << 2)) size += 4 + symbol.size;
+    if (present & (uint64_t(1) << 3)) size += 4 + security_id.size;
+    if (present & (uint64_t(1) << 4)) size += 4 + security_id_source.size;
+    if (present & (uint64_t(1) << 5)) size += 5 + security_type.size;
+    if (present & (uint64_t(1) << 6)) size += 4 + currency.size;
+    return size;
+}
+
+char* SecurityListRequest::write_body(char* pos) const {
+    if (present & (uint64_t(1) << 0)) {
+        pos = fix_put_prefix(pos, "320=");
+        pos = fix_put_text(pos, security_req_id);
+    }
+    if (present & (uint64_t(1) << 1)) {
+        pos = fix_put_prefix(pos, "559=");
+        pos = fix_put_int(pos, security_list_request_type);
+    }
+    if (present & (uint64_t(1) << 2)) {
+        pos = fix_put_prefix(pos, "55=");
+        pos = fix_put_text(pos, symbol);
+    }
+    if (present & (uint64_t(1) << 3)) {
+        pos = fix_put_prefix(pos, "48=");
+        pos = fix_put_text(pos, security_id);
+    }
+    if (present & (uint64_t(1) << 4)) {
+        pos = fix_put_prefix(pos, "22=");
+        pos = fix_put_text(pos, security_id_source);
+    }
+    if (present & (uint64_t(1) << 5)) {
+        pos = fix_put_prefix(pos, "167=");
+        pos = fix_put_text(pos, security_type);
+    }
+    if (present & (uint64_t(1) << 6)) {
+        pos = fix_put_prefix(pos, "15=");
+        pos = fix_put_text(pos, currency);
+    }
+    if (present & (uint64_t(1) << 7)) {
+        pos = fix_put_prefix(pos, "263=");
+        pos = fix_put_char(pos, subscription_request_type);
+    }
+    return pos;
+}
+
+bool SecurityListRequest::decode(const char* data, size_t size) {
+    present = 0;
+    const char* pos = data;
+    const char* const end = data + size;
+    int tag = 0;
+    FixText value;
+
+    while (fix_next_field(pos, end, tag, value)) {
+        switch (tag) {
+            case 320:
+                if (present & (uint64_t(1) << 0)) break;
+                security_req_id = value;
+                present |= (uint64_t(1) << 0);
+                break;
+            case 559:
+                if (present & (uint64_t(1) << 1)) break;
+                if (!fix_get_int(value, security_list_request_type)) return false;
+                present |= (uint64_t(1) << 1);
+                break;
+            case 55:
+                if (present & (uint64_t(1) << 2)) break;
+                symbol = value;
+                present |= (uint64_t(1) << 2);
+                break;
+            case 48:
+                if (present & (uint64_t(1) << 3)) break;
+                security_id = value;
+                present |= (uint64_t(1) << 3);
+                break;
+            case 22:
+                if (present & (uint64_t(1) << 4)) break;
+                security_id_source = value;
+                present |= (uint64_t(1) << 4);
+                break;
+            case 167:
+                if (present & (uint64_t(1) << 5)) break;
+                security_type = value;
+                present |= (uint64_t(1) << 5);
+                break;
+            case 15:
+                if (present & (uint64_t(1) << 6)) break;
+                currency = value;
+                present |= (uint64_t(1) << 6);
+                break;
+            case 263:
+                if (present & (uint64_t(1) << 7)) break;
+                if (!fix_get_char(value, subscription_request_type)) return false;
+                present |= (uint64_t(1) << 7);
+                break;
+            default:
+                break;
+        }
+    }
+    return pos == end;
+}
+
+size_t SecurityList::max_body_size() const {
+    size_t size = 81;
+    if (present & (uint64_t(1) << 0)) size += 5 + security_req_id.size;
+    if (present & (uint64_t(1) << 1)) size += 5 + security_response_id.size;
+    if (present & (uint64_t(1) << 5)) size += no_related_sym_entries.size;
+    return size;
+}
+
+char* SecurityList::write_body(char* pos) const {
+    if (present & (uint64_t(1) << 0)) {
+        pos = fix_put_prefix(pos, "320=");
+        pos = fix_put_text(pos, security_req_id);
+    }
+    if (present & (uint64_t(1) << 1)) {
+        pos = fix_put_prefix(pos, "322=");
+        pos = fix_put_text(pos, security_response_id);
+    }
+    if (present & (uint64_t(1) << 2)) {
+        pos = fix_put_prefix(pos, "560=");
+        pos = fix_put_int(pos, security_request_result);
+    }
+    if (present & (uint64_t(1) << 3)) {
+        pos = fix_put_prefix(pos, "393=");
+        pos = fix_put_int(pos, tot_no_related_sym);
+    }
+    if (present & (uint64_t(1) << 4)) {
+        pos = fix_put_prefix(pos, "893=");
+        pos = fix_put_bool(pos, last_fragment);
+    }
+    if (present & (uint64_t(1) << 5)) {
+        pos = fix_put_prefix(pos, "146=");
+        pos = fix_put_int(pos, no_related_sym);
+        pos = fix_put_raw(pos, no_related_sym_entries);
+    }
+    return pos;
+}
+
+static bool security_list_no_related_sym_member(int tag) {
+    switch (tag) {
+        case 55:
+        case 48:
+        case 22:
+        case 167:
+        case 15:
+        case 969:
+        case 561:
+        case 562:
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool SecurityList::decode(const char* data, size_t size) {
+    present = 0;
+    const char* pos = data;
+    const char* const end = data + size;
+    int tag = 0;
+    FixText value;
+    int group = 0;                  // entries being walked, 1-based
+
+    while (fix_next_field(pos, end, tag, value)) {
+        if (group != 0) {
+            if (group == 1 && security_list_no_related_sym_member(tag)) {
+                no_related_sym_entries.size = static_cast<size_t>(pos - no_related_sym_entries.data);
+                continue;
+            }
+            group = 0;
+        }
+
+        switch (tag) {
+            case 320:
+                if (present & (uint64_t(1) << 0)) break;
+                security_req_id = value;
+                present |= (uint64_t(1) << 0);
+                break;
+            case 322:
+                if (present & (uint64_t(1) << 1)) break;
+                security_response_id = value;
+                present |= (uint64_t(1) << 1);
+                break;
+            case 560:
+                if (present & (uint64_t(1) << 2)) break;
+                if (!fix_get_int(value, security_request_result)) return false;
+                present |= (uint64_t(1) << 2);
+                break;
+            case 393:
+                if (present & (uint64_t(1) << 3)) break;
+                if (!fix_get_int(value, tot_no_related_sym)) return false;
+                present |= (uint64_t(1) << 3);
+                break;
+            case 893:
+                if (present & (uint64_t(1) << 4)) break;
+                if (!fix_get_bool(value, last_fragment)) return false;
+                present |= (uint64_t(1) << 4);
+                break;
+            case 146:
+                if (present & (uint64_t(1) << 5)) break;
+                if (!fix_get_int(value, no_related_sym)) return false;
+                present |= (uint64_t(1) << 5);
+                no_related_sym_entries = FixText(pos, 0);
+                group = 1;
+                break;
+            default:
+                break;
+        }
+    }
+    return pos == end;
+}
+
+}
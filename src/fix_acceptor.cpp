@@ -0,0 +1,465 @@
+#include "fix_acceptor.h"
+#include "transport.h"
+#include "utils.h"
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/epoll.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <netdb.h>
+#include <signal.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <set>
+
+static const int max_events = 64;
+static const int tick_ms = 100;
+static const int max_reactor_threads = 256;
+
+// Below this many messages per second between
+// the busiest and the least busy reactor the
+// traffic is left where it is
+static const uint64_t min_rebalance_rate = 1000;
+
+// Sessions moved per rebalancing round
+static const int max_moves = 8;
+
+static volatile sig_atomic_t stop_signal = 0;
+static volatile sig_atomic_t report_signal = 0;
+
+static void on_stop_signal(int) {
+    stop_signal = 1;
+}
+
+static void on_report_signal(int) {
+    report_signal = 1;
+}
+
+FixAcceptor::FixAcceptor() : listen_fd(-1), epoll_fd(-1), logon_timeout_ms(0),
+                             rebalance_interval_s(0), reported_ns(0) {}
+
+FixAcceptor::~FixAcceptor() {
+    for (size_t i = 0; i < reactors.size(); ++i) {
+        reactors[i]->stop();
+    }
+    for (size_t i = 0; i < reactors.size(); ++i) {
+        delete reactors[i];
+    }
+
+    if (listen_fd >= 0) ::close(listen_fd);
+    if (epoll_fd >= 0) ::close(epoll_fd);
+    if (!unix_path.empty()) ::unlink(unix_path.c_str());
+}
+
+bool FixAcceptor::open_listener(const SessionConfig& listen_config) {
+    std::string address;
+    const TransportKind transport = parse_transport_host(listen_config.host, address);
+
+    if (transport == transport_inproc) {
+        std::printf("Error: host=inproc cannot accept connections\n");
+        return false;
+    }
+
+    if (transport == transport_unix) {
+        sockaddr_un addr;
+        if (address.empty() || address.size() >= sizeof(addr.sun_path)) {
+            std::printf("Error: invalid unix socket path\n");
+            return false;
+        }
+
+        listen_fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0);
+        if (listen_fd < 0) return false;
+
+        std::memset(&addr, 0, sizeof(addr));
+        addr.sun_family = AF_UNIX;
+        std::memcpy(addr.sun_path, address.c_str(), address.size());
+
+        // Stale socket file of an earlier run
+        ::unlink(address.c_str());
+        if (::bind(listen_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 ||
+            ::listen(listen_fd, SOMAXCONN) != 0) {
+            std::printf("Error: cannot listen on unix:%s (%s)\n", address.c_str(), std::strerror(errno));
+            return false;
+        }
+
+        unix_path = address;
+        std::printf("Info: Listening on unix:%s\n", address.c_str());
+        return true;
+    }
+
+    addrinfo hints;
+    std::memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_flags = AI_PASSIVE;
+
+    char port_buf[16];
+    std::snprintf(port_buf, sizeof(port_buf), "%d", listen_config.port);
+
+    // Empty host = every local address
+    addrinfo* result = 0;
+    if (::getaddrinfo(address.empty() ? 0 : address.c_str(), port_buf, &hints, &result) != 0) {
+        std::printf("Error: cannot resolve %s\n", address.c_str());
+        return false;
+    }
+
+    for (addrinfo* ai = result; ai != 0; ai = ai->ai_next) {
+        listen_fd = ::socket(ai->ai_family, ai->ai_socktype | SOCK_NONBLOCK, ai->ai_protocol);
+        if (listen_fd < 0) continue;
+
+        const int reuse = 1;
+        ::setsockopt(listen_fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+        if (::bind(listen_fd, ai->ai_addr, ai->ai_addrlen) == 0 &&
+            ::listen(listen_fd, SOMAXCONN) == 0) {
+            break;
+        }
+
+        ::close(listen_fd);
+        listen_fd = -1;
+    }
+    ::freeaddrinfo(result);
+
+    if (listen_fd < 0) {
+        std::printf("Error: cannot listen on %s:%d (%s)\n", address.c_str(), listen_config.port,
+                    std::strerror(errno));
+        return false;
+    }
+
+    std::printf("Info: Listening on %s:%d\n", address.empty() ? "*" : address.c_str(), listen_config.port);
+    return true;
+}
+
+int FixAcceptor::run(const SessionConfig& listen_config, const std::vector<SessionConfig>& sections) {
+    if (listen_config.reactor_threads < 1 || listen_config.reactor_threads > max_reactor_threads) {
+        std::printf("Error: reactor_threads must be 1..%d\n", max_reactor_threads);
+        return 1;
+    }
+
+    // Every acceptor section on the same
+    // address is served by this process
+    std::vector<SessionConfig> configs;
+    for (size_t i = 0; i < sections.size(); ++i) {
+        const SessionConfig& section = sections[i];
+        if (section.connection_type != "acceptor" || section.host != listen_config.host ||
+            section.port != listen_config.port) {
+            continue;
+        }
+
+        if (section.acceptor_role != "venue" && section.acceptor_role != "drop_copy") {
+            std::printf("Error: [%s] acceptor_role must be venue or drop_copy\n", section.name.c_str());
+            return 1;
+        }
+        if (section.heartbeat_interval <= 0) {
+            std::printf("Error: [%s] heartbeat_interval must be > 0\n", section.name.c_str());
+            return 1;
+        }
+        if (section.session_weight <= 0) {
+            std::printf("Error: [%s] session_weight must be > 0\n", section.name.c_str());
+            return 1;
+        }
+        configs.push_back(section);
+    }
+
+    logon_timeout_ms = static_cast<uint64_t>(listen_config.heartbeat_interval) * 1000ULL;
+    registry.configure(configs, listen_config.reactor_threads);
+
+    if (!open_listener(listen_config)) {
+        return 1;
+    }
+
+    epoll_fd = ::epoll_create1(0);
+    if (epoll_fd < 0) {
+        std::printf("Error: epoll_create1 failed\n");
+        return 1;
+    }
+
+    epoll_event listen_event;
+    std::memset(&listen_event, 0, sizeof(listen_event));
+    listen_event.events = EPOLLIN;
+    listen_event.data.fd = listen_fd;
+    if (::epoll_ctl(epoll_fd, EPOLL_CTL_ADD, listen_fd, &listen_event) != 0) {
+        std::printf("Error: epoll_ctl failed\n");
+        return 1;
+    }
+
+    for (size_t i = 0; i < configs.size(); ++i) {
+        std::printf("Info: [%s] %s %s <- %s, weight %d\n", configs[i].name.c_str(),
+                    configs[i].acceptor_role.c_str(), configs[i].sender_comp_id.c_str(),
+                    configs[i].target_comp_id.empty() ? "*" : configs[i].target_comp_id.c_str(),
+                    configs[i].session_weight);
+    }
+
+    // No SA_RESTART: epoll_wait
+    // returns EINTR on the signal
+    struct sigaction action;
+    std::memset(&action, 0, sizeof(action));
+    sigemptyset(&action.sa_mask);
+    action.sa_handler = on_stop_signal;
+    ::sigaction(SIGINT, &action, 0);
+    ::sigaction(SIGTERM, &action, 0);
+    action.sa_handler = on_report_signal;
+    ::sigaction(SIGUSR1, &action, 0);
+    ::signal(SIGPIPE, SIG_IGN);
+
+    // Reactor threads inherit the mask, so
+    // the signals land on this thread
+    sigset_t blocked;
+    sigemptyset(&blocked);
+    sigaddset(&blocked, SIGINT);
+    sigaddset(&blocked, SIGTERM);
+    sigaddset(&blocked, SIGUSR1);
+    ::pthread_sigmask(SIG_BLOCK, &blocked, 0);
+
+    for (int i = 0; i < listen_config.reactor_threads; ++i) {
+        reactors.push_back(new AcceptorReactor(i, registry, logon_timeout_ms));
+    }
+    for (size_t i = 0; i < reactors.size(); ++i) {
+        reactors[i]->set_peers(reactors);
+        if (!reactors[i]->start()) {
+            std::printf("Error: cannot start reactor %zu\n", i);
+            return 1;
+        }
+    }
+
+    ::pthread_sigmask(SIG_UNBLOCK, &blocked, 0);
+    std::printf("Info: %zu reactor(s)\n", reactors.size());
+    std::fflush(stdout);
+
+    reported.assign(reactors.size(), ReactorLoad());
+    for (size_t i = 0; i < reactors.size(); ++i) {
+        reported[i] = reactors[i]->load();
+    }
+    reported_ns = utils::get_realtime_nanos();
+
+    rebalance_interval_s = static_cast<uint64_t>(listen_config.rebalance_interval > 0 ?
+                                                 listen_config.rebalance_interval : 0);
+    const uint64_t rebalance_ms = rebalance_interval_s * 1000ULL;
+    uint64_t last_rebalance_ms = utils::get_monotonic_millis();
+    epoll_event events[max_events];
+
+    while (!stop_signal) {
+        const int count = ::epoll_wait(epoll_fd, events, max_events, tick_ms);
+        if (count < 0 && errno != EINTR) {
+            std::printf("Error: epoll_wait failed\n");
+            break;
+        }
+        if (count > 0) {
+            accept_connections();
+        }
+
+        if (report_signal) {
+            report_signal = 0;
+            report_load();
+        }
+
+        const uint64_t now_ms = utils::get_monotonic_millis();
+        if (rebalance_ms > 0 && now_ms - last_rebalance_ms >= rebalance_ms) {
+            rebalance();
+            last_rebalance_ms = now_ms;
+        }
+    }
+
+    std::printf("Info: stopping\n");
+    std::fflush(stdout);
+    for (size_t i = 0; i < reactors.size(); ++i) {
+        reactors[i]->stop();
+    }
+    report_load();
+    return 0;
+}
+
+// New connections go to the reactor with the
+// fewest; at Logon they move to their session's
+void FixAcceptor::accept_connections() {
+    for (;;) {
+        sockaddr_storage addr;
+        socklen_t addr_len = sizeof(addr);
+        const int fd = ::accept4(listen_fd, reinterpret_cast<sockaddr*>(&addr), &addr_len, SOCK_NONBLOCK);
+        if (fd < 0) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                std::printf("Error: accept failed (%s)\n", std::strerror(errno));
+            }
+            return;
+        }
+
+        AcceptorConnection* conn = new AcceptorConnection();
+        conn->fd = fd;
+        conn->accepted_ms = utils::get_monotonic_millis();
+        conn->last_send_ms = conn->accepted_ms;
+        conn->last_recv_ms = conn->accepted_ms;
+
+        if (addr.ss_family == AF_UNIX) {
+            conn->peer = "unix";
+        } else {
+            const int no_delay = 1;
+            ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &no_delay, sizeof(no_delay));
+
+            char host[NI_MAXHOST];
+            char port[NI_MAXSERV];
+            if (::getnameinfo(reinterpret_cast<sockaddr*>(&addr), addr_len, host, sizeof(host),
+                              port, sizeof(port), NI_NUMERICHOST | NI_NUMERICSERV) == 0) {
+                conn->peer = std::string(host) + ":" + port;
+            }
+        }
+
+        size_t target = 0;
+        uint64_t fewest = reactors[0]->load().connections;
+        for (size_t i = 1; i < reactors.size(); ++i) {
+            const uint64_t connections = reactors[i]->load().connections;
+            if (connections < fewest) {
+                fewest = connections;
+                target = i;
+            }
+        }
+        reactors[target]->adopt(conn);
+    }
+}
+
+static size_t busiest(const std::vector<uint64_t>& values) {
+    size_t found = 0;
+    for (size_t i = 1; i < values.size(); ++i) {
+        if (values[i] > values[found]) found = i;
+    }
+    return found;
+}
+
+static size_t least_busy(const std::vector<uint64_t>& values) {
+    size_t found = 0;
+    for (size_t i = 1; i < values.size(); ++i) {
+        if (values[i] < values[found]) found = i;
+    }
+    return found;
+}
+
+// Messages since the last round decide the
+// load. The busiest reactor, when well above
+// the least busy one, hands over the session
+// that closes most of the gap without
+// overshooting it. Otherwise sessions with no
+// traffic even out the connected weight. A
+// session first seen this round has no rate
+// yet and is left where it logged on.
+void FixAcceptor::rebalance() {
+    std::vector<std::vector<AcceptorSession*> > by_reactor;
+    std::vector<int> weight_sum;
+    registry.snapshot(by_reactor, weight_sum);
+
+    std::map<AcceptorSession*, uint64_t> current;
+    std::map<AcceptorSession*, uint64_t> delta;
+    std::set<AcceptorSession*> unseen;
+    std::vector<uint64_t> load(reactors.size(), 0);
+    std::vector<uint64_t> weight(reactors.size(), 0);
+
+    for (size_t r = 0; r < by_reactor.size(); ++r) {
+        weight[r] = static_cast<uint64_t>(weight_sum[r]);
+
+        for (size_t i = 0; i < by_reactor[r].size(); ++i) {
+            AcceptorSession* session = by_reactor[r][i];
+            const uint64_t messages = session->messages.load(std::memory_order_relaxed);
+
+            std::map<AcceptorSession*, uint64_t>::const_iterator seen = session_messages.find(session);
+            const uint64_t previous = (seen != session_messages.end()) ? seen->second : messages;
+            if (seen == session_messages.end()) unseen.insert(session);
+
+            current[session] = messages;
+            delta[session] = messages - previous;
+            load[r] += messages - previous;
+        }
+    }
+    session_messages.swap(current);
+
+    if (reactors.size() < 2) {
+        return;
+    }
+
+    const uint64_t min_gap = min_rebalance_rate * rebalance_interval_s;
+
+    for (int moves = 0; moves < max_moves; ++moves) {
+        size_t from = busiest(load);
+        size_t to = least_busy(load);
+        AcceptorSession* chosen = 0;
+        const char* reason = "overloaded";
+
+        const uint64_t gap = load[from] - load[to];
+        if (gap >= min_gap && load[to] * 4 < load[from] * 3) {
+            uint64_t best = 0;
+            for (size_t i = 0; i < by_reactor[from].size(); ++i) {
+                if (unseen.count(by_reactor[from][i])) continue;
+                const uint64_t messages = delta[by_reactor[from][i]];
+                if (messages > best && messages <= gap / 2) {
+                    best = messages;
+                    chosen = by_reactor[from][i];
+                }
+            }
+        }
+
+        if (!chosen) {
+            from = busiest(weight);
+            to = least_busy(weight);
+            reason = "idle";
+
+            const uint64_t weight_gap = weight[from] - weight[to];
+            for (size_t i = 0; i < by_reactor[from].size(); ++i) {
+                AcceptorSession* session = by_reactor[from][i];
+                if (unseen.count(session)) continue;
+                if (delta[session] == 0 && static_cast<uint64_t>(session->weight) * 2 <= weight_gap) {
+                    chosen = session;
+                    break;
+                }
+            }
+        }
+
+        if (!chosen) {
+            break;
+        }
+
+        reactors[from]->migrate(chosen, static_cast<int>(to));
+
+        std::vector<AcceptorSession*>& source = by_reactor[from];
+        for (size_t i = 0; i < source.size(); ++i) {
+            if (source[i] == chosen) {
+                source.erase(source.begin() + static_cast<std::ptrdiff_t>(i));
+                break;
+            }
+        }
+        by_reactor[to].push_back(chosen);
+
+        load[from] -= delta[chosen];
+        load[to] += delta[chosen];
+        weight[from] -= static_cast<uint64_t>(chosen->weight);
+        weight[to] += static_cast<uint64_t>(chosen->weight);
+
+        std::printf("Info: [%s] reactor %zu -> %zu (%s, %llu msgs)\n", chosen->name.c_str(), from, to,
+                    reason, static_cast<unsigned long long>(delta[chosen]));
+    }
+    std::fflush(stdout);
+}
+
+// Rates since the previous report
+void FixAcceptor::report_load() {
+    const uint64_t now_ns = utils::get_realtime_nanos();
+    const double elapsed_s = static_cast<double>(now_ns - reported_ns) / 1e9;
+
+    for (size_t i = 0; i < reactors.size(); ++i) {
+        const ReactorLoad current = reactors[i]->load();
+        const ReactorLoad& previous = reported[i];
+
+        const double in_rate = elapsed_s > 0 ? static_cast<double>(current.messages_in - previous.messages_in) / elapsed_s : 0;
+        const double out_rate = elapsed_s > 0 ? static_cast<double>(current.messages_out - previous.messages_out) / elapsed_s : 0;
+        const double busy_pct = elapsed_s > 0 ? static_cast<double>(current.busy_ns - previous.busy_ns) / (elapsed_s * 1e7) : 0;
+
+        std::printf("Info: reactor %zu connections=%llu sessions=%llu in=%.0f/s out=%.0f/s busy=%.0f%% moved_in=%llu\n",
+                    i, static_cast<unsigned long long>(current.connections),
+                    static_cast<unsigned long long>(current.sessions), in_rate, out_rate, busy_pct,
+                    static_cast<unsigned long long>(current.migrated_in));
+        reported[i] = current;
+    }
+
+    reported_ns = now_ns;
+    std::fflush(stdout);
+}
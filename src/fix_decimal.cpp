@@ -0,0 +1,211 @@
+#include "fix_decimal.h"
+#include "constants.h"
+
+static const int64_t pow10_table[fix_decimal_max_digits + 1] = {
+    1LL,
+    10LL,
+    100LL,
+    1000LL,
+    10000LL,
+    100000LL,
+    1000000LL,
+    10000000LL,
+    100000000LL,
+    1000000000LL,
+    10000000000LL,
+    100000000000LL,
+    1000000000000LL,
+    10000000000000LL,
+    100000000000000LL,
+    1000000000000000LL,
+    10000000000000000LL,
+    100000000000000000LL,
+    1000000000000000000LL
+};
+
+bool fix_decimal_parse(const char* text, size_t len, FixDecimal& value) {
+    if (!text || len == 0) return false;
+
+    const bool negative = (text[0] == '-');
+    size_t pos = negative ? 1 : 0;
+
+    uint64_t mantissa = 0;
+    int digits = 0;
+    int scale = 0;
+    int seen_dot = 0;
+    int int_digits = 0;
+    int frac_digits = 0;
+
+    // Fraction zeros wait here until a nonzero
+    // digit follows, trailing ones never count
+    int zeros = 0;
+
+    for (; pos < len; ++pos) {
+        const unsigned int d = static_cast<unsigned int>(static_cast<unsigned char>(text[pos])) - '0';
+        if (d < 10) {
+            if (seen_dot) {
+                frac_digits++;
+                if (d == 0) {
+                    zeros++;
+                    continue;
+                }
+                for (; zeros > 0; --zeros) {
+                    digits += (mantissa != 0);
+                    mantissa *= 10;
+                    scale++;
+                }
+            } else {
+                int_digits++;
+            }
+
+            // Leading zeros are not significant
+            digits += (mantissa != 0 || d != 0);
+            mantissa = mantissa * 10 + d;
+            scale += seen_dot;
+            continue;
+        }
+
+        if (text[pos] == '.' && !seen_dot) {
+            seen_dot = 1;
+            continue;
+        }
+        return false;
+    }
+
+    if (int_digits == 0 || (seen_dot && frac_digits == 0) ||
+        digits > fix_decimal_max_digits || scale > fix_decimal_max_digits) {
+        return false;
+    }
+
+    value.mantissa = negative ? -static_cast<int64_t>(mantissa) : static_cast<int64_t>(mantissa);
+    value.scale = scale;
+    fix_decimal_normalize(value);
+    return true;
+}
+
+bool fix_decimal_parse(const std::string& text, FixDecimal& value) {
+    return fix_decimal_parse(text.data(), text.size(), value);
+}
+
+void fix_decimal_normalize(FixDecimal& value) {
+    if (value.mantissa == 0) {
+        value.scale = 0;
+        return;
+    }
+
+    while (value.scale > 0 && (value.mantissa % 10) == 0) {
+        value.mantissa /= 10;
+        value.scale--;
+    }
+}
+
+size_t fix_decimal_format(const FixDecimal& value, char* out) {
+    const bool negative = value.mantissa < 0;
+    uint64_t abs_value = negative ? (0ULL - static_cast<uint64_t>(value.mantissa))
+                                  : static_cast<uint64_t>(value.mantissa);
+
+    // Reversed digits, at least scale + 1
+    // so 0.05 keeps its leading "0."
+    char digits[24];
+    int count = 0;
+    do {
+        digits[count++] = static_cast<char>('0' + (abs_value % 10));
+        abs_value /= 10;
+    } while (abs_value != 0 || count <= value.scale);
+
+    size_t len = 0;
+    if (negative) out[len++] = '-';
+
+    for (int i = count - 1; i >= 0; --i) {
+        if (i == value.scale - 1) out[len++] = '.';
+        out[len++] = digits[i];
+    }
+    return len;
+}
+
+std::string fix_decimal_to_string(const FixDecimal& value) {
+    char buf[32];
+    const size_t len = fix_decimal_format(value, buf);
+    return std::string(buf, len);
+}
+
+// Bring mantissa to a larger scale,
+// False when it no longer fits int64
+static bool rescale(const FixDecimal& value, int scale, int64_t& mantissa) {
+    const int diff = scale - value.scale;
+    if (diff == 0) {
+        mantissa = value.mantissa;
+        return true;
+    }
+
+    if (diff < 0 || diff > fix_decimal_max_digits) return false;
+
+    const int64_t factor = pow10_table[diff];
+    const int64_t limit = INT64_MAX / factor;
+    if (value.mantissa > limit || value.mantissa < -limit) return false;
+
+    mantissa = value.mantissa * factor;
+    return true;
+}
+
+int fix_decimal_compare(const FixDecimal& lhs, const FixDecimal& rhs) {
+    const int scale = lhs.scale > rhs.scale ? lhs.scale : rhs.scale;
+
+    int64_t lhs_m = 0;
+    int64_t rhs_m = 0;
+
+    // Overflow on rescale means that side
+    // has the larger magnitude
+    if (!rescale(lhs, scale, lhs_m)) return lhs.mantissa < 0 ? -1 : 1;
+    if (!rescale(rhs, scale, rhs_m)) return rhs.mantissa < 0 ? 1 : -1;
+
+    return (lhs_m > rhs_m) - (lhs_m < rhs_m);
+}
+
+bool fix_decimal_add(const FixDecimal& lhs, const FixDecimal& rhs, FixDecimal& out) {
+    const int scale = lhs.scale > rhs.scale ? lhs.scale : rhs.scale;
+
+    int64_t lhs_m = 0;
+    int64_t rhs_m = 0;
+    if (!rescale(lhs, scale, lhs_m) || !rescale(rhs, scale, rhs_m)) return false;
+
+    int64_t sum = 0;
+    if (__builtin_add_overflow(lhs_m, rhs_m, &sum)) return false;
+
+    out.mantissa = sum;
+    out.scale = scale;
+    fix_decimal_normalize(out);
+    return true;
+}
+
+bool fix_decimal_sub(const FixDecimal& lhs, const FixDecimal& rhs, FixDecimal& out) {
+    if (rhs.mantissa == INT64_MIN) return false;
+    return fix_decimal_add(lhs, FixDecimal(-rhs.mantissa, rhs.scale), out);
+}
+
+bool fix_int_parse(const char* text, size_t len, int64_t& value) {
+    FixDecimal decimal;
+    if (!fix_decimal_parse(text, len, decimal) || decimal.scale != 0) {
+        return false;
+    }
+    value = decimal.mantissa;
+    return true;
+}
+
+size_t fix_int_format(int64_t value, char* out) {
+    return fix_decimal_format(FixDecimal(value, 0), out);
+}
+
+bool fix_is_decimal_tag(int tag) {
+    switch (tag) {
+        case fix_tag_price:
+        case fix_tag_order_qty:
+        case fix_tag_cum_qty:
+        case fix_tag_leaves_qty:
+        case fix_tag_avg_px:
+        case fix_tag_cash_order_qty:
+            return true;
+        default:
+            return false;
+    }
+}
@@ -0,0 +1,244 @@
+#include "fix_dictionary.h"
+#include "xml_reader.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <map>
+
+// Elements are kept as a tree until the whole
+// file is read, <fields> and <components> come
+// after the messages that use them
+struct XmlNode {
+    XmlTag tag;
+    std::vector<XmlNode> children;
+};
+
+static bool read_children(const std::string& xml, size_t& pos, XmlNode& node, std::string& error) {
+    if (node.tag.self_closing) return true;
+
+    XmlTag tag;
+    while (xml_next_tag(xml, pos, tag, error)) {
+        if (tag.closing) {
+            if (tag.name != node.tag.name) {
+                error = "</" + tag.name + "> closes <" + node.tag.name + ">";
+                return false;
+            }
+            return true;
+        }
+        node.children.push_back(XmlNode());
+        node.children.back().tag = tag;
+        if (!read_children(xml, pos, node.children.back(), error)) return false;
+    }
+    if (error.empty()) error = "<" + node.tag.name + "> not closed";
+    return false;
+}
+
+static const XmlNode* child_named(const XmlNode& node, const char* name) {
+    for (size_t i = 0; i < node.children.size(); ++i) {
+        if (node.children[i].tag.name == name) return &node.children[i];
+    }
+    return 0;
+}
+
+static FixFieldType field_type(const std::string& type_name) {
+    static const char* const decimals[] = { "PRICE", "QTY", "FLOAT", "AMT", "PRICEOFFSET", "PERCENTAGE" };
+    for (size_t i = 0; i < sizeof(decimals) / sizeof(decimals[0]); ++i) {
+        if (type_name == decimals[i]) return fix_type_decimal;
+    }
+    if (type_name == "CHAR") return fix_type_char;
+    if (type_name == "INT" || type_name == "SEQNUM" || type_name == "LENGTH" ||
+        type_name == "NUMINGROUP" || type_name == "DAYOFMONTH") return fix_type_int;
+    if (type_name == "BOOLEAN") return fix_type_boolean;
+    if (type_name == "UTCTIMESTAMP") return fix_type_timestamp;
+    return fix_type_string;
+}
+
+bool FixFieldDef::allows(const char* data, size_t size) const {
+    if (values.empty()) return true;
+    for (size_t i = 0; i < values.size(); ++i) {
+        if (values[i].size() == size && std::memcmp(values[i].data(), data, size) == 0) return true;
+    }
+    return false;
+}
+
+// Field and component names to tags
+struct Resolver {
+    const FixDictionary& dictionary;
+    std::map<std::string, const XmlNode*> components;
+    std::string& error;
+
+    Resolver(const FixDictionary& dict, std::string& err) : dictionary(dict), error(err) {}
+
+    // Appends the members of node to members,
+    // groups to message.groups. Components nest,
+    // depth stops a component including itself.
+    bool add_members(const XmlNode& node, bool required, FixMessageDef& message,
+                     std::vector<FixMemberDef>& members, int depth) {
+        if (depth > 16) {
+            error = "components nested too deep under " + node.tag.attr("name");
+            return false;
+        }
+
+        for (size_t i = 0; i < node.children.size(); ++i) {
+            const XmlTag& tag = node.children[i].tag;
+            const std::string name = tag.attr("name");
+            const bool member_required = required && tag.attr("required") == "Y";
+
+            if (tag.name == "component") {
+                const std::map<std::string, const XmlNode*>::const_iterator it = components.find(name);
+                if (it == components.end()) {
+                    error = "unknown component " + name;
+                    return false;
+                }
+                if (!add_members(*it->second, member_required, message, members, depth + 1)) return false;
+                continue;
+            }
+            if (tag.name != "field" && tag.name != "group") continue;
+
+            const FixFieldDef* field = dictionary.field(name);
+            if (!field) {
+                error = "unknown field " + name;
+                return false;
+            }
+
+            if (tag.name == "field") {
+                members.push_back(FixMemberDef(field->tag, member_required, -1));
+                continue;
+            }
+
+            // Entry members are required relative
+            // to the entry, not the message
+            std::vector<FixMemberDef> entry;
+            if (!add_members(node.children[i], true, message, entry, depth + 1)) return false;
+            if (entry.empty()) {
+                error = "group " + name + " has no members";
+                return false;
+            }
+
+            FixGroupDef group;
+            group.count_tag = field->tag;
+            group.delimiter_tag = entry[0].tag;
+            group.members.swap(entry);
+            members.push_back(FixMemberDef(field->tag, member_required, static_cast<int>(message.groups.size())));
+            message.groups.push_back(group);
+        }
+        return true;
+    }
+};
+
+bool FixDictionary::load(const std::string& path, std::string& error) {
+    std::string text;
+    return xml_read_file(path, text, error) && load_text(text, error);
+}
+
+bool FixDictionary::load_text(const std::string& xml, std::string& error) {
+    field_defs.clear();
+    by_tag.clear();
+    message_defs.clear();
+    header_def = FixMessageDef();
+    trailer_def = FixMessageDef();
+
+    XmlNode root;
+    size_t pos = 0;
+    if (!xml_next_tag(xml, pos, root.tag, error) || root.tag.name != "fix") {
+        if (error.empty()) error = "no <fix> element";
+        return false;
+    }
+    if (!read_children(xml, pos, root, error)) return false;
+
+    begin = root.tag.attr("type") + "." + root.tag.attr("major") + "." + root.tag.attr("minor");
+    if (root.tag.attr("type").empty()) begin = "FIX" + begin;
+
+    const XmlNode* fields_node = child_named(root, "fields");
+    if (!fields_node) {
+        error = "no <fields>";
+        return false;
+    }
+    for (size_t i = 0; i < fields_node->children.size(); ++i) {
+        const XmlNode& node = fields_node->children[i];
+        if (node.tag.name != "field") continue;
+
+        FixFieldDef field;
+        field.tag = std::atoi(node.tag.attr("number").c_str());
+        field.name = node.tag.attr("name");
+        field.type_name = node.tag.attr("type");
+        field.type = field_type(field.type_name);
+        field.num_in_group = field.type_name == "NUMINGROUP";
+        if (field.tag <= 0 || field.name.empty()) {
+            error = "field " + field.name + ": bad number";
+            return false;
+        }
+        for (size_t v = 0; v < node.children.size(); ++v) {
+            if (node.children[v].tag.name == "value") field.values.push_back(node.children[v].tag.attr("enum"));
+        }
+
+        if (by_tag.size() <= static_cast<size_t>(field.tag)) {
+            by_tag.resize(static_cast<size_t>(field.tag) + 1, -1);
+        }
+        if (by_tag[field.tag] >= 0) {
+            error = "field " + field.name + ": duplicate number";
+            return false;
+        }
+        by_tag[field.tag] = static_cast<int>(field_defs.size());
+        field_defs.push_back(field);
+    }
+
+    Resolver resolver(*this, error);
+    const XmlNode* components_node = child_named(root, "components");
+    if (components_node) {
+        for (size_t i = 0; i < components_node->children.size(); ++i) {
+            const XmlNode& node = components_node->children[i];
+            resolver.components[node.tag.attr("name")] = &node;
+        }
+    }
+
+    const XmlNode* header_node = child_named(root, "header");
+    const XmlNode* trailer_node = child_named(root, "trailer");
+    header_def.name = "Header";
+    trailer_def.name = "Trailer";
+    if (header_node && !resolver.add_members(*header_node, true, header_def, header_def.members, 0)) return false;
+    if (trailer_node && !resolver.add_members(*trailer_node, true, trailer_def, trailer_def.members, 0)) return false;
+
+    const XmlNode* messages_node = child_named(root, "messages");
+    if (!messages_node) {
+        error = "no <messages>";
+        return false;
+    }
+    for (size_t i = 0; i < messages_node->children.size(); ++i) {
+        const XmlNode& node = messages_node->children[i];
+        if (node.tag.name != "message") continue;
+
+        FixMessageDef message;
+        message.name = node.tag.attr("name");
+        message.msg_type = node.tag.attr("msgtype");
+        message.admin = node.tag.attr("msgcat") == "admin";
+        if (message.msg_type.empty()) {
+            error = "message " + message.name + ": no msgtype";
+            return false;
+        }
+        if (this->message(message.msg_type)) {
+            error = "message " + message.name + ": duplicate msgtype";
+            return false;
+        }
+        if (!resolver.add_members(node, true, message, message.members, 0)) {
+            error = message.name + ": " + error;
+            return false;
+        }
+        message_defs.push_back(message);
+    }
+    return true;
+}
+
+const FixFieldDef* FixDictionary::field(const std::string& name) const {
+    for (size_t i = 0; i < field_defs.size(); ++i) {
+        if (field_defs[i].name == name) return &field_defs[i];
+    }
+    return 0;
+}
+
+const FixMessageDef* FixDictionary::message(const std::string& msg_type) const {
+    for (size_t i = 0; i < message_defs.size(); ++i) {
+        if (message_defs[i].msg_type == msg_type) return &message_defs[i];
+    }
+    return 0;
+}
@@ -0,0 +1,337 @@
+#include "fix_groups.h"
+#include "constants.h"
+
+#include <cstring>
+
+// A field split across feeds longer than
+// this is not FIX, the stream is given up
+static const size_t max_stream_field = 65536;
+
+size_t FixGroupView::size() const {
+    return decoder ? decoder->groups[index].count : 0;
+}
+
+int64_t FixGroupView::declared() const {
+    return decoder ? decoder->groups[index].declared : 0;
+}
+
+FixEntryView FixGroupView::entry(size_t i) const {
+    const FixGroupDecoder::Group& group = decoder->groups[index];
+    return FixEntryView(decoder, decoder->entry_order[group.first + i]);
+}
+
+bool FixEntryView::get(int tag, FixText& value) const {
+    const FixGroupDecoder::Entry& entry = decoder->entries[index];
+    for (size_t i = entry.first_field; i < entry.end_field; ++i) {
+        const FixGroupDecoder::Field& field = decoder->fields[i];
+        if (field.tag == tag && field.owner == static_cast<int>(index)) {
+            value = field.value;
+            return true;
+        }
+    }
+    return false;
+}
+
+FixGroupView FixEntryView::group(int count_tag) const {
+    return decoder->find_group(static_cast<int>(index), count_tag);
+}
+
+size_t FixEntryView::field_count() const {
+    const FixGroupDecoder::Entry& entry = decoder->entries[index];
+    return entry.end_field - entry.first_field;
+}
+
+int FixEntryView::field_tag(size_t i) const {
+    return decoder->fields[decoder->entries[index].first_field + i].tag;
+}
+
+const FixText& FixEntryView::field_value(size_t i) const {
+    return decoder->fields[decoder->entries[index].first_field + i].value;
+}
+
+bool FixGroupDecoder::decode(const char* data, size_t size, const FixMessageDef& def) {
+    return index(data, size, def, 0);
+}
+
+bool FixGroupDecoder::decode_entries(const char* data, size_t size, const FixMessageDef& def,
+                                     const FixGroupDef& group) {
+    return index(data, size, def, &group);
+}
+
+bool FixGroupDecoder::get(int tag, FixText& value) const {
+    for (size_t i = 0; i < fields.size(); ++i) {
+        if (fields[i].tag == tag && fields[i].owner < 0) {
+            value = fields[i].value;
+            return true;
+        }
+    }
+    return false;
+}
+
+FixGroupView FixGroupDecoder::group(int count_tag) const {
+    return find_group(-1, count_tag);
+}
+
+// Groups nested in an entry are created while
+// it is open, so the search starts at its
+// first_group and stops past its fields
+FixGroupView FixGroupDecoder::find_group(int owner, int count_tag) const {
+    size_t g = (owner < 0) ? 0 : entries[static_cast<size_t>(owner)].first_group;
+    for (; g < groups.size(); ++g) {
+        const Group& group = groups[g];
+        if (group.owner == owner && group.def->count_tag == count_tag) {
+            return FixGroupView(this, g);
+        }
+        if (owner >= 0 && group.owner >= 0 &&
+            entries[static_cast<size_t>(group.owner)].first_field >= entries[static_cast<size_t>(owner)].end_field) {
+            break;
+        }
+    }
+    return FixGroupView();
+}
+
+const FixGroupDef* FixGroupDecoder::count_group(const std::vector<FixMemberDef>& members, int tag) const {
+    for (size_t i = 0; i < members.size(); ++i) {
+        if (members[i].tag == tag && members[i].group >= 0) {
+            return &message->groups[static_cast<size_t>(members[i].group)];
+        }
+    }
+    return 0;
+}
+
+bool FixGroupDecoder::is_member(const FixGroupDef& group, int tag) {
+    for (size_t i = 0; i < group.members.size(); ++i) {
+        if (group.members[i].tag == tag) return true;
+    }
+    return false;
+}
+
+bool FixGroupDecoder::index(const char* data, size_t size, const FixMessageDef& def,
+                            const FixGroupDef* root_group) {
+    message = &def;
+    fields.clear();
+    groups.clear();
+    entries.clear();
+    open.clear();
+
+    if (root_group) {
+        const Group root = { root_group, -1, -1, 0, 0, -1 };
+        groups.push_back(root);
+        open.push_back(0);
+    }
+
+    const char* pos = data;
+    const char* const end = data + size;
+    int tag = 0;
+    FixText value;
+
+    while (fix_next_field(pos, end, tag, value)) {
+        int owner = -1;
+
+        // Innermost group first: a delimiter starts
+        // an entry, a member extends the current
+        // one, anything else closes the group
+        while (!open.empty()) {
+            Group& group = groups[open.back()];
+            if (tag == group.def->delimiter_tag) {
+                if (group.current >= 0) entries[static_cast<size_t>(group.current)].end_field = fields.size();
+                const Entry entry = { open.back(), fields.size(), fields.size(), groups.size() };
+                group.current = static_cast<int>(entries.size());
+                entries.push_back(entry);
+                owner = group.current;
+                break;
+            }
+            if (group.current >= 0 && is_member(*group.def, tag)) {
+                owner = group.current;
+                break;
+            }
+            if (group.current >= 0) entries[static_cast<size_t>(group.current)].end_field = fields.size();
+            open.pop_back();
+        }
+
+        const Field field = { tag, value, owner };
+        fields.push_back(field);
+
+        const std::vector<FixMemberDef>& level = (owner < 0)
+            ? def.members : groups[entries[static_cast<size_t>(owner)].group].def->members;
+        const FixGroupDef* nested = count_group(level, tag);
+        if (nested) {
+            int64_t declared = 0;
+            fix_get_int(value, declared);
+            const Group group = { nested, declared, owner, 0, 0, -1 };
+            open.push_back(groups.size());
+            groups.push_back(group);
+        }
+    }
+
+    while (!open.empty()) {
+        const Group& group = groups[open.back()];
+        if (group.current >= 0) entries[static_cast<size_t>(group.current)].end_field = fields.size();
+        open.pop_back();
+    }
+
+    // Entries of a group are interleaved with
+    // nested ones, order them by group so a
+    // group view is one slice
+    for (size_t g = 0; g < groups.size(); ++g) groups[g].count = 0;
+    for (size_t e = 0; e < entries.size(); ++e) ++groups[entries[e].group].count;
+    size_t first = 0;
+    for (size_t g = 0; g < groups.size(); ++g) {
+        groups[g].first = first;
+        first += groups[g].count;
+        groups[g].count = 0;
+    }
+    entry_order.resize(entries.size());
+    for (size_t e = 0; e < entries.size(); ++e) {
+        Group& group = groups[entries[e].group];
+        entry_order[group.first + group.count++] = e;
+    }
+
+    return pos == end;
+}
+
+void FixStreamDecoder::reset() {
+    partial.clear();
+    entry_bytes.clear();
+    group_tags.clear();
+    message = 0;
+    group = 0;
+    summary = FixStreamSummary();
+    field_number = 0;
+    body_bytes = 0;
+    sum = 0;
+    finished = false;
+    broken = false;
+}
+
+size_t FixStreamDecoder::feed(const char* data, size_t size) {
+    size_t used = 0;
+    while (used < size && !done()) {
+        const char* start = data + used;
+        const char* soh = static_cast<const char*>(std::memchr(start, '\x01', size - used));
+        if (!soh) {
+            partial.append(start, size - used);
+            used = size;
+            if (partial.size() > max_stream_field) broken = true;
+            break;
+        }
+
+        const size_t length = static_cast<size_t>(soh - start) + 1;
+        used += length;
+
+        bool ok = false;
+        if (partial.empty()) {
+            ok = field(start, length);
+        } else {
+            partial.append(start, length);
+            ok = field(partial.data(), partial.size());
+            partial.clear();
+        }
+        if (!ok) broken = true;
+    }
+    return used;
+}
+
+// Members of a group and of the groups in it
+static void collect_group_tags(const FixMessageDef& message, const FixGroupDef& group, std::vector<int>& tags) {
+    for (size_t i = 0; i < group.members.size(); ++i) {
+        tags.push_back(group.members[i].tag);
+        if (group.members[i].group >= 0) {
+            collect_group_tags(message, message.groups[static_cast<size_t>(group.members[i].group)], tags);
+        }
+    }
+}
+
+// One whole field with its SOH
+bool FixStreamDecoder::field(const char* data, size_t size) {
+    const char* pos = data;
+    int tag = 0;
+    FixText value;
+    if (!fix_next_field(pos, data + size, tag, value)) {
+        return false;
+    }
+
+    ++field_number;
+    if ((field_number == 1 && tag != fix_tag_begin_string) || (field_number == 2 && tag != fix_tag_body_length)) {
+        return false;
+    }
+
+    if (tag == fix_tag_check_sum) {
+        flush_entry();
+        int64_t checksum = -1;
+        summary.checksum_ok = fix_get_int(value, checksum) && checksum == static_cast<int64_t>(sum % 256);
+        summary.length_ok = body_bytes == summary.body_length;
+        finished = true;
+        if (end_handler) end_handler(summary);
+        return true;
+    }
+
+    for (size_t i = 0; i < size; ++i) {
+        sum += static_cast<unsigned char>(data[i]);
+    }
+    if (field_number > 2) {
+        body_bytes += size;
+    }
+
+    if (tag == fix_tag_begin_string) {
+        return true;
+    }
+    if (tag == fix_tag_body_length) {
+        int64_t length = 0;
+        if (!fix_get_int(value, length) || length < 0) return false;
+        summary.body_length = static_cast<size_t>(length);
+        return true;
+    }
+    if (tag == fix_tag_msg_type) {
+        summary.msg_type.assign(value.data, value.size);
+        message = dictionary ? dictionary->message(summary.msg_type) : 0;
+    }
+
+    if (group) {
+        if (tag == group->delimiter_tag) {
+            flush_entry();
+            entry_bytes.append(data, size);
+            return true;
+        }
+        if (!entry_bytes.empty()) {
+            for (size_t i = 0; i < group_tags.size(); ++i) {
+                if (group_tags[i] == tag) {
+                    entry_bytes.append(data, size);
+                    return true;
+                }
+            }
+        }
+        flush_entry();
+        group = 0;
+    }
+
+    if (field_handler) field_handler(tag, value);
+
+    if (message) {
+        for (size_t i = 0; i < message->members.size(); ++i) {
+            const FixMemberDef& member = message->members[i];
+            if (member.tag == tag && member.group >= 0) {
+                group = &message->groups[static_cast<size_t>(member.group)];
+                group_tags.clear();
+                collect_group_tags(*message, *group, group_tags);
+                break;
+            }
+        }
+    }
+    return true;
+}
+
+void FixStreamDecoder::flush_entry() {
+    if (entry_bytes.empty()) {
+        return;
+    }
+
+    if (entry_decoder.decode_entries(entry_bytes.data(), entry_bytes.size(), *message, *group)) {
+        const FixGroupView entries = entry_decoder.root();
+        if (entries.size() > 0) {
+            ++summary.entries;
+            if (entry_handler) entry_handler(group->count_tag, entries.entry(0));
+        }
+    }
+    entry_bytes.clear();
+}
@@ -1,5 +1,6 @@
 #include "fix_message.h"
 #include "utils.h"
+#include "constants.h"
 #include <cstdio>
 
 FixMessage::FixMessage() {}
@@ -20,21 +21,55 @@ char FixMessage::soh() {
     return '\x01';
 }
 
+// Decimal digits without snprintf,
+// every field goes through here
+static void append_int(std::string& buffer, int value) {
+    char digits[16];
+    char* end = digits + sizeof(digits);
+    char* pos = end;
+
+    unsigned int rest = (value < 0) ? 0u - static_cast<unsigned int>(value) : static_cast<unsigned int>(value);
+    do {
+        *--pos = static_cast<char>('0' + rest % 10);
+        rest /= 10;
+    } while (rest != 0);
+
+    if (value < 0) *--pos = '-';
+    buffer.append(pos, static_cast<size_t>(end - pos));
+}
+
 void FixMessage::append_field(std::string& buffer, int tag, const std::string& tag_value) {
-    char tag_buf[32];
-    std::snprintf(tag_buf, sizeof(tag_buf), "%d=", tag);
-    buffer.append(tag_buf);
-    buffer.append(tag_value);
-    buffer.push_back(soh());
+    append_field_view(buffer, tag, tag_value.data(), tag_value.size());
 }
 
 void FixMessage::append_field_int(std::string& buffer, int tag, int tag_value) {
-    char field_buf[64];
-    std::snprintf(field_buf, sizeof(field_buf), "%d=%d", tag, tag_value);
-    buffer.append(field_buf);
+    append_int(buffer, tag);
+    buffer.push_back('=');
+    append_int(buffer, tag_value);
+    buffer.push_back(soh());
+}
+
+void FixMessage::append_field_view(std::string& buffer, int tag, const char* data, size_t size) {
+    append_int(buffer, tag);
+    buffer.push_back('=');
+    buffer.append(data, size);
     buffer.push_back(soh());
 }
 
+static size_t count_digits(int value) {
+    size_t digits = (value < 0) ? 2 : 1;
+    unsigned int rest = (value < 0) ? 0u - static_cast<unsigned int>(value) : static_cast<unsigned int>(value);
+    for (; rest >= 10; rest /= 10) {
+        ++digits;
+    }
+    return digits;
+}
+
+// "tag=value<SOH>"
+static size_t field_size(int tag, size_t value_size) {
+    return count_digits(tag) + 1 + value_size + 1;
+}
+
 int FixMessage::calculate_checksum(const std::string& data) {
     unsigned int sum = 0;
     for (size_t i = 0; i < data.size(); ++i) {
@@ -91,6 +126,58 @@ std::string FixMessage::build_message(const std::string& msg_type,
     return msg;
 }
 
+bool FixMessage::encode_view(std::string& out,
+                             const FixMessageView& view,
+                             int msg_seq_num,
+                             const std::string& sending_time) const {
+
+    // Guard
+    if (begin_string.empty() || sender_comp_id.empty() || target_comp_id.empty()) {
+        return false;
+    }
+
+    const size_t msg_type_size = std::strlen(view.msg_type);
+
+    size_t body_size = field_size(35, msg_type_size) +
+                       field_size(34, count_digits(msg_seq_num)) +
+                       field_size(49, sender_comp_id.size()) +
+                       field_size(56, target_comp_id.size()) +
+                       field_size(52, sending_time.size());
+    for (size_t i = 0; i < view.count; ++i) {
+        body_size += field_size(view.fields[i].tag, view.fields[i].size);
+    }
+
+    const size_t start = out.size();
+    out.reserve(start + body_size + 32);
+
+    append_field(out, 8, begin_string);
+    append_field_int(out, 9, static_cast<int>(body_size));
+
+    append_field_view(out, 35, view.msg_type, msg_type_size);
+    append_field_int(out, 34, msg_seq_num);
+    append_field(out, 49, sender_comp_id);
+    append_field(out, 56, target_comp_id);
+    append_field(out, 52, sending_time);
+
+    for (size_t i = 0; i < view.count; ++i) {
+        append_field_view(out, view.fields[i].tag, view.fields[i].data, view.fields[i].size);
+    }
+
+    unsigned int sum = 0;
+    for (size_t i = start; i < out.size(); ++i) {
+        sum += static_cast<unsigned char>(out[i]);
+    }
+
+    const unsigned int checksum = sum % 256;
+    const char checksum_buf[3] = {
+        static_cast<char>('0' + checksum / 100),
+        static_cast<char>('0' + checksum / 10 % 10),
+        static_cast<char>('0' + checksum % 10)
+    };
+    append_field_view(out, 10, checksum_buf, sizeof(checksum_buf));
+    return true;
+}
+
 // Logon
 std::string FixMessage::build_logon(int msg_seq_num, const std::string& sending_time,
                                     int heartbeat_interval, bool reset_seq_num) const {
@@ -204,6 +291,31 @@ std::string FixMessage::build_logout(int msg_seq_num,
     return build_message("5", msg_seq_num, sending_time, fields);
 }
 
+// Reject
+std::string FixMessage::build_reject(int msg_seq_num,
+                                     const std::string& sending_time,
+                                     int ref_seq_num, int ref_tag_id,
+                                     const std::string& ref_msg_type,
+                                     int reason, const std::string& text) const {
+
+    FieldList fields;
+    fields.reserve(5);
+
+    fields.push_back(Field(fix_tag_ref_seq_num, std::to_string(ref_seq_num)));
+    if (ref_tag_id > 0) {
+        fields.push_back(Field(fix_tag_ref_tag_id, std::to_string(ref_tag_id)));
+    }
+    if (!ref_msg_type.empty()) {
+        fields.push_back(Field(fix_tag_ref_msg_type, ref_msg_type));
+    }
+    fields.push_back(Field(fix_tag_sess_rej_reason, std::to_string(reason)));
+    if (!text.empty()) {
+        fields.push_back(Field(fix_tag_text, text));
+    }
+
+    return build_message("3", msg_seq_num, sending_time, fields);
+}
+
 // Build from fields
 std::string FixMessage::build_from_fields(const FieldList& ordered_fields) const {
     if (begin_string.empty()) {
@@ -239,6 +351,12 @@ std::string FixMessage::build_from_fields(const FieldList& ordered_fields) const
     return msg;
 }
 
+FixMessage::Field FixMessage::make_decimal_field(int tag, const FixDecimal& value) {
+    char buf[32];
+    const size_t len = fix_decimal_format(value, buf);
+    return Field(tag, std::string(buf, len));
+}
+
 std::string FixMessage::to_pipe_delimited(const std::string& fix) {
     return utils::to_pipe_delimited(fix);
 }
@@ -1,9 +1,10 @@
 #include "fix_parser.h"
+#include "fix_groups.h"
 #include <cctype>
 
 static const char soh = '\x01';
 
-FixParser::FixParser() {}
+FixParser::FixParser() : oversize(0), streaming(false), stream_offset(0) {}
 
 void FixParser::append_bytes(const char* data, size_t size) {
     if (data == 0 || size == 0) {
@@ -13,8 +14,28 @@ void FixParser::append_bytes(const char* data, size_t size) {
     buffer.append(data, size);
 }
 
+void FixParser::append_bytes(const char* data, size_t size, const SocketTimestamp& stamp) {
+    if (data == 0 || size == 0) {
+        return;
+    }
+
+    buffer.append(data, size);
+    stamps.push_back(std::make_pair(stream_offset + buffer.size(), stamp));
+}
+
 void FixParser::reset() {
-    buffer.clear();
+    discard(buffer.size());
+    streaming = false;
+}
+
+void FixParser::discard(size_t count) {
+    buffer.erase(0, count);
+    stream_offset += count;
+
+    // Drop stamps of chunks fully consumed
+    while (!stamps.empty() && stamps.front().first <= stream_offset) {
+        stamps.pop_front();
+    }
 }
 
 bool FixParser::find_begin_string(size_t& start_pos) const {
@@ -22,9 +43,11 @@ bool FixParser::find_begin_string(size_t& start_pos) const {
     return (start_pos != std::string::npos);
 }
 
-bool FixParser::parse_body_length(size_t start_pos, int& body_length, size_t& end_body_len_field) const {
+bool FixParser::parse_body_length(size_t start_pos, int& body_length, size_t& end_body_len_field,
+                                  bool& oversized) const {
     body_length = -1;
     end_body_len_field = 0;
+    oversized = false;
 
     size_t body_len_pos = std::string::npos;
     size_t scan_pos = start_pos;
@@ -66,6 +89,7 @@ bool FixParser::parse_body_length(size_t start_pos, int& body_length, size_t& en
 
         body_len_value = body_len_value * 10 + (ch - '0');
         if (body_len_value > max_body_len) {
+            oversized = true;
             return false;
         }
     }
@@ -76,13 +100,34 @@ bool FixParser::parse_body_length(size_t start_pos, int& body_length, size_t& en
 }
 
 bool FixParser::read_next_message(std::string& message) {
+    SocketTimestamp stamp;
+    return read_next_message(message, stamp);
+}
+
+bool FixParser::stream_oversized() {
+    const size_t used = oversize->feed(buffer.data(), buffer.size());
+    discard(used);
+    if (!oversize->done()) {
+        return false;
+    }
+
+    streaming = false;
+    return true;
+}
+
+bool FixParser::read_next_message(std::string& message, SocketTimestamp& stamp) {
     message.clear();
+    stamp = SocketTimestamp();
+
+    if (streaming && !stream_oversized()) {
+        return false;
+    }
 
     // Find "8=FIX"
     size_t start_pos = 0;
     if (!find_begin_string(start_pos)) {
         if (buffer.size() > 8) {
-            buffer.erase(0, buffer.size() - 8);
+            discard(buffer.size() - 8);
         }
         return false;
     }
@@ -90,13 +135,19 @@ bool FixParser::read_next_message(std::string& message) {
     // Drop garbage
     // before beginstring
     if (start_pos > 0) {
-        buffer.erase(0, start_pos);
+        discard(start_pos);
     }
 
     // Read BodyLength
     int body_length = -1;
     size_t end_body_len_field = 0;
-    if (!parse_body_length(0, body_length, end_body_len_field)) {
+    bool oversized = false;
+    if (!parse_body_length(0, body_length, end_body_len_field, oversized)) {
+        if (oversized && oversize) {
+            oversize->reset();
+            streaming = true;
+            return read_next_message(message, stamp);
+        }
         return false;
     }
 
@@ -114,9 +165,9 @@ bool FixParser::read_next_message(std::string& message) {
 	if (checksum_start + 3 > buffer.size() || buffer.compare(checksum_start, 3, "10=") != 0) {
 		const size_t next_start = buffer.find("8=FIX", 1);
         if (next_start != std::string::npos) {
-            buffer.erase(0, next_start);
+            discard(next_start);
         } else {
-            buffer.clear();
+            discard(buffer.size());
         }
 
         return false;
@@ -130,6 +181,16 @@ bool FixParser::read_next_message(std::string& message) {
 
     // Extract complete FIX message
     message.assign(buffer.data(), end_pos + 1);
-    buffer.erase(0, end_pos + 1);
+
+    // Stamp of the chunk holding the last byte
+    const size_t message_end = stream_offset + end_pos + 1;
+    for (size_t i = 0; i < stamps.size(); ++i) {
+        if (stamps[i].first >= message_end) {
+            stamp = stamps[i].second;
+            break;
+        }
+    }
+
+    discard(end_pos + 1);
     return true;
 }
@@ -1,6 +1,9 @@
 #include "fix_regression.h"
 #include "token_handler.h"
 #include "constants.h"
+#include "fix_decimal.h"
+#include "scenario_compiler.h"
+#include "tst_matcher.h"
 #include "utils.h"
 #include <cstdio>
 #include <cstdlib>
@@ -14,8 +17,11 @@
 #include <cstdarg>
 #include <ctime>
 #include <sys/stat.h>
+#include <map>
+#include <deque>
 
-bool read_next_business_message(TcpSocket& socket,
+bool read_next_business_message(Transport& socket,
+                               SessionContext& session,
                                FixParser& fix_parser,
                                FixMessage& fix,
                                int& outbound_seq,
@@ -30,45 +36,54 @@ bool read_next_business_message(TcpSocket& socket,
                                int timeout_ms,
                                std::string& out_message);
 
+// Per-step upper bounds, a step returns
+// as soon as its message arrives
 const int timeout_test_ms = 3000;
 const int timeout_discard_ms = 500;
-const int max_clr = 50;
+const int max_clr = scenario_max_clr;
+const int table_indent = 9;
 static std::string log_begin_string;
 static std::string log_sender_comp_id;
 
-static void print_result_log(const char* format, ...) {
-    static FILE* result_log_file = 0;
+// results/<begin>_<sender>_REGRESSION_RESULT_<time>,
+// shared by the .log and the latency .csv
+static const std::string& result_path_base() {
+    static std::string path_base;
 
-    if (!result_log_file) {
+    if (path_base.empty()) {
         ::mkdir("results", 0755);
 
         std::time_t now = std::time(0);
         std::tm local_time;
         localtime_r(&now, &local_time);
 
-        char log_path[256];
-        std::snprintf(log_path, sizeof(log_path), "results/%s_%s_REGRESSION_RESULT_%04d%02d%02d_%02d%02d%02d.log",
+        char base[256];
+        std::snprintf(base, sizeof(base), "results/%s_%s_REGRESSION_RESULT_%04d%02d%02d_%02d%02d%02d",
                                        log_begin_string.c_str(), log_sender_comp_id.c_str(), local_time.tm_year + 1900,
                                        local_time.tm_mon + 1, local_time.tm_mday + 1, local_time.tm_hour,
                                        local_time.tm_min, local_time.tm_sec);
-
-        result_log_file = std::fopen(log_path, "w");
+        path_base = base;
     }
+    return path_base;
+}
 
-    char formatted_text[8192];
-    va_list args;
-    va_start(args, format);
-    const int text_len = std::vsnprintf(formatted_text, sizeof(formatted_text), format, args);
-    va_end(args);
+// Writes to stdout and, without ANSI
+// color codes, to the result log
+static void write_result_log(const char* text, size_t text_len) {
+    static FILE* result_log_file = 0;
+
+    if (!result_log_file) {
+        result_log_file = std::fopen((result_path_base() + ".log").c_str(), "w");
+    }
 
-    if (text_len <= 0) return;
+    if (text_len == 0) return;
 
-    std::fwrite(formatted_text, 1, static_cast<size_t>(text_len), stdout);
+    std::fwrite(text, 1, text_len, stdout);
 
     if (result_log_file) {
         bool inside_ansi_code = false;
-        for (int i = 0; i < text_len; ++i) {
-            const char ch = formatted_text[i];
+        for (size_t i = 0; i < text_len; ++i) {
+            const char ch = text[i];
 
             if (ch == '\033') {
                 inside_ansi_code = true;
@@ -86,29 +101,55 @@ static void print_result_log(const char* format, ...) {
     }
 }
 
-static void get_status_clr(const char* label, bool is_success) {
+static size_t format_text(char* out, size_t out_size, const char* format, va_list args) {
+    const int text_len = std::vsnprintf(out, out_size, format, args);
+    if (text_len <= 0) return 0;
+
+    return (static_cast<size_t>(text_len) < out_size) ? static_cast<size_t>(text_len) : out_size - 1;
+}
+
+static void print_result_log(const char* format, ...) {
+    char formatted_text[8192];
+    va_list args;
+    va_start(args, format);
+    const size_t text_len = format_text(formatted_text, sizeof(formatted_text), format, args);
+    va_end(args);
+
+    write_result_log(formatted_text, text_len);
+}
+
+// Scenario output is buffered per scenario
+// and written in file order when it ends
+static void append_report(std::string& report, const char* format, ...) {
+    char formatted_text[8192];
+    va_list args;
+    va_start(args, format);
+    const size_t text_len = format_text(formatted_text, sizeof(formatted_text), format, args);
+    va_end(args);
+
+    report.append(formatted_text, text_len);
+}
+
+static void get_status_clr(std::string& report, const char* label, bool is_success) {
     const bool use_color =
         (std::getenv("NO_COLOR") == nullptr) &&
         (::isatty(::fileno(stdout)) == 1);
 
     if (use_color) {
-        print_result_log("%s%-4s%s", is_success ? GREEN : RED, label, RESET);
+        append_report(report, "%s%-4s%s", is_success ? GREEN : RED, label, RESET);
     } else {
-        print_result_log("%-4s", label);
+        append_report(report, "%-4s", label);
     }
 }
 
-static void print_details(const std::string& fix) {
-    std::string printable;
-    printable.reserve(fix.size());
+static void print_details(std::string& report, const std::string& fix) {
+    report.reserve(report.size() + fix.size());
 
     for (size_t i = 0; i < fix.size(); ++i) {
         char ch = fix[i];
         if (ch == '\x01') ch = '|';
-        printable.push_back(ch);
+        report.push_back(ch);
     }
-
-    print_result_log("%s", printable.c_str());
 }
 
 static void make_fix_field_name(std::string& out_line, int tag, const char* value) {
@@ -125,420 +166,758 @@ static void make_fix_field_name(std::string& out_line, int tag, const char* valu
     out_line.append(buf);
 }
 
-static void build_clr_id(std::string clr_values[max_clr + 1], int scenario_index) {
-    (void)scenario_index;
-
-    for (int i = 0; i <= max_clr; ++i) {
-        clr_values[i].clear();
+// clrN values of one running scenario,
+// generated on first use and registered in
+// routes so its responses find it. They stay
+// registered once it ends, a late response
+// is then recognized as such.
+struct ClrTable {
+    IdGenerator* ids;
+    std::map<std::string, size_t>* routes;
+    size_t owner;
+    std::string values[max_clr + 1];
+
+    ClrTable(IdGenerator& id_generator,
+             std::map<std::string, size_t>& route_table,
+             size_t owner_index)
+        : ids(&id_generator), routes(&route_table), owner(owner_index) {}
+
+    const std::string& get(int n) {
+        if (values[n].empty()) {
+            values[n] = ids->next("");
+            (*routes)[values[n]] = owner;
+        }
+        return values[n];
+    }
+};
+
+// Session state shared by all steps
+struct RegressionLink {
+    Transport& socket;
+    SessionContext& session;
+    FixParser& fix_parser;
+    FixMessage& fix;
+    int& outbound_seq;
+    uint64_t& last_send_ms;
+    const std::string& token_path;
+    bool& logon_accepted;
+    bool& scenarios_sent;
+    bool& scenario_response_started;
+    uint64_t& last_scenario_response_ms;
+    bool& logout_initiated;
+};
+
+// Business messages received but not yet
+// consumed by a TST/RCV step. Indexed by
+// "11=<v>", "41=<v>" and "548=<v>" so a step
+// takes its own response even when responses
+// of several orders interleave.
+class RegressionInbox {
+public:
+    RegressionInbox() : next_id(1) {}
+
+    // received_ns: CLOCK_REALTIME when read
+    void add(const std::string& message, uint64_t received_ns) {
+        const uint64_t id = next_id++;
+        messages[id] = Inbound(message, received_ns);
+
+        static const char* const key_prefixes[] = { "11=", "41=", "548=" };
+        for (size_t i = 0; i < sizeof(key_prefixes) / sizeof(key_prefixes[0]); ++i) {
+            std::string value;
+            if (utils::find_tag_value(message, key_prefixes[i], value) && !value.empty()) {
+                by_key[std::string(key_prefixes[i]) + value].push_back(id);
+            }
+        }
     }
 
-    static unsigned long long uniq = 0;
-    uniq++;
-
-    const unsigned long long now_ms =
-        static_cast<unsigned long long>(utils::get_monotonic_millis());
+    // Oldest message carrying key,
+    // any message when key is empty
+    bool take(const std::string& key, std::string& message, uint64_t& received_ns) {
+        if (key.empty()) {
+            if (messages.empty()) return false;
+            message.swap(messages.begin()->second.first);
+            received_ns = messages.begin()->second.second;
+            messages.erase(messages.begin());
+            return true;
+        }
 
-    const unsigned long long base = now_ms * 1000000ULL + (uniq % 1000000ULL);
+        std::map<std::string, std::deque<uint64_t> >::iterator found = by_key.find(key);
+        if (found == by_key.end()) return false;
+
+        // Ids already taken through
+        // another key are skipped
+        std::deque<uint64_t>& ids = found->second;
+        while (!ids.empty()) {
+            std::map<uint64_t, Inbound>::iterator entry = messages.find(ids.front());
+            ids.pop_front();
+            if (entry != messages.end()) {
+                message.swap(entry->second.first);
+                received_ns = entry->second.second;
+                messages.erase(entry);
+                return true;
+            }
+        }
 
-    for (int i = 1; i <= max_clr; ++i) {
-        char buf[64];
-        std::snprintf(buf, sizeof(buf), "%llu_%d", base, i);
-        clr_values[i] = buf;
+        by_key.erase(found);
+        return false;
     }
-}
 
-static void parse_fields(const std::string& payload,
-                         FixMessage::FieldList& fields,
-                         std::string* msg_type_out) {
-    fields.clear();
-    fields.reserve(64);
-    if (msg_type_out) msg_type_out->clear();
+private:
+    typedef std::pair<std::string, uint64_t> Inbound;
 
-    char delim = 0;
-    if (payload.find('|') != std::string::npos) delim = '|';
-    else if (payload.find(',') != std::string::npos) delim = ',';
-    else delim = 0;
+    uint64_t next_id;
+    std::map<uint64_t, Inbound> messages;
+    std::map<std::string, std::deque<uint64_t> > by_key;
+};
 
-    size_t pos = 0;
-    while (pos <= payload.size()) {
-        size_t end = std::string::npos;
-        if (delim) end = payload.find(delim, pos);
-        if (end == std::string::npos) end = payload.size();
+// Index of the correlation field of a TST step:
+// first of ClOrdID, CrossID, OrigClOrdID with a
+// concrete expected value, -1 if none
+static int correlation_field(const FixMessage::FieldList& expected) {
+    static const int key_tags[] = { fix_tag_clord_id, fix_tag_cross_id, 41 };
 
-        std::string token = payload.substr(pos, end - pos);
-        pos = (end < payload.size()) ? (end + 1) : (payload.size() + 1);
+    for (size_t k = 0; k < sizeof(key_tags) / sizeof(key_tags[0]); ++k) {
+        for (size_t i = 0; i < expected.size(); ++i) {
+            if (expected[i].first != key_tags[k]) continue;
 
-        if (token.empty()) continue;
+            const std::string& exp_text = expected[i].second;
+            if (exp_text.empty() || exp_text == "IGNORE" || exp_text == "NONE") continue;
 
-        const size_t eq = token.find('=');
-        if (eq == std::string::npos || eq == 0) continue;
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
+}
 
-        const int tag = std::atoi(utils::trim(token.substr(0, eq)).c_str());
-        if (tag <= 0) continue;
+// Inbox key of a TST step, empty
+// when it has no correlation field
+static std::string correlation_key(const ScenarioRecord& expected,
+                                   ClrTable& clr_values) {
+    const int index = correlation_field(expected.fields);
+    if (index < 0) {
+        return std::string();
+    }
 
-        const std::string val = token.substr(eq + 1);
-        fields.push_back(std::make_pair(tag, val));
+    std::string value = expected.fields[index].second;
+    const uint16_t slot = expected.slots[index];
+    if (slot >= 1 && slot <= max_clr) {
+        value = clr_values.get(slot);
+    }
+
+    char prefix[16];
+    std::snprintf(prefix, sizeof(prefix), "%d=", expected.fields[index].first);
+    return std::string(prefix) + value;
+}
 
-        if (msg_type_out && tag == 35 && msg_type_out->empty()) {
-            *msg_type_out = val;
+// One BGN..END block
+// ClOrdID(11)/CrossID(548) given as text,
+// not as clrN
+static bool has_literal_id(const ScenarioRecord& record) {
+    for (size_t i = 0; i < record.fields.size(); ++i) {
+        const int tag = record.fields[i].first;
+        if ((tag == fix_tag_clord_id || tag == fix_tag_cross_id) && !record.fields[i].second.empty() &&
+            !(record.slots[i] >= 1 && record.slots[i] <= max_clr)) {
+            return true;
         }
     }
+    return false;
 }
 
-static bool run_file(const std::string& file_path,
-                     TcpSocket& socket,
-                     FixParser& fix_parser,
-                     FixMessage& fix,
-                     int& outbound_seq,
-                     uint64_t& last_send_ms,
-                     const std::string& token_path,
-                     bool& logon_accepted,
-                     bool& scenarios_sent,
-                     bool& scenario_response_started,
-                     uint64_t& last_scenario_response_ms,
-                     bool& logout_initiated,
-                     int& total_run,
-                     int& total_passed,
-                     int& total_failed,
-                     std::vector<std::string>& failed_names) {
-    std::ifstream in(file_path.c_str());
-    if (!in.is_open()) {
+struct ScenarioScript {
+    std::string name;
+    std::vector<ScenarioRecord> steps;      // SND, TST, RCV
+    std::vector<TstMatcher> matchers;       // per step, set for TST
+    size_t file_index;
+    uint64_t cache_key;                     // see regression_cache.h
+
+    // RCV, TST without a correlation key, or
+    // SND with a literal ClOrdID/CrossID (only
+    // clrN values are routed): inbound can't be
+    // routed to it while other scenarios run,
+    // so it runs alone
+    bool exclusive;
+};
+
+// A scenario in progress, own step pointer,
+// clrN table and inbox
+struct ScenarioRun {
+    const ScenarioScript* script;
+    size_t next_step;
+    int step;
+    bool ok;
+    bool done;
+    bool cached;
+    uint64_t started_ms;
+    uint64_t finished_ms;
+    ClrTable clr_values;
+    RegressionInbox inbox;
+    std::string report;
+    int unused;                 // inbound no step took
+
+    // Send time per correlation key
+    // ("11=<v>"), for TST latencies
+    std::map<std::string, uint64_t> sent_ns;
+    uint64_t last_sent_ns;
+    std::vector<LatencySample> latencies;
+
+    // TST/RCV waiting for inbound
+    bool waiting;
+    bool waiting_tst;
+    std::string wait_key;
+    uint64_t deadline_ms;
+    const ScenarioRecord* expected;
+    const TstMatcher* matcher;
+    std::vector<TstMatcher::Verdict> verdicts;
+
+    ScenarioRun(const ScenarioScript& scenario_script,
+                IdGenerator& id_generator,
+                std::map<std::string, size_t>& routes,
+                size_t index)
+        : script(&scenario_script), next_step(0), step(0), ok(true), done(false), cached(false),
+          started_ms(utils::get_monotonic_millis()), finished_ms(0),
+          clr_values(id_generator, routes, index), unused(0), last_sent_ns(0),
+          waiting(false), waiting_tst(false), deadline_ms(0), expected(0), matcher(0) {}
+};
+
+// Appends the BGN..END blocks of a file,
+// a block without END is dropped
+static bool load_scripts(const std::string& file_path,
+                         size_t file_index,
+                         std::vector<ScenarioScript>& scripts) {
+    ScenarioReader reader;
+    if (!reader.open(file_path, scenario_format_regression)) {
         std::printf("ERROR: Cannot open regression file: %s\n", file_path.c_str());
         return false;
     }
 
-    int scenario_index = 0;
-    int step = 0;
-
     bool in_scenario = false;
-    bool scenario_ok = true;
+    ScenarioScript script;
+    ScenarioRecord record;
+
+    while (reader.next(record)) {
+        if (record.opcode == scenario_op_bgn) {
+            script.name = record.text;
+            script.steps.clear();
+            script.matchers.clear();
+            script.file_index = file_index;
+            script.cache_key = 0;
+            script.exclusive = false;
+            in_scenario = true;
+            continue;
+        }
 
-    std::string scenario_name;
-    std::string clr_values[max_clr + 1];
+        if (!in_scenario) continue;
 
-    std::string line;
-    while (std::getline(in, line)) {
-        line = utils::trim(line);
-        if (line.empty() || line[0] == '#') continue;
-        if (line.size() >= 2 && line[0] == '/' && line[1] == '/') continue;
+        if (record.opcode == scenario_op_end) {
+            scripts.push_back(script);
+            in_scenario = false;
+            continue;
+        }
 
-        const size_t first_bar = line.find('|');
-        if (first_bar == std::string::npos) {
-            continue; 
+        if (record.opcode == scenario_op_rcv) {
+            script.exclusive = true;
         }
 
-        std::string cmd = utils::trim(line.substr(0, first_bar));
-        while (!cmd.empty()) {
-            const unsigned char c = static_cast<unsigned char>(cmd[0]);
-            if ((c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z')) break;
-            cmd.erase(0, 1);
+        if (record.opcode == scenario_op_tst && correlation_field(record.fields) < 0) {
+            script.exclusive = true;
         }
 
-        while (!cmd.empty()) {
-            const unsigned char c = static_cast<unsigned char>(cmd[cmd.size() - 1]);
-            if ((c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z')) break;
-            cmd.erase(cmd.size() - 1, 1);
+        if (record.opcode == scenario_op_snd && has_literal_id(record)) {
+            script.exclusive = true;
         }
 
-        for (size_t i = 0; i < cmd.size(); ++i) {
-            const unsigned char c = static_cast<unsigned char>(cmd[i]);
-            if (c >= 'a' && c <= 'z') cmd[i] = static_cast<char>(c - ('a' - 'A'));
+        script.steps.push_back(record);
+        script.matchers.push_back(TstMatcher());
+        if (record.opcode == scenario_op_tst) {
+            script.matchers.back().compile(record.fields, record.slots);
         }
+    }
 
-        if (cmd != "BGN" && cmd != "SND" && cmd != "TST" && cmd != "RCV" && cmd != "END") {
-            continue;
+    return true;
+}
+
+// Name and steps as compiled, so edits that
+// only touch comments or spacing keep the key
+static uint64_t scenario_cache_key(const ScenarioScript& script, uint64_t config_hash) {
+    uint64_t hash = regression_hash(config_hash, script.name);
+    for (size_t i = 0; i < script.steps.size(); ++i) {
+        const ScenarioRecord& step = script.steps[i];
+        const int32_t head[2] = { step.opcode, step.timeout_ms };
+        const uint64_t field_count = step.fields.size();
+
+        hash = regression_hash(hash, head, sizeof(head));
+        hash = regression_hash(hash, &field_count, sizeof(field_count));
+        for (size_t f = 0; f < step.fields.size(); ++f) {
+            const int32_t tag = step.fields[f].first;
+            hash = regression_hash(hash, &tag, sizeof(tag));
+            hash = regression_hash(hash, step.fields[f].second);
         }
+    }
+    return hash;
+}
 
-        const size_t second_bar = line.find('|', first_bar + 1);
-        const std::string payload = (second_bar == std::string::npos)
-            ? utils::trim(line.substr(first_bar + 1))
-            : utils::trim(line.substr(second_bar + 1));
-
-        if (cmd == "BGN") {
-            if (scenarios_sent) {
-                const int timeout_drain_ms = 5;
-                const int drain_max_reads = 50;
-
-                for (int i = 0; i < drain_max_reads; ++i) {
-                    std::string pending;
-                    bool stop_requested = false;
-
-                    if (!read_next_business_message(socket, fix_parser, fix,
-                                                    outbound_seq, last_send_ms, token_path,
-                                                    logon_accepted, stop_requested,
-                                                    scenarios_sent, scenario_response_started,
-                                                    last_scenario_response_ms, logout_initiated,
-                                                    timeout_drain_ms, pending)) {
-                        return false;
-                    }
-
-                    if (pending.empty()) {
-                        break;
-                    }
-                }
-            }
+// Cached result standing in for a run,
+// per options.rerun
+static bool find_cached_result(const ScenarioScript& script,
+                               const RegressionOptions& options,
+                               RegressionCacheEntry& entry) {
+    if (options.rerun == regression_rerun_all) {
+        return false;
+    }
+    if (!load_regression_result(script.cache_key, entry)) {
+        return false;
+    }
+    return entry.passed || options.rerun == regression_rerun_changed;
+}
 
-            scenario_index++;
-            build_clr_id(clr_values, scenario_index);
+static bool send_step(RegressionLink& link,
+                      OutboundThrottle& throttle,
+                      ScenarioRun& run,
+                      const ScenarioRecord& scenario_step) {
+    FixMessage::FieldList raw = scenario_step.fields;
+    const std::string& msg_type = scenario_step.msg_type;
+
+    if (msg_type.empty()) {
+        run.step++;
+        append_report(run.report, "  %02d  SEND: (ERROR missing 35)\n", run.step);
+        run.ok = false;
+        return true;
+    }
 
-            scenario_name = payload;
-            in_scenario = true;
-            scenario_ok = true;
-            step = 0;
+    const std::string now_utc = utils::get_utc_timestamp();
 
-            print_result_log("\nBEGIN %s\n", scenario_name.c_str());
-            continue;
+    // Apply clrN and fill blanks (34/52/60)
+    for (size_t i = 0; i < raw.size(); ++i) {
+        const int tag = raw[i].first;
+        std::string& value = raw[i].second;
+
+        // clrN replacement
+        const uint16_t slot = scenario_step.slots[i];
+        if (slot >= 1 && slot <= max_clr) {
+            value = run.clr_values.get(slot);
+        }
+
+        // fill blanks like v1
+        if (tag == 34 && value.empty()) {
+            char buf[32];
+            std::snprintf(buf, sizeof(buf), "%d", link.outbound_seq);
+            value = buf;
         }
+        if (tag == 52 && value.empty()) value = now_utc;
+        if (tag == 60 && value.empty()) value = now_utc;
+    }
 
-        if (cmd == "END") {
-            if (!in_scenario) continue;
+    // Build raw FIX from ordered fields (preserves your scenario order)
+    const std::string msg = link.fix.build_from_fields(raw);
+    if (msg.empty()) {
+        run.step++;
+        append_report(run.report, "  %02d  SEND: (ERROR build_from_fields failed)\n", run.step);
+        run.ok = false;
+        return true;
+    }
+
+    // Venue rate limit, waits
+    // for a token if needed
+    throttle.acquire(msg_type);
+
+    run.last_sent_ns = utils::get_realtime_nanos();
+    const int key_field = correlation_field(raw);
+    if (key_field >= 0) {
+        char prefix[16];
+        std::snprintf(prefix, sizeof(prefix), "%d=", raw[key_field].first);
+        run.sent_ns[prefix + raw[key_field].second] = run.last_sent_ns;
+    }
+
+    if (!link.socket.send_bytes(msg)) {
+        return false;
+    }
+
+    link.last_send_ms = utils::get_monotonic_millis();
+    link.outbound_seq++;
+    save_token(link.token_path, link.outbound_seq);
+    link.scenarios_sent = true;
+
+    run.step++;
+
+    std::string send_line;
+    send_line.reserve(raw.size() * 16);
+    for (size_t i = 0; i < raw.size(); ++i) {
+        make_fix_field_name(send_line, raw[i].first, raw[i].second.c_str());
+    }
 
-            total_run++;
-            if (scenario_ok) {
-                total_passed++;
+    append_report(run.report, "  %02d \tSEND: %s\n", run.step, send_line.c_str());
+    return true;
+}
+
+// Compares the response of a TST step, empty
+// msg means the step timed out. The field table
+// is only formatted on failure or when verbose.
+static void check_step(ScenarioRun& run, const std::string& msg, uint64_t received_ns, bool verbose) {
+    std::string& report = run.report;
+    const FixMessage::FieldList& expected = run.expected->fields;
+
+    run.step++;
+    if (msg.empty()) {
+        append_report(report, "  %02d  \tRECV: (TIMEOUT)\n", run.step);
+        run.ok = false;
+        return;
+    }
+
+    // Round trip from the send of the order
+    // the step correlates to, else the last send
+    LatencySample sample;
+    sample.scenario = run.script->name;
+    sample.step = run.step;
+    sample.received_ns = received_ns;
+
+    std::map<std::string, uint64_t>::const_iterator sent = run.sent_ns.find(run.wait_key);
+    sample.sent_ns = (sent != run.sent_ns.end()) ? sent->second : run.last_sent_ns;
+    if (sample.sent_ns != 0) {
+        run.latencies.push_back(sample);
+    }
+    const unsigned long long latency_us = sample.sent_ns ? sample.latency_us() : 0;
+
+    // clrN of the step, generated on first use
+    for (size_t i = 0; i < expected.size(); ++i) {
+        const uint16_t slot = run.expected->slots[i];
+        if (slot >= 1 && slot <= max_clr) {
+            run.clr_values.get(slot);
+        }
+    }
+
+    const bool matched = run.matcher->match(msg, run.clr_values.values, run.verdicts);
+    if (!matched) {
+        run.ok = false;
+    }
+
+    if (matched && !verbose) {
+        append_report(report, "  %02d\tRECV:  ", run.step);
+        get_status_clr(report, "OK", true);
+        append_report(report, "(%lluus)\n", latency_us);
+        return;
+    }
+
+    // Print RAW FIX message received
+    // from server
+    append_report(report, "  %02d\tRECV:  ", run.step);
+    print_details(report, msg);
+    append_report(report, "  (%lluus)\n", latency_us);
+
+    append_report(report, "%*sRECEIVED:\n", table_indent, "");
+
+    for (size_t i = 0; i < expected.size(); ++i) {
+        const int tag = expected[i].first;
+        const std::string& exp_text = expected[i].second;
+        const TstMatcher::Verdict& verdict = run.verdicts[i];
+
+        const uint16_t slot = run.expected->slots[i];
+        const bool is_clr = (slot >= 1 && slot <= max_clr);
+        const char* show_exp = is_clr ? run.clr_values.values[slot].c_str() : exp_text.c_str();
+
+        const std::string act_val = verdict.found ? msg.substr(verdict.value_pos, verdict.value_len) : std::string();
+        const bool is_ignored = exp_text.empty() || exp_text == "IGNORE";
+        const char* got_text = verdict.found ? act_val.c_str() : (is_ignored ? "IGNORE" : "MISSING");
+
+        std::string received_named;
+        received_named.reserve(64);
+        make_fix_field_name(received_named, tag, got_text);
+        if (!received_named.empty() && received_named.back() == '|') received_named.pop_back();
+
+        append_report(report, "%*s", table_indent, "");
+
+        if (verdict.match) {
+            get_status_clr(report, "OK", true);
+            append_report(report, "  %s\n", received_named.c_str());
+        }
+        else {
+            std::string got_exp_name;
+            got_exp_name.reserve(64);
+            make_fix_field_name(got_exp_name, tag, show_exp);
+            if (!got_exp_name.empty() && got_exp_name.back() == '|') got_exp_name.pop_back();
+
+            append_report(report, "%s%-4s  %s != %s <- (exp)\n", RED, "FAIL",
+                          received_named.c_str(), got_exp_name.c_str(), RESET);
+        }
+    }
+}
+
+// Runs steps until the scenario ends or waits
+// for inbound. Returns False on socket error.
+static bool advance_scenario(RegressionLink& link,
+                             OutboundThrottle& throttle,
+                             const RegressionOptions& options,
+                             ScenarioRun& run) {
+    while (!run.done) {
+        if (run.waiting) {
+            std::string msg;
+            uint64_t received_ns = 0;
+            if (!run.inbox.take(run.wait_key, msg, received_ns) &&
+                utils::get_monotonic_millis() < run.deadline_ms) {
+                return true;
+            }
+
+            run.waiting = false;
+            if (run.waiting_tst) {
+                check_step(run, msg, received_ns, options.verbose);
             } else {
-                total_failed++;
-                failed_names.push_back(scenario_name);
+                run.step++;
+                append_report(run.report, "  %02d  \tRCV\n", run.step);
             }
+            continue;
+        }
 
-            print_result_log("END %s\n", scenario_name.c_str());
-            print_result_log("\n");
+        if (run.next_step >= run.script->steps.size()) {
+            if (!run.latencies.empty()) {
+                std::vector<uint64_t> samples_us;
+                for (size_t i = 0; i < run.latencies.size(); ++i) {
+                    samples_us.push_back(run.latencies[i].latency_us());
+                }
+                append_report(run.report, "  latency %s\n",
+                              format_latency_stats(latency_stats(samples_us)).c_str());
+                run.report += format_latency_histogram(samples_us);
+            }
 
-            in_scenario = false;
-            continue;
+            // Responses routed here that no
+            // TST/RCV step asked for
+            std::string left;
+            uint64_t left_ns = 0;
+            while (run.inbox.take("", left, left_ns)) {
+                append_report(run.report, "  UNUSED: %s\n", utils::to_pipe_delimited(left).c_str());
+                run.unused++;
+            }
+            append_report(run.report, "END %s\n", run.script->name.c_str());
+            append_report(run.report, "\n");
+            run.done = true;
+            run.finished_ms = utils::get_monotonic_millis();
+            break;
         }
 
-        if (!in_scenario) continue;
+        const size_t step_index = run.next_step++;
+        const ScenarioRecord& scenario_step = run.script->steps[step_index];
 
-        if (cmd == "RCV") {
-            std::string msg;
-            bool stop_requested = false;
-
-            if (!read_next_business_message(socket, fix_parser, fix,
-                                            outbound_seq, last_send_ms, token_path,
-                                            logon_accepted, stop_requested,
-                                            scenarios_sent,
-                                            scenario_response_started, last_scenario_response_ms,
-                                            logout_initiated,
-                                            timeout_discard_ms, msg)) {
+        if (scenario_step.opcode == scenario_op_snd) {
+            if (!send_step(link, throttle, run, scenario_step)) {
                 return false;
             }
+            continue;
+        }
 
-            step++;
-            std::printf("  %02d  \tRCV\n", step);
+        if (scenario_step.opcode == scenario_op_rcv) {
+            run.waiting = true;
+            run.waiting_tst = false;
+            run.wait_key.clear();
+            run.deadline_ms = utils::get_monotonic_millis() + static_cast<uint64_t>(
+                scenario_step.timeout_ms > 0 ? scenario_step.timeout_ms : timeout_discard_ms);
             continue;
         }
 
-		if (cmd == "SND") {
-		    FixMessage::FieldList raw;
-		    std::string msg_type;
-		    parse_fields(payload, raw, &msg_type);
-		
-		    if (msg_type.empty()) {
-		        step++;
-		        std::printf("  %02d  SEND: (ERROR missing 35)\n", step);
-		        scenario_ok = false;
-		        continue;
-		    }
-		
-		    const std::string now_utc = utils::get_utc_timestamp();
-		
-		    // Apply clrN and fill blanks (34/52/60)
-		    for (size_t i = 0; i < raw.size(); ++i) {
-		        const int tag = raw[i].first;
-		        std::string& value = raw[i].second;
-		
-		        // clrN replacement
-		        if (value.size() >= 4 && value[0] == 'c' && value[1] == 'l' && value[2] == 'r') {
-		            int n = 0;
-		            bool ok = true;
-		            for (size_t j = 3; j < value.size(); ++j) {
-		                const char ch = value[j];
-		                if (ch < '0' || ch > '9') { ok = false; break; }
-		                n = (n * 10) + (ch - '0');
-		            }
-		            if (ok && n >= 1 && n <= max_clr) {
-		                value = clr_values[n];
-		            }
-		        }
-		
-		        // fill blanks like v1
-		        if (tag == 34 && value.empty()) {
-		            char buf[32];
-		            std::snprintf(buf, sizeof(buf), "%d", outbound_seq);
-		            value = buf;
-		        }
-		        if (tag == 52 && value.empty()) value = now_utc;
-		        if (tag == 60 && value.empty()) value = now_utc;
-		    }
-		
-		    // Build raw FIX from ordered fields (preserves your scenario order)
-		    const std::string msg = fix.build_from_fields(raw);
-		    if (msg.empty()) {
-		        step++;
-		        std::printf("  %02d  SEND: (ERROR build_from_fields failed)\n", step);
-		        scenario_ok = false;
-		        continue;
-		    }
-		
-		    if (!socket.send_bytes(msg)) {
-		        return false;
-		    }
-		
-		    last_send_ms = utils::get_monotonic_millis();
-		    outbound_seq++;
-		    save_token(token_path, outbound_seq);
-		    scenarios_sent = true;
-		
-		    step++;
-
-            std::string send_line;
-            send_line.reserve(raw.size() * 16);
-            for (size_t i = 0; i < raw.size(); ++i) {
-                make_fix_field_name(send_line, raw[i].first, raw[i].second.c_str());
+        if (scenario_step.opcode == scenario_op_tst) {
+            run.expected = &scenario_step;
+            run.matcher = &run.script->matchers[step_index];
+
+            run.step++;
+
+            std::string tst_message;
+            tst_message.reserve(scenario_step.fields.size() * 16);
+            for (size_t i = 0; i < scenario_step.fields.size(); ++i) {
+                make_fix_field_name(tst_message, scenario_step.fields[i].first, scenario_step.fields[i].second.c_str());
             }
 
-            print_result_log("  %02d \tSEND: %s\n", step, send_line.c_str());
-		    continue;
-		}
+            append_report(run.report, "  %02d  \tTEST:  %s\n", run.step, tst_message.c_str());
 
-        if (cmd == "TST") {
-            FixMessage::FieldList expected;
-            parse_fields(payload, expected, 0);
-            const int table_indent = 9;
+            // Satisfied as soon as the response
+            // for this step's order arrives
+            run.waiting = true;
+            run.waiting_tst = true;
+            run.wait_key = correlation_key(scenario_step, run.clr_values);
+            run.deadline_ms = utils::get_monotonic_millis() + static_cast<uint64_t>(
+                scenario_step.timeout_ms > 0 ? scenario_step.timeout_ms : timeout_test_ms);
+            continue;
+        }
+    }
 
-            step++;
+    return true;
+}
 
-            std::string tst_message;
-            tst_message.reserve(expected.size() * 16);
-            for (size_t i = 0; i < expected.size(); ++i) {
-                make_fix_field_name(tst_message, expected[i].first, expected[i].second.c_str());
+// Hands a business message to the scenario
+// owning its ClOrdID/CrossID/OrigClOrdID.
+// Responses of a scenario that already ended
+// and messages no scenario can own are logged
+// and counted, never given to another one.
+static void route_message(const std::string& msg,
+                          uint64_t received_ns,
+                          const std::map<std::string, size_t>& routes,
+                          std::deque<ScenarioRun>& runs,
+                          const std::vector<size_t>& active,
+                          RegressionSummary& summary) {
+    static const char* const key_prefixes[] = { "11=", "548=", "41=" };
+
+    for (size_t i = 0; i < sizeof(key_prefixes) / sizeof(key_prefixes[0]); ++i) {
+        std::string value;
+        if (!utils::find_tag_value(msg, key_prefixes[i], value)) continue;
+
+        std::map<std::string, size_t>::const_iterator found = routes.find(value);
+        if (found == routes.end()) continue;
+
+        ScenarioRun& owner = runs[found->second];
+        if (owner.done) {
+            print_result_log("LATE %s: %s\n", owner.script->name.c_str(), utils::to_pipe_delimited(msg).c_str());
+            summary.unmatched++;
+            return;
+        }
+        owner.inbox.add(msg, received_ns);
+        return;
+    }
+
+    // Unknown IDs only go to
+    // a scenario running alone
+    if (active.size() == 1) {
+        runs[active[0]].inbox.add(msg, received_ns);
+        return;
+    }
+
+    print_result_log("UNROUTED: %s\n", utils::to_pipe_delimited(msg).c_str());
+    summary.unmatched++;
+}
+
+// Runs up to options.max_jobs scenarios at once on one
+// session and reports them in file order
+static bool run_scripts(RegressionLink& link,
+                        const std::vector<ScenarioScript>& scripts,
+                        const RegressionOptions& options,
+                        IdGenerator& id_generator,
+                        OutboundThrottle& throttle,
+                        RegressionSummary& summary,
+                        std::vector<LatencySample>& latencies) {
+    const size_t job_limit = (options.max_jobs > 0) ? static_cast<size_t>(options.max_jobs) : 1;
+
+    std::deque<ScenarioRun> runs;
+    std::map<std::string, size_t> routes;
+    std::vector<size_t> active;
+    size_t next_report = 0;
+
+    while (next_report < scripts.size()) {
+        // Start scenarios in file order,
+        // an exclusive one runs alone
+        while (runs.size() < scripts.size() && active.size() < job_limit) {
+            const ScenarioScript& script = scripts[runs.size()];
+            if (!active.empty() && (script.exclusive || runs[active[0]].script->exclusive)) {
+                break;
             }
 
-            print_result_log("  %02d  \tTEST:  %s\n", step, tst_message.c_str());
+            const size_t index = runs.size();
+            runs.push_back(ScenarioRun(script, id_generator, routes, index));
+            ScenarioRun& run = runs.back();
+
+            RegressionCacheEntry entry;
+            if (find_cached_result(script, options, entry)) {
+                append_report(run.report, "\nBEGIN %s (cached %s, %llums)\n", script.name.c_str(),
+                              entry.passed ? "PASS" : "FAIL",
+                              static_cast<unsigned long long>(entry.elapsed_ms));
+                run.report += entry.report;
+                run.ok = entry.passed;
+                run.done = true;
+                run.cached = true;
+
+                // Keeps the file's duration
+                // for shard planning
+                run.finished_ms = run.started_ms + entry.elapsed_ms;
+                continue;
+            }
 
-            std::string msg;
-            bool stop_requested = false;
-
-            if (!read_next_business_message(socket, fix_parser, fix,
-                                            outbound_seq, last_send_ms, token_path,
-                                            logon_accepted, stop_requested,
-                                            scenarios_sent,
-                                            scenario_response_started, last_scenario_response_ms,
-                                            logout_initiated,
-                                            timeout_test_ms, msg)) {
+            append_report(run.report, "\nBEGIN %s\n", script.name.c_str());
+            active.push_back(index);
+        }
+
+        for (size_t i = 0; i < active.size(); ++i) {
+            if (!advance_scenario(link, throttle, options, runs[active[i]])) {
                 return false;
             }
-    
-            step++;
-            if (msg.empty()) {
-                std::printf("  %02d  \tRECV: (TIMEOUT)\n", step);
-                scenario_ok = false;
+        }
+
+        size_t kept = 0;
+        for (size_t i = 0; i < active.size(); ++i) {
+            ScenarioRun& run = runs[active[i]];
+            if (run.done) {
                 continue;
             }
+            active[kept++] = active[i];
+        }
+        active.resize(kept);
 
-            // Print RAW FIX message received
-            // from server
-            print_result_log("  %02d\tRECV:  ", step);
-            print_details(msg);
-            print_result_log("\n");
-
-            print_result_log("%*sRECEIVED:\n", table_indent, "");
-
-            for (size_t i = 0; i < expected.size(); ++i) {
-                const int tag = expected[i].first;
-                const std::string& exp_text = expected[i].second;
-
-                std::string exp_val = exp_text;
-                if (exp_text.size() >= 4 && exp_text[0] == 'c' && exp_text[1] == 'l' && exp_text[2] == 'r') {
-                    int n = 0;
-                    bool ok = true;
-                    for (size_t j = 3; j < exp_text.size(); ++j) {
-                        const char ch = exp_text[j];
-                        if (ch < '0' || ch > '9') { ok = false; break; }
-                        n = (n * 10) + (ch - '0');
-                    }
-                    if (ok && n >= 1 && n <= max_clr) {
-                        exp_val = clr_values[n];
-                    }
-                }
+        while (next_report < runs.size() && runs[next_report].done) {
+            ScenarioRun& run = runs[next_report];
+            write_result_log(run.report.data(), run.report.size());
 
-                char prefix[16];
-                std::snprintf(prefix, sizeof(prefix), "%d=", tag);
-
-                std::string act_val;
-                act_val.clear();
-                const bool has = utils::find_tag_value(msg, prefix, act_val);
-
-                bool match = false;
-				if (exp_text.empty()) {
-					match = true;
-				}	
-                else if (exp_text == "IGNORE") {
-                    match = true;
-                } else if (exp_text == "NONE") {
-                    match = (!has || act_val.empty() || act_val == "NONE");
-                } else {
-                    match = has && (act_val == exp_val);
-                }
+            if (!run.cached) {
+                const size_t begin_len = run.script->name.size() + sizeof("\nBEGIN \n") - 1;
 
-                const char* show_exp = exp_text.c_str();
-                if (exp_text.size() >= 4 && exp_text[0]=='c' && exp_text[1]=='l' && exp_text[2]=='r') {
-                    show_exp = exp_val.c_str();
+                RegressionCacheEntry entry;
+                entry.passed = run.ok;
+                entry.elapsed_ms = run.finished_ms - run.started_ms;
+                entry.report.assign(run.report, begin_len, std::string::npos);
+                if (!save_regression_result(run.script->cache_key, entry)) {
+                    std::printf("Warning: cannot cache the result of %s\n", run.script->name.c_str());
                 }
+            }
+            std::string().swap(run.report);
+            summary.unmatched += run.unused;
+            latencies.insert(latencies.end(), run.latencies.begin(), run.latencies.end());
+
+            summary.total_run++;
+            if (run.cached) summary.total_cached++;
+            if (run.ok) {
+                summary.total_passed++;
+            } else {
+                summary.total_failed++;
+                summary.failed_names.push_back(run.script->name);
+            }
+            summary.file_ms[run.script->file_index].second += run.finished_ms - run.started_ms;
+            next_report++;
+        }
 
-                const char* got_text = has ? act_val.c_str() : "MISSING";
+        if (active.empty()) {
+            continue;
+        }
 
-                std::string received_named;
-                received_named.reserve(64);
-                make_fix_field_name(received_named, tag, got_text);
-                if (!received_named.empty() && received_named.back() == '|') received_named.pop_back();
+        // Every active scenario waits for inbound,
+        // read until the nearest step deadline
+        const uint64_t now_ms = utils::get_monotonic_millis();
+        uint64_t deadline_ms = runs[active[0]].deadline_ms;
+        for (size_t i = 1; i < active.size(); ++i) {
+            if (runs[active[i]].deadline_ms < deadline_ms) {
+                deadline_ms = runs[active[i]].deadline_ms;
+            }
+        }
+        if (deadline_ms <= now_ms) {
+            continue;
+        }
 
-                print_result_log("%*s", table_indent, "");
+        std::string inbound;
+        bool stop_requested = false;
+        if (!read_next_business_message(link.socket, link.session, link.fix_parser, link.fix,
+                                        link.outbound_seq, link.last_send_ms, link.token_path,
+                                        link.logon_accepted, stop_requested,
+                                        link.scenarios_sent,
+                                        link.scenario_response_started, link.last_scenario_response_ms,
+                                        link.logout_initiated,
+                                        static_cast<int>(deadline_ms - now_ms), inbound)) {
+            return false;
+        }
 
-                if (match) {
-                    get_status_clr("OK", true);
-                    print_result_log("  %s\n", received_named.c_str());
-                }
-                else {
-                    std::string got_exp_name;
-                    got_exp_name.reserve(64);
-                    make_fix_field_name(got_exp_name, tag, show_exp);
-                    if (!got_exp_name.empty() && got_exp_name.back() == '|') got_exp_name.pop_back();
-
-                    print_result_log("%s%-4s  %s != %s <- (exp)\n", RED, "FAIL",
-                                     received_named.c_str(), got_exp_name.c_str(), RESET);
-                    scenario_ok = false;
-                }
-            }
+        if (stop_requested) {
+            return false;
+        }
 
-            continue;
+        if (!inbound.empty()) {
+            route_message(inbound, utils::get_realtime_nanos(), routes, runs, active, summary);
         }
     }
 
     return true;
 }
 
-bool run_fix_regression(TcpSocket& socket,
-                        FixParser& fix_parser,
-                        FixMessage& fix,
-                        const std::string& scenarios_path,
-                        int& outbound_seq,
-                        uint64_t& last_send_ms,
-                        const std::string& token_path,
-                        bool& logon_accepted,
-                        bool& scenarios_sent,
-                        bool& scenario_response_started,
-                        uint64_t& last_scenario_response_ms,
-                        bool& logout_initiated) {
-    int total_run = 0;
-    int total_passed = 0;
-    int total_failed = 0;
-    std::vector<std::string> failed_names;
-    log_begin_string = fix.get_begin_string();
-    log_sender_comp_id = fix.get_sender_comp_id();
-
-
+std::vector<std::string> list_regression_files(const std::string& scenarios_path) {
     std::vector<std::string> files;
     DIR* dir = ::opendir(scenarios_path.c_str());
     if (dir) {
@@ -554,37 +933,202 @@ bool run_fix_regression(TcpSocket& socket,
     } else {
         files.push_back(scenarios_path);
     }
+    return files;
+}
+
+// Suite histogram, CSV sidecar and
+// the comparison with options.baseline_path
+static void report_latency(const std::vector<LatencySample>& latencies,
+                           const RegressionOptions& options,
+                           RegressionSummary& summary) {
+    std::map<std::string, std::vector<uint64_t> > by_scenario;
+    std::vector<uint64_t> samples_us;
+    for (size_t i = 0; i < latencies.size(); ++i) {
+        samples_us.push_back(latencies[i].latency_us());
+        by_scenario[latencies[i].scenario].push_back(samples_us.back());
+    }
+
+    print_result_log("\n# LATENCY (SND -> TST)\n");
+    print_result_log("Round trips:\t\t%s\n", format_latency_stats(latency_stats(samples_us)).c_str());
+    const std::string histogram = format_latency_histogram(samples_us);
+    write_result_log(histogram.data(), histogram.size());
+
+    const std::string csv_path = result_path_base() + ".csv";
+    if (save_latency_csv(csv_path, latencies)) {
+        print_result_log("Samples:\t\t%s\n", csv_path.c_str());
+    } else {
+        std::printf("Error: cannot write %s\n", csv_path.c_str());
+    }
+
+    if (options.baseline_path.empty()) {
+        return;
+    }
+
+    std::map<std::string, std::vector<uint64_t> > baseline;
+    if (!load_latency_csv(options.baseline_path, baseline)) {
+        std::printf("Error: cannot read baseline %s\n", options.baseline_path.c_str());
+        return;
+    }
+
+    const std::vector<LatencyShift> shifts = compare_latency(baseline, by_scenario, options.baseline_threshold_pct);
+    summary.latency_flagged = static_cast<int>(shifts.size());
+
+    print_result_log("\n# BASELINE %s (p50/p99 moved > %d%%)\n",
+                     options.baseline_path.c_str(), options.baseline_threshold_pct);
+    for (size_t i = 0; i < shifts.size(); ++i) {
+        const LatencyShift& shift = shifts[i];
+        print_result_log("%-7s %s: p50 %llu -> %lluus, p99 %llu -> %lluus\n",
+                         shift.slower ? "SLOWER" : "FASTER", shift.scenario.c_str(),
+                         static_cast<unsigned long long>(shift.baseline.p50_us),
+                         static_cast<unsigned long long>(shift.current.p50_us),
+                         static_cast<unsigned long long>(shift.baseline.p99_us),
+                         static_cast<unsigned long long>(shift.current.p99_us));
+    }
+    print_result_log("Flagged:\t\t%d of %zu scenarios\n", summary.latency_flagged, by_scenario.size());
+}
+
+bool run_fix_regression(Transport& socket,
+                        SessionContext& session,
+                        FixParser& fix_parser,
+                        FixMessage& fix,
+                        const std::vector<std::string>& files,
+                        int& outbound_seq,
+                        uint64_t& last_send_ms,
+                        const std::string& token_path,
+                        bool& logon_accepted,
+                        bool& scenarios_sent,
+                        bool& scenario_response_started,
+                        uint64_t& last_scenario_response_ms,
+                        bool& logout_initiated,
+                        IdGenerator& id_generator,
+                        OutboundThrottle& throttle,
+                        const RegressionOptions& options,
+                        RegressionSummary& summary) {
+    summary = RegressionSummary();
+    log_begin_string = fix.get_begin_string();
+    log_sender_comp_id = fix.get_sender_comp_id();
+
+    RegressionLink link = {
+        socket, session, fix_parser, fix, outbound_seq, last_send_ms, token_path,
+        logon_accepted, scenarios_sent, scenario_response_started,
+        last_scenario_response_ms, logout_initiated
+    };
 
     bool ok = true;
+    precompile_scenarios(files, scenario_format_regression);
+
+    std::vector<ScenarioScript> scripts;
     for (size_t i = 0; i < files.size(); ++i) {
-        if (!run_file(files[i], socket, fix_parser, fix,
-                      outbound_seq, last_send_ms, token_path,
-                      logon_accepted, scenarios_sent,
-                      scenario_response_started, last_scenario_response_ms,
-                      logout_initiated,
-                      total_run, total_passed, total_failed, failed_names)) {
+        summary.file_ms.push_back(std::make_pair(files[i], static_cast<uint64_t>(0)));
+        if (!load_scripts(files[i], i, scripts)) {
             ok = false;
             break;
         }
     }
 
+    for (size_t i = 0; i < scripts.size(); ++i) {
+        scripts[i].cache_key = scenario_cache_key(scripts[i], options.config_hash);
+    }
+
+    std::vector<LatencySample> latencies;
+    if (!run_scripts(link, scripts, options, id_generator, throttle, summary, latencies)) {
+        ok = false;
+    }
+
+    if (!latencies.empty()) {
+        report_latency(latencies, options, summary);
+    }
+
     print_result_log("\n# OVER ALL SUMMARY\n");
-    print_result_log("Total Scenarios:\t%d\n", total_run);
-    print_result_log("Total Passed:\t\t%d\n", total_passed);
+    print_result_log("Total Scenarios:\t%d\n", summary.total_run);
+    print_result_log("Total Passed:\t\t%d\n", summary.total_passed);
+    if (summary.total_cached > 0) {
+        print_result_log("Total Cached:\t\t%d\n", summary.total_cached);
+    }
+    if (summary.latency_flagged > 0) {
+        print_result_log("Latency Flagged:\t%d\n", summary.latency_flagged);
+    }
+    if (summary.unmatched > 0) {
+        print_result_log("Unmatched Inbound:\t%d\n", summary.unmatched);
+    }
 
-    if (total_failed == 0) {
+    if (summary.total_failed == 0) {
         print_result_log("Total Failed:\t\t0\n");
         print_result_log("All done!\n");
     } else {
-        std::printf("Total Failed:\t\t%d (", total_failed);
-        for (size_t i = 0; i < failed_names.size(); ++i) {
+        std::printf("Total Failed:\t\t%d (", summary.total_failed);
+        for (size_t i = 0; i < summary.failed_names.size(); ++i) {
             if (i) print_result_log(", ");
-            print_result_log("%s", failed_names[i].c_str());
+            print_result_log("%s", summary.failed_names[i].c_str());
         }
         print_result_log(")\n");
     }
 
     std::printf("\n");
 
-    return ok && (total_failed == 0);
+    return ok && (summary.total_failed == 0);
+}
+
+// Line based:
+//   run|passed|failed|cached|latency_flagged|unmatched <n>
+//   failed_name <name>
+//   file_ms <ms> <path>
+bool save_regression_summary(const std::string& path, const RegressionSummary& summary) {
+    FILE* out = std::fopen(path.c_str(), "w");
+    if (!out) {
+        return false;
+    }
+
+    std::fprintf(out, "run %d\n", summary.total_run);
+    std::fprintf(out, "passed %d\n", summary.total_passed);
+    std::fprintf(out, "failed %d\n", summary.total_failed);
+    std::fprintf(out, "cached %d\n", summary.total_cached);
+    std::fprintf(out, "latency_flagged %d\n", summary.latency_flagged);
+    std::fprintf(out, "unmatched %d\n", summary.unmatched);
+    for (size_t i = 0; i < summary.failed_names.size(); ++i) {
+        std::fprintf(out, "failed_name %s\n", summary.failed_names[i].c_str());
+    }
+    for (size_t i = 0; i < summary.file_ms.size(); ++i) {
+        std::fprintf(out, "file_ms %llu %s\n",
+                     static_cast<unsigned long long>(summary.file_ms[i].second),
+                     summary.file_ms[i].first.c_str());
+    }
+
+    const bool ok = (std::fflush(out) == 0);
+    std::fclose(out);
+    return ok;
+}
+
+bool load_regression_summary(const std::string& path, RegressionSummary& summary) {
+    std::ifstream in(path.c_str());
+    if (!in.is_open()) {
+        return false;
+    }
+
+    summary = RegressionSummary();
+
+    std::string line;
+    while (std::getline(in, line)) {
+        const size_t space = line.find(' ');
+        if (space == std::string::npos) continue;
+
+        const std::string key = line.substr(0, space);
+        const std::string value = line.substr(space + 1);
+
+        if (key == "run") summary.total_run = std::atoi(value.c_str());
+        else if (key == "passed") summary.total_passed = std::atoi(value.c_str());
+        else if (key == "failed") summary.total_failed = std::atoi(value.c_str());
+        else if (key == "cached") summary.total_cached = std::atoi(value.c_str());
+        else if (key == "latency_flagged") summary.latency_flagged = std::atoi(value.c_str());
+        else if (key == "unmatched") summary.unmatched = std::atoi(value.c_str());
+        else if (key == "failed_name") summary.failed_names.push_back(value);
+        else if (key == "file_ms") {
+            const size_t path_pos = value.find(' ');
+            if (path_pos == std::string::npos) continue;
+
+            const uint64_t ms = std::strtoull(value.c_str(), 0, 10);
+            summary.file_ms.push_back(std::make_pair(value.substr(path_pos + 1), ms));
+        }
+    }
+    return true;
 }
@@ -1,4 +1,5 @@
 #include "fix_template.h"
+#include "instrument_cache.h"
 #include "utils.h"
 
 #include <fstream>
@@ -32,35 +33,50 @@ static bool parse_fix_tag(const std::string& tag_text, int& tag_value) {
     return true;
 }
 
-// For ClordID(11)
-// PREF + EPOS_MS + COUNTER (eg. CL1100..)
-static std::string make_unique_id(const char* prefix,
-                                  const std::string& sending_time_utc,
-                                  int msg_seq_num,
-                                  int counter) {
-    char digits[32];
-    size_t digits_len = 0;
-
-    for (size_t i = 0; i < sending_time_utc.size() && digits_len + 1 < sizeof(digits); ++i) {
-        char ch = sending_time_utc[i];
-        if (ch >= '0' && ch <= '9') {
-            digits[digits_len++] = ch;
-        }
-    }
-    digits[digits_len] = '\0';
+// For ClordID(11), CrossID(548)
+// PREF + EPOCH + COUNTER (eg. CL0001000000A7)
+static std::string make_unique_id(FixTemplateRuntime& runtime, const char* prefix) {
+    char buf[IdGenerator::max_id_len];
+    const size_t len = runtime.id_generator->next(prefix, buf);
+    return std::string(buf, len);
+}
 
-    const size_t keep = 11;
-    const char* time_part = digits;
-    if (digits_len > keep) {
-        time_part = digits + (digits_len - keep);
+// Security master placeholders, unknown
+// names and fields stay as they are
+static bool instrument_value(const InstrumentRecord& record, std::string& value_text) {
+    char buf[fix_decimal_max_size];
+    if (value_text == "${TICK_SIZE}" && (record.known & instrument_has_tick_size)) {
+        value_text.assign(buf, fix_decimal_format(record.tick_size, buf));
     }
+    else if (value_text == "${ROUND_LOT}" && (record.known & instrument_has_round_lot)) {
+        value_text.assign(buf, fix_decimal_format(record.round_lot, buf));
+    }
+    else if (value_text == "${MIN_TRADE_VOL}" && (record.known & instrument_has_min_trade_vol)) {
+        value_text.assign(buf, fix_decimal_format(record.min_trade_vol, buf));
+    }
+    else if (value_text == "${SECURITY_ID}" && (record.known & instrument_has_security_id)) {
+        value_text = record.security_id;
+    }
+    else if (value_text == "${SECURITY_ID_SOURCE}" && (record.known & instrument_has_security_id_source)) {
+        value_text = record.security_id_source;
+    }
+    else if (value_text == "${CURRENCY}" && (record.known & instrument_has_currency)) {
+        value_text = record.currency;
+    }
+    else {
+        return false;
+    }
+    return true;
+}
 
-    const int seq_part = (msg_seq_num < 0) ? 0 : (msg_seq_num % 10000);
-    const int count_part = (counter < 0) ? 0 : (counter % 100);
-
-    char buf[64];
-    std::snprintf(buf, sizeof(buf), "%s%s%04d%02d", prefix, time_part, seq_part, count_part);
-    return std::string(buf);
+static const InstrumentRecord* find_instrument(const FixTemplateRuntime& runtime,
+                                               const FixMessage::FieldList& fields) {
+    for (size_t i = 0; i < fields.size(); i++) {
+        if (fields[i].first == 55) {
+            return runtime.instruments->find(fields[i].second);
+        }
+    }
+    return 0;
 }
 
 // Parse RAW FIX
@@ -126,12 +142,23 @@ bool fix_template_load(const std::string& file_path,FixTemplateMessage& template
 bool fix_template_apply(FixTemplateRuntime& runtime,
                         FixTemplateMessage& template_message) {
 
+    // Without the session's generator the
+    // epoch is unknown and IDs would repeat
+    // those of an earlier run
+    if (!runtime.id_generator) {
+        std::printf("Error: template needs the session ID generator\n");
+        return false;
+    }
+
     bool is_set_begin_string = false;
     bool is_set_sender = false;
     bool is_set_target = false;
     bool is_set_seq = false;
     bool is_set_time = false;
 
+    const InstrumentRecord* instrument = 0;
+    bool is_instrument_looked_up = false;
+
     // Overwrite header/runtime fields
     // and fill 60 if blank
     for (size_t i = 0; i < template_message.fields.size(); i++) {
@@ -173,18 +200,25 @@ bool fix_template_apply(FixTemplateRuntime& runtime,
         // placeholder 41:${ORG_CLRID}
         if (tag_value == 41 && value_text == "${ORG_CLRID}") {
             if (runtime.state.org_clord_id.empty()) {
-                runtime.state.org_clord_id = make_unique_id("CL", runtime.sending_time_utc, runtime.msg_seq_num, 1);
+                runtime.state.org_clord_id = make_unique_id(runtime, "CL");
             }
             value_text = runtime.state.org_clord_id;
             continue;
         }
+
+        if (runtime.instruments && value_text.compare(0, 2, "${") == 0) {
+            if (!is_instrument_looked_up) {
+                instrument = find_instrument(runtime, template_message.fields);
+                is_instrument_looked_up = true;
+            }
+            if (instrument) {
+                instrument_value(*instrument, value_text);
+            }
+        }
     }
 
     // ALWAYS overwrite CrossID, ClordID
     // (ignore template values)
-    int clord_counter = 0;
-    int cross_counter = 0;
-
     for (size_t i = 0; i < template_message.fields.size(); i++) {
         const int tag_value = template_message.fields[i].first;
         std::string& value_text = template_message.fields[i].second;
@@ -192,20 +226,18 @@ bool fix_template_apply(FixTemplateRuntime& runtime,
         if (tag_value == 11) {
             if (value_text == "${ORG_CLRID}") {
                 if (runtime.state.org_clord_id.empty()) {
-                    runtime.state.org_clord_id = make_unique_id("CL", runtime.sending_time_utc, runtime.msg_seq_num, 1);
+                    runtime.state.org_clord_id = make_unique_id(runtime, "CL");
                 }
                 value_text = runtime.state.org_clord_id;
             }
             else {
-                clord_counter++;
-                value_text = make_unique_id("CL", runtime.sending_time_utc, runtime.msg_seq_num, clord_counter);
+                value_text = make_unique_id(runtime, "CL");
             }
             continue;
         }
 
         if (tag_value == 548) {
-            cross_counter++;
-            value_text = make_unique_id("X", runtime.sending_time_utc, runtime.msg_seq_num, cross_counter);
+            value_text = make_unique_id(runtime, "X");
             continue;
         }
     }
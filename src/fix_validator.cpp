@@ -0,0 +1,386 @@
+#include "fix_validator.h"
+#include "fix_typed.h"
+#include "constants.h"
+
+#include <cstring>
+
+static const uint16_t no_field = 0xFFFF;
+
+// field_flags: FixFieldType in the low bits
+static const uint8_t flag_type_mask = 0x07;
+static const uint8_t flag_num_in_group = 0x08;
+static const uint8_t flag_enum = 0x10;
+
+// Rule::slots: defined at the top level,
+// required (bit number in the low 6 bits),
+// innermost group + 1 in bits 6..13
+static const uint16_t slot_body = 0x8000;
+static const uint16_t slot_required = 0x4000;
+static const uint16_t slot_bit_mask = 0x003F;
+static const int slot_group_shift = 6;
+static const uint16_t slot_group_mask = 0xFF;
+
+// Open groups tracked in one message
+static const int max_group_depth = 8;
+
+bool parse_validation_mode(const std::string& text, FixValidationMode& mode) {
+    if (text == "off") mode = validation_off;
+    else if (text == "warn") mode = validation_warn;
+    else if (text == "reject") mode = validation_reject;
+    else return false;
+    return true;
+}
+
+static const char* reject_text(int reason) {
+    switch (reason) {
+        case fix_reject_required_tag_missing:   return "Required tag missing";
+        case fix_reject_tag_not_defined:        return "Tag not defined for this message type";
+        case fix_reject_undefined_tag:          return "Undefined tag";
+        case fix_reject_tag_without_value:      return "Tag specified without a value";
+        case fix_reject_value_incorrect:        return "Value is incorrect (out of range) for this tag";
+        case fix_reject_incorrect_data_format:  return "Incorrect data format for value";
+        case fix_reject_invalid_msg_type:       return "Invalid MsgType";
+        case fix_reject_tag_appears_twice:      return "Tag appears more than once";
+        case fix_reject_tag_out_of_order:       return "Tag specified out of required order";
+        case fix_reject_group_out_of_order:     return "Repeating group fields out of order";
+        case fix_reject_incorrect_num_in_group: return "Incorrect NumInGroup count for repeating group";
+        default:                                return "Invalid message";
+    }
+}
+
+static bool fail(FixValidationError& error, int reason, int ref_tag) {
+    error.reason = reason;
+    error.ref_tag = ref_tag;
+    error.text = reject_text(reason);
+    if (ref_tag > 0) {
+        error.text += " (" + std::to_string(ref_tag) + ")";
+    }
+    return false;
+}
+
+static bool is_digit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+static bool is_int(const FixText& value) {
+    size_t i = (value.data[0] == '-') ? 1 : 0;
+    if (i == value.size) return false;
+    for (; i < value.size; ++i) {
+        if (!is_digit(value.data[i])) return false;
+    }
+    return true;
+}
+
+static bool is_decimal(const FixText& value) {
+    size_t i = (value.data[0] == '-') ? 1 : 0;
+    bool digits = false;
+    bool dot = false;
+    for (; i < value.size; ++i) {
+        if (is_digit(value.data[i])) {
+            digits = true;
+        } else if (value.data[i] == '.' && !dot) {
+            dot = true;
+        } else {
+            return false;
+        }
+    }
+    return digits;
+}
+
+// YYYYMMDD-HH:MM:SS[.sss|.ssssss|.sssssssss]
+static bool is_timestamp(const FixText& value) {
+    static const char shape[] = "dddddddd-dd:dd:dd";
+    if (value.size < 17) return false;
+    for (size_t i = 0; i < 17; ++i) {
+        if (shape[i] == 'd' ? !is_digit(value.data[i]) : value.data[i] != shape[i]) return false;
+    }
+    if (value.size == 17) return true;
+    if (value.data[17] != '.' || (value.size != 21 && value.size != 24 && value.size != 27)) return false;
+    for (size_t i = 18; i < value.size; ++i) {
+        if (!is_digit(value.data[i])) return false;
+    }
+    return true;
+}
+
+static bool has_type(uint8_t flags, const FixText& value) {
+    switch (static_cast<FixFieldType>(flags & flag_type_mask)) {
+        case fix_type_char:      return value.size == 1;
+        case fix_type_int:       return is_int(value);
+        case fix_type_decimal:   return is_decimal(value);
+        case fix_type_boolean:   return value.size == 1 && (value.data[0] == 'Y' || value.data[0] == 'N');
+        case fix_type_timestamp: return is_timestamp(value);
+        default:                 return true;
+    }
+}
+
+bool FixValidator::load(const std::string& path, std::string& error) {
+    FixDictionary loaded;
+    return loaded.load(path, error) && build(loaded, error);
+}
+
+bool FixValidator::build(const FixDictionary& source, std::string& error) {
+    dictionary = source;
+    rules.clear();
+    for (size_t i = 0; i < 256; ++i) single_char_rule[i] = -1;
+
+    const std::vector<FixFieldDef>& fields = dictionary.fields();
+    if (fields.size() >= no_field) {
+        error = "too many fields";
+        return false;
+    }
+
+    tag_index.assign(static_cast<size_t>(dictionary.max_tag()) + 1, no_field);
+    field_flags.assign(fields.size(), 0);
+    for (size_t i = 0; i < fields.size(); ++i) {
+        tag_index[static_cast<size_t>(fields[i].tag)] = static_cast<uint16_t>(i);
+        field_flags[i] = static_cast<uint8_t>(fields[i].type) |
+                         (fields[i].num_in_group ? flag_num_in_group : 0) |
+                         (fields[i].values.empty() ? 0 : flag_enum);
+    }
+
+    for (size_t i = 0; i < dictionary.messages().size(); ++i) {
+        if (!add_rule(dictionary.messages()[i], error)) return false;
+    }
+
+    seen.assign(fields.size(), 0);
+    generation = 0;
+    return true;
+}
+
+// Members of a message, group entry, header or
+// trailer into the slots of rule. group_base is
+// where def's groups start in rule.groups.
+static bool add_slots(std::vector<uint16_t>& slots, uint64_t& required, std::vector<int>& required_tags,
+                      const std::vector<uint16_t>& tag_index, const FixMessageDef& def,
+                      const std::vector<FixMemberDef>& members, size_t group, size_t group_base,
+                      std::string& error) {
+    for (size_t i = 0; i < members.size(); ++i) {
+        const FixMemberDef& member = members[i];
+        const uint16_t index = tag_index[static_cast<size_t>(member.tag)];
+        uint16_t& slot = slots[index];
+
+        if (group == 0) {
+            slot |= slot_body;
+            if (member.required && !(slot & slot_required)) {
+                if (required_tags.size() >= 64) {
+                    error = def.name + ": more than 64 required fields";
+                    return false;
+                }
+                slot |= slot_required | static_cast<uint16_t>(required_tags.size());
+                required |= uint64_t(1) << required_tags.size();
+                required_tags.push_back(member.tag);
+            }
+        } else if (((slot >> slot_group_shift) & slot_group_mask) == 0) {
+            slot |= static_cast<uint16_t>(group << slot_group_shift);
+        }
+
+        if (member.group >= 0) {
+            const size_t nested = group_base + static_cast<size_t>(member.group) + 1;
+            if (!add_slots(slots, required, required_tags, tag_index, def,
+                           def.groups[static_cast<size_t>(member.group)].members,
+                           nested, group_base, error)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool FixValidator::add_rule(const FixMessageDef& message, std::string& error) {
+    Rule rule;
+    rule.msg_type = message.msg_type;
+    rule.slots.assign(field_flags.size(), 0);
+    rule.required = 0;
+
+    const FixMessageDef* parts[3] = { &dictionary.header(), &message, &dictionary.trailer() };
+    for (size_t p = 0; p < 3; ++p) {
+        const size_t base = rule.groups.size();
+        for (size_t g = 0; g < parts[p]->groups.size(); ++g) {
+            Group group;
+            group.count_tag = parts[p]->groups[g].count_tag;
+            group.delimiter_tag = parts[p]->groups[g].delimiter_tag;
+            rule.groups.push_back(group);
+        }
+        if (rule.groups.size() > slot_group_mask) {
+            error = message.name + ": too many groups";
+            return false;
+        }
+        if (!add_slots(rule.slots, rule.required, rule.required_tags, tag_index,
+                       *parts[p], parts[p]->members, 0, base, error)) {
+            return false;
+        }
+    }
+
+    if (message.msg_type.size() == 1) {
+        single_char_rule[static_cast<unsigned char>(message.msg_type[0])] = static_cast<int16_t>(rules.size());
+    }
+    rules.push_back(rule);
+    return true;
+}
+
+const FixValidator::Rule* FixValidator::find_rule(const char* msg_type, size_t size) const {
+    if (size == 1) {
+        const int16_t index = single_char_rule[static_cast<unsigned char>(msg_type[0])];
+        return index < 0 ? 0 : &rules[static_cast<size_t>(index)];
+    }
+    for (size_t i = 0; i < rules.size(); ++i) {
+        if (rules[i].msg_type.size() == size && std::memcmp(rules[i].msg_type.data(), msg_type, size) == 0) {
+            return &rules[i];
+        }
+    }
+    return 0;
+}
+
+bool FixValidator::validate(const char* data, size_t size, FixValidationError& error) {
+    error = FixValidationError();
+    if (rules.empty() || check(data, size, error)) {
+        return true;
+    }
+
+    // Stopped before 34, the Reject needs it
+    if (error.ref_seq_num == 0) {
+        const char* pos = data;
+        int tag = 0;
+        FixText value;
+        while (fix_next_field(pos, data + size, tag, value)) {
+            int64_t seq = 0;
+            if (tag == fix_tag_msg_seq_num && fix_get_int(value, seq)) {
+                error.ref_seq_num = static_cast<int>(seq);
+                break;
+            }
+        }
+    }
+    return false;
+}
+
+bool FixValidator::check(const char* data, size_t size, FixValidationError& error) {
+    if (++generation == 0) {
+        seen.assign(seen.size(), 0);
+        generation = 1;
+    }
+
+    struct OpenGroup {
+        size_t id;              // index in rule->groups + 1
+        int64_t count;
+        int64_t entries;
+    };
+    OpenGroup open[max_group_depth];
+    int depth = 0;
+    size_t expect_delimiter = 0;        // group id whose first entry is due
+
+    const Rule* rule = 0;
+    uint64_t seen_required = 0;
+    int field_number = 0;
+
+    const char* pos = data;
+    const char* const end = data + size;
+    int tag = 0;
+    FixText value;
+
+    while (fix_next_field(pos, end, tag, value)) {
+        ++field_number;
+
+        // FixParser framed it, but 8, 9 and
+        // 35 must still lead in that order
+        if (field_number <= 3) {
+            static const int leading[3] = { fix_tag_begin_string, fix_tag_body_length, fix_tag_msg_type };
+            if (tag != leading[field_number - 1]) return fail(error, fix_reject_tag_out_of_order, tag);
+        }
+
+        if (value.size == 0) return fail(error, fix_reject_tag_without_value, tag);
+
+        const uint16_t index = (static_cast<size_t>(tag) < tag_index.size()) ? tag_index[static_cast<size_t>(tag)] : no_field;
+        if (index == no_field) return fail(error, fix_reject_undefined_tag, tag);
+
+        const uint8_t flags = field_flags[index];
+        if (!has_type(flags, value)) return fail(error, fix_reject_incorrect_data_format, tag);
+        if ((flags & flag_enum) && !dictionary.field(tag)->allows(value.data, value.size)) {
+            return fail(error, fix_reject_value_incorrect, tag);
+        }
+
+        if (tag == fix_tag_msg_seq_num) {
+            int64_t seq = 0;
+            fix_get_int(value, seq);
+            error.ref_seq_num = static_cast<int>(seq);
+        }
+
+        if (tag == fix_tag_msg_type) {
+            error.ref_msg_type.assign(value.data, value.size);
+            rule = find_rule(value.data, value.size);
+            if (!rule) return fail(error, fix_reject_invalid_msg_type, tag);
+
+            // 8 and 9 came before the rule was known
+            const int leading[2] = { fix_tag_begin_string, fix_tag_body_length };
+            for (size_t i = 0; i < 2; ++i) {
+                const uint16_t lead = tag_index[static_cast<size_t>(leading[i])];
+                seen[lead] = generation;
+                if (rule->slots[lead] & slot_required) seen_required |= uint64_t(1) << (rule->slots[lead] & slot_bit_mask);
+            }
+        }
+        if (!rule) continue;
+
+        const uint16_t slot = rule->slots[index];
+        const size_t group = (slot >> slot_group_shift) & slot_group_mask;
+
+        if (expect_delimiter != 0) {
+            if (tag != rule->groups[expect_delimiter - 1].delimiter_tag) {
+                return fail(error, fix_reject_group_out_of_order, tag);
+            }
+            expect_delimiter = 0;
+        }
+
+        // Leave the groups this tag is not part of
+        while (depth > 0 && open[depth - 1].id != group) {
+            --depth;
+            if (open[depth].entries != open[depth].count) {
+                return fail(error, fix_reject_incorrect_num_in_group, rule->groups[open[depth].id - 1].count_tag);
+            }
+        }
+
+        if (depth > 0) {
+            if (tag == rule->groups[open[depth - 1].id - 1].delimiter_tag) {
+                ++open[depth - 1].entries;
+            }
+        } else {
+            if (!(slot & slot_body)) return fail(error, fix_reject_tag_not_defined, tag);
+            if (seen[index] == generation) return fail(error, fix_reject_tag_appears_twice, tag);
+            seen[index] = generation;
+            if (slot & slot_required) seen_required |= uint64_t(1) << (slot & slot_bit_mask);
+        }
+
+        if (flags & flag_num_in_group) {
+            int64_t count = 0;
+            fix_get_int(value, count);
+
+            size_t id = 0;
+            for (size_t g = 0; g < rule->groups.size() && id == 0; ++g) {
+                if (rule->groups[g].count_tag == tag) id = g + 1;
+            }
+            if (id != 0 && count > 0 && depth < max_group_depth) {
+                open[depth].id = id;
+                open[depth].count = count;
+                open[depth].entries = 0;
+                ++depth;
+                expect_delimiter = id;
+            }
+        }
+    }
+
+    if (pos != end) return fail(error, fix_reject_incorrect_data_format, 0);
+    if (!rule) return fail(error, fix_reject_required_tag_missing, fix_tag_msg_type);
+
+    while (depth > 0) {
+        --depth;
+        if (open[depth].entries != open[depth].count) {
+            return fail(error, fix_reject_incorrect_num_in_group, rule->groups[open[depth].id - 1].count_tag);
+        }
+    }
+
+    if ((seen_required & rule->required) != rule->required) {
+        const uint64_t missing = rule->required & ~seen_required;
+        size_t bit = 0;
+        while (!(missing & (uint64_t(1) << bit))) ++bit;
+        return fail(error, fix_reject_required_tag_missing, rule->required_tags[bit]);
+    }
+    return true;
+}
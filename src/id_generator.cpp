@@ -0,0 +1,70 @@
+#include "id_generator.h"
+
+#include <cstring>
+
+static const char radix_alphabet[] =
+    "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz";
+
+IdGenerator::IdGenerator() : radix(base36) {
+    init(0, base36);
+}
+
+uint32_t IdGenerator::max_epoch(Radix id_radix) {
+    uint32_t limit = 1;
+    for (size_t i = 0; i < epoch_width; ++i) {
+        limit *= static_cast<uint32_t>(id_radix);
+    }
+    return limit - 1;
+}
+
+bool IdGenerator::init(uint32_t session_epoch, Radix id_radix) {
+    radix = id_radix;
+
+    // Epoch digits, most significant first
+    uint32_t value = session_epoch;
+    for (size_t i = epoch_width; i > 0; --i) {
+        digits[i - 1] = radix_alphabet[value % static_cast<uint32_t>(radix)];
+        value /= static_cast<uint32_t>(radix);
+    }
+
+    for (size_t i = epoch_width; i < sizeof(digits); ++i) {
+        digits[i] = radix_alphabet[0];
+    }
+    return session_epoch <= max_epoch(id_radix);
+}
+
+size_t IdGenerator::next(const char* prefix, char* out) {
+    // Odometer increment, carry runs into
+    // the epoch only after radix^8 IDs
+    size_t pos = sizeof(digits);
+    while (pos > 0) {
+        --pos;
+        const char ch = digits[pos];
+        const int value = (ch <= '9') ? (ch - '0')
+                        : (ch <= 'Z') ? (ch - 'A' + 10)
+                        : (ch - 'a' + 36);
+
+        if (value + 1 < radix) {
+            digits[pos] = radix_alphabet[value + 1];
+            break;
+        }
+        digits[pos] = radix_alphabet[0];
+    }
+
+    size_t len = 0;
+    if (prefix) {
+        while (prefix[len] != '\0' && len < max_prefix_len) {
+            out[len] = prefix[len];
+            len++;
+        }
+    }
+
+    std::memcpy(out + len, digits, sizeof(digits));
+    return len + sizeof(digits);
+}
+
+std::string IdGenerator::next(const char* prefix) {
+    char buf[max_id_len];
+    const size_t len = next(prefix, buf);
+    return std::string(buf, len);
+}
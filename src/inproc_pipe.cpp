@@ -0,0 +1,144 @@
+#include "inproc_pipe.h"
+
+#include <map>
+#include <chrono>
+#include <cerrno>
+#include <cstring>
+
+static std::mutex registry_mutex;
+static std::map<std::string, InprocPipe*> registry;
+
+bool inproc_register(const std::string& name, InprocPipe& pipe) {
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    return registry.insert(std::make_pair(name, &pipe)).second;
+}
+
+void inproc_unregister(const std::string& name) {
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    registry.erase(name);
+}
+
+InprocPipe* inproc_find(const std::string& name) {
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    std::map<std::string, InprocPipe*>::const_iterator found = registry.find(name);
+    return (found == registry.end()) ? 0 : found->second;
+}
+
+InprocEndpoint::InprocEndpoint() : in(0), out(0), receive_timeout_ms(0) {}
+
+InprocEndpoint::~InprocEndpoint() {
+    close();
+}
+
+void InprocEndpoint::reopen(InprocPipe::Direction& direction) {
+    std::lock_guard<std::mutex> lock(direction.mutex);
+    direction.data.clear();
+    direction.offset = 0;
+    direction.closed = false;
+}
+
+void InprocEndpoint::shut(InprocPipe::Direction& direction) {
+    {
+        std::lock_guard<std::mutex> lock(direction.mutex);
+        direction.closed = true;
+    }
+    direction.ready.notify_all();
+}
+
+bool InprocEndpoint::connect(InprocPipe& pipe, Side side) {
+    close();
+
+    if (side == client_side) {
+        in = &pipe.to_client;
+        out = &pipe.to_server;
+        reopen(*in);
+        reopen(*out);
+    } else {
+        in = &pipe.to_server;
+        out = &pipe.to_client;
+    }
+    return true;
+}
+
+void InprocEndpoint::close() {
+    if (in) {
+        shut(*in);
+        shut(*out);
+    }
+    in = 0;
+    out = 0;
+    receive_timeout_ms = 0;
+}
+
+bool InprocEndpoint::send_bytes(const std::string& data) {
+    if (!out) return false;
+
+    {
+        std::lock_guard<std::mutex> lock(out->mutex);
+        if (out->closed) {
+            return false;
+        }
+
+        // Read part dropped before it grows
+        if (out->offset == out->data.size()) {
+            out->data.clear();
+            out->offset = 0;
+        }
+        out->data.append(data);
+    }
+    out->ready.notify_one();
+    return true;
+}
+
+bool InprocEndpoint::set_receive_timeout(int timeout_millis) {
+    if (!in || timeout_millis < 0) return false;
+
+    receive_timeout_ms = timeout_millis;
+    return true;
+}
+
+bool InprocEndpoint::has_input(const InprocPipe::Direction& direction) {
+    return direction.offset < direction.data.size() || direction.closed;
+}
+
+// True when receive_bytes() returns
+// at once, bytes or the close
+bool InprocEndpoint::wait_readable(int timeout_millis) {
+    if (!in) return false;
+
+    std::unique_lock<std::mutex> lock(in->mutex);
+    while (!has_input(*in)) {
+        if (in->ready.wait_for(lock, std::chrono::milliseconds(timeout_millis)) == std::cv_status::timeout) {
+            return has_input(*in);
+        }
+    }
+    return true;
+}
+
+int InprocEndpoint::receive_bytes(char* buf, size_t max_len) {
+    if (!in || !buf || max_len == 0) {
+        return -1;
+    }
+
+    std::unique_lock<std::mutex> lock(in->mutex);
+    const std::chrono::steady_clock::time_point deadline =
+        std::chrono::steady_clock::now() + std::chrono::milliseconds(receive_timeout_ms);
+    while (!has_input(*in)) {
+        if (receive_timeout_ms == 0) {
+            in->ready.wait(lock);
+        } else if (in->ready.wait_until(lock, deadline) == std::cv_status::timeout && !has_input(*in)) {
+            errno = EAGAIN;
+            return -1;
+        }
+    }
+
+    size_t count = in->data.size() - in->offset;
+    if (count == 0) {
+        return 0;
+    }
+    if (count > max_len) count = max_len;
+
+    std::memcpy(buf, in->data.data() + in->offset, count);
+    in->offset += count;
+    return static_cast<int>(count);
+}
@@ -0,0 +1,615 @@
+#include "instrument_cache.h"
+#include "constants.h"
+#include "fix44_messages.h"
+
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <algorithm>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// Bump when InstrumentRecord or the file
+// layout changes, older caches are refetched
+const uint32_t cache_version = 1;
+const char cache_magic[4] = { 'F', 'X', 'I', 'M' };
+const size_t header_size = 32;
+
+static_assert(sizeof(InstrumentRecord) == 128, "InstrumentRecord is stored as is");
+
+// SecurityListRequestType(559) 4 = all securities,
+// SecurityRequestType(321) 0 = identity and specs
+const int64_t list_all_securities = 4;
+const int64_t request_security_specs = 0;
+
+// SecurityResponseType(323) 5/6: rejected,
+// nothing matched
+const int64_t response_rejected = 5;
+const int64_t response_no_match = 6;
+
+// Symbol hashed 8 bytes at a time, the
+// slot is taken from the high bits
+static uint64_t symbol_hash(const char* symbol, size_t size) {
+    uint64_t hash = 14695981039346656037ULL ^ size;
+    for (size_t i = 0; i < size; i += 8) {
+        uint64_t word = 0;
+        std::memcpy(&word, symbol + i, std::min<size_t>(8, size - i));
+        hash = (hash ^ word) * 0xff51afd7ed558ccdULL;
+        hash ^= hash >> 33;
+    }
+    return hash * 0x9e3779b97f4a7c15ULL;
+}
+
+// Power of two, at most half full
+static size_t slot_count_for(size_t records) {
+    size_t slots = 16;
+    while (slots < records * 2) {
+        slots *= 2;
+    }
+    return slots;
+}
+
+static bool symbol_less(const InstrumentRecord& lhs, const InstrumentRecord& rhs) {
+    return std::memcmp(lhs.symbol, rhs.symbol, sizeof(lhs.symbol)) < 0;
+}
+
+static bool set_text(char* out, size_t capacity, const char* data, size_t size) {
+    if (size == 0 || size >= capacity) {
+        return false;
+    }
+    std::memset(out, 0, capacity);
+    std::memcpy(out, data, size);
+    return true;
+}
+
+// Zeroed, padding included, so the file
+// bytes of a record only depend on its values
+static bool start_record(InstrumentRecord& record, const FixText& symbol) {
+    std::memset(static_cast<void*>(&record), 0, sizeof(record));
+    return set_text(record.symbol, sizeof(record.symbol), symbol.data, symbol.size);
+}
+
+static void set_field(InstrumentRecord& record, char* out, size_t capacity, const FixText& value, uint32_t bit) {
+    if (set_text(out, capacity, value.data, value.size)) record.known |= bit;
+}
+
+static void set_field(InstrumentRecord& record, FixDecimal& out, const FixDecimal& value, uint32_t bit) {
+    out = value;
+    record.known |= bit;
+}
+
+// Instrument and InstrumentTrading of a typed
+// 35=d or 35=f
+template <class Message>
+static bool stage_message(const Message& message, InstrumentRecord& record) {
+    if (!message.has_symbol() || !start_record(record, message.symbol)) {
+        return false;
+    }
+
+    if (message.has_security_id()) {
+        set_field(record, record.security_id, sizeof(record.security_id), message.security_id,
+                  instrument_has_security_id);
+    }
+    if (message.has_security_id_source()) {
+        set_field(record, record.security_id_source, sizeof(record.security_id_source),
+                  message.security_id_source, instrument_has_security_id_source);
+    }
+    if (message.has_security_type()) {
+        set_field(record, record.security_type, sizeof(record.security_type), message.security_type,
+                  instrument_has_security_type);
+    }
+    if (message.has_currency()) {
+        set_field(record, record.currency, sizeof(record.currency), message.currency, instrument_has_currency);
+    }
+    if (message.has_min_price_increment()) {
+        set_field(record, record.tick_size, message.min_price_increment, instrument_has_tick_size);
+    }
+    if (message.has_round_lot()) {
+        set_field(record, record.round_lot, message.round_lot, instrument_has_round_lot);
+    }
+    if (message.has_min_trade_vol()) {
+        set_field(record, record.min_trade_vol, message.min_trade_vol, instrument_has_min_trade_vol);
+    }
+    return true;
+}
+
+// Known fields of update over record
+static void merge_record(InstrumentRecord& record, const InstrumentRecord& update) {
+    const uint32_t known = update.known;
+    if (known & instrument_has_security_id) {
+        std::memcpy(record.security_id, update.security_id, sizeof(record.security_id));
+    }
+    if (known & instrument_has_security_id_source) {
+        std::memcpy(record.security_id_source, update.security_id_source, sizeof(record.security_id_source));
+    }
+    if (known & instrument_has_security_type) {
+        std::memcpy(record.security_type, update.security_type, sizeof(record.security_type));
+    }
+    if (known & instrument_has_currency) {
+        std::memcpy(record.currency, update.currency, sizeof(record.currency));
+    }
+    if (known & instrument_has_tick_size) record.tick_size = update.tick_size;
+    if (known & instrument_has_round_lot) record.round_lot = update.round_lot;
+    if (known & instrument_has_min_trade_vol) record.min_trade_vol = update.min_trade_vol;
+    if (known & instrument_has_trading_status) record.trading_status = update.trading_status;
+    record.known |= known;
+}
+
+InstrumentCache::InstrumentCache()
+    : security_list(0), records(0), count(0), slots(0), slot_count(0), slot_shift(64), mapped(0), mapped_size(0),
+      mapped_writable(false), dirty(false), changes(0), request_counter(1), stream_list(false), stream_last(true) {}
+
+InstrumentCache::~InstrumentCache() {
+    close();
+}
+
+bool InstrumentCache::load_dictionary(const std::string& dictionary_path, std::string& error) {
+    if (!dictionary.load(dictionary_path, error)) {
+        return false;
+    }
+
+    security_list = dictionary.message("y");
+    if (!security_list) {
+        error = "no SecurityList (35=y)";
+        return false;
+    }
+    return true;
+}
+
+void InstrumentCache::set_slots(uint32_t* table, size_t size) {
+    slots = table;
+    slot_count = size;
+    slot_shift = 64;
+    for (size_t n = size; n > 1; n /= 2) {
+        --slot_shift;
+    }
+}
+
+void InstrumentCache::unmap() {
+    if (mapped) {
+        ::munmap(mapped, mapped_size);
+    }
+    mapped = 0;
+    mapped_size = 0;
+    mapped_writable = false;
+}
+
+void InstrumentCache::close() {
+    unmap();
+    path.clear();
+    records = 0;
+    count = 0;
+    slots = 0;
+    slot_count = 0;
+    slot_shift = 64;
+    std::vector<uint32_t>().swap(owned_slots);
+    std::vector<InstrumentRecord>().swap(owned_records);
+    staged.clear();
+    dirty = false;
+    open_requests.clear();
+}
+
+bool InstrumentCache::open(const std::string& cache_path, std::string& error) {
+    close();
+    path = cache_path;
+
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        error = "no cache file";
+        return false;
+    }
+
+    struct stat file_stat;
+    if (::fstat(fd, &file_stat) != 0 || file_stat.st_size < static_cast<off_t>(header_size)) {
+        ::close(fd);
+        error = "truncated";
+        return false;
+    }
+
+    const size_t size = static_cast<size_t>(file_stat.st_size);
+    void* data = ::mmap(0, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (data == MAP_FAILED) {
+        error = "mmap failed";
+        return false;
+    }
+
+    char* in = static_cast<char*>(data);
+    uint32_t version = 0;
+    uint32_t record_size = 0;
+    uint32_t slots_in_file = 0;
+    uint64_t records_in_file = 0;
+    std::memcpy(&version, in + 4, sizeof(version));
+    std::memcpy(&record_size, in + 8, sizeof(record_size));
+    std::memcpy(&slots_in_file, in + 12, sizeof(slots_in_file));
+    std::memcpy(&records_in_file, in + 16, sizeof(records_in_file));
+
+    if (std::memcmp(in, cache_magic, sizeof(cache_magic)) != 0 ||
+        version != cache_version || record_size != sizeof(InstrumentRecord)) {
+        ::munmap(data, size);
+        char text[64];
+        std::snprintf(text, sizeof(text), "version %u, expected %u", version, cache_version);
+        error = text;
+        return false;
+    }
+
+    if (records_in_file > size / sizeof(InstrumentRecord) || slots_in_file != slot_count_for(records_in_file) ||
+        size != header_size + records_in_file * sizeof(InstrumentRecord) + slots_in_file * sizeof(uint32_t)) {
+        ::munmap(data, size);
+        error = "truncated";
+        return false;
+    }
+
+    // The index is trusted by find(): every slot
+    // must name a record and some must be empty
+    // for a probe to end
+    const uint32_t* table = reinterpret_cast<const uint32_t*>(in + header_size + records_in_file * sizeof(InstrumentRecord));
+    size_t used = 0;
+    for (size_t i = 0; i < slots_in_file; ++i) {
+        if (table[i] > records_in_file) {
+            used = slots_in_file;
+            break;
+        }
+        if (table[i] != 0) ++used;
+    }
+    if (used > records_in_file) {
+        ::munmap(data, size);
+        error = "corrupt index";
+        return false;
+    }
+
+    mapped = data;
+    mapped_size = size;
+    count = static_cast<size_t>(records_in_file);
+    records = reinterpret_cast<InstrumentRecord*>(in + header_size);
+    set_slots(reinterpret_cast<uint32_t*>(in + header_size + count * sizeof(InstrumentRecord)), slots_in_file);
+    return true;
+}
+
+bool InstrumentCache::save(std::string& error) {
+    if (path.empty()) {
+        error = "not open";
+        return false;
+    }
+
+    std::string out;
+    out.reserve(header_size + count * sizeof(InstrumentRecord) + slot_count * sizeof(uint32_t));
+
+    const uint32_t record_size = sizeof(InstrumentRecord);
+    const uint32_t slots_out = static_cast<uint32_t>(slot_count);
+    const uint64_t records_out = count;
+    const int64_t saved_sec = static_cast<int64_t>(std::time(0));
+    out.append(cache_magic, sizeof(cache_magic));
+    out.append(reinterpret_cast<const char*>(&cache_version), sizeof(cache_version));
+    out.append(reinterpret_cast<const char*>(&record_size), sizeof(record_size));
+    out.append(reinterpret_cast<const char*>(&slots_out), sizeof(slots_out));
+    out.append(reinterpret_cast<const char*>(&records_out), sizeof(records_out));
+    out.append(reinterpret_cast<const char*>(&saved_sec), sizeof(saved_sec));
+    out.append(reinterpret_cast<const char*>(records), count * sizeof(InstrumentRecord));
+    out.append(reinterpret_cast<const char*>(slots), slot_count * sizeof(uint32_t));
+
+    // Write-then-rename, a reader (or the
+    // mapping of this process) keeps the
+    // old file until it is done
+    char suffix[32];
+    std::snprintf(suffix, sizeof(suffix), ".%d.tmp", static_cast<int>(::getpid()));
+    const std::string tmp_path = path + suffix;
+
+    FILE* file = std::fopen(tmp_path.c_str(), "wb");
+    if (!file) {
+        error = "cannot write " + tmp_path;
+        return false;
+    }
+
+    const bool written = std::fwrite(out.data(), 1, out.size(), file) == out.size();
+    const bool closed = std::fclose(file) == 0;
+    if (!written || !closed || std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+        ::unlink(tmp_path.c_str());
+        error = "cannot write " + path;
+        return false;
+    }
+
+    dirty = false;
+    return true;
+}
+
+const InstrumentRecord* InstrumentCache::find(const char* symbol, size_t size) const {
+    const size_t index = locate(symbol, size);
+    return (index < count) ? &records[index] : 0;
+}
+
+// Record number of symbol, count when unknown
+size_t InstrumentCache::locate(const char* symbol, size_t size) const {
+    if (size == 0 || size >= sizeof(records->symbol) || slot_count == 0) {
+        return count;
+    }
+
+    size_t slot = static_cast<size_t>(symbol_hash(symbol, size) >> slot_shift);
+    while (slots[slot] != 0) {
+        const InstrumentRecord& record = records[slots[slot] - 1];
+        if (std::memcmp(record.symbol, symbol, size) == 0 && record.symbol[size] == '\0') {
+            return slots[slot] - 1;
+        }
+        slot = (slot + 1) & (slot_count - 1);
+    }
+    return count;
+}
+
+void InstrumentCache::stage_entry(const FixEntryView& entry) {
+    FixText value;
+    InstrumentRecord record;
+    if (!entry.get(fix_tag_symbol, value) || !start_record(record, value)) {
+        return;
+    }
+
+    if (entry.get(fix_tag_security_id, value)) {
+        set_field(record, record.security_id, sizeof(record.security_id), value, instrument_has_security_id);
+    }
+    if (entry.get(fix_tag_security_id_source, value)) {
+        set_field(record, record.security_id_source, sizeof(record.security_id_source), value,
+                  instrument_has_security_id_source);
+    }
+    if (entry.get(fix_tag_security_type, value)) {
+        set_field(record, record.security_type, sizeof(record.security_type), value, instrument_has_security_type);
+    }
+    if (entry.get(fix_tag_currency, value)) {
+        set_field(record, record.currency, sizeof(record.currency), value, instrument_has_currency);
+    }
+
+    FixDecimal number;
+    if (entry.get(fix_tag_min_price_increment, value) && fix_get_decimal(value, number)) {
+        set_field(record, record.tick_size, number, instrument_has_tick_size);
+    }
+    if (entry.get(fix_tag_round_lot, value) && fix_get_decimal(value, number)) {
+        set_field(record, record.round_lot, number, instrument_has_round_lot);
+    }
+    if (entry.get(fix_tag_min_trade_vol, value) && fix_get_decimal(value, number)) {
+        set_field(record, record.min_trade_vol, number, instrument_has_min_trade_vol);
+    }
+
+    staged.push_back(record);
+}
+
+// Applies staged updates, later updates of a
+// symbol win. Known symbols change in place,
+// only new ones are merged into the sorted
+// records and reindexed.
+bool InstrumentCache::commit() {
+    changes = 0;
+    if (staged.empty()) {
+        return false;
+    }
+
+    std::stable_sort(staged.begin(), staged.end(), symbol_less);
+
+    std::vector<InstrumentRecord> added;
+    size_t next = 0;
+    while (next < staged.size()) {
+        InstrumentRecord update = staged[next++];
+        while (next < staged.size() && !symbol_less(update, staged[next])) {
+            merge_record(update, staged[next++]);
+        }
+
+        const size_t index = locate(update.symbol, ::strnlen(update.symbol, sizeof(update.symbol)));
+        if (index < count) {
+            InstrumentRecord record = records[index];
+            merge_record(record, update);
+            if (std::memcmp(&record, &records[index], sizeof(record)) != 0) {
+                make_writable();
+                records[index] = record;
+                ++changes;
+            }
+        } else {
+            added.push_back(update);
+            ++changes;
+        }
+    }
+    staged.clear();
+
+    if (!added.empty()) {
+        insert(added);
+    }
+    if (changes > 0) {
+        dirty = true;
+    }
+    return changes > 0;
+}
+
+// Mapped read only, lookups are faster that
+// way. The first update in place turns it into
+// a copy-on-write mapping, so only the pages
+// written to are copied; the heap when that
+// is refused.
+void InstrumentCache::make_writable() {
+    if (!mapped || mapped_writable) {
+        return;
+    }
+    if (::mprotect(mapped, mapped_size, PROT_READ | PROT_WRITE) == 0) {
+        mapped_writable = true;
+        return;
+    }
+
+    owned_records.assign(records, records + count);
+    owned_slots.assign(slots, slots + slot_count);
+    unmap();
+    records = &owned_records[0];
+    set_slots(&owned_slots[0], owned_slots.size());
+}
+
+// Sorted records not in the cache yet, merged
+// in one pass; moves the records to the heap
+void InstrumentCache::insert(const std::vector<InstrumentRecord>& added) {
+    std::vector<InstrumentRecord> merged;
+    merged.reserve(count + added.size());
+
+    size_t existing = 0;
+    for (size_t i = 0; i < added.size(); ++i) {
+        while (existing < count && symbol_less(records[existing], added[i])) {
+            merged.push_back(records[existing++]);
+        }
+        merged.push_back(added[i]);
+    }
+    merged.insert(merged.end(), records + existing, records + count);
+
+    owned_records.swap(merged);
+    unmap();
+    records = &owned_records[0];
+    count = owned_records.size();
+
+    // Linear probing, slot = record index + 1
+    owned_slots.assign(slot_count_for(count), 0);
+    set_slots(&owned_slots[0], owned_slots.size());
+    for (size_t i = 0; i < count; ++i) {
+        const size_t size = ::strnlen(records[i].symbol, sizeof(records[i].symbol));
+        size_t slot = static_cast<size_t>(symbol_hash(records[i].symbol, size) >> slot_shift);
+        while (owned_slots[slot] != 0) {
+            slot = (slot + 1) & (slot_count - 1);
+        }
+        owned_slots[slot] = static_cast<uint32_t>(i + 1);
+    }
+}
+
+void InstrumentCache::answered(const std::string& req_id, bool last) {
+    if (last) {
+        open_requests.erase(req_id);
+    }
+}
+
+bool InstrumentCache::on_message(const std::string& msg) {
+    // MsgType is the third field
+    const char* pos = msg.data();
+    const char* const end = msg.data() + msg.size();
+    int tag = 0;
+    FixText msg_type;
+    for (int i = 0; i < 3 && fix_next_field(pos, end, tag, msg_type); ++i) {}
+    if (tag != fix_tag_msg_type || msg_type.size != 1) {
+        return false;
+    }
+
+    InstrumentRecord record;
+    if (msg_type.data[0] == 'd') {
+        fix44::SecurityDefinition definition;
+        if (!definition.decode(msg)) {
+            return false;
+        }
+
+        answered(definition.security_req_id.str(), true);
+        if (definition.security_response_type == response_rejected ||
+            definition.security_response_type == response_no_match) {
+            return false;
+        }
+        if (stage_message(definition, record)) {
+            staged.push_back(record);
+        }
+        return commit();
+    }
+
+    if (msg_type.data[0] == 'f') {
+        fix44::SecurityStatus status;
+        if (!status.decode(msg) || !stage_message(status, record)) {
+            return false;
+        }
+
+        if (status.has_security_trading_status()) {
+            record.trading_status = static_cast<int32_t>(status.security_trading_status);
+            record.known |= instrument_has_trading_status;
+        }
+        staged.push_back(record);
+        return commit();
+    }
+
+    if (msg_type.data[0] != 'y' || !security_list ||
+        !list_decoder.decode(msg.data(), msg.size(), *security_list)) {
+        return false;
+    }
+
+    FixText value;
+    bool last = true;
+    if (list_decoder.get(fix_tag_last_fragment, value)) {
+        fix_get_bool(value, last);
+    }
+    list_decoder.get(fix_tag_security_req_id, value);
+    answered(value.str(), last);
+
+    int64_t result = 0;
+    if (list_decoder.get(fix_tag_security_request_result, value) &&
+        (!fix_get_int(value, result) || result != 0)) {
+        return false;
+    }
+
+    const FixGroupView related = list_decoder.group(fix_tag_no_related_sym);
+    for (size_t i = 0; i < related.size(); ++i) {
+        stage_entry(related.entry(i));
+    }
+    return commit();
+}
+
+void InstrumentCache::on_stream_field(int tag, const FixText& value) {
+    if (tag == fix_tag_msg_type) {
+        stream_list = value.size == 1 && value.data[0] == 'y';
+        stream_req_id.clear();
+        stream_last = true;
+        staged.clear();
+    }
+    else if (tag == fix_tag_security_req_id) {
+        stream_req_id = value.str();
+    }
+    else if (tag == fix_tag_last_fragment) {
+        fix_get_bool(value, stream_last);
+    }
+}
+
+void InstrumentCache::on_stream_entry(int count_tag, const FixEntryView& entry) {
+    if (stream_list && count_tag == fix_tag_no_related_sym) {
+        stage_entry(entry);
+    }
+}
+
+// A list that arrived damaged is dropped
+bool InstrumentCache::on_stream_end(const FixStreamSummary& summary) {
+    if (!stream_list) {
+        return false;
+    }
+    stream_list = false;
+
+    if (!summary.checksum_ok || !summary.length_ok) {
+        staged.clear();
+        return false;
+    }
+
+    answered(stream_req_id, stream_last);
+    return commit();
+}
+
+std::string InstrumentCache::request_list(const FixTypedHeader& header, int msg_seq_num,
+                                          const std::string& sending_time) {
+    const std::string req_id = "SL" + std::to_string(request_counter++);
+
+    fix44::SecurityListRequest request;
+    request.set_security_req_id(req_id);
+    request.set_security_list_request_type(list_all_securities);
+
+    std::string out;
+    if (fix_encode(header, request, msg_seq_num, sending_time, out)) {
+        open_requests.insert(req_id);
+    }
+    return out;
+}
+
+std::string InstrumentCache::request_definition(const FixTypedHeader& header, int msg_seq_num,
+                                                const std::string& sending_time, const std::string& symbol) {
+    const std::string req_id = "SD" + std::to_string(request_counter++);
+
+    fix44::SecurityDefinitionRequest request;
+    request.set_security_req_id(req_id);
+    request.set_security_request_type(request_security_specs);
+    request.set_symbol(symbol);
+
+    std::string out;
+    if (fix_encode(header, request, msg_seq_num, sending_time, out)) {
+        open_requests.insert(req_id);
+    }
+    return out;
+}
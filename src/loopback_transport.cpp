@@ -0,0 +1,81 @@
+#include "loopback_transport.h"
+#include "utils.h"
+
+#include <cerrno>
+
+LoopbackTransport::LoopbackTransport() : peer(0), receive_timeout_ms(0) {}
+
+bool LoopbackTransport::connect(LoopbackPeer& loopback_peer) {
+    close();
+    peer = &loopback_peer;
+    return true;
+}
+
+void LoopbackTransport::close() {
+    peer = 0;
+    receive_timeout_ms = 0;
+}
+
+bool LoopbackTransport::send_bytes(const std::string& data) {
+    if (!peer) return false;
+
+    peer->on_client_bytes(data.data(), data.size(), utils::get_realtime_nanos());
+    return true;
+}
+
+bool LoopbackTransport::set_receive_timeout(int timeout_millis) {
+    if (!peer || timeout_millis < 0) return false;
+
+    receive_timeout_ms = timeout_millis;
+    return true;
+}
+
+bool LoopbackTransport::wait_readable(int timeout_millis) {
+    if (!peer) return false;
+
+    const uint64_t deadline_ns = utils::get_realtime_nanos() +
+                                 static_cast<uint64_t>(timeout_millis) * 1000000ULL;
+
+    const uint64_t next_due_ns = peer->next_due_ns();
+    if (next_due_ns != 0 && next_due_ns <= deadline_ns) {
+        utils::sleep_until_nanos(next_due_ns);
+        return true;
+    }
+
+    utils::sleep_until_nanos(deadline_ns);
+    return false;
+}
+
+// Nothing due: wait for the next reply, or
+// the receive timeout if that comes first
+int LoopbackTransport::receive_bytes(char* buf, size_t max_bytes) {
+    if (!peer || !buf || max_bytes == 0) {
+        return -1;
+    }
+
+    const uint64_t now_ns = utils::get_realtime_nanos();
+
+    const int bytes_read = peer->read_due(buf, max_bytes, now_ns);
+    if (bytes_read >= 0) {
+        return bytes_read;
+    }
+
+    const uint64_t next_due_ns = peer->next_due_ns();
+    const uint64_t timeout_ns = static_cast<uint64_t>(receive_timeout_ms) * 1000000ULL;
+    if (next_due_ns != 0 && (timeout_ns == 0 || next_due_ns <= now_ns + timeout_ns)) {
+        utils::sleep_until_nanos(next_due_ns);
+
+        const uint64_t due_now_ns = utils::get_realtime_nanos();
+        return peer->read_due(buf, max_bytes, due_now_ns > next_due_ns ? due_now_ns : next_due_ns);
+    }
+
+    // Blocking read of a peer with
+    // nothing pending never returns
+    if (timeout_ns == 0) {
+        return 0;
+    }
+
+    utils::sleep_until_nanos(now_ns + timeout_ns);
+    errno = EAGAIN;
+    return -1;
+}
@@ -1,17 +1,31 @@
 #include "application.h"
+#include "regression_shard.h"
 #include <cstdio>
 #include <getopt.h>
 #include <cstring>
+#include <cstdlib>
+#include <string>
+#include <vector>
 
 static void usage(const char* program_name) {
     std::printf(
             "Usage:\n"
             " %s -u <session> [options]\n\n"
             "Options:\n"
-            " -u <session>          session name (f01)\n"
+            " -u <session>          session name (f01), test mode takes a\n"
+            "                       list to shard the scenarios (f01,f02,f03)\n"
             " -c <config>           config file (default: config/config.ini)\n"
             " -s <scenario>         scenario file or directory (default: scenarios)\n"
             " -m, --mode test       validates expected scenarios\n"
+            " -S, --simulate        in-process acceptor on a virtual clock,\n"
+            "                       no network and no waiting\n"
+            " -j, --jobs <n>        test mode: scenarios run at once (default: 1)\n"
+            " -v, --verbose         test mode: field table for passing steps too\n"
+            " -r, --rerun <what>    test mode: all (default), failed or changed,\n"
+            "                       others are reported from results/regression_cache\n"
+            " -b, --baseline <csv>  test mode: flag scenarios whose SND->TST p50/p99\n"
+            "                       moved against this latency CSV of an earlier run\n"
+            " -t, --threshold <pct> test mode: baseline threshold (default: 20)\n"
             " -h, --help            show help\n",
             program_name
     );
@@ -23,13 +37,19 @@ int main(int argc, char** argv) {
     static const struct option long_options[] = {
         {"help", no_argument, 0, 'h'},
         {"mode", required_argument, 0, 'm'},
+        {"simulate", no_argument, 0, 'S'},
+        {"jobs", required_argument, 0, 'j'},
+        {"verbose", no_argument, 0, 'v'},
+        {"rerun", required_argument, 0, 'r'},
+        {"baseline", required_argument, 0, 'b'},
+        {"threshold", required_argument, 0, 't'},
         {0,0,0,0}
     };
 
     int option = 0;
     int long_index = 0;
 
-    while ((option = getopt_long(argc, argv, "u:c:s:m:h", long_options, &long_index)) != -1) {
+    while ((option = getopt_long(argc, argv, "u:c:s:m:Sj:vr:b:t:h", long_options, &long_index)) != -1) {
         switch (option) {
             case 'u':
                 args.session_name = optarg;
@@ -52,6 +72,41 @@ int main(int argc, char** argv) {
                 }
                 break;
 
+            case 'S':
+                args.is_simulation = true;
+                break;
+
+            case 'j':
+                args.regression_jobs = std::atoi(optarg);
+                if (args.regression_jobs < 1) {
+                    std::printf("Error: (-j|--jobs) must be >= 1\n");
+                    return 1;
+                }
+                break;
+
+            case 'v':
+                args.is_verbose = true;
+                break;
+
+            case 'r':
+                if (!parse_regression_rerun(optarg, args.regression_rerun)) {
+                    std::printf("Error: (-r|--rerun) must be all, failed or changed\n");
+                    return 1;
+                }
+                break;
+
+            case 'b':
+                args.baseline_path = optarg;
+                break;
+
+            case 't':
+                args.baseline_threshold_pct = std::atoi(optarg);
+                if (args.baseline_threshold_pct < 1) {
+                    std::printf("Error: (-t|--threshold) must be >= 1\n");
+                    return 1;
+                }
+                break;
+
             case 'h':
                 usage(argv[0]);
                 return 0;
@@ -74,6 +129,24 @@ int main(int argc, char** argv) {
         return 1;
     }
 
+    // f01,f02,f03 -> one shard per session
+    std::vector<std::string> sessions;
+    size_t pos = 0;
+    while (pos <= args.session_name.size()) {
+        size_t end = args.session_name.find(',', pos);
+        if (end == std::string::npos) end = args.session_name.size();
+        if (end > pos) sessions.push_back(args.session_name.substr(pos, end - pos));
+        pos = end + 1;
+    }
+
+    if (sessions.size() > 1) {
+        if (!args.is_test_mode) {
+            std::printf("Error: multiple sessions need -m test\n");
+            return 1;
+        }
+        return run_sharded_regression(args, sessions);
+    }
+
     Application app;
     return app.run(args);
 }
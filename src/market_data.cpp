@@ -0,0 +1,281 @@
+#include "market_data.h"
+#include "constants.h"
+
+#include <cstring>
+
+// One NoMDEntries instance as it is decoded
+struct MdEntry {
+    char action;                // 279, '0' (New) in a snapshot
+    char type;                  // 269
+    const char* symbol;
+    size_t symbol_size;
+    FixDecimal price;
+    int64_t price_key;
+    FixDecimal size;
+    int64_t rpt_seq;            // -1 = absent
+    bool has_price;
+
+    MdEntry() : action('0'), type(0), symbol(0), symbol_size(0), price_key(0),
+                rpt_seq(-1), has_price(false) {}
+};
+
+static const int64_t price_key_factors[book_price_scale + 1] = {
+    100000000LL, 10000000LL, 1000000LL, 100000LL, 10000LL, 1000LL, 100LL, 10LL, 1LL
+};
+
+// False past book_price_scale
+// decimals or on overflow
+static bool make_price_key(const FixDecimal& price, int64_t& key) {
+    if (price.scale < 0 || price.scale > book_price_scale) return false;
+
+    const int64_t factor = price_key_factors[price.scale];
+    const int64_t limit = INT64_MAX / price_key_factors[0];
+    if (price.mantissa > limit || price.mantissa < -limit) return false;
+
+    key = price.mantissa * factor;
+    return true;
+}
+
+// Scans from the best level down: feeds touch
+// the top of the book far more than the rest
+static void apply_level(BookSide& side, bool bid_side, const MdEntry& entry) {
+    std::vector<BookLevel>& levels = side.levels;
+
+    size_t pos = levels.size();
+    const int64_t key = entry.price_key;
+    if (bid_side) {
+        while (pos > 0 && levels[pos - 1].price_key > key) --pos;
+    } else {
+        while (pos > 0 && levels[pos - 1].price_key < key) --pos;
+    }
+    const bool found = pos > 0 && levels[pos - 1].price_key == key;
+
+    switch (entry.action) {
+        case '0':                   // New
+        case '1':                   // Change
+        case '5':                   // Overlay
+            if (found) {
+                levels[pos - 1].size = entry.size;
+            } else {
+                BookLevel level;
+                level.price_key = key;
+                level.price = entry.price;
+                level.size = entry.size;
+                levels.insert(levels.begin() + static_cast<std::ptrdiff_t>(pos), level);
+            }
+            break;
+        case '2':                   // Delete
+            if (found) {
+                levels.erase(levels.begin() + static_cast<std::ptrdiff_t>(pos - 1));
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+MarketDataBooks::~MarketDataBooks() {
+    for (size_t i = 0; i < book_list.size(); ++i) {
+        delete book_list[i];
+    }
+}
+
+const MarketDataBook* MarketDataBooks::find(const std::string& symbol) const {
+    std::unordered_map<std::string, MarketDataBook*>::const_iterator it = by_symbol.find(symbol);
+    return it == by_symbol.end() ? 0 : it->second;
+}
+
+MarketDataBook* MarketDataBooks::book_for(const char* symbol, size_t len) {
+    if (last_book && last_book->symbol.size() == len &&
+        std::memcmp(last_book->symbol.data(), symbol, len) == 0) {
+        return last_book;
+    }
+
+    const std::string key(symbol, len);
+    std::unordered_map<std::string, MarketDataBook*>::iterator it = by_symbol.find(key);
+    if (it == by_symbol.end()) {
+        MarketDataBook* book = new MarketDataBook();
+        book->symbol = key;
+        book_list.push_back(book);
+        it = by_symbol.insert(std::make_pair(key, book)).first;
+    }
+
+    last_book = it->second;
+    return last_book;
+}
+
+void MarketDataBooks::mark_stale(MarketDataBook& book) {
+    book.stale = true;
+    book.rpt_seq = -1;
+    book.bids.levels.clear();
+    book.offers.levels.clear();
+    newly_stale.push_back(book.symbol);
+    totals.gaps++;
+}
+
+bool MarketDataBooks::take_stale(std::vector<std::string>& symbols) {
+    symbols.swap(newly_stale);
+    newly_stale.clear();
+    return !symbols.empty();
+}
+
+bool MarketDataBooks::on_message(const std::string& msg) {
+    const char* pos = msg.data();
+    const char* end = pos + msg.size();
+
+    char msg_type = 0;
+    const char* body_symbol = 0;
+    size_t body_symbol_size = 0;
+    int64_t body_rpt_seq = -1;
+
+    MarketDataBook* snapshot_book = 0;
+    bool in_group = false;
+    int first_entry_tag = 0;    // the tag that opens each entry
+    bool entry_open = false;
+    MdEntry entry;
+    const char* entry_symbol = 0;
+    size_t entry_symbol_size = 0;
+
+    while (pos < end) {
+        int tag = 0;
+        while (pos < end && *pos >= '0' && *pos <= '9') {
+            tag = tag * 10 + (*pos - '0');
+            ++pos;
+        }
+        if (pos >= end || *pos != '=') return false;
+        ++pos;
+
+        const char* value = pos;
+        while (pos < end && *pos != '\x01') {
+            ++pos;
+        }
+        if (pos >= end) return false;
+        const size_t size = static_cast<size_t>(pos - value);
+        ++pos;
+
+        if (!in_group) {
+            if (tag == fix_tag_msg_type) {
+                if (size != 1 || (value[0] != 'W' && value[0] != 'X')) return false;
+                msg_type = value[0];
+            } else if (tag == fix_tag_symbol) {
+                body_symbol = value;
+                body_symbol_size = size;
+            } else if (tag == fix_tag_rpt_seq) {
+                fix_int_parse(value, size, body_rpt_seq);
+            } else if (tag == fix_tag_no_md_entries) {
+                if (msg_type == 0) return false;
+                in_group = true;
+
+                // A snapshot replaces the whole
+                // book and clears a gap
+                if (msg_type == 'W') {
+                    if (!body_symbol) return false;
+                    snapshot_book = book_for(body_symbol, body_symbol_size);
+                    snapshot_book->bids.levels.clear();
+                    snapshot_book->offers.levels.clear();
+                    snapshot_book->stale = false;
+                    snapshot_book->rpt_seq = body_rpt_seq;
+                    totals.snapshots++;
+                } else {
+                    totals.incrementals++;
+                }
+            }
+            continue;
+        }
+
+        if (first_entry_tag == 0) {
+            first_entry_tag = tag;
+        }
+
+        // Next entry or the trailer closes the one
+        // being decoded; X entries without 55
+        // belong to the previous entry's symbol
+        if ((tag == first_entry_tag || tag == fix_tag_check_sum) && entry_open) {
+            if (entry.symbol) {
+                entry_symbol = entry.symbol;
+                entry_symbol_size = entry.symbol_size;
+            } else {
+                entry.symbol = entry_symbol;
+                entry.symbol_size = entry_symbol_size;
+            }
+
+            MarketDataBook* book = snapshot_book;
+            if (!book) {
+                if (!entry.symbol) return false;
+                book = book_for(entry.symbol, entry.symbol_size);
+            }
+
+            totals.entries++;
+            bool apply = true;
+            if (!snapshot_book) {
+                if (book->stale) {
+                    totals.skipped++;
+                    apply = false;
+                } else if (entry.rpt_seq >= 0) {
+                    if (book->rpt_seq >= 0 && entry.rpt_seq <= book->rpt_seq) {
+                        totals.duplicates++;
+                        apply = false;
+                    } else if (book->rpt_seq >= 0 && entry.rpt_seq != book->rpt_seq + 1) {
+                        mark_stale(*book);
+                        apply = false;
+                    } else {
+                        book->rpt_seq = entry.rpt_seq;
+                    }
+                }
+            }
+
+            if (apply && entry.has_price && (entry.type == '0' || entry.type == '1')) {
+                apply_level(entry.type == '0' ? book->bids : book->offers, entry.type == '0', entry);
+                book->updates++;
+            }
+
+            entry = MdEntry();
+            entry_open = false;
+        }
+
+        if (tag == fix_tag_check_sum) {
+            break;
+        }
+
+        entry_open = true;
+        switch (tag) {
+            case fix_tag_md_update_action:  entry.action = size > 0 ? value[0] : 0; break;
+            case fix_tag_md_entry_type:     entry.type = size > 0 ? value[0] : 0; break;
+            case fix_tag_symbol:            entry.symbol = value; entry.symbol_size = size; break;
+            case fix_tag_rpt_seq:           fix_int_parse(value, size, entry.rpt_seq); break;
+            case fix_tag_md_entry_px:
+                entry.has_price = fix_decimal_parse(value, size, entry.price) &&
+                                  make_price_key(entry.price, entry.price_key);
+                break;
+            case fix_tag_md_entry_size:     fix_decimal_parse(value, size, entry.size); break;
+            default: break;
+        }
+    }
+
+    return in_group && !entry_open;
+}
+
+std::string build_market_data_request(const FixMessage& fix,
+                                      int msg_seq_num,
+                                      const std::string& sending_time,
+                                      const std::string& md_req_id,
+                                      char subscription_type,
+                                      int depth,
+                                      const std::vector<std::string>& symbols) {
+    FixMessage::FieldList fields;
+    fields.push_back(FixMessage::Field(fix_tag_md_req_id, md_req_id));
+    fields.push_back(FixMessage::Field(fix_tag_subscription_request_type, std::string(1, subscription_type)));
+    fields.push_back(FixMessage::Field(fix_tag_market_depth, std::to_string(depth)));
+    if (subscription_type == '1') {
+        fields.push_back(FixMessage::Field(fix_tag_md_update_type, "1"));     // incremental
+    }
+    fields.push_back(FixMessage::Field(fix_tag_no_md_entry_types, "2"));
+    fields.push_back(FixMessage::Field(fix_tag_md_entry_type, "0"));
+    fields.push_back(FixMessage::Field(fix_tag_md_entry_type, "1"));
+    fields.push_back(FixMessage::Field(fix_tag_no_related_sym, std::to_string(symbols.size())));
+    for (size_t i = 0; i < symbols.size(); ++i) {
+        fields.push_back(FixMessage::Field(fix_tag_symbol, symbols[i]));
+    }
+
+    return fix.build_message("V", msg_seq_num, sending_time, fields);
+}
@@ -0,0 +1,443 @@
+#include "order_manager.h"
+#include "constants.h"
+
+#include <cstring>
+
+// Raw value inside the message, 0 if absent
+struct FieldRef {
+    const char* data;
+    size_t size;
+
+    FieldRef() : data(0), size(0) {}
+    char first() const { return size > 0 ? data[0] : 0; }
+};
+
+struct OrderFields {
+    FieldRef msg_type;
+    FieldRef clord_id;
+    FieldRef orig_clord_id;
+    FieldRef order_id;
+    FieldRef symbol;
+    FieldRef side;
+    FieldRef ord_status;
+    FieldRef exec_type;
+    FieldRef order_qty;
+    FieldRef price;
+    FieldRef cum_qty;
+    FieldRef leaves_qty;
+    FieldRef avg_px;
+};
+
+static void keep_first(FieldRef& field, const char* data, size_t size) {
+    if (!field.data) {
+        field.data = data;
+        field.size = size;
+    }
+}
+
+// One pass over tag=value<SOH>, first
+// occurrence of each tag wins
+static void scan_order_fields(const std::string& msg, OrderFields& fields) {
+    const char* pos = msg.data();
+    const char* end = pos + msg.size();
+
+    while (pos < end) {
+        int tag = 0;
+        while (pos < end && *pos >= '0' && *pos <= '9') {
+            tag = tag * 10 + (*pos - '0');
+            ++pos;
+        }
+        if (pos >= end || *pos != '=') return;
+        ++pos;
+
+        // Values are short, a plain loop
+        // beats memchr's call overhead
+        const char* value = pos;
+        while (pos < end && *pos != '\x01') {
+            ++pos;
+        }
+        if (pos >= end) return;
+        const size_t size = static_cast<size_t>(pos - value);
+        ++pos;
+
+        switch (tag) {
+            case fix_tag_msg_type:      keep_first(fields.msg_type, value, size); break;
+            case fix_tag_clord_id:      keep_first(fields.clord_id, value, size); break;
+            case fix_tag_orig_clord_id: keep_first(fields.orig_clord_id, value, size); break;
+            case fix_tag_order_id:      keep_first(fields.order_id, value, size); break;
+            case fix_tag_symbol:        keep_first(fields.symbol, value, size); break;
+            case fix_tag_side:          keep_first(fields.side, value, size); break;
+            case fix_tag_ord_status:    keep_first(fields.ord_status, value, size); break;
+            case fix_tag_exec_type:     keep_first(fields.exec_type, value, size); break;
+            case fix_tag_order_qty:     keep_first(fields.order_qty, value, size); break;
+            case fix_tag_price:         keep_first(fields.price, value, size); break;
+            case fix_tag_cum_qty:       keep_first(fields.cum_qty, value, size); break;
+            case fix_tag_leaves_qty:    keep_first(fields.leaves_qty, value, size); break;
+            case fix_tag_avg_px:        keep_first(fields.avg_px, value, size); break;
+            default: break;
+        }
+    }
+}
+
+static uint64_t hash_id(const char* data, size_t len) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < len; ++i) {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+static bool copy_text(char* out, size_t capacity, const FieldRef& field, bool truncate) {
+    size_t size = field.size;
+    if (size >= capacity) {
+        if (!truncate) return false;
+        size = capacity - 1;
+    }
+    std::memcpy(out, field.data, size);
+    out[size] = '\0';
+    return true;
+}
+
+static void parse_decimal(const FieldRef& field, FixDecimal& value) {
+    if (field.data) {
+        fix_decimal_parse(field.data, field.size, value);
+    }
+}
+
+// 39 values after which nothing
+// more happens to an order
+static bool is_terminal_status(char ord_status) {
+    return ord_status == '2' || ord_status == '4' || ord_status == '8' || ord_status == 'C';
+}
+
+OrderManager::OrderManager(size_t expected_orders) : used_slots(0) {
+    size_t capacity = 16;
+    while (capacity < expected_orders * 2) {
+        capacity *= 2;
+    }
+
+    Slot empty;
+    empty.hash = 0;
+    empty.index = order_none;
+    slots.assign(capacity, empty);
+}
+
+OrderManager::~OrderManager() {
+    for (size_t i = 0; i < slabs.size(); ++i) {
+        delete[] slabs[i];
+    }
+}
+
+OrderState* OrderManager::entry_at(uint32_t index) const {
+    if (index == order_none) return 0;
+    return &slabs[index / slab_size][index % slab_size];
+}
+
+uint32_t OrderManager::lookup(const char* clord_id, size_t len, uint64_t hash) const {
+    const size_t mask = slots.size() - 1;
+    const uint32_t short_hash = static_cast<uint32_t>(hash);
+
+    for (size_t pos = hash & mask; ; pos = (pos + 1) & mask) {
+        const Slot& slot = slots[pos];
+        if (slot.index == order_none) {
+            return order_none;
+        }
+
+        if (slot.hash == short_hash) {
+            const OrderState& order = *entry_at(slot.index);
+            if (std::strncmp(order.clord_id, clord_id, len) == 0 && order.clord_id[len] == '\0') {
+                return slot.index;
+            }
+        }
+    }
+}
+
+const OrderState* OrderManager::find(const char* clord_id, size_t len) const {
+    if (len >= order_id_capacity) return 0;
+    return entry_at(lookup(clord_id, len, hash_id(clord_id, len)));
+}
+
+// Table kept at most 70% full
+void OrderManager::grow() {
+    std::vector<Slot> old_slots;
+    old_slots.swap(slots);
+
+    Slot empty;
+    empty.hash = 0;
+    empty.index = order_none;
+    slots.assign(old_slots.size() * 2, empty);
+
+    const size_t mask = slots.size() - 1;
+    for (size_t i = 0; i < old_slots.size(); ++i) {
+        if (old_slots[i].index == order_none) continue;
+
+        size_t pos = old_slots[i].hash & mask;
+        while (slots[pos].index != order_none) {
+            pos = (pos + 1) & mask;
+        }
+        slots[pos] = old_slots[i];
+    }
+}
+
+uint32_t OrderManager::insert(const char* clord_id, size_t len) {
+    if (len == 0 || len >= order_id_capacity) {
+        return order_none;
+    }
+
+    if ((used_slots + 1) * 10 > slots.size() * 7) {
+        grow();
+    }
+
+    if (free_entries.empty()) {
+        const uint32_t base = static_cast<uint32_t>(slabs.size() * slab_size);
+        slabs.push_back(new OrderState[slab_size]);
+        for (size_t i = slab_size; i > 0; --i) {
+            slabs.back()[i - 1].ord_status = 0;
+            free_entries.push_back(base + static_cast<uint32_t>(i - 1));
+        }
+    }
+
+    const uint32_t index = free_entries.back();
+    free_entries.pop_back();
+
+    OrderState& order = *entry_at(index);
+    std::memcpy(order.clord_id, clord_id, len);
+    order.clord_id[len] = '\0';
+    order.order_id[0] = '\0';
+    order.symbol[0] = '\0';
+    order.side = 0;
+    order.ord_status = 'A';
+    order.order_qty = FixDecimal();
+    order.price = FixDecimal();
+    order.cum_qty = FixDecimal();
+    order.leaves_qty = FixDecimal();
+    order.avg_px = FixDecimal();
+    order.orig = order_none;
+    order.next = order_none;
+
+    const uint64_t hash = hash_id(clord_id, len);
+    const size_t mask = slots.size() - 1;
+    size_t pos = hash & mask;
+    while (slots[pos].index != order_none) {
+        pos = (pos + 1) & mask;
+    }
+    slots[pos].hash = static_cast<uint32_t>(hash);
+    slots[pos].index = index;
+
+    used_slots++;
+    totals.live++;
+    return index;
+}
+
+// Linear probing without tombstones: later
+// entries of the run shift back into the hole
+void OrderManager::erase(uint32_t index) {
+    OrderState& order = *entry_at(index);
+
+    OrderState* previous_request = entry_at(order.orig);
+    if (previous_request && previous_request->next == index) previous_request->next = order_none;
+    OrderState* following_request = entry_at(order.next);
+    if (following_request && following_request->orig == index) following_request->orig = order_none;
+
+    const size_t mask = slots.size() - 1;
+    size_t hole = hash_id(order.clord_id, std::strlen(order.clord_id)) & mask;
+    while (slots[hole].index != index) {
+        hole = (hole + 1) & mask;
+    }
+
+    for (size_t pos = (hole + 1) & mask; slots[pos].index != order_none; pos = (pos + 1) & mask) {
+        const size_t home = slots[pos].hash & mask;
+
+        // Moves back unless its home lies
+        // cyclically in (hole, pos]
+        const bool stays = (hole <= pos) ? (hole < home && home <= pos) : (hole < home || home <= pos);
+        if (!stays) {
+            slots[hole] = slots[pos];
+            hole = pos;
+        }
+    }
+    slots[hole].index = order_none;
+
+    order.ord_status = 0;
+    free_entries.push_back(index);
+    used_slots--;
+    totals.live--;
+}
+
+void OrderManager::retire(uint32_t index) {
+    const OrderState& order = *entry_at(index);
+
+    switch (order.ord_status) {
+        case '2': totals.filled++; break;
+        case '4': totals.canceled++; break;
+        case '8': totals.rejected++; break;
+        case 'C': totals.expired++; break;
+        case '5': totals.replaced++; break;
+        default: break;
+    }
+
+    if (terminal) {
+        terminal(order);
+    }
+    erase(index);
+}
+
+bool OrderManager::on_outbound(const std::string& msg) {
+    OrderFields fields;
+    scan_order_fields(msg, fields);
+
+    const char msg_type = (fields.msg_type.size == 1) ? fields.msg_type.first() : 0;
+    if (msg_type != 'D' && msg_type != 'G' && msg_type != 'F') {
+        return false;
+    }
+    if (!fields.clord_id.data ||
+        lookup(fields.clord_id.data, fields.clord_id.size,
+               hash_id(fields.clord_id.data, fields.clord_id.size)) != order_none) {
+        return false;
+    }
+
+    uint32_t orig = order_none;
+    if (msg_type != 'D' && fields.orig_clord_id.data && fields.orig_clord_id.size < order_id_capacity) {
+        orig = lookup(fields.orig_clord_id.data, fields.orig_clord_id.size,
+                      hash_id(fields.orig_clord_id.data, fields.orig_clord_id.size));
+    }
+
+    const uint32_t index = insert(fields.clord_id.data, fields.clord_id.size);
+    if (index == order_none) {
+        return false;
+    }
+
+    OrderState& order = *entry_at(index);
+    const OrderState* previous_request = entry_at(orig);
+
+    // G/F carry only what changes,
+    // the rest comes from the order
+    if (previous_request) {
+        std::memcpy(order.order_id, previous_request->order_id, sizeof(order.order_id));
+        std::memcpy(order.symbol, previous_request->symbol, sizeof(order.symbol));
+        order.side = previous_request->side;
+        order.order_qty = previous_request->order_qty;
+        order.price = previous_request->price;
+        order.cum_qty = previous_request->cum_qty;
+        order.leaves_qty = previous_request->leaves_qty;
+        order.avg_px = previous_request->avg_px;
+
+        order.orig = orig;
+        entry_at(orig)->next = index;
+    }
+
+    if (fields.symbol.data) copy_text(order.symbol, sizeof(order.symbol), fields.symbol, true);
+    if (fields.side.data) order.side = fields.side.first();
+    parse_decimal(fields.order_qty, order.order_qty);
+    parse_decimal(fields.price, order.price);
+
+    if (msg_type == 'D') {
+        order.leaves_qty = order.order_qty;
+        order.ord_status = 'A';         // PendingNew
+    } else if (msg_type == 'G') {
+        order.ord_status = 'E';         // PendingReplace
+    } else {
+        order.ord_status = '6';         // PendingCancel
+    }
+    return true;
+}
+
+bool OrderManager::on_inbound(const std::string& msg) {
+    OrderFields fields;
+    scan_order_fields(msg, fields);
+
+    const char msg_type = (fields.msg_type.size == 1) ? fields.msg_type.first() : 0;
+    if ((msg_type != '8' && msg_type != '9') || !fields.clord_id.data ||
+        fields.clord_id.size >= order_id_capacity) {
+        return false;
+    }
+
+    uint32_t index = lookup(fields.clord_id.data, fields.clord_id.size,
+                            hash_id(fields.clord_id.data, fields.clord_id.size));
+    uint32_t orig = (index != order_none) ? entry_at(index)->orig : order_none;
+    if (orig == order_none && fields.orig_clord_id.data && fields.orig_clord_id.size < order_id_capacity) {
+        orig = lookup(fields.orig_clord_id.data, fields.orig_clord_id.size,
+                      hash_id(fields.orig_clord_id.data, fields.orig_clord_id.size));
+    }
+
+    // CancelReject: the order keeps going with
+    // the 39 it reports, the request is dropped
+    if (msg_type == '9') {
+        if (orig != order_none && fields.ord_status.data) {
+            entry_at(orig)->ord_status = fields.ord_status.first();
+        }
+        if (index != order_none) {
+            totals.cancel_rejects++;
+            erase(index);
+        }
+        return index != order_none || orig != order_none;
+    }
+
+    if (index == order_none) {
+        index = insert(fields.clord_id.data, fields.clord_id.size);
+        if (index == order_none) {
+            return false;
+        }
+        totals.unsolicited++;
+
+        if (orig != order_none) {
+            OrderState& order = *entry_at(index);
+            const OrderState& previous_request = *entry_at(orig);
+            std::memcpy(order.order_id, previous_request.order_id, sizeof(order.order_id));
+            std::memcpy(order.symbol, previous_request.symbol, sizeof(order.symbol));
+            order.side = previous_request.side;
+            order.order_qty = previous_request.order_qty;
+            order.price = previous_request.price;
+            order.orig = orig;
+            entry_at(orig)->next = index;
+        }
+    }
+
+    OrderState& order = *entry_at(index);
+    if (fields.order_id.data) copy_text(order.order_id, sizeof(order.order_id), fields.order_id, true);
+    if (fields.symbol.data) copy_text(order.symbol, sizeof(order.symbol), fields.symbol, true);
+    if (fields.side.data) order.side = fields.side.first();
+    if (fields.ord_status.data) order.ord_status = fields.ord_status.first();
+    parse_decimal(fields.order_qty, order.order_qty);
+    parse_decimal(fields.price, order.price);
+    parse_decimal(fields.cum_qty, order.cum_qty);
+    parse_decimal(fields.leaves_qty, order.leaves_qty);
+    parse_decimal(fields.avg_px, order.avg_px);
+
+    // Replaced on a G: the request it followed
+    // is superseded and counts as replaced.
+    // Canceled on an F: the cancel request is
+    // the order from here and counts once, as
+    // canceled, the request it followed goes
+    // uncounted. Pending: that request shows
+    // the pending status.
+    if (order.orig != order_none) {
+        const char exec_type = fields.exec_type.first();
+        OrderState& previous_request = *entry_at(order.orig);
+
+        if (exec_type == '5') {
+            previous_request.ord_status = '5';
+            retire(order.orig);
+        } else if (exec_type == '4') {
+            erase(order.orig);
+        } else if (exec_type == 'E' || exec_type == '6') {
+            previous_request.ord_status = order.ord_status;
+        }
+    }
+
+    if (is_terminal_status(order.ord_status)) {
+        retire(index);
+    }
+    return true;
+}
+
+void OrderManager::snapshot(std::vector<OrderState>& out) const {
+    out.clear();
+    out.reserve(static_cast<size_t>(totals.live));
+    for (size_t i = 0; i < slabs.size(); ++i) {
+        for (size_t j = 0; j < slab_size; ++j) {
+            if (slabs[i][j].ord_status != 0) out.push_back(slabs[i][j]);
+        }
+    }
+}
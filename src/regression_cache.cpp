@@ -0,0 +1,111 @@
+#include "regression_cache.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+const char* const cache_dir = "results/regression_cache";
+
+// Bumped when the result file or the
+// scenario hash input changes
+const uint32_t cache_version = 1;
+
+uint64_t regression_hash(uint64_t seed, const void* data, size_t len) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    uint64_t hash = seed;
+    for (size_t i = 0; i < len; ++i) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+// Length first, so "ab"+"c" and
+// "a"+"bc" hash differently
+uint64_t regression_hash(uint64_t seed, const std::string& text) {
+    const uint64_t len = text.size();
+    seed = regression_hash(seed, &len, sizeof(len));
+    return regression_hash(seed, text.data(), text.size());
+}
+
+uint64_t regression_config_hash(const SessionConfig& config) {
+    uint64_t hash = regression_hash(regression_hash_seed, &cache_version, sizeof(cache_version));
+    hash = regression_hash(hash, config.begin_string);
+    hash = regression_hash(hash, config.target_comp_id);
+    hash = regression_hash(hash, config.host);
+
+    const int32_t port = config.port;
+    return regression_hash(hash, &port, sizeof(port));
+}
+
+bool parse_regression_rerun(const std::string& text, RegressionRerun& mode) {
+    if (text == "all") mode = regression_rerun_all;
+    else if (text == "failed") mode = regression_rerun_failed;
+    else if (text == "changed") mode = regression_rerun_changed;
+    else return false;
+    return true;
+}
+
+static std::string result_path(uint64_t key) {
+    char name[32];
+    std::snprintf(name, sizeof(name), "/%016llx", static_cast<unsigned long long>(key));
+    return cache_dir + std::string(name);
+}
+
+// "passed <0|1>\nms <n>\n\n" then the report
+bool load_regression_result(uint64_t key, RegressionCacheEntry& entry) {
+    std::ifstream in(result_path(key).c_str(), std::ios::in | std::ios::binary);
+    if (!in.is_open()) {
+        return false;
+    }
+
+    std::string passed_line;
+    std::string ms_line;
+    std::string blank_line;
+    if (!std::getline(in, passed_line) || !std::getline(in, ms_line) ||
+        !std::getline(in, blank_line) || !blank_line.empty() ||
+        passed_line.compare(0, 7, "passed ") != 0 || ms_line.compare(0, 3, "ms ") != 0) {
+        return false;
+    }
+
+    std::ostringstream report;
+    report << in.rdbuf();
+
+    entry.passed = (passed_line.compare(7, std::string::npos, "1") == 0);
+    entry.elapsed_ms = std::strtoull(ms_line.c_str() + 3, 0, 10);
+    entry.report = report.str();
+    return true;
+}
+
+// Written aside and renamed, shards
+// may store results at the same time
+bool save_regression_result(uint64_t key, const RegressionCacheEntry& entry) {
+    ::mkdir("results", 0755);
+    ::mkdir(cache_dir, 0755);
+
+    const std::string path = result_path(key);
+    char suffix[32];
+    std::snprintf(suffix, sizeof(suffix), ".%ld.tmp", static_cast<long>(::getpid()));
+    const std::string tmp_path = path + suffix;
+
+    FILE* out = std::fopen(tmp_path.c_str(), "wb");
+    if (!out) {
+        return false;
+    }
+
+    std::fprintf(out, "passed %d\nms %llu\n\n", entry.passed ? 1 : 0,
+                 static_cast<unsigned long long>(entry.elapsed_ms));
+    std::fwrite(entry.report.data(), 1, entry.report.size(), out);
+
+    const bool ok = (std::fflush(out) == 0);
+    std::fclose(out);
+    if (!ok || std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+        ::unlink(tmp_path.c_str());
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,166 @@
+#include "regression_latency.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <algorithm>
+#include <fstream>
+
+static uint64_t nearest_rank(const std::vector<uint64_t>& sorted, int percent) {
+    size_t rank = (sorted.size() * static_cast<size_t>(percent) + 99) / 100;
+    if (rank == 0) rank = 1;
+    return sorted[rank - 1];
+}
+
+LatencyStats latency_stats(std::vector<uint64_t> samples_us) {
+    LatencyStats stats;
+    if (samples_us.empty()) {
+        return stats;
+    }
+
+    std::sort(samples_us.begin(), samples_us.end());
+    stats.count = samples_us.size();
+    stats.min_us = samples_us.front();
+    stats.p50_us = nearest_rank(samples_us, 50);
+    stats.p99_us = nearest_rank(samples_us, 99);
+    stats.max_us = samples_us.back();
+    return stats;
+}
+
+std::string format_latency_stats(const LatencyStats& stats) {
+    char buf[160];
+    std::snprintf(buf, sizeof(buf), "n=%zu min=%lluus p50=%lluus p99=%lluus max=%lluus",
+                  stats.count,
+                  static_cast<unsigned long long>(stats.min_us),
+                  static_cast<unsigned long long>(stats.p50_us),
+                  static_cast<unsigned long long>(stats.p99_us),
+                  static_cast<unsigned long long>(stats.max_us));
+    return buf;
+}
+
+std::string format_latency_histogram(const std::vector<uint64_t>& samples_us) {
+    const int bucket_count = 40;
+    const int bar_width = 40;
+
+    size_t buckets[bucket_count] = { 0 };
+    size_t peak = 0;
+    for (size_t i = 0; i < samples_us.size(); ++i) {
+        // Bucket b holds [2^(b-1), 2^b)
+        int bucket = 0;
+        for (uint64_t value = samples_us[i]; value > 0 && bucket < bucket_count - 1; value >>= 1) {
+            bucket++;
+        }
+        peak = std::max(peak, ++buckets[bucket]);
+    }
+
+    std::string out;
+    for (int b = 0; b < bucket_count; ++b) {
+        if (buckets[b] == 0) continue;
+
+        const unsigned long long low = (b == 0) ? 0ULL : (1ULL << (b - 1));
+        const unsigned long long high = 1ULL << b;
+        const int bar = static_cast<int>((buckets[b] * bar_width + peak - 1) / peak);
+
+        char range[48];
+        std::snprintf(range, sizeof(range), "%llu-%lluus", low, high);
+
+        char line[160];
+        std::snprintf(line, sizeof(line), "  %-20s %8zu  %.*s\n",
+                      range, buckets[b], bar, "########################################");
+        out += line;
+    }
+    return out;
+}
+
+bool save_latency_csv(const std::string& path, const std::vector<LatencySample>& samples) {
+    FILE* out = std::fopen(path.c_str(), "w");
+    if (!out) {
+        return false;
+    }
+
+    std::fprintf(out, "scenario,step,sent_ns,received_ns,latency_us\n");
+    for (size_t i = 0; i < samples.size(); ++i) {
+        const LatencySample& sample = samples[i];
+
+        // Quoted, scenario names may hold commas
+        std::string name;
+        for (size_t c = 0; c < sample.scenario.size(); ++c) {
+            if (sample.scenario[c] == '"') name.push_back('"');
+            name.push_back(sample.scenario[c]);
+        }
+
+        std::fprintf(out, "\"%s\",%d,%llu,%llu,%llu\n", name.c_str(), sample.step,
+                     static_cast<unsigned long long>(sample.sent_ns),
+                     static_cast<unsigned long long>(sample.received_ns),
+                     static_cast<unsigned long long>(sample.latency_us()));
+    }
+
+    const bool ok = (std::fflush(out) == 0);
+    std::fclose(out);
+    return ok;
+}
+
+bool load_latency_csv(const std::string& path,
+                      std::map<std::string, std::vector<uint64_t> >& by_scenario) {
+    std::ifstream in(path.c_str());
+    if (!in.is_open()) {
+        return false;
+    }
+
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.empty() || line[0] != '"') continue;
+
+        std::string name;
+        size_t pos = 1;
+        for (; pos < line.size(); ++pos) {
+            if (line[pos] == '"') {
+                if (pos + 1 < line.size() && line[pos + 1] == '"') {
+                    name.push_back('"');
+                    pos++;
+                    continue;
+                }
+                break;
+            }
+            name.push_back(line[pos]);
+        }
+
+        // latency_us is the last column
+        const size_t last_comma = line.rfind(',');
+        if (last_comma == std::string::npos || last_comma <= pos) continue;
+
+        by_scenario[name].push_back(std::strtoull(line.c_str() + last_comma + 1, 0, 10));
+    }
+    return true;
+}
+
+static bool moved(uint64_t baseline_us, uint64_t current_us, int threshold_pct) {
+    const uint64_t diff = (current_us > baseline_us) ? current_us - baseline_us : baseline_us - current_us;
+    return diff * 100 > baseline_us * static_cast<uint64_t>(threshold_pct);
+}
+
+std::vector<LatencyShift> compare_latency(const std::map<std::string, std::vector<uint64_t> >& baseline,
+                                          const std::map<std::string, std::vector<uint64_t> >& current,
+                                          int threshold_pct) {
+    std::vector<LatencyShift> shifts;
+
+    typedef std::map<std::string, std::vector<uint64_t> >::const_iterator Iterator;
+    for (Iterator it = current.begin(); it != current.end(); ++it) {
+        Iterator base = baseline.find(it->first);
+        if (base == baseline.end() || base->second.empty() || it->second.empty()) continue;
+
+        LatencyShift shift;
+        shift.scenario = it->first;
+        shift.baseline = latency_stats(base->second);
+        shift.current = latency_stats(it->second);
+
+        if (!moved(shift.baseline.p50_us, shift.current.p50_us, threshold_pct) &&
+            !moved(shift.baseline.p99_us, shift.current.p99_us, threshold_pct)) {
+            continue;
+        }
+
+        shift.slower = shift.current.p50_us > shift.baseline.p50_us ||
+                       shift.current.p99_us > shift.baseline.p99_us;
+        shifts.push_back(shift);
+    }
+    return shifts;
+}
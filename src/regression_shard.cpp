@@ -0,0 +1,294 @@
+#include "regression_shard.h"
+#include "fix_regression.h"
+#include "utils.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstdarg>
+#include <ctime>
+#include <map>
+#include <fstream>
+#include <algorithm>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+// "<ms> <file>" per line, updated
+// after every sharded run
+const char* const durations_path = "results/regression_durations.txt";
+const uint64_t default_file_ms = 1000;
+
+struct Shard {
+    std::string session_name;
+    std::vector<std::string> files;
+    uint64_t estimate_ms;
+    std::string summary_path;
+    std::string output_path;
+    pid_t pid;
+    int exit_code;
+};
+
+static void load_durations(std::map<std::string, uint64_t>& durations) {
+    std::ifstream in(durations_path);
+
+    std::string line;
+    while (std::getline(in, line)) {
+        const size_t space = line.find(' ');
+        if (space == std::string::npos) continue;
+
+        durations[line.substr(space + 1)] = std::strtoull(line.c_str(), 0, 10);
+    }
+}
+
+static bool save_durations(const std::map<std::string, uint64_t>& durations) {
+    const std::string tmp_path = std::string(durations_path) + ".tmp";
+
+    FILE* out = std::fopen(tmp_path.c_str(), "w");
+    if (!out) {
+        return false;
+    }
+
+    for (std::map<std::string, uint64_t>::const_iterator it = durations.begin(); it != durations.end(); ++it) {
+        std::fprintf(out, "%llu %s\n", static_cast<unsigned long long>(it->second), it->first.c_str());
+    }
+
+    const bool ok = (std::fflush(out) == 0);
+    std::fclose(out);
+    return ok && std::rename(tmp_path.c_str(), durations_path) == 0;
+}
+
+static bool longer_first(const std::pair<uint64_t, size_t>& a,
+                         const std::pair<uint64_t, size_t>& b) {
+    if (a.first != b.first) return a.first > b.first;
+    return a.second < b.second;
+}
+
+// Longest file first onto the least loaded
+// shard. Files never run before count as
+// the average of the known ones.
+static void plan_shards(const std::vector<std::string>& files,
+                        const std::map<std::string, uint64_t>& durations,
+                        std::vector<Shard>& shards) {
+    uint64_t known_total = 0;
+    size_t known_count = 0;
+    for (size_t i = 0; i < files.size(); ++i) {
+        std::map<std::string, uint64_t>::const_iterator found = durations.find(files[i]);
+        if (found != durations.end()) {
+            known_total += found->second;
+            known_count++;
+        }
+    }
+    const uint64_t unknown_ms = known_count ? (known_total / known_count) : default_file_ms;
+
+    std::vector<std::pair<uint64_t, size_t> > order;
+    for (size_t i = 0; i < files.size(); ++i) {
+        std::map<std::string, uint64_t>::const_iterator found = durations.find(files[i]);
+        order.push_back(std::make_pair(found != durations.end() ? found->second : unknown_ms, i));
+    }
+    std::sort(order.begin(), order.end(), longer_first);
+
+    std::vector<std::vector<size_t> > assigned(shards.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        size_t best = 0;
+        for (size_t s = 1; s < shards.size(); ++s) {
+            if (shards[s].estimate_ms < shards[best].estimate_ms) best = s;
+        }
+        shards[best].estimate_ms += order[i].first;
+        assigned[best].push_back(order[i].second);
+    }
+
+    // Keep file order inside a shard
+    for (size_t s = 0; s < shards.size(); ++s) {
+        std::sort(assigned[s].begin(), assigned[s].end());
+        for (size_t i = 0; i < assigned[s].size(); ++i) {
+            shards[s].files.push_back(files[assigned[s][i]]);
+        }
+    }
+}
+
+// Merged report goes to stdout and
+// results/SHARDED_REGRESSION_RESULT_*.log
+static void print_merged_log(FILE* log_file, const char* format, ...) {
+    char formatted_text[8192];
+    va_list args;
+    va_start(args, format);
+    const int text_len = std::vsnprintf(formatted_text, sizeof(formatted_text), format, args);
+    va_end(args);
+
+    if (text_len <= 0) return;
+
+    std::fputs(formatted_text, stdout);
+    if (log_file) std::fputs(formatted_text, log_file);
+}
+
+static FILE* open_merged_log() {
+    std::time_t now = std::time(0);
+    std::tm local_time;
+    localtime_r(&now, &local_time);
+
+    char log_path[256];
+    std::snprintf(log_path, sizeof(log_path), "results/SHARDED_REGRESSION_RESULT_%04d%02d%02d_%02d%02d%02d.log",
+                  local_time.tm_year + 1900, local_time.tm_mon + 1, local_time.tm_mday,
+                  local_time.tm_hour, local_time.tm_min, local_time.tm_sec);
+
+    return std::fopen(log_path, "w");
+}
+
+int run_sharded_regression(const AppArgs& args,
+                           const std::vector<std::string>& sessions) {
+    ::mkdir("results", 0755);
+
+    const std::vector<std::string> files = list_regression_files(args.scenario_path);
+
+    std::map<std::string, uint64_t> durations;
+    load_durations(durations);
+
+    std::vector<Shard> shards(sessions.size());
+    for (size_t s = 0; s < sessions.size(); ++s) {
+        shards[s].session_name = sessions[s];
+        shards[s].estimate_ms = 0;
+        shards[s].summary_path = "results/." + sessions[s] + "_shard.summary";
+        shards[s].output_path = "results/" + sessions[s] + "_SHARD.out";
+        shards[s].pid = -1;
+        shards[s].exit_code = 0;
+    }
+    plan_shards(files, durations, shards);
+
+    const uint64_t start_ms = utils::get_monotonic_millis();
+
+    for (size_t s = 0; s < shards.size(); ++s) {
+        Shard& shard = shards[s];
+        if (shard.files.empty()) continue;
+
+        std::printf("Info: shard %s: %zu files, estimated %llums, output %s\n",
+                    shard.session_name.c_str(), shard.files.size(),
+                    static_cast<unsigned long long>(shard.estimate_ms), shard.output_path.c_str());
+        std::fflush(stdout);
+
+        ::unlink(shard.summary_path.c_str());
+
+        const pid_t pid = ::fork();
+        if (pid < 0) {
+            std::printf("Error: fork failed for shard %s\n", shard.session_name.c_str());
+            shard.exit_code = 1;
+            continue;
+        }
+
+        if (pid == 0) {
+            if (!std::freopen(shard.output_path.c_str(), "w", stdout)) {
+                ::_exit(1);
+            }
+
+            AppArgs shard_args = args;
+            shard_args.session_name = shard.session_name;
+            shard_args.scenario_files = shard.files;
+            shard_args.shard_summary_path = shard.summary_path;
+
+            Application app;
+            const int rc = app.run(shard_args);
+            std::fflush(stdout);
+            ::_exit(rc);
+        }
+
+        shard.pid = pid;
+    }
+
+    for (size_t s = 0; s < shards.size(); ++s) {
+        Shard& shard = shards[s];
+        if (shard.pid <= 0) continue;
+
+        int status = 0;
+        if (::waitpid(shard.pid, &status, 0) < 0) {
+            shard.exit_code = 1;
+        } else if (WIFEXITED(status)) {
+            shard.exit_code = WEXITSTATUS(status);
+        } else {
+            shard.exit_code = 128 + (WIFSIGNALED(status) ? WTERMSIG(status) : 0);
+        }
+    }
+
+    const uint64_t elapsed_ms = utils::get_monotonic_millis() - start_ms;
+
+    FILE* log_file = open_merged_log();
+    RegressionSummary merged;
+    bool ok = true;
+
+    print_merged_log(log_file, "\n# SHARDS\n");
+    for (size_t s = 0; s < shards.size(); ++s) {
+        Shard& shard = shards[s];
+        if (shard.files.empty()) continue;
+
+        RegressionSummary summary;
+        if (!load_regression_summary(shard.summary_path, summary)) {
+            print_merged_log(log_file, "%s:\t(no summary, exit %d) see %s\n",
+                             shard.session_name.c_str(), shard.exit_code, shard.output_path.c_str());
+            ok = false;
+            continue;
+        }
+        ::unlink(shard.summary_path.c_str());
+
+        print_merged_log(log_file, "%s:\t%d run, %d passed, %d failed, %d cached, exit %d\n",
+                         shard.session_name.c_str(), summary.total_run, summary.total_passed,
+                         summary.total_failed, summary.total_cached, shard.exit_code);
+
+        if (shard.exit_code != 0 && summary.total_failed == 0) {
+            ok = false;
+        }
+
+        merged.total_run += summary.total_run;
+        merged.total_passed += summary.total_passed;
+        merged.total_failed += summary.total_failed;
+        merged.total_cached += summary.total_cached;
+        merged.latency_flagged += summary.latency_flagged;
+        merged.unmatched += summary.unmatched;
+        merged.failed_names.insert(merged.failed_names.end(),
+                                   summary.failed_names.begin(), summary.failed_names.end());
+
+        // Files not reached (aborted shard)
+        // keep their previous duration
+        for (size_t i = 0; i < summary.file_ms.size(); ++i) {
+            if (summary.file_ms[i].second > 0) {
+                durations[summary.file_ms[i].first] = summary.file_ms[i].second;
+            }
+        }
+    }
+
+    print_merged_log(log_file, "\n# OVER ALL SUMMARY\n");
+    print_merged_log(log_file, "Total Scenarios:\t%d\n", merged.total_run);
+    print_merged_log(log_file, "Total Passed:\t\t%d\n", merged.total_passed);
+    if (merged.total_cached > 0) {
+        print_merged_log(log_file, "Total Cached:\t\t%d\n", merged.total_cached);
+    }
+    if (merged.latency_flagged > 0) {
+        print_merged_log(log_file, "Latency Flagged:\t%d\n", merged.latency_flagged);
+    }
+    if (merged.unmatched > 0) {
+        print_merged_log(log_file, "Unmatched Inbound:\t%d\n", merged.unmatched);
+    }
+
+    if (merged.total_failed == 0) {
+        print_merged_log(log_file, "Total Failed:\t\t0\n");
+    } else {
+        print_merged_log(log_file, "Total Failed:\t\t%d (", merged.total_failed);
+        for (size_t i = 0; i < merged.failed_names.size(); ++i) {
+            if (i) print_merged_log(log_file, ", ");
+            print_merged_log(log_file, "%s", merged.failed_names[i].c_str());
+        }
+        print_merged_log(log_file, ")\n");
+    }
+    print_merged_log(log_file, "Wall time:\t\t%llums\n", static_cast<unsigned long long>(elapsed_ms));
+
+    if (ok && merged.total_failed == 0) {
+        print_merged_log(log_file, "All done!\n");
+    }
+    std::printf("\n");
+
+    if (log_file) std::fclose(log_file);
+
+    if (!save_durations(durations)) {
+        std::printf("Warning: cannot update %s\n", durations_path);
+    }
+
+    return (ok && merged.total_failed == 0) ? 0 : 1;
+}
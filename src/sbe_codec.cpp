@@ -0,0 +1,487 @@
+#include "sbe_codec.h"
+#include "constants.h"
+#include "utils.h"
+
+#include <cstring>
+
+static const int64_t pow10_values[19] = {
+    1LL, 10LL, 100LL, 1000LL, 10000LL, 100000LL, 1000000LL, 10000000LL, 100000000LL,
+    1000000000LL, 10000000000LL, 100000000000LL, 1000000000000LL, 10000000000000LL,
+    100000000000000LL, 1000000000000000LL, 10000000000000000LL, 100000000000000000LL,
+    1000000000000000000LL
+};
+
+static uint64_t load_be(const char* in, size_t size) {
+    uint64_t value = 0;
+    for (size_t i = 0; i < size; ++i) {
+        value = (value << 8) | static_cast<unsigned char>(in[i]);
+    }
+    return value;
+}
+
+bool sbe_decimal_rescale(const FixDecimal& value, int exponent, int64_t& mantissa) {
+    mantissa = value.mantissa;
+
+    const int shift = -value.scale - exponent;
+    if (shift > 18 || shift < -18) return false;
+    if (shift > 0) {
+        const int64_t factor = pow10_values[shift];
+        if (mantissa > INT64_MAX / factor || mantissa < -(INT64_MAX / factor)) return false;
+        mantissa *= factor;
+    } else if (shift < 0) {
+        const int64_t factor = pow10_values[-shift];
+        if (mantissa % factor != 0) return false;   // finer than the field
+        mantissa /= factor;
+    }
+    return true;
+}
+
+bool sbe_decimal_value(int64_t mantissa, int exponent, FixDecimal& value) {
+    if (exponent > 0) {
+        if (exponent > 18 || mantissa > INT64_MAX / pow10_values[exponent] ||
+            mantissa < -(INT64_MAX / pow10_values[exponent])) {
+            return false;
+        }
+        mantissa *= pow10_values[exponent];
+    }
+
+    value = FixDecimal(mantissa, exponent < 0 ? -exponent : 0);
+    fix_decimal_normalize(value);
+    return true;
+}
+
+// YYYYMMDD-HH:MM:SS[.fraction] to epoch nanos,
+// fraction up to 9 digits
+static bool parse_utc_timestamp(const char* text, size_t size, uint64_t& nanos) {
+    if (size < 17 || text[8] != '-' || text[11] != ':' || text[14] != ':') return false;
+
+    static const size_t digit_pos[] = { 0, 1, 2, 3, 4, 5, 6, 7, 9, 10, 12, 13, 15, 16 };
+    int d[14];
+    for (size_t i = 0; i < 14; ++i) {
+        const char c = text[digit_pos[i]];
+        if (c < '0' || c > '9') return false;
+        d[i] = c - '0';
+    }
+
+    int year = d[0] * 1000 + d[1] * 100 + d[2] * 10 + d[3];
+    const int month = d[4] * 10 + d[5];
+    const int day = d[6] * 10 + d[7];
+    const int hour = d[8] * 10 + d[9];
+    const int minute = d[10] * 10 + d[11];
+    const int second = d[12] * 10 + d[13];
+    if (month < 1 || month > 12 || day < 1 || day > 31 || hour > 23 || minute > 59 || second > 60) return false;
+
+    uint64_t fraction = 0;
+    if (size > 17) {
+        if (text[17] != '.' || size == 18 || size > 27) return false;
+        for (size_t i = 18; i < 27; ++i) {
+            int digit = 0;
+            if (i < size) {
+                if (text[i] < '0' || text[i] > '9') return false;
+                digit = text[i] - '0';
+            }
+            fraction = fraction * 10 + static_cast<uint64_t>(digit);
+        }
+    }
+
+    // Days from 1970-01-01 (civil calendar)
+    year -= month <= 2;
+    const int era = year / 400;
+    const int year_of_era = year - era * 400;
+    const int day_of_year = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    const int day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+    const int64_t days = static_cast<int64_t>(era) * 146097 + day_of_era - 719468;
+    if (days < 0) return false;
+
+    const uint64_t seconds = static_cast<uint64_t>(days) * 86400ULL +
+                             static_cast<uint64_t>(hour * 3600 + minute * 60 + second);
+    nanos = seconds * 1000000000ULL + fraction;
+    return true;
+}
+
+static void write_null(char* block, const SbeField& field) {
+    char* at = block + field.offset;
+    switch (field.kind) {
+        case sbe_kind_int:
+            sbe_store_le(at, static_cast<uint64_t>(sbe_int_null(field.size)), field.size);
+            break;
+        case sbe_kind_uint:
+        case sbe_kind_timestamp:
+            sbe_store_le(at, sbe_uint_null(field.size), field.size);
+            break;
+        case sbe_kind_decimal:
+            sbe_store_le(at, static_cast<uint64_t>(sbe_int_null(field.mantissa_size)), field.mantissa_size);
+            if (!field.constant_exponent) at[field.mantissa_size] = static_cast<char>(-128);
+            break;
+        default:
+            std::memset(at, 0, field.size);
+            break;
+    }
+}
+
+bool SbeEncoder::wrap(char* out, size_t capacity, const SbeSchema& schema, const SbeMessageLayout& layout) {
+    const size_t frame_size = sofh_size + sbe_header_size + layout.block_length;
+    if (!out || capacity < frame_size) {
+        buffer = 0;
+        message = 0;
+        return false;
+    }
+
+    buffer = out;
+    block = out + sofh_size + sbe_header_size;
+    message = &layout;
+
+    sbe_store_be(out, frame_size, 4);
+    sbe_store_be(out + 4, sofh_sbe_le, 2);
+
+    char* header = out + sofh_size;
+    sbe_store_le(header, layout.block_length, 2);
+    sbe_store_le(header + 2, layout.template_id, 2);
+    sbe_store_le(header + 4, schema.id(), 2);
+    sbe_store_le(header + 6, schema.version(), 2);
+
+    std::memset(block, 0, layout.block_length);
+    for (size_t i = 0; i < layout.fields.size(); ++i) {
+        if (layout.fields[i].optional) write_null(block, layout.fields[i]);
+    }
+    return true;
+}
+
+size_t SbeEncoder::size() const {
+    return message ? sofh_size + sbe_header_size + message->block_length : 0;
+}
+
+bool SbeEncoder::put_int(int tag, int64_t value) {
+    const SbeField* field = message ? message->field(tag) : 0;
+    if (!field) return false;
+
+    if (field->kind == sbe_kind_int) {
+        if (!sbe_int_fits(value, field->size)) return false;
+    } else if (field->kind == sbe_kind_uint || field->kind == sbe_kind_timestamp) {
+        if (value < 0 || (field->size < 8 && static_cast<uint64_t>(value) >= sbe_uint_null(field->size))) return false;
+    } else {
+        return false;
+    }
+
+    sbe_store_le(block + field->offset, static_cast<uint64_t>(value), field->size);
+    return true;
+}
+
+bool SbeEncoder::put_char(int tag, char value) {
+    const SbeField* field = message ? message->field(tag) : 0;
+    if (!field || field->kind != sbe_kind_char) return false;
+
+    block[field->offset] = value;
+    return true;
+}
+
+bool SbeEncoder::put_string(int tag, const char* data, size_t size) {
+    const SbeField* field = message ? message->field(tag) : 0;
+    if (!field || field->kind != sbe_kind_string || size > field->size) return false;
+
+    char* at = block + field->offset;
+    std::memcpy(at, data, size);
+    std::memset(at + size, 0, field->size - size);
+    return true;
+}
+
+// value = mantissa * 10^exponent on the wire,
+// FixDecimal is mantissa / 10^scale
+bool SbeEncoder::put_decimal(int tag, const FixDecimal& value) {
+    const SbeField* field = message ? message->field(tag) : 0;
+    if (!field || field->kind != sbe_kind_decimal) return false;
+
+    int64_t mantissa = value.mantissa;
+    int exponent = -value.scale;
+
+    if (field->constant_exponent) {
+        if (!sbe_decimal_rescale(value, field->exponent, mantissa)) return false;
+        exponent = field->exponent;
+    } else if (exponent < -127 || exponent > 127) {
+        return false;
+    }
+
+    if (!sbe_int_fits(mantissa, field->mantissa_size)) return false;
+
+    char* at = block + field->offset;
+    sbe_store_le(at, static_cast<uint64_t>(mantissa), field->mantissa_size);
+    if (!field->constant_exponent) at[field->mantissa_size] = static_cast<char>(exponent);
+    return true;
+}
+
+bool SbeEncoder::put_text(int tag, const char* data, size_t size) {
+    const SbeField* field = message ? message->field(tag) : 0;
+    if (!field) return false;
+
+    switch (field->kind) {
+        case sbe_kind_int:
+        case sbe_kind_uint: {
+            int64_t value = 0;
+            return fix_int_parse(data, size, value) && put_int(tag, value);
+        }
+        case sbe_kind_char:
+            return size == 1 && put_char(tag, data[0]);
+        case sbe_kind_string:
+            return put_string(tag, data, size);
+        case sbe_kind_decimal: {
+            FixDecimal value;
+            return fix_decimal_parse(data, size, value) && put_decimal(tag, value);
+        }
+        case sbe_kind_timestamp: {
+            uint64_t nanos = 0;
+            return parse_utc_timestamp(data, size, nanos) && put_int(tag, static_cast<int64_t>(nanos));
+        }
+    }
+    return false;
+}
+
+bool SbeDecoder::wrap(const char* data, size_t size, const SbeSchema& schema) {
+    block = 0;
+    message = 0;
+    if (!data || size < sbe_header_size) return false;
+
+    const size_t block_length = static_cast<size_t>(sbe_load_le(data, 2));
+    const uint16_t template_id = static_cast<uint16_t>(sbe_load_le(data + 2, 2));
+    const uint16_t schema_id = static_cast<uint16_t>(sbe_load_le(data + 4, 2));
+    if (schema_id != schema.id() || size < sbe_header_size + block_length) return false;
+
+    const SbeMessageLayout* layout = schema.find_template(template_id);
+    if (!layout || block_length < layout->block_length) return false;
+
+    block = data + sbe_header_size;
+    message = layout;
+    return true;
+}
+
+bool SbeDecoder::is_null(const SbeField& field) const {
+    const char* at = block + field.offset;
+    switch (field.kind) {
+        case sbe_kind_int:
+            return field.optional && sbe_load_le_signed(at, field.size) == sbe_int_null(field.size);
+        case sbe_kind_uint:
+        case sbe_kind_timestamp:
+            return field.optional && sbe_load_le(at, field.size) == sbe_uint_null(field.size);
+        case sbe_kind_decimal:
+            return field.optional && sbe_load_le_signed(at, field.mantissa_size) == sbe_int_null(field.mantissa_size);
+        default:
+            return at[0] == '\0';
+    }
+}
+
+bool SbeDecoder::get_int(int tag, int64_t& value) const {
+    const SbeField* field = message ? message->field(tag) : 0;
+    if (!field || is_null(*field)) return false;
+
+    if (field->kind == sbe_kind_int) {
+        value = sbe_load_le_signed(block + field->offset, field->size);
+    } else if (field->kind == sbe_kind_uint || field->kind == sbe_kind_timestamp) {
+        value = static_cast<int64_t>(sbe_load_le(block + field->offset, field->size));
+    } else {
+        return false;
+    }
+    return true;
+}
+
+bool SbeDecoder::get_char(int tag, char& value) const {
+    const SbeField* field = message ? message->field(tag) : 0;
+    if (!field || field->kind != sbe_kind_char || is_null(*field)) return false;
+
+    value = block[field->offset];
+    return true;
+}
+
+bool SbeDecoder::get_string(int tag, const char*& data, size_t& size) const {
+    const SbeField* field = message ? message->field(tag) : 0;
+    if (!field || field->kind != sbe_kind_string || is_null(*field)) return false;
+
+    data = block + field->offset;
+    const void* nul = std::memchr(data, '\0', field->size);
+    size = nul ? static_cast<size_t>(static_cast<const char*>(nul) - data) : field->size;
+    return true;
+}
+
+bool SbeDecoder::get_decimal(int tag, FixDecimal& value) const {
+    const SbeField* field = message ? message->field(tag) : 0;
+    if (!field || field->kind != sbe_kind_decimal || is_null(*field)) return false;
+
+    const char* at = block + field->offset;
+    const int64_t mantissa = sbe_load_le_signed(at, field->mantissa_size);
+    const int exponent = field->constant_exponent ? field->exponent
+                                                  : static_cast<signed char>(at[field->mantissa_size]);
+    return sbe_decimal_value(mantissa, exponent, value);
+}
+
+void SbeDecoder::append_tag_value(std::string& out) const {
+    if (!message) return;
+
+    out.append("35=");
+    out.append(message->msg_type);
+    out.push_back('\x01');
+
+    char number[32];
+    for (size_t i = 0; i < message->fields.size(); ++i) {
+        const SbeField& field = message->fields[i];
+        if (is_null(field)) continue;
+
+        const size_t tag_size = fix_int_format(field.tag, number);
+        number[tag_size] = '=';
+
+        switch (field.kind) {
+            case sbe_kind_int:
+            case sbe_kind_uint: {
+                int64_t value = 0;
+                get_int(field.tag, value);
+                out.append(number, tag_size + 1);
+                out.append(number, fix_int_format(value, number));
+                break;
+            }
+            case sbe_kind_char:
+                out.append(number, tag_size + 1);
+                out.push_back(block[field.offset]);
+                break;
+            case sbe_kind_string: {
+                const char* data = 0;
+                size_t size = 0;
+                get_string(field.tag, data, size);
+                out.append(number, tag_size + 1);
+                out.append(data, size);
+                break;
+            }
+            case sbe_kind_timestamp: {
+                const std::string text = utils::format_utc_timestamp(sbe_load_le(block + field.offset, 8));
+                out.append(number, tag_size + 1);
+                out.append(text);
+                break;
+            }
+            case sbe_kind_decimal: {
+                FixDecimal value;
+                if (!get_decimal(field.tag, value)) continue;
+                out.append(number, tag_size + 1);
+                out.append(number, fix_decimal_format(value, number));
+                break;
+            }
+        }
+        out.push_back('\x01');
+    }
+}
+
+void SofhParser::append_bytes(const char* data, size_t size) {
+    if (data == 0 || size == 0) {
+        return;
+    }
+
+    buffer.append(data, size);
+}
+
+void SofhParser::append_bytes(const char* data, size_t size, const SocketTimestamp& stamp) {
+    if (data == 0 || size == 0) {
+        return;
+    }
+
+    buffer.append(data, size);
+    stamps.push_back(std::make_pair(stream_offset + buffer.size(), stamp));
+}
+
+void SofhParser::reset() {
+    discard(buffer.size());
+    failed = false;
+}
+
+void SofhParser::discard(size_t count) {
+    buffer.erase(0, count);
+    stream_offset += count;
+
+    while (!stamps.empty() && stamps.front().first <= stream_offset) {
+        stamps.pop_front();
+    }
+}
+
+bool SofhParser::read_next_frame(std::string& frame) {
+    SocketTimestamp stamp;
+    return read_next_frame(frame, stamp);
+}
+
+bool SofhParser::read_next_frame(std::string& frame, SocketTimestamp& stamp) {
+    frame.clear();
+    stamp = SocketTimestamp();
+
+    if (failed || buffer.size() < sofh_size) {
+        return false;
+    }
+
+    const size_t frame_size = static_cast<size_t>(load_be(buffer.data(), 4));
+    const uint16_t encoding = static_cast<uint16_t>(load_be(buffer.data() + 4, 2));
+    if (encoding != sofh_sbe_le || frame_size < sofh_size + sbe_header_size || frame_size > sofh_max_frame) {
+        failed = true;
+        return false;
+    }
+
+    if (buffer.size() < frame_size) {
+        return false;
+    }
+
+    frame.assign(buffer.data() + sofh_size, frame_size - sofh_size);
+
+    const size_t frame_end = stream_offset + frame_size;
+    for (size_t i = 0; i < stamps.size(); ++i) {
+        if (stamps[i].first >= frame_end) {
+            stamp = stamps[i].second;
+            break;
+        }
+    }
+
+    discard(frame_size);
+    return true;
+}
+
+// Carried by FIXP or rebuilt on
+// the way out, not in the block
+static bool is_session_tag(int tag) {
+    return tag == fix_tag_begin_string || tag == fix_tag_body_length || tag == fix_tag_check_sum ||
+           tag == fix_tag_msg_type || tag == fix_tag_msg_seq_num || tag == fix_tag_sender_comp_id ||
+           tag == fix_tag_target_comp_id || tag == fix_tag_sending_time;
+}
+
+bool sbe_encode_fields(const SbeSchema& schema,
+                       const FixMessage::FieldList& fields,
+                       char* out, size_t capacity, size_t& size,
+                       std::string& error) {
+    size = 0;
+
+    const SbeMessageLayout* layout = 0;
+    for (size_t i = 0; i < fields.size(); ++i) {
+        if (fields[i].first == fix_tag_msg_type) {
+            layout = schema.find_msg_type(fields[i].second);
+            if (!layout) {
+                error = "no SBE message for 35=" + fields[i].second;
+                return false;
+            }
+            break;
+        }
+    }
+    if (!layout) {
+        error = "no MsgType(35)";
+        return false;
+    }
+
+    SbeEncoder encoder;
+    if (!encoder.wrap(out, capacity, schema, *layout)) {
+        error = "buffer too small for " + layout->name;
+        return false;
+    }
+
+    for (size_t i = 0; i < fields.size(); ++i) {
+        const int tag = fields[i].first;
+        if (is_session_tag(tag)) continue;
+
+        const std::string& value = fields[i].second;
+        if (!encoder.put_text(tag, value.data(), value.size())) {
+            error = layout->field(tag) ? "bad value for tag " + std::to_string(tag)
+                                       : "tag " + std::to_string(tag) + " not in " + layout->name;
+            return false;
+        }
+    }
+
+    size = encoder.size();
+    return true;
+}
@@ -0,0 +1,261 @@
+#include "sbe_schema.h"
+#include "xml_reader.h"
+#include "utils.h"
+
+#include <cstdlib>
+#include <map>
+
+// Named entry of <types>
+struct SbeType {
+    SbeFieldKind kind;
+    size_t size;
+    bool optional;
+    size_t mantissa_size;
+    bool constant_exponent;
+    int exponent;
+
+    SbeType() : kind(sbe_kind_int), size(0), optional(false),
+                mantissa_size(8), constant_exponent(false), exponent(0) {}
+};
+
+// Returns False for float/double and unknown names
+static bool primitive_type(const std::string& primitive, size_t length, SbeType& type) {
+    if (primitive == "char") {
+        type.kind = (length > 1) ? sbe_kind_string : sbe_kind_char;
+        type.size = length;
+        return true;
+    }
+
+    static const char* const names[] = { "int8", "int16", "int32", "int64", "uint8", "uint16", "uint32", "uint64" };
+    static const size_t sizes[] = { 1, 2, 4, 8, 1, 2, 4, 8 };
+    for (size_t i = 0; i < 8; ++i) {
+        if (primitive == names[i]) {
+            if (length != 1) return false;
+            type.kind = (i < 4) ? sbe_kind_int : sbe_kind_uint;
+            type.size = sizes[i];
+            return true;
+        }
+    }
+    return false;
+}
+
+// semanticType="UTCTimestamp" on a uint64
+// type or field, carried as epoch nanos
+static bool make_timestamp(const XmlTag& tag, SbeType& type, std::string& error) {
+    if (tag.attr("semanticType") != "UTCTimestamp" || type.kind == sbe_kind_timestamp) return true;
+
+    if (type.kind != sbe_kind_uint || type.size != 8) {
+        error = tag.attr("name") + ": UTCTimestamp must be uint64 nanos";
+        return false;
+    }
+    type.kind = sbe_kind_timestamp;
+    return true;
+}
+
+static size_t length_attr(const XmlTag& tag) {
+    const std::string length = tag.attr("length");
+    return length.empty() ? 1 : static_cast<size_t>(std::atoi(length.c_str()));
+}
+
+// A composite is either the messageHeader (four
+// uint16) or a decimal: mantissa, exponent
+static bool finish_composite(const std::string& name, const std::vector<XmlTag>& members,
+                             const std::vector<std::string>& values,
+                             std::map<std::string, SbeType>& types, std::string& error) {
+    if (name == "messageHeader") {
+        static const char* const expected[] = { "blockLength", "templateId", "schemaId", "version" };
+        if (members.size() != 4) { error = "messageHeader must be blockLength, templateId, schemaId, version"; return false; }
+        for (size_t i = 0; i < 4; ++i) {
+            if (members[i].attr("name") != expected[i] || members[i].attr("primitiveType") != "uint16") {
+                error = "messageHeader must be blockLength, templateId, schemaId, version (uint16)";
+                return false;
+            }
+        }
+        return true;
+    }
+
+    if (members.size() != 2 || members[0].attr("name") != "mantissa" || members[1].attr("name") != "exponent") {
+        error = "composite " + name + ": only mantissa/exponent decimals are supported";
+        return false;
+    }
+
+    SbeType mantissa;
+    if (!primitive_type(members[0].attr("primitiveType"), 1, mantissa) || mantissa.kind != sbe_kind_int) {
+        error = "composite " + name + ": mantissa must be a signed integer";
+        return false;
+    }
+    if (members[1].attr("primitiveType") != "int8") {
+        error = "composite " + name + ": exponent must be int8";
+        return false;
+    }
+
+    SbeType type;
+    type.kind = sbe_kind_decimal;
+    type.mantissa_size = mantissa.size;
+    type.optional = members[0].attr("presence") == "optional";
+    type.constant_exponent = members[1].attr("presence") == "constant";
+    if (type.constant_exponent) {
+        type.exponent = std::atoi(utils::trim(values[1]).c_str());
+        type.size = mantissa.size;
+    } else {
+        type.size = mantissa.size + 1;
+    }
+
+    types[name] = type;
+    return true;
+}
+
+bool SbeSchema::load(const std::string& path, std::string& error) {
+    std::string text;
+    return xml_read_file(path, text, error) && load_text(text, error);
+}
+
+bool SbeSchema::load_text(const std::string& xml, std::string& error) {
+    layouts.clear();
+    std::map<std::string, SbeType> types;
+
+    std::string composite;              // open <composite>, empty if none
+    std::vector<XmlTag> members;
+    std::vector<std::string> member_values;
+    bool in_enum = false;
+    bool in_message = false;
+    size_t next_offset = 0;
+    bool explicit_block_length = false;
+
+    size_t pos = 0;
+    XmlTag tag;
+    while (xml_next_tag(xml, pos, tag, error)) {
+        const std::string& name = tag.name;
+
+        if (tag.closing) {
+            if (name == "composite") {
+                if (!finish_composite(composite, members, member_values, types, error)) return false;
+                composite.clear();
+            } else if (name == "type" && !composite.empty() && !member_values.empty()) {
+                member_values.back() = tag.text_before;
+            } else if (name == "enum" || name == "set") {
+                in_enum = false;
+            } else if (name == "message") {
+                SbeMessageLayout& layout = layouts.back();
+                if (!explicit_block_length) {
+                    layout.block_length = static_cast<uint16_t>(next_offset);
+                } else if (next_offset > layout.block_length) {
+                    error = "message " + layout.name + ": fields past blockLength";
+                    return false;
+                }
+                in_message = false;
+            }
+            continue;
+        }
+
+        if (name == "messageSchema") {
+            const std::string byte_order = tag.attr("byteOrder");
+            if (!byte_order.empty() && byte_order != "littleEndian") {
+                error = "only littleEndian schemas are supported";
+                return false;
+            }
+            schema_id = static_cast<uint16_t>(std::atoi(tag.attr("id").c_str()));
+            schema_version = static_cast<uint16_t>(std::atoi(tag.attr("version").c_str()));
+        } else if (name == "composite") {
+            composite = tag.attr("name");
+            members.clear();
+            member_values.clear();
+        } else if (name == "type" && !composite.empty()) {
+            members.push_back(tag);
+            member_values.push_back(std::string());
+        } else if (name == "type") {
+            SbeType type;
+            if (!primitive_type(tag.attr("primitiveType"), length_attr(tag), type)) {
+                error = "type " + tag.attr("name") + ": unsupported primitiveType";
+                return false;
+            }
+            type.optional = tag.attr("presence") == "optional";
+            if (!make_timestamp(tag, type, error)) return false;
+            types[tag.attr("name")] = type;
+        } else if ((name == "enum" || name == "set") && !in_enum) {
+            SbeType type;
+            if (!primitive_type(tag.attr("encodingType"), 1, type)) {
+                error = name + " " + tag.attr("name") + ": unsupported encodingType";
+                return false;
+            }
+            types[tag.attr("name")] = type;
+            in_enum = !tag.self_closing;
+        } else if (name == "message") {
+            SbeMessageLayout layout;
+            layout.name = tag.attr("name");
+            layout.msg_type = tag.attr("semanticType");
+            layout.template_id = static_cast<uint16_t>(std::atoi(tag.attr("id").c_str()));
+            explicit_block_length = !tag.attr("blockLength").empty();
+            layout.block_length = static_cast<uint16_t>(std::atoi(tag.attr("blockLength").c_str()));
+
+            if (find_template(layout.template_id)) {
+                error = "message " + layout.name + ": duplicate template id";
+                return false;
+            }
+            layouts.push_back(layout);
+            in_message = true;
+            next_offset = 0;
+        } else if (name == "group" || name == "data") {
+            error = "<" + name + "> is not supported, root block fields only";
+            return false;
+        } else if (name == "field" && in_message) {
+            const std::map<std::string, SbeType>::const_iterator it = types.find(tag.attr("type"));
+            SbeType type;
+            if (it != types.end()) {
+                type = it->second;
+            } else if (!primitive_type(tag.attr("type"), 1, type)) {
+                error = "field " + tag.attr("name") + ": unknown type " + tag.attr("type");
+                return false;
+            }
+
+            if (!make_timestamp(tag, type, error)) return false;
+
+            SbeField field;
+            field.name = tag.attr("name");
+            field.tag = std::atoi(tag.attr("id").c_str());
+            field.kind = type.kind;
+            field.size = type.size;
+            field.optional = type.optional || tag.attr("presence") == "optional";
+            field.mantissa_size = type.mantissa_size;
+            field.constant_exponent = type.constant_exponent;
+            field.exponent = type.exponent;
+            field.offset = tag.attr("offset").empty() ? next_offset
+                                                      : static_cast<size_t>(std::atoi(tag.attr("offset").c_str()));
+            if (field.tag <= 0) {
+                error = "field " + field.name + ": id must be the FIX tag";
+                return false;
+            }
+            next_offset = field.offset + field.size;
+
+            SbeMessageLayout& layout = layouts.back();
+            if (layout.by_tag.size() <= static_cast<size_t>(field.tag)) {
+                layout.by_tag.resize(static_cast<size_t>(field.tag) + 1, -1);
+            }
+            layout.by_tag[static_cast<size_t>(field.tag)] = static_cast<int>(layout.fields.size());
+            layout.fields.push_back(field);
+        }
+    }
+
+    if (!error.empty()) {
+        return false;
+    }
+    if (layouts.empty()) {
+        error = "no messages in schema";
+        return false;
+    }
+    return true;
+}
+
+const SbeMessageLayout* SbeSchema::find_template(uint16_t template_id) const {
+    for (size_t i = 0; i < layouts.size(); ++i) {
+        if (layouts[i].template_id == template_id) return &layouts[i];
+    }
+    return 0;
+}
+
+const SbeMessageLayout* SbeSchema::find_msg_type(const std::string& msg_type) const {
+    for (size_t i = 0; i < layouts.size(); ++i) {
+        if (layouts[i].msg_type == msg_type) return &layouts[i];
+    }
+    return 0;
+}
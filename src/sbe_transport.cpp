@@ -0,0 +1,232 @@
+#include "sbe_transport.h"
+#include "utils.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+// Largest SOFH frame send_bytes() writes
+const size_t sbe_send_capacity = 4096;
+
+SbeTransport::SbeTransport()
+    : wire(0), schema(0), inbound_seq(1), pending_offset(0) {}
+
+// Logon, Heartbeat, TestRequest, Logout
+static const char* const session_msg_types[] = { "A", "0", "1", "5" };
+
+bool SbeTransport::session_layouts(const SbeSchema& schema, std::string& error) {
+    for (size_t i = 0; i < sizeof(session_msg_types) / sizeof(session_msg_types[0]); ++i) {
+        if (!schema.find_msg_type(session_msg_types[i])) {
+            error = std::string("no SBE message for 35=") + session_msg_types[i] +
+                    ", the venue needs the session messages";
+            return false;
+        }
+    }
+    return true;
+}
+
+bool SbeTransport::connect(Transport& session_wire, const SbeSchema& session_schema,
+                           const SessionConfig& config) {
+    close();
+
+    std::string error;
+    if (!session_layouts(session_schema, error)) {
+        std::printf("Error: SBE session: %s\n", error.c_str());
+        return false;
+    }
+
+    venue.set_begin_string(config.begin_string);
+    venue.set_sender_comp_id(config.target_comp_id);
+    venue.set_target_comp_id(config.sender_comp_id);
+
+    wire = &session_wire;
+    schema = &session_schema;
+    encoded.reserve(sbe_send_capacity);
+    return true;
+}
+
+void SbeTransport::close() {
+    if (wire) {
+        wire->close();
+    }
+    wire = 0;
+    inbound_seq = 1;
+    frames.reset();
+    last_rx = SocketTimestamp();
+    pending.clear();
+    pending_offset = 0;
+}
+
+// One tag=value message from pos up to and
+// including its 10=, pos moved past it.
+// False on a field without '=' or SOH.
+static bool split_message(const std::string& data, size_t& pos, FixMessage::FieldList& fields) {
+    fields.clear();
+
+    while (pos < data.size()) {
+        const size_t equals = data.find('=', pos);
+        const size_t end = data.find('\x01', pos);
+        if (equals == std::string::npos || end == std::string::npos || equals > end) {
+            return false;
+        }
+
+        const int tag = std::atoi(data.c_str() + pos);
+        fields.push_back(FixMessage::Field(tag, data.substr(equals + 1, end - equals - 1)));
+        pos = end + 1;
+
+        if (tag == 10) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static const std::string* field_value(const FixMessage::FieldList& fields, int tag) {
+    for (size_t i = 0; i < fields.size(); ++i) {
+        if (fields[i].first == tag) return &fields[i].second;
+    }
+    return 0;
+}
+
+bool SbeTransport::send_bytes(const std::string& data) {
+    if (!wire || !schema) return false;
+
+    size_t pos = 0;
+    while (pos < data.size()) {
+        if (!split_message(data, pos, outbound)) {
+            std::printf("Error: SBE session: outbound message is not tag=value\n");
+            return false;
+        }
+
+        const std::string* msg_type = field_value(outbound, 35);
+        if (!msg_type) {
+            std::printf("Error: SBE session: outbound message has no MsgType(35)\n");
+            return false;
+        }
+
+        if ((*msg_type == "2" || *msg_type == "3" || *msg_type == "4") && !schema->find_msg_type(*msg_type)) {
+            std::printf("Warning: SBE session: 35=%s has no SBE message, not sent\n", msg_type->c_str());
+            continue;
+        }
+
+        if (!send_message(*msg_type)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool SbeTransport::send_message(const std::string& msg_type) {
+    encoded.resize(sbe_send_capacity);
+
+    size_t size = 0;
+    std::string error;
+    if (!sbe_encode_fields(*schema, outbound, &encoded[0], encoded.size(), size, error)) {
+        std::printf("Error: SBE session: 35=%s: %s\n", msg_type.c_str(), error.c_str());
+        return false;
+    }
+
+    encoded.resize(size);
+    return wire->send_bytes(encoded);
+}
+
+void SbeTransport::push_inbound(const std::string& message) {
+    if (pending_offset == pending.size()) {
+        pending.clear();
+        pending_offset = 0;
+    }
+    pending.append(message);
+}
+
+// Decoded block after a header rebuilt as the
+// venue's: 35 first, then 34/49/56/52
+void SbeTransport::render_frame(const SocketTimestamp& stamp) {
+    if (!decoder.wrap(frame.data(), frame.size(), *schema)) {
+        std::printf("Warning: SBE session: %zu byte frame not in schema %u, dropped\n",
+                    frame.size(), static_cast<unsigned>(schema->id()));
+        return;
+    }
+
+    rendered.clear();
+    decoder.append_tag_value(rendered);
+    const size_t type_end = rendered.find('\x01') + 1;
+
+    std::string body;
+    body.reserve(rendered.size() + 96);
+    body.append(rendered, 0, type_end);
+    body += "34=" + std::to_string(inbound_seq++) + "\x01";
+    body += "49=" + venue.get_sender_comp_id() + "\x01";
+    body += "56=" + venue.get_target_comp_id() + "\x01";
+    body += "52=" + utils::get_utc_timestamp() + "\x01";
+    body.append(rendered, type_end, std::string::npos);
+
+    unsigned int sum = 0;
+    std::string message = "8=" + venue.get_begin_string() + "\x01" "9=" + std::to_string(body.size()) + "\x01";
+    message += body;
+    for (size_t i = 0; i < message.size(); ++i) {
+        sum += static_cast<unsigned char>(message[i]);
+    }
+    char checksum[8];
+    std::snprintf(checksum, sizeof(checksum), "%03u", sum % 256);
+    message += "10=";
+    message += checksum;
+    message += '\x01';
+
+    push_inbound(message);
+    last_rx = stamp;
+}
+
+bool SbeTransport::set_receive_timeout(int timeout_millis) {
+    return wire != 0 && wire->set_receive_timeout(timeout_millis);
+}
+
+bool SbeTransport::wait_readable(int timeout_millis) {
+    if (!wire) return false;
+    if (pending_offset < pending.size()) return true;
+    return wire->wait_readable(timeout_millis);
+}
+
+// Locally answered messages and decoded frames
+// first, otherwise reads until a whole frame is
+// in. A partial frame waits like the wire does.
+int SbeTransport::receive_bytes(char* buf, size_t max_len) {
+    if (!wire || !buf || max_len == 0) {
+        return -1;
+    }
+
+    while (pending_offset == pending.size()) {
+        if (frames.framing_error()) {
+            std::printf("Error: SBE session: bad SOFH header from the venue\n");
+            errno = EPROTO;
+            return -1;
+        }
+
+        const int bytes_read = wire->receive_bytes(read_buffer, sizeof(read_buffer));
+        if (bytes_read <= 0) {
+            return bytes_read;
+        }
+
+        frames.append_bytes(read_buffer, static_cast<size_t>(bytes_read), wire->last_rx_timestamp());
+
+        SocketTimestamp stamp;
+        while (frames.read_next_frame(frame, stamp)) {
+            render_frame(stamp);
+        }
+    }
+
+    size_t count = pending.size() - pending_offset;
+    if (count > max_len) count = max_len;
+
+    std::memcpy(buf, pending.data() + pending_offset, count);
+    pending_offset += count;
+    return static_cast<int>(count);
+}
+
+bool SbeTransport::enable_timestamping(bool hardware) {
+    return wire != 0 && wire->enable_timestamping(hardware);
+}
+
+bool SbeTransport::read_tx_timestamp(uint32_t& tx_key, SocketTimestamp& stamp) {
+    return wire != 0 && wire->read_tx_timestamp(tx_key, stamp);
+}
@@ -0,0 +1,568 @@
+#include "scenario_compiler.h"
+#include "constants.h"
+#include "utils.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <thread>
+#include <atomic>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// Bump when the record layout changes,
+// older caches are then rebuilt
+const uint32_t cache_version = 2;
+const uint32_t flag_generator = 1;
+const char cache_magic[4] = { 'F', 'X', 'S', 'C' };
+
+// Header:
+//   magic[4] version:u32 format:u32 flags:u32
+//   source_size:u64 mtime_sec:i64 mtime_nsec:i64
+//   record_count:u64
+// Record:
+//   opcode:u8 pad:u8 field_count:u16 timeout_ms:i32
+//   text_len:u32 pool_len:u32
+//   field_count x { tag:i32 slot:u16 pad:u16 value_len:u32 }
+//   text bytes, pool bytes
+const size_t header_size = 48;
+const size_t record_head_size = 16;
+const size_t field_entry_size = 12;
+
+struct ScenarioHeader {
+    uint32_t version;
+    uint32_t format;
+    uint32_t flags;
+    uint64_t source_size;
+    int64_t mtime_sec;
+    int64_t mtime_nsec;
+    uint64_t record_count;
+};
+
+template <typename T>
+static void put(std::string& out, T value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+template <typename T>
+static T get(const char* in) {
+    T value;
+    std::memcpy(&value, in, sizeof(value));
+    return value;
+}
+
+static void write_header(std::string& out, const ScenarioHeader& header) {
+    out.append(cache_magic, sizeof(cache_magic));
+    put<uint32_t>(out, header.version);
+    put<uint32_t>(out, header.format);
+    put<uint32_t>(out, header.flags);
+    put<uint64_t>(out, header.source_size);
+    put<int64_t>(out, header.mtime_sec);
+    put<int64_t>(out, header.mtime_nsec);
+    put<uint64_t>(out, header.record_count);
+}
+
+static bool read_header(const char* in, size_t size, ScenarioHeader& header) {
+    if (size < header_size || std::memcmp(in, cache_magic, sizeof(cache_magic)) != 0) {
+        return false;
+    }
+
+    header.version = get<uint32_t>(in + 4);
+    header.format = get<uint32_t>(in + 8);
+    header.flags = get<uint32_t>(in + 12);
+    header.source_size = get<uint64_t>(in + 16);
+    header.mtime_sec = get<int64_t>(in + 24);
+    header.mtime_nsec = get<int64_t>(in + 32);
+    header.record_count = get<uint64_t>(in + 40);
+    return true;
+}
+
+static ScenarioHeader make_header(const struct stat& source, ScenarioFormat format) {
+    ScenarioHeader header;
+    header.version = cache_version;
+    header.format = static_cast<uint32_t>(format);
+    header.flags = 0;
+    header.source_size = static_cast<uint64_t>(source.st_size);
+    header.mtime_sec = static_cast<int64_t>(source.st_mtim.tv_sec);
+    header.mtime_nsec = static_cast<int64_t>(source.st_mtim.tv_nsec);
+    header.record_count = 0;
+    return header;
+}
+
+std::string scenario_cache_path(const std::string& source_path) {
+    const size_t slash = source_path.rfind('/');
+    if (slash == std::string::npos) {
+        return "." + source_path + ".fxc";
+    }
+    return source_path.substr(0, slash + 1) + "." + source_path.substr(slash + 1) + ".fxc";
+}
+
+static bool cache_is_fresh(const std::string& cache_path,
+                           const struct stat& source,
+                           ScenarioFormat format) {
+    const int fd = ::open(cache_path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+
+    char raw[header_size];
+    const ssize_t got = ::read(fd, raw, sizeof(raw));
+    ::close(fd);
+
+    ScenarioHeader header;
+    if (got != static_cast<ssize_t>(sizeof(raw)) || !read_header(raw, sizeof(raw), header)) {
+        return false;
+    }
+
+    const ScenarioHeader expected = make_header(source, format);
+    return header.version == expected.version &&
+           header.format == expected.format &&
+           header.source_size == expected.source_size &&
+           header.mtime_sec == expected.mtime_sec &&
+           header.mtime_nsec == expected.mtime_nsec;
+}
+
+// "clrN" -> N, "${ORG_CLRID}" -> placeholder,
+// other "${" -> generator variable
+static uint16_t value_slot(const std::string& value) {
+    if (value == "${ORG_CLRID}") {
+        return scenario_slot_org_clrid;
+    }
+
+    if (value.find("${") != std::string::npos) {
+        return scenario_slot_expand;
+    }
+
+    if (value.size() < 4 || value[0] != 'c' || value[1] != 'l' || value[2] != 'r') {
+        return scenario_slot_literal;
+    }
+
+    int n = 0;
+    for (size_t j = 3; j < value.size(); ++j) {
+        const char ch = value[j];
+        if (ch < '0' || ch > '9') return scenario_slot_literal;
+        n = (n * 10) + (ch - '0');
+        if (n > scenario_max_clr) return scenario_slot_literal;
+    }
+    return (n >= 1) ? static_cast<uint16_t>(n) : scenario_slot_literal;
+}
+
+// Regression payload, '|' or ',' delimited
+static void parse_regression_fields(const std::string& payload, FixMessage::FieldList& fields) {
+    fields.clear();
+
+    char delim = 0;
+    if (payload.find('|') != std::string::npos) delim = '|';
+    else if (payload.find(',') != std::string::npos) delim = ',';
+    else delim = 0;
+
+    size_t pos = 0;
+    while (pos <= payload.size()) {
+        size_t end = std::string::npos;
+        if (delim) end = payload.find(delim, pos);
+        if (end == std::string::npos) end = payload.size();
+
+        std::string token = payload.substr(pos, end - pos);
+        pos = (end < payload.size()) ? (end + 1) : (payload.size() + 1);
+
+        if (token.empty()) continue;
+
+        const size_t eq = token.find('=');
+        if (eq == std::string::npos || eq == 0) continue;
+
+        const int tag = std::atoi(utils::trim(token.substr(0, eq)).c_str());
+        if (tag <= 0) continue;
+
+        fields.push_back(std::make_pair(tag, token.substr(eq + 1)));
+    }
+}
+
+// RAW scenario line, '|' delimited
+static void parse_raw_fields(const std::string& line, FixMessage::FieldList& fields) {
+    fields.clear();
+
+    size_t pos = 0;
+    while (pos < line.size()) {
+        size_t end = line.find('|', pos);
+        if (end == std::string::npos) {
+            end = line.size();
+        }
+
+        const std::string field_text = line.substr(pos, end - pos);
+        pos = (end < line.size()) ? (end + 1) : end;
+
+        if (field_text.empty()) {
+            continue;
+        }
+
+        const size_t eq = field_text.find('=');
+        if (eq == std::string::npos) {
+            continue;
+        }
+
+        const int tag_value = std::atoi(field_text.substr(0, eq).c_str());
+        if (tag_value <= 0) {
+            continue;
+        }
+
+        fields.push_back(std::make_pair(tag_value, field_text.substr(eq + 1)));
+    }
+}
+
+static void write_record(std::string& out,
+                         int opcode,
+                         int timeout_ms,
+                         const std::string& text,
+                         const FixMessage::FieldList& fields) {
+    size_t pool_len = 0;
+    for (size_t i = 0; i < fields.size(); ++i) {
+        pool_len += fields[i].second.size();
+    }
+
+    put<uint8_t>(out, static_cast<uint8_t>(opcode));
+    put<uint8_t>(out, 0);
+    put<uint16_t>(out, static_cast<uint16_t>(fields.size()));
+    put<int32_t>(out, timeout_ms);
+    put<uint32_t>(out, static_cast<uint32_t>(text.size()));
+    put<uint32_t>(out, static_cast<uint32_t>(pool_len));
+
+    for (size_t i = 0; i < fields.size(); ++i) {
+        put<int32_t>(out, fields[i].first);
+        put<uint16_t>(out, value_slot(fields[i].second));
+        put<uint16_t>(out, 0);
+        put<uint32_t>(out, static_cast<uint32_t>(fields[i].second.size()));
+    }
+
+    out.append(text);
+    for (size_t i = 0; i < fields.size(); ++i) {
+        out.append(fields[i].second);
+    }
+}
+
+// CMD | col | payload -> opcode,
+// -1 for a line that isn't a step
+static int regression_line(const std::string& line,
+                           int& timeout_ms,
+                           std::string& payload) {
+    const size_t first_bar = line.find('|');
+    if (first_bar == std::string::npos) {
+        return -1;
+    }
+
+    std::string cmd = utils::trim(line.substr(0, first_bar));
+    while (!cmd.empty()) {
+        const unsigned char c = static_cast<unsigned char>(cmd[0]);
+        if ((c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z')) break;
+        cmd.erase(0, 1);
+    }
+
+    while (!cmd.empty()) {
+        const unsigned char c = static_cast<unsigned char>(cmd[cmd.size() - 1]);
+        if ((c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z')) break;
+        cmd.erase(cmd.size() - 1, 1);
+    }
+
+    for (size_t i = 0; i < cmd.size(); ++i) {
+        const unsigned char c = static_cast<unsigned char>(cmd[i]);
+        if (c >= 'a' && c <= 'z') cmd[i] = static_cast<char>(c - ('a' - 'A'));
+    }
+
+    int opcode = -1;
+    if (cmd == "BGN") opcode = scenario_op_bgn;
+    else if (cmd == "SND") opcode = scenario_op_snd;
+    else if (cmd == "TST") opcode = scenario_op_tst;
+    else if (cmd == "RCV") opcode = scenario_op_rcv;
+    else if (cmd == "END") opcode = scenario_op_end;
+    else return -1;
+
+    const size_t second_bar = line.find('|', first_bar + 1);
+    payload = (second_bar == std::string::npos)
+        ? utils::trim(line.substr(first_bar + 1))
+        : utils::trim(line.substr(second_bar + 1));
+
+    // Optional "timeout=<ms>" in the
+    // middle column
+    timeout_ms = 0;
+    if (second_bar != std::string::npos) {
+        const std::string column = line.substr(first_bar + 1, second_bar - first_bar - 1);
+        const size_t pos = column.find("timeout=");
+        if (pos != std::string::npos) {
+            const int value = std::atoi(column.c_str() + pos + 8);
+            if (value > 0) timeout_ms = value;
+        }
+    }
+
+    return opcode;
+}
+
+static bool compile_source(const std::string& source_path,
+                           const struct stat& source,
+                           ScenarioFormat format,
+                           std::string& out) {
+    std::ifstream in(source_path.c_str());
+    if (!in.is_open()) {
+        return false;
+    }
+
+    ScenarioHeader header = make_header(source, format);
+
+    out.clear();
+    write_header(out, header);
+
+    FixMessage::FieldList fields;
+    std::string payload;
+    std::string line;
+    while (std::getline(in, line)) {
+        line = utils::trim(line);
+        if (line.empty() || line[0] == '#') continue;
+
+        if (format == scenario_format_raw) {
+            if (line[0] == '@') {
+                fields.clear();
+                write_record(out, scenario_op_directive, 0, utils::trim(line.substr(1)), fields);
+                header.flags |= flag_generator;
+                header.record_count++;
+                continue;
+            }
+
+            parse_raw_fields(line, fields);
+            if (fields.empty()) continue;
+
+            write_record(out, scenario_op_raw, 0, std::string(), fields);
+            header.record_count++;
+            continue;
+        }
+
+        if (line.size() >= 2 && line[0] == '/' && line[1] == '/') continue;
+
+        int timeout_ms = 0;
+        const int opcode = regression_line(line, timeout_ms, payload);
+        if (opcode < 0) continue;
+
+        fields.clear();
+        if (opcode == scenario_op_bgn || opcode == scenario_op_end) {
+            write_record(out, opcode, timeout_ms, payload, fields);
+        } else {
+            parse_regression_fields(payload, fields);
+            write_record(out, opcode, timeout_ms, std::string(), fields);
+        }
+        header.record_count++;
+    }
+
+    std::memcpy(&out[12], &header.flags, sizeof(header.flags));
+    std::memcpy(&out[40], &header.record_count, sizeof(header.record_count));
+    return true;
+}
+
+// Write-then-rename so readers (and
+// other shards) never see half a file
+static bool write_cache(const std::string& cache_path, const std::string& data) {
+    char suffix[32];
+    std::snprintf(suffix, sizeof(suffix), ".%d.tmp", static_cast<int>(::getpid()));
+    const std::string tmp_path = cache_path + suffix;
+
+    FILE* out = std::fopen(tmp_path.c_str(), "wb");
+    if (!out) {
+        return false;
+    }
+
+    const bool written = std::fwrite(data.data(), 1, data.size(), out) == data.size();
+    const bool closed = std::fclose(out) == 0;
+    if (!written || !closed || std::rename(tmp_path.c_str(), cache_path.c_str()) != 0) {
+        ::unlink(tmp_path.c_str());
+        return false;
+    }
+    return true;
+}
+
+// Returns False when the source can't be read.
+// A cache that can't be written is left in
+// compiled_out for the caller.
+static bool ensure_compiled(const std::string& source_path,
+                            ScenarioFormat format,
+                            bool& cached,
+                            std::string& compiled_out) {
+    struct stat source;
+    if (::stat(source_path.c_str(), &source) != 0) {
+        return false;
+    }
+
+    const std::string cache_path = scenario_cache_path(source_path);
+    if (cache_is_fresh(cache_path, source, format)) {
+        cached = true;
+        return true;
+    }
+
+    if (!compile_source(source_path, source, format, compiled_out)) {
+        return false;
+    }
+
+    cached = write_cache(cache_path, compiled_out);
+    if (cached) {
+        std::string().swap(compiled_out);
+    }
+    return true;
+}
+
+void precompile_scenarios(const std::vector<std::string>& files, ScenarioFormat format) {
+    std::vector<const std::string*> stale;
+    for (size_t i = 0; i < files.size(); ++i) {
+        struct stat source;
+        if (::stat(files[i].c_str(), &source) != 0) continue;
+        if (!cache_is_fresh(scenario_cache_path(files[i]), source, format)) {
+            stale.push_back(&files[i]);
+        }
+    }
+
+    if (stale.empty()) {
+        return;
+    }
+
+    size_t worker_count = std::thread::hardware_concurrency();
+    if (worker_count == 0) worker_count = 1;
+    if (worker_count > stale.size()) worker_count = stale.size();
+
+    std::atomic<size_t> next_file(0);
+    std::vector<std::thread> workers;
+
+    // Worker 0 is this thread
+    for (size_t w = 1; w < worker_count; ++w) {
+        workers.push_back(std::thread([&stale, &next_file, format]() {
+            std::string compiled;
+            for (size_t i = next_file++; i < stale.size(); i = next_file++) {
+                bool cached = false;
+                ensure_compiled(*stale[i], format, cached, compiled);
+            }
+        }));
+    }
+
+    std::string compiled;
+    for (size_t i = next_file++; i < stale.size(); i = next_file++) {
+        bool cached = false;
+        ensure_compiled(*stale[i], format, cached, compiled);
+    }
+
+    for (size_t w = 0; w < workers.size(); ++w) {
+        workers[w].join();
+    }
+}
+
+ScenarioReader::ScenarioReader()
+    : data(0), size(0), offset(0), records(0), generator(false), is_mapped(false) {}
+
+ScenarioReader::~ScenarioReader() {
+    close();
+}
+
+void ScenarioReader::close() {
+    if (is_mapped && data) {
+        ::munmap(const_cast<char*>(data), size);
+    }
+
+    data = 0;
+    size = 0;
+    offset = 0;
+    records = 0;
+    generator = false;
+    is_mapped = false;
+    std::string().swap(buffer);
+}
+
+bool ScenarioReader::open(const std::string& source_path, ScenarioFormat format) {
+    close();
+
+    bool cached = false;
+    if (!ensure_compiled(source_path, format, cached, buffer)) {
+        return false;
+    }
+
+    if (cached) {
+        const int fd = ::open(scenario_cache_path(source_path).c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            return false;
+        }
+
+        struct stat cache_stat;
+        if (::fstat(fd, &cache_stat) != 0 || cache_stat.st_size < static_cast<off_t>(header_size)) {
+            ::close(fd);
+            return false;
+        }
+
+        void* mapped = ::mmap(0, static_cast<size_t>(cache_stat.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (mapped == MAP_FAILED) {
+            return false;
+        }
+
+        data = static_cast<const char*>(mapped);
+        size = static_cast<size_t>(cache_stat.st_size);
+        is_mapped = true;
+        ::madvise(mapped, size, MADV_SEQUENTIAL);
+    } else {
+        data = buffer.data();
+        size = buffer.size();
+    }
+
+    ScenarioHeader header;
+    if (!read_header(data, size, header) || header.version != cache_version) {
+        close();
+        return false;
+    }
+
+    records = header.record_count;
+    generator = (header.flags & flag_generator) != 0;
+    offset = header_size;
+    return true;
+}
+
+bool ScenarioReader::next(ScenarioRecord& record) {
+    if (!data || offset + record_head_size > size) {
+        return false;
+    }
+
+    const char* in = data + offset;
+    const size_t field_count = get<uint16_t>(in + 2);
+    const size_t text_len = get<uint32_t>(in + 8);
+    const size_t pool_len = get<uint32_t>(in + 12);
+
+    const size_t record_size = record_head_size + field_count * field_entry_size + text_len + pool_len;
+    if (offset + record_size > size) {
+        return false;
+    }
+
+    record.opcode = get<uint8_t>(in);
+    record.timeout_ms = get<int32_t>(in + 4);
+
+    const char* entries = in + record_head_size;
+    const char* text = entries + field_count * field_entry_size;
+    const char* pool = text + text_len;
+
+    record.text.assign(text, text_len);
+    record.msg_type.clear();
+    record.fields.resize(field_count);
+    record.slots.resize(field_count);
+
+    size_t pool_pos = 0;
+    for (size_t i = 0; i < field_count; ++i) {
+        const char* entry = entries + i * field_entry_size;
+        const size_t value_len = get<uint32_t>(entry + 8);
+        if (pool_pos + value_len > pool_len) {
+            return false;
+        }
+
+        record.fields[i].first = get<int32_t>(entry);
+        record.fields[i].second.assign(pool + pool_pos, value_len);
+        record.slots[i] = get<uint16_t>(entry + 4);
+        pool_pos += value_len;
+
+        if (record.fields[i].first == fix_tag_msg_type && record.msg_type.empty()) {
+            record.msg_type = record.fields[i].second;
+        }
+    }
+
+    offset += record_size;
+    return true;
+}
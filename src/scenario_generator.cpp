@@ -0,0 +1,433 @@
+#include "scenario_generator.h"
+#include "constants.h"
+#include "utils.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+
+ScenarioGenerator::ScenarioGenerator()
+    : pc(0), serial(0), iterations(0), rng(1) {}
+
+void ScenarioGenerator::close() {
+    reader.close();
+    program.clear();
+    variables.clear();
+    variable_index.clear();
+    frames.clear();
+    pc = 0;
+    serial = 0;
+    iterations = 0;
+    rng.seed(1);
+}
+
+bool ScenarioGenerator::open(const std::string& source_path) {
+    close();
+    path = source_path;
+
+    if (!reader.open(source_path, scenario_format_raw)) {
+        return false;
+    }
+
+    if (reader.is_generator() && !load_program()) {
+        reader.close();
+        return false;
+    }
+    return true;
+}
+
+bool ScenarioGenerator::fail(const std::string& text, const char* reason) {
+    std::printf("Error: %s: @%s: %s\n", path.c_str(), text.c_str(), reason);
+    return false;
+}
+
+int ScenarioGenerator::find_or_add_variable(const std::string& name) {
+    std::map<std::string, int>::iterator found = variable_index.find(name);
+    if (found != variable_index.end()) {
+        return found->second;
+    }
+
+    Variable variable;
+    variable.kind = variable_constant;
+    variable.cursor = 0;
+    variable.drawn_at = 0;
+    variables.push_back(variable);
+
+    const int index = static_cast<int>(variables.size() - 1);
+    variable_index[name] = index;
+    return index;
+}
+
+// "a,b,c" -> items
+static void split_args(const std::string& text, std::vector<std::string>& items) {
+    items.clear();
+
+    size_t pos = 0;
+    while (pos <= text.size()) {
+        size_t end = text.find(',', pos);
+        if (end == std::string::npos) end = text.size();
+
+        items.push_back(utils::trim(text.substr(pos, end - pos)));
+        pos = end + 1;
+    }
+}
+
+// Brings both to the finer scale,
+// False on overflow
+static bool align_scale(FixDecimal& lhs, FixDecimal& rhs) {
+    FixDecimal* coarse = (lhs.scale < rhs.scale) ? &lhs : &rhs;
+    const int target = (lhs.scale < rhs.scale) ? rhs.scale : lhs.scale;
+
+    while (coarse->scale < target) {
+        if (coarse->mantissa > INT64_MAX / 10 || coarse->mantissa < INT64_MIN / 10) return false;
+        coarse->mantissa *= 10;
+        coarse->scale++;
+    }
+    return true;
+}
+
+bool ScenarioGenerator::parse_variable(const std::string& name, const std::string& expr) {
+    Variable& variable = variables[find_or_add_variable(name)];
+    variable.cursor = 0;
+    variable.drawn_at = 0;
+
+    const size_t open_paren = expr.find('(');
+    const bool is_call = open_paren != std::string::npos &&
+                         !expr.empty() && expr[expr.size() - 1] == ')';
+    if (!is_call) {
+        variable.kind = variable_constant;
+        variable.value = expr;
+        return true;
+    }
+
+    const std::string function = utils::trim(expr.substr(0, open_paren));
+    std::vector<std::string> args;
+    split_args(expr.substr(open_paren + 1, expr.size() - open_paren - 2), args);
+
+    if (function == "list" || function == "choice") {
+        variable.kind = (function == "list") ? variable_list : variable_choice;
+        variable.items = args;
+        return !args.empty() && !(args.size() == 1 && args[0].empty());
+    }
+
+    if (function == "range") {
+        variable.kind = variable_range;
+        if (args.size() < 2 || args.size() > 3 ||
+            !fix_decimal_parse(args[0], variable.low) ||
+            !fix_decimal_parse(args[1], variable.high)) {
+            return false;
+        }
+
+        variable.step = FixDecimal(1, 0);
+        if (args.size() == 3 && !fix_decimal_parse(args[2], variable.step)) {
+            return false;
+        }
+
+        variable.current = variable.low;
+        return variable.step.mantissa > 0 && fix_decimal_compare(variable.low, variable.high) <= 0;
+    }
+
+    if (function == "uniform") {
+        variable.kind = variable_uniform;
+        if (args.size() != 2 ||
+            !fix_decimal_parse(args[0], variable.low) ||
+            !fix_decimal_parse(args[1], variable.high)) {
+            return false;
+        }
+
+        // Draws integer mantissas at the
+        // finer scale of the two bounds
+        return align_scale(variable.low, variable.high) &&
+               variable.low.mantissa <= variable.high.mantissa;
+    }
+
+    return false;
+}
+
+bool ScenarioGenerator::parse_directive(const std::string& text, std::vector<size_t>& open_repeats) {
+    const size_t space = text.find(' ');
+    const std::string keyword = text.substr(0, space);
+    const std::string rest = (space == std::string::npos) ? std::string() : utils::trim(text.substr(space + 1));
+
+    if (keyword == "seed") {
+        rng.seed(std::strtoull(rest.c_str(), 0, 10));
+        return true;
+    }
+
+    if (keyword == "var") {
+        const size_t eq = rest.find('=');
+        if (eq == std::string::npos) {
+            return fail(text, "expected NAME = value");
+        }
+
+        const std::string name = utils::trim(rest.substr(0, eq));
+        if (name.empty() || !parse_variable(name, utils::trim(rest.substr(eq + 1)))) {
+            return fail(text, "bad variable");
+        }
+        return true;
+    }
+
+    if (keyword == "repeat") {
+        char* end = 0;
+        const unsigned long long count = std::strtoull(rest.c_str(), &end, 10);
+        if (end == rest.c_str()) {
+            return fail(text, "expected a count");
+        }
+
+        Op op;
+        op.kind = op_repeat;
+        op.count = count;
+        op.variable = -1;
+        op.match = 0;
+
+        const std::string name = utils::trim(std::string(end));
+        if (!name.empty()) {
+            op.variable = find_or_add_variable(name);
+            variables[op.variable].kind = variable_loop;
+        }
+
+        open_repeats.push_back(program.size());
+        program.push_back(op);
+        return true;
+    }
+
+    if (keyword == "end") {
+        if (open_repeats.empty()) {
+            return fail(text, "no matching @repeat");
+        }
+
+        Op op;
+        op.kind = op_end;
+        op.count = 0;
+        op.variable = -1;
+        op.match = open_repeats.back();
+
+        program[open_repeats.back()].match = program.size();
+        open_repeats.pop_back();
+        program.push_back(op);
+        return true;
+    }
+
+    return fail(text, "unknown directive");
+}
+
+// Splits ${NAME} references of known
+// variables out of the field values
+bool ScenarioGenerator::compile_message(ScenarioRecord& message, Op& op) {
+    op.kind = op_message;
+    op.count = 0;
+    op.variable = -1;
+    op.match = 0;
+    op.msg_type.swap(message.msg_type);
+    op.fields.swap(message.fields);
+
+    for (size_t i = 0; i < op.fields.size(); ++i) {
+        if (message.slots[i] != scenario_slot_expand) continue;
+
+        const std::string& value = op.fields[i].second;
+        Expansion expansion;
+        expansion.field = i;
+
+        bool has_variable = false;
+        size_t pos = 0;
+        while (pos < value.size()) {
+            const size_t open_ref = value.find("${", pos);
+            const size_t close_ref = (open_ref == std::string::npos) ? std::string::npos : value.find('}', open_ref);
+
+            std::map<std::string, int>::const_iterator found = variable_index.end();
+            if (close_ref != std::string::npos) {
+                found = variable_index.find(value.substr(open_ref + 2, close_ref - open_ref - 2));
+            }
+
+            // Unknown names (${ORG_CLRID}) stay literal
+            const size_t literal_end = (found != variable_index.end()) ? open_ref
+                                     : (close_ref != std::string::npos) ? close_ref + 1
+                                     : value.size();
+
+            if (literal_end > pos) {
+                Part part;
+                part.text = value.substr(pos, literal_end - pos);
+                part.variable = -1;
+                expansion.parts.push_back(part);
+            }
+
+            if (found != variable_index.end()) {
+                Part part;
+                part.variable = found->second;
+                expansion.parts.push_back(part);
+                has_variable = true;
+                pos = close_ref + 1;
+            } else {
+                pos = literal_end;
+            }
+        }
+
+        if (has_variable) {
+            op.expansions.push_back(expansion);
+        }
+    }
+    return true;
+}
+
+// Variables first, so messages anywhere in
+// the file can reference them
+bool ScenarioGenerator::load_program() {
+    std::vector<ScenarioRecord> records;
+    while (reader.next(record)) {
+        if (record.opcode == scenario_op_directive) {
+            const std::string& text = record.text;
+            if (text.compare(0, 4, "var ") == 0 || text.compare(0, 5, "seed ") == 0) {
+                std::vector<size_t> unused;
+                if (!parse_directive(text, unused)) return false;
+                continue;
+            }
+        }
+        records.push_back(record);
+    }
+
+    std::vector<size_t> open_repeats;
+    for (size_t i = 0; i < records.size(); ++i) {
+        if (records[i].opcode == scenario_op_directive) {
+            if (!parse_directive(records[i].text, open_repeats)) return false;
+            continue;
+        }
+
+        Op op;
+        compile_message(records[i], op);
+        program.push_back(op);
+    }
+
+    if (!open_repeats.empty()) {
+        return fail("repeat", "missing @end");
+    }
+
+    pc = 0;
+    return true;
+}
+
+const std::string& ScenarioGenerator::draw(int index) {
+    Variable& variable = variables[index];
+    if (variable.drawn_at == serial) {
+        return variable.value;
+    }
+    variable.drawn_at = serial;
+
+    switch (variable.kind) {
+        case variable_list:
+            variable.value = variable.items[variable.cursor];
+            variable.cursor = (variable.cursor + 1) % variable.items.size();
+            break;
+
+        case variable_choice:
+            variable.value = variable.items[rng() % variable.items.size()];
+            break;
+
+        case variable_range: {
+            variable.value = fix_decimal_to_string(variable.current);
+
+            FixDecimal next_value;
+            if (!fix_decimal_add(variable.current, variable.step, next_value) ||
+                fix_decimal_compare(next_value, variable.high) > 0) {
+                next_value = variable.low;
+            }
+            variable.current = next_value;
+            break;
+        }
+
+        case variable_uniform: {
+            const uint64_t span = static_cast<uint64_t>(variable.high.mantissa - variable.low.mantissa);
+            const uint64_t offset = (span == UINT64_MAX) ? rng() : rng() % (span + 1);
+
+            FixDecimal drawn(variable.low.mantissa + static_cast<int64_t>(offset), variable.low.scale);
+            fix_decimal_normalize(drawn);
+            variable.value = fix_decimal_to_string(drawn);
+            break;
+        }
+
+        case variable_constant:
+        case variable_loop:
+            break;
+    }
+    return variable.value;
+}
+
+void ScenarioGenerator::set_loop_value(const Frame& frame) {
+    iterations++;
+    serial++;
+    if (frame.variable < 0) return;
+
+    char buf[24];
+    std::snprintf(buf, sizeof(buf), "%llu", static_cast<unsigned long long>(frame.index));
+    variables[frame.variable].value = buf;
+}
+
+bool ScenarioGenerator::next(std::string& msg_type, FixMessage::FieldList& fields) {
+    if (!reader.is_generator()) {
+        if (!reader.next(record)) {
+            return false;
+        }
+        msg_type.swap(record.msg_type);
+        fields.swap(record.fields);
+        return true;
+    }
+
+    while (pc < program.size()) {
+        const Op& op = program[pc];
+
+        if (op.kind == op_repeat) {
+            if (op.count == 0) {
+                pc = op.match + 1;
+                continue;
+            }
+
+            Frame frame;
+            frame.start = pc + 1;
+            frame.count = op.count;
+            frame.index = 1;
+            frame.variable = op.variable;
+            frames.push_back(frame);
+            set_loop_value(frame);
+            pc++;
+            continue;
+        }
+
+        if (op.kind == op_end) {
+            Frame& frame = frames.back();
+            if (frame.index < frame.count) {
+                frame.index++;
+                set_loop_value(frame);
+                pc = frame.start;
+            } else {
+                frames.pop_back();
+                pc++;
+            }
+            continue;
+        }
+
+        if (frames.empty()) {
+            serial++;
+        }
+        msg_type = op.msg_type;
+        fields = op.fields;
+
+        for (size_t e = 0; e < op.expansions.size(); ++e) {
+            const Expansion& expansion = op.expansions[e];
+            std::string& value = fields[expansion.field].second;
+
+            value.clear();
+            for (size_t p = 0; p < expansion.parts.size(); ++p) {
+                const Part& part = expansion.parts[p];
+                value.append(part.variable >= 0 ? draw(part.variable) : part.text);
+            }
+
+            if (fields[expansion.field].first == fix_tag_msg_type) {
+                msg_type = value;
+            }
+        }
+
+        pc++;
+        return true;
+    }
+
+    return false;
+}
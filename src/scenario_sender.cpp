@@ -0,0 +1,223 @@
+#include "scenario_sender.h"
+#include "constants.h"
+#include "utils.h"
+
+#include <cstdlib>
+#include <algorithm>
+#include <dirent.h>
+
+ScenarioSender::ScenarioSender(const SessionConfig& config,
+                               IdGenerator& id_generator)
+    : ids(id_generator),
+      max_in_flight(config.max_in_flight > 0 ? static_cast<size_t>(config.max_in_flight) : 1),
+      file_index(0),
+      generator_iteration(0),
+      has_pending(false),
+      exhausted(false),
+      unsent_keyless(0),
+      sent(0),
+      acked(0),
+      progress_ms(0) {
+
+    runtime.begin_string = config.begin_string;
+    runtime.sender_comp_id = config.sender_comp_id;
+    runtime.target_comp_id = config.target_comp_id;
+    runtime.msg_seq_num = 0;
+    runtime.id_generator = &ids;
+    runtime.instruments = 0;
+}
+
+void ScenarioSender::open(const std::string& scenario_path) {
+    files.clear();
+    file_index = 0;
+    has_pending = false;
+    exhausted = false;
+    generator.close();
+
+    DIR* dir = ::opendir(scenario_path.c_str());
+    if (dir) {
+        dirent* entry = 0;
+        while ((entry = ::readdir(dir)) != 0) {
+            const std::string name(entry->d_name);
+            if (name == "." || name == "..") {
+                continue;
+            }
+
+            // Ignore hidden files and folder
+            if (!name.empty() && name[0] == '.') {
+                continue;
+            }
+
+            files.push_back(scenario_path + "/" + name);
+        }
+
+        ::closedir(dir);
+        std::sort(files.begin(), files.end());
+    } else {
+        files.push_back(scenario_path);
+    }
+
+    precompile_scenarios(files, scenario_format_raw);
+
+    progress_ms = utils::get_monotonic_millis();
+}
+
+bool ScenarioSender::load_next() {
+    while (true) {
+        if (!generator.is_open()) {
+            if (file_index >= files.size()) {
+                return false;
+            }
+
+            if (!generator.open(files[file_index++])) {
+                continue;
+            }
+
+            // ${ORG_CLRID} is per file
+            runtime.state.org_clord_id.clear();
+            generator_iteration = generator.iteration();
+        }
+
+        if (!generator.next(pending.msg_type, pending.fields)) {
+            generator.close();
+            continue;
+        }
+
+        // ... and per @repeat iteration
+        if (generator.iteration() != generator_iteration) {
+            runtime.state.org_clord_id.clear();
+            generator_iteration = generator.iteration();
+        }
+        return true;
+    }
+}
+
+bool ScenarioSender::can_send() {
+    if (!window_open()) {
+        return false;
+    }
+
+    if (!has_pending && !exhausted) {
+        has_pending = load_next();
+        exhausted = !has_pending;
+    }
+    return has_pending;
+}
+
+// CrossID wins for cross orders, the
+// ExecutionReports of both sides carry it
+std::string ScenarioSender::order_key(const FixMessage::FieldList& fields) {
+    std::string key;
+    for (size_t i = 0; i < fields.size(); ++i) {
+        if (fields[i].first == fix_tag_cross_id) {
+            return fields[i].second;
+        }
+        if (fields[i].first == fix_tag_clord_id && key.empty()) {
+            key = fields[i].second;
+        }
+    }
+    return key;
+}
+
+bool ScenarioSender::next_message(FixTemplateMessage& message) {
+    if (!has_pending && (exhausted || !(has_pending = load_next()))) {
+        exhausted = true;
+        return false;
+    }
+    has_pending = false;
+
+    runtime.msg_seq_num = 0;
+    runtime.sending_time_utc = utils::get_utc_timestamp();
+
+    if (!fix_template_apply(runtime, pending)) {
+        return false;
+    }
+    message = pending;
+
+    const std::string key = order_key(message.fields);
+    if (!key.empty()) {
+        outstanding[key] = 0;
+    } else {
+        unsent_keyless++;
+    }
+
+    sent++;
+    progress_ms = utils::get_monotonic_millis();
+    return true;
+}
+
+void ScenarioSender::on_sent(const FixMessage::FieldList& fields, int msg_seq_num) {
+    const std::string key = order_key(fields);
+    if (key.empty()) {
+        if (unsent_keyless > 0) unsent_keyless--;
+        progress_ms = utils::get_monotonic_millis();
+        return;
+    }
+
+    std::map<std::string, int>::iterator found = outstanding.find(key);
+    if (found == outstanding.end()) {
+        return;
+    }
+
+    found->second = msg_seq_num;
+    outstanding_seq[msg_seq_num] = key;
+    progress_ms = utils::get_monotonic_millis();
+}
+
+void ScenarioSender::ack(const std::string& key) {
+    std::map<std::string, int>::iterator found = outstanding.find(key);
+    if (found == outstanding.end()) {
+        return;
+    }
+
+    if (found->second != 0) {
+        outstanding_seq.erase(found->second);
+    }
+    outstanding.erase(found);
+    acked++;
+    progress_ms = utils::get_monotonic_millis();
+}
+
+bool ScenarioSender::on_inbound(const std::string& inbound_message) {
+    if (outstanding.empty()) {
+        return false;
+    }
+
+    std::string msg_type;
+    if (!utils::find_tag_value(inbound_message, "35=", msg_type)) {
+        return false;
+    }
+
+    const size_t before = acked;
+
+    // ExecutionReport / OrderCancelReject
+    if (msg_type == "8" || msg_type == "9") {
+        std::string key;
+        if (utils::find_tag_value(inbound_message, "548=", key)) {
+            ack(key);
+        }
+        if (utils::find_tag_value(inbound_message, "11=", key)) {
+            ack(key);
+        }
+    }
+
+    // Session/BusinessMessage Reject,
+    // matched by RefSeqNum(45)
+    if (msg_type == "3" || msg_type == "j") {
+        std::string ref_seq;
+        if (utils::find_tag_value(inbound_message, "45=", ref_seq)) {
+            std::map<int, std::string>::iterator found =
+                outstanding_seq.find(std::atoi(ref_seq.c_str()));
+            if (found != outstanding_seq.end()) {
+                const std::string key = found->second;
+                ack(key);
+            }
+        }
+    }
+
+    return acked != before;
+}
+
+bool ScenarioSender::finished() const {
+    return outstanding.empty() && unsent_keyless == 0 && !has_pending && exhausted;
+}
@@ -0,0 +1,354 @@
+#include "session.h"
+#include "session_admin.h"
+#include "token_handler.h"
+#include "utils.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+
+static const size_t receive_buffer_size = 65536;
+static const uint64_t logon_timeout_ms = 5000;
+static const uint64_t logout_timeout_ms = 2000;
+
+bool FixInbound::get(int tag, std::string& value) const {
+    char prefix[16];
+    std::snprintf(prefix, sizeof(prefix), "%d=", tag);
+    return raw && utils::find_tag_value(*raw, prefix, value);
+}
+
+Session::Session(const SessionConfig& session_config)
+    : config(session_config), active(&stream_socket), validation(validation_off),
+      session_state(session_disconnected),
+      outbound_seq(1), saved_seq(0),
+      heartbeat_interval_ms(static_cast<uint64_t>(session_config.heartbeat_interval > 0 ?
+                                                  session_config.heartbeat_interval : 30) * 1000ULL),
+      last_send_ms(0), last_recv_ms(0), test_request_sent_ms(0), test_request_counter(1),
+      state_since_ms(0) {
+    fix.set_begin_string(config.begin_string);
+    fix.set_sender_comp_id(config.sender_comp_id);
+    fix.set_target_comp_id(config.target_comp_id);
+    typed_header = FixTypedHeader(fix);
+}
+
+Session::~Session() {
+    close();
+}
+
+bool Session::connect(LoopbackPeer* peer) {
+    if (session_state != session_disconnected) {
+        return false;
+    }
+
+    if (!parse_validation_mode(config.validation, validation)) {
+        return false;
+    }
+    std::string error;
+    if (validation != validation_off && !validator.load(config.data_dictionary, error)) {
+        std::printf("Error: data_dictionary %s: %s\n", config.data_dictionary.c_str(), error.c_str());
+        return false;
+    }
+
+    std::string address;
+    const TransportKind transport = parse_transport_host(config.host, address);
+
+    bool connected = false;
+    switch (transport) {
+        case transport_tcp:
+            active = &stream_socket;
+            connected = stream_socket.connect(address, config.port);
+            break;
+        case transport_unix:
+            active = &stream_socket;
+            connected = stream_socket.connect_unix(address);
+            break;
+        case transport_inproc:
+            active = &loopback;
+            connected = peer && loopback.connect(*peer);
+            break;
+        case transport_pipe: {
+            InprocPipe* pipe = inproc_find(address);
+            active = &pipe_end;
+            connected = pipe && pipe_end.connect(*pipe, InprocEndpoint::client_side);
+            break;
+        }
+    }
+
+    if (!connected) {
+        return false;
+    }
+
+    // poll() only reads what wait_readable()
+    // reported, this bounds a spurious wakeup
+    if (!active->set_receive_timeout(1)) {
+        active->close();
+        return false;
+    }
+
+    if ((transport == transport_tcp || transport == transport_unix) &&
+        (config.timestamping == "software" || config.timestamping == "hardware") &&
+        !active->enable_timestamping(config.timestamping == "hardware")) {
+        active->close();
+        return false;
+    }
+
+    if (!token_dir.empty() &&
+        !read_token(token_dir, config.sender_comp_id, utils::get_utc_timestamp(),
+                    config.reset_on_logon, outbound_seq, token_path)) {
+        active->close();
+        return false;
+    }
+    saved_seq = outbound_seq;
+
+    last_send_ms = utils::get_monotonic_millis();
+    last_recv_ms = last_send_ms;
+    return true;
+}
+
+bool Session::logon() {
+    if (session_state != session_disconnected || !active->is_open()) {
+        return false;
+    }
+
+    queue(fix.build_logon(outbound_seq, utils::get_utc_timestamp(),
+                          config.heartbeat_interval, config.reset_on_logon));
+    session_state = session_logon_sent;
+    state_since_ms = utils::get_monotonic_millis();
+    return flush();
+}
+
+void Session::logout(const std::string& text) {
+    if (session_state != session_active && session_state != session_logon_sent) {
+        return;
+    }
+
+    queue(fix.build_logout(outbound_seq, utils::get_utc_timestamp(), text));
+    session_state = session_logout_sent;
+    state_since_ms = utils::get_monotonic_millis();
+    flush();
+}
+
+void Session::on(const std::string& msg_type, const Handler& handler) {
+    if (msg_type.empty()) return;
+
+    std::vector<Route>& slot = routes[static_cast<unsigned char>(msg_type[0])];
+    for (size_t i = 0; i < slot.size(); ++i) {
+        if (slot[i].msg_type == msg_type) {
+            slot[i].handler = handler;
+            return;
+        }
+    }
+
+    Route route;
+    route.msg_type = msg_type;
+    route.handler = handler;
+    slot.push_back(route);
+}
+
+// Admin messages are built by FixMessage,
+// each takes the next MsgSeqNum
+void Session::queue(const std::string& msg) {
+    outbound.append(msg);
+    outbound_seq++;
+}
+
+bool Session::send(const FixMessageView& message) {
+    if (session_state != session_active) {
+        return false;
+    }
+
+    if (!fix.encode_view(outbound, message, outbound_seq, utils::get_utc_timestamp())) {
+        return false;
+    }
+
+    outbound_seq++;
+    return true;
+}
+
+// Token saved once per batch, before
+// the bytes leave
+bool Session::flush() {
+    if (outbound.empty()) {
+        return true;
+    }
+
+    if (!token_path.empty() && saved_seq != outbound_seq) {
+        save_token(token_path, outbound_seq);
+        saved_seq = outbound_seq;
+    }
+
+    if (!active->send_bytes(outbound)) {
+        close();
+        return false;
+    }
+
+    outbound.clear();
+    last_send_ms = utils::get_monotonic_millis();
+    return true;
+}
+
+void Session::check_timers(uint64_t now_ms) {
+    if (session_state == session_logon_sent) {
+        if (now_ms - state_since_ms >= logon_timeout_ms) {
+            std::printf("Error: logon timeout (no 35=A)\n");
+            close();
+        }
+        return;
+    }
+
+    if (session_state == session_logout_sent) {
+        if (now_ms - state_since_ms >= logout_timeout_ms) {
+            close();
+        }
+        return;
+    }
+
+    if (session_state != session_active) {
+        return;
+    }
+
+    const KeepaliveAction keepalive = check_keepalive(now_ms, heartbeat_interval_ms, last_send_ms,
+                                                      last_recv_ms, test_request_sent_ms);
+
+    if (keepalive == keepalive_timeout) {
+        std::printf("Error: TestRequest timeout\n");
+        close();
+    } else if (keepalive == keepalive_test_request) {
+        char test_req_id[32];
+        std::snprintf(test_req_id, sizeof(test_req_id), "TR%d", test_request_counter++);
+        queue(fix.build_test_request(outbound_seq, utils::get_utc_timestamp(), test_req_id));
+        test_request_sent_ms = now_ms;
+    } else if (keepalive == keepalive_heartbeat) {
+        queue(fix.build_heartbeat(outbound_seq, utils::get_utc_timestamp(), ""));
+    }
+}
+
+bool Session::poll(int timeout_ms) {
+    if (session_state == session_disconnected || session_state == session_closed) {
+        return false;
+    }
+
+    check_timers(utils::get_monotonic_millis());
+    if (session_state == session_closed || !flush()) {
+        return false;
+    }
+
+    if (!active->wait_readable(timeout_ms)) {
+        return session_state != session_closed;
+    }
+
+    char buffer[receive_buffer_size];
+    const int bytes_read = active->receive_bytes(buffer, sizeof(buffer));
+
+    if (bytes_read == 0) {
+        close();
+        return false;
+    }
+    if (bytes_read < 0) {
+        if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) {
+            return true;
+        }
+        close();
+        return false;
+    }
+
+    last_recv_ms = utils::get_monotonic_millis();
+    test_request_sent_ms = 0;
+    parser.append_bytes(buffer, static_cast<size_t>(bytes_read), active->last_rx_timestamp());
+
+    std::string msg;
+    SocketTimestamp stamp;
+    while (session_state != session_closed && parser.read_next_message(msg, stamp)) {
+        handle(msg, stamp);
+    }
+
+    if (session_state == session_closed || !flush()) {
+        return false;
+    }
+    return true;
+}
+
+void Session::handle(const std::string& msg, const SocketTimestamp& stamp) {
+    FixInbound inbound;
+    inbound.raw = &msg;
+    inbound.rx_stamp = stamp;
+    if (!utils::find_tag_value(msg, "35=", inbound.msg_type) || inbound.msg_type.empty()) {
+        return;
+    }
+
+    std::string seq;
+    if (utils::find_tag_value(msg, "34=", seq)) {
+        inbound.msg_seq_num = std::atoi(seq.c_str());
+    }
+
+    if (inbound.msg_type == "A" && session_state == session_logon_sent) {
+        session_state = session_active;
+    }
+
+    bool peer_logout = false;
+    std::string reply;
+    const AdminAction action = answer_admin_message(fix, inbound.msg_type, msg, outbound_seq, reply);
+
+    if (action == admin_heartbeat) {
+        queue(reply);
+    } else if (action == admin_logout) {
+        if (session_state != session_logout_sent) {
+            queue(reply);
+        }
+        peer_logout = true;
+    }
+
+    // Business messages failing validation=reject
+    // are answered with 35=3 and not dispatched
+    FixValidationError invalid;
+    if (validation != validation_off && !is_admin_msg_type(inbound.msg_type) &&
+        !validator.validate(msg, invalid)) {
+        std::printf("%s: 35=%s seq %d failed validation: %s\n",
+                    validation == validation_reject ? "Error" : "Warning",
+                    inbound.msg_type.c_str(), inbound.msg_seq_num, invalid.text.c_str());
+        if (validation == validation_reject) {
+            queue(fix.build_reject(outbound_seq, utils::get_utc_timestamp(), invalid.ref_seq_num,
+                                   invalid.ref_tag, invalid.ref_msg_type, invalid.reason, invalid.text));
+            return;
+        }
+    }
+
+    dispatch(inbound);
+
+    if (peer_logout) {
+        flush();
+        close();
+    }
+}
+
+void Session::dispatch(const FixInbound& inbound) {
+    const std::vector<Route>& slot = routes[static_cast<unsigned char>(inbound.msg_type[0])];
+    for (size_t i = 0; i < slot.size(); ++i) {
+        if (slot[i].msg_type == inbound.msg_type) {
+            slot[i].handler(*this, inbound);
+            return;
+        }
+    }
+
+    if (unhandled && !is_admin_msg_type(inbound.msg_type)) {
+        unhandled(*this, inbound);
+    }
+}
+
+void Session::close() {
+    if (session_state == session_closed) {
+        return;
+    }
+
+    if (!token_path.empty() && saved_seq != outbound_seq) {
+        save_token(token_path, outbound_seq);
+        saved_seq = outbound_seq;
+    }
+
+    stream_socket.close();
+    loopback.close();
+    pipe_end.close();
+    parser.reset();
+    outbound.clear();
+    session_state = session_closed;
+}
@@ -0,0 +1,51 @@
+#include "session_admin.h"
+#include "utils.h"
+
+bool is_admin_msg_type(const std::string& msg_type) {
+    return msg_type == "0" || msg_type == "1" || msg_type == "2" ||
+           msg_type == "4" || msg_type == "A" || msg_type == "5";
+}
+
+AdminAction answer_admin_message(const FixMessage& fix,
+                                 const std::string& msg_type,
+                                 const std::string& inbound_message,
+                                 int msg_seq_num,
+                                 std::string& reply) {
+    reply.clear();
+
+    // TestRequest (35=1) -> Heartbeat (35=0) with same 112 (if present)
+    if (msg_type == "1") {
+        std::string test_req_id;
+        utils::find_tag_value(inbound_message, "112=", test_req_id);
+
+        reply = fix.build_heartbeat(msg_seq_num, utils::get_utc_timestamp(), test_req_id);
+        return admin_heartbeat;
+    }
+
+    // Logout (35=5) -> reply Logout and stop
+    if (msg_type == "5") {
+        reply = fix.build_logout(msg_seq_num, utils::get_utc_timestamp(), "");
+        return admin_logout;
+    }
+
+    return admin_none;
+}
+
+KeepaliveAction check_keepalive(uint64_t now_ms,
+                                uint64_t interval_ms,
+                                uint64_t last_send_ms,
+                                uint64_t last_recv_ms,
+                                uint64_t test_request_sent_ms) {
+    if (test_request_sent_ms != 0) {
+        if (now_ms - test_request_sent_ms >= interval_ms) {
+            return keepalive_timeout;
+        }
+    } else if (now_ms - last_recv_ms >= interval_ms) {
+        return keepalive_test_request;
+    }
+
+    if (now_ms - last_send_ms >= interval_ms) {
+        return keepalive_heartbeat;
+    }
+    return keepalive_idle;
+}
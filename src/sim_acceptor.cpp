@@ -0,0 +1,187 @@
+#include "sim_acceptor.h"
+#include "constants.h"
+#include "utils.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+
+bool build_order_ack(const FixMessage& fix,
+                     const std::string& msg_type,
+                     const std::string& request,
+                     int msg_seq_num,
+                     const std::string& sending_time,
+                     uint64_t exec_id,
+                     std::string& ack) {
+    const char* exec_type = 0;
+    const char* ord_status = 0;
+    if (msg_type == "D" || msg_type == "s") {
+        exec_type = "0";
+        ord_status = "0";
+    } else if (msg_type == "F") {
+        exec_type = "4";
+        ord_status = "4";
+    } else if (msg_type == "G") {
+        exec_type = "5";
+        ord_status = "0";
+    } else {
+        return false;
+    }
+
+    std::string clord_id;
+    std::string orig_clord_id;
+    std::string cross_id;
+    std::string symbol;
+    std::string side;
+    std::string order_qty;
+    std::string price;
+    utils::find_tag_value(request, "11=", clord_id);
+    utils::find_tag_value(request, "41=", orig_clord_id);
+    utils::find_tag_value(request, "548=", cross_id);
+    utils::find_tag_value(request, "55=", symbol);
+    utils::find_tag_value(request, "54=", side);
+    utils::find_tag_value(request, "38=", order_qty);
+    utils::find_tag_value(request, "44=", price);
+
+    const bool is_cancel = std::strcmp(exec_type, "4") == 0;
+    char exec_id_buf[24];
+    std::snprintf(exec_id_buf, sizeof(exec_id_buf), "%llu", static_cast<unsigned long long>(exec_id));
+
+    FixMessage::FieldList body;
+    body.push_back(FixMessage::Field(fix_tag_order_id, "O" + (orig_clord_id.empty() ? clord_id : orig_clord_id)));
+    body.push_back(FixMessage::Field(fix_tag_clord_id, clord_id));
+    if (!orig_clord_id.empty()) body.push_back(FixMessage::Field(41, orig_clord_id));
+    if (!cross_id.empty()) body.push_back(FixMessage::Field(fix_tag_cross_id, cross_id));
+    body.push_back(FixMessage::Field(fix_tag_exec_id, exec_id_buf));
+    body.push_back(FixMessage::Field(fix_tag_exec_type, exec_type));
+    body.push_back(FixMessage::Field(fix_tag_ord_status, ord_status));
+    body.push_back(FixMessage::Field(fix_tag_symbol, symbol));
+    if (!side.empty()) body.push_back(FixMessage::Field(fix_tag_side, side));
+
+    // Quantities and prices go out normalized,
+    // text that is no decimal is echoed as is
+    FixDecimal qty;
+    const bool qty_ok = fix_decimal_parse(order_qty, qty);
+    FixDecimal px;
+    if (!order_qty.empty()) {
+        body.push_back(qty_ok ? FixMessage::make_decimal_field(fix_tag_order_qty, qty)
+                              : FixMessage::Field(fix_tag_order_qty, order_qty));
+    }
+    if (!price.empty()) {
+        body.push_back(fix_decimal_parse(price, px) ? FixMessage::make_decimal_field(fix_tag_price, px)
+                                                    : FixMessage::Field(fix_tag_price, price));
+    }
+
+    const FixDecimal none;
+    body.push_back(FixMessage::make_decimal_field(fix_tag_cum_qty, none));
+    body.push_back(FixMessage::make_decimal_field(fix_tag_leaves_qty, is_cancel || !qty_ok ? none : qty));
+    body.push_back(FixMessage::make_decimal_field(fix_tag_avg_px, none));
+
+    ack = fix.build_message("8", msg_seq_num, sending_time, body);
+    return true;
+}
+
+SimAcceptor::SimAcceptor(const SessionConfig& config)
+    : front_offset(0),
+      latency_ns(static_cast<uint64_t>(config.sim_latency_us > 0 ? config.sim_latency_us : 0) * 1000ULL),
+      outbound_seq(1), next_exec_id(1), closed(false) {
+    fix.set_begin_string(config.begin_string);
+    fix.set_sender_comp_id(config.target_comp_id);
+    fix.set_target_comp_id(config.sender_comp_id);
+}
+
+// Replies leave in request order, a
+// reply is never due before the previous
+void SimAcceptor::queue(const std::string& bytes, uint64_t due_ns) {
+    if (!replies.empty() && replies.back().due_ns > due_ns) {
+        due_ns = replies.back().due_ns;
+    }
+
+    Reply reply;
+    reply.due_ns = due_ns;
+    reply.bytes = bytes;
+    replies.push_back(reply);
+}
+
+void SimAcceptor::on_client_bytes(const char* data, size_t len, uint64_t now_ns) {
+    if (closed) return;
+
+    parser.append_bytes(data, len);
+
+    std::string msg;
+    while (!closed && parser.read_next_message(msg)) {
+        handle(msg, now_ns);
+    }
+}
+
+void SimAcceptor::handle(const std::string& msg, uint64_t now_ns) {
+    std::string msg_type;
+    if (!utils::find_tag_value(msg, "35=", msg_type)) {
+        return;
+    }
+
+    const uint64_t due_ns = now_ns + latency_ns;
+    const std::string sending_time = utils::format_utc_timestamp(due_ns);
+
+    if (msg_type == "A") {
+        std::string heart_bt_int;
+        utils::find_tag_value(msg, "108=", heart_bt_int);
+
+        std::string reset_seq_num;
+        utils::find_tag_value(msg, "141=", reset_seq_num);
+
+        queue(fix.build_logon(outbound_seq++, sending_time, std::atoi(heart_bt_int.c_str()),
+                              reset_seq_num == "Y"), due_ns);
+        return;
+    }
+
+    if (msg_type == "1") {
+        std::string test_req_id;
+        utils::find_tag_value(msg, "112=", test_req_id);
+        queue(fix.build_heartbeat(outbound_seq++, sending_time, test_req_id), due_ns);
+        return;
+    }
+
+    if (msg_type == "5") {
+        queue(fix.build_logout(outbound_seq++, sending_time, ""), due_ns);
+        queue(std::string(), due_ns);
+        closed = true;
+        return;
+    }
+
+    std::string ack;
+    if (build_order_ack(fix, msg_type, msg, outbound_seq, sending_time, next_exec_id, ack)) {
+        outbound_seq++;
+        next_exec_id++;
+        queue(ack, due_ns);
+    }
+}
+
+uint64_t SimAcceptor::next_due_ns() const {
+    return replies.empty() ? 0 : replies.front().due_ns;
+}
+
+int SimAcceptor::read_due(char* buf, size_t max_len, uint64_t now_ns) {
+    size_t copied = 0;
+    while (copied < max_len && !replies.empty() && replies.front().due_ns <= now_ns) {
+        const std::string& bytes = replies.front().bytes;
+        if (bytes.empty()) {
+            // Close after what was already copied
+            if (copied > 0) break;
+            return 0;
+        }
+
+        const size_t count = std::min(bytes.size() - front_offset, max_len - copied);
+        std::memcpy(buf + copied, bytes.data() + front_offset, count);
+        copied += count;
+        front_offset += count;
+
+        if (front_offset == bytes.size()) {
+            replies.pop_front();
+            front_offset = 0;
+        }
+    }
+
+    return (copied > 0) ? static_cast<int>(copied) : -1;
+}
@@ -2,43 +2,258 @@
 
 #include <sys/types.h>
 #include <sys/socket.h>
-#include <arpa/inet.h>
+#include <sys/uio.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <sys/ioctl.h>
+#include <netdb.h>
+#include <net/if.h>
+#include <netinet/in.h>
+#include <ifaddrs.h>
+#include <linux/net_tstamp.h>
+#include <linux/sockios.h>
+#include <linux/errqueue.h>
+#include <poll.h>
 #include <unistd.h>
 #include <cerrno>
 #include <cstring>
+#include <cstdio>
 
-TcpSocket::TcpSocket() : sock_fd(-1) {}
+StreamSocket::StreamSocket() : sock_fd(-1), timestamping(false), hardware_stamps(false), tx_bytes(0) {}
 
-TcpSocket::~TcpSocket() {
+static uint64_t timespec_to_nanos(const timespec& ts) {
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL +
+           static_cast<uint64_t>(ts.tv_nsec);
+}
+
+// Pull SCM_TIMESTAMPING out of the control
+// messages; ts[0] is software, ts[2] raw hardware
+static bool read_cmsg_timestamp(msghdr& msg, SocketTimestamp& stamp) {
+    bool found = false;
+    for (cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg != 0; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+        if (cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_TIMESTAMPING) {
+            continue;
+        }
+
+        timespec ts[3];
+        std::memcpy(ts, CMSG_DATA(cmsg), sizeof(ts));
+        stamp.software_ns = timespec_to_nanos(ts[0]);
+        stamp.hardware_ns = timespec_to_nanos(ts[2]);
+        found = true;
+    }
+    return found;
+}
+
+StreamSocket::~StreamSocket() {
     close();
 }
 
-void TcpSocket::close() {
+void StreamSocket::close() {
     if (sock_fd >= 0) {
         ::close(sock_fd);
         sock_fd = -1;
     }
+    timestamping = false;
+    hardware_stamps = false;
+    tx_bytes = 0;
+    last_rx = SocketTimestamp();
+}
+
+// Interface holding the local address of
+// the connection, empty for unix sockets
+static std::string local_interface(int fd) {
+    sockaddr_storage local = {};
+    socklen_t local_len = sizeof(local);
+    if (::getsockname(fd, reinterpret_cast<sockaddr*>(&local), &local_len) != 0) {
+        return std::string();
+    }
+    if (local.ss_family != AF_INET && local.ss_family != AF_INET6) {
+        return std::string();
+    }
+
+    ifaddrs* interfaces = 0;
+    if (::getifaddrs(&interfaces) != 0) {
+        return std::string();
+    }
+
+    std::string name;
+    for (ifaddrs* entry = interfaces; entry != 0 && name.empty(); entry = entry->ifa_next) {
+        if (!entry->ifa_addr || entry->ifa_addr->sa_family != local.ss_family) continue;
+
+        if (local.ss_family == AF_INET) {
+            const sockaddr_in* mine = reinterpret_cast<const sockaddr_in*>(&local);
+            const sockaddr_in* theirs = reinterpret_cast<const sockaddr_in*>(entry->ifa_addr);
+            if (mine->sin_addr.s_addr == theirs->sin_addr.s_addr) name = entry->ifa_name;
+        } else {
+            const sockaddr_in6* mine = reinterpret_cast<const sockaddr_in6*>(&local);
+            const sockaddr_in6* theirs = reinterpret_cast<const sockaddr_in6*>(entry->ifa_addr);
+            if (std::memcmp(&mine->sin6_addr, &theirs->sin6_addr, sizeof(in6_addr)) == 0) name = entry->ifa_name;
+        }
+    }
+
+    ::freeifaddrs(interfaces);
+    return name;
 }
 
-bool TcpSocket::connect(const std::string& host, int port) {
+// SIOCSHWTSTAMP: the NIC stamps every packet
+// in and out. SO_TIMESTAMPING alone only asks
+// for stamps the NIC is not making.
+static bool enable_nic_timestamping(int fd, std::string& error) {
+    const std::string name = local_interface(fd);
+    if (name.empty()) {
+        error = "no network interface for this connection";
+        return false;
+    }
+    if (name.size() >= IFNAMSIZ) {
+        error = "interface name " + name + " too long";
+        return false;
+    }
+
+    hwtstamp_config config = {};
+    config.tx_type = HWTSTAMP_TX_ON;
+    config.rx_filter = HWTSTAMP_FILTER_ALL;
+
+    ifreq request = {};
+    std::memcpy(request.ifr_name, name.c_str(), name.size() + 1);
+    request.ifr_data = reinterpret_cast<char*>(&config);
+
+    if (::ioctl(fd, SIOCSHWTSTAMP, &request) != 0) {
+        error = name + ": " + std::strerror(errno);
+        return false;
+    }
+    if (config.tx_type != HWTSTAMP_TX_ON || config.rx_filter == HWTSTAMP_FILTER_NONE) {
+        error = name + ": driver does not stamp all packets";
+        return false;
+    }
+    return true;
+}
+
+bool StreamSocket::enable_timestamping(bool hardware) {
+    if (sock_fd < 0) return false;
+
+    const unsigned int software_flags =
+        SOF_TIMESTAMPING_RX_SOFTWARE | SOF_TIMESTAMPING_TX_SOFTWARE |
+        SOF_TIMESTAMPING_SOFTWARE | SOF_TIMESTAMPING_OPT_ID |
+        SOF_TIMESTAMPING_OPT_TSONLY;
+
+    const unsigned int hardware_flags =
+        SOF_TIMESTAMPING_RX_HARDWARE | SOF_TIMESTAMPING_TX_HARDWARE |
+        SOF_TIMESTAMPING_RAW_HARDWARE;
+
+    std::string error;
+    if (hardware && !enable_nic_timestamping(sock_fd, error)) {
+        std::printf("Warning: no hardware timestamps (%s), software only\n", error.c_str());
+        hardware = false;
+    }
+
+    unsigned int flags = software_flags;
+    if (hardware) {
+        flags |= hardware_flags;
+    }
+
+    if (::setsockopt(sock_fd, SOL_SOCKET, SO_TIMESTAMPING, &flags, sizeof(flags)) != 0) {
+        // Kernel refused hardware
+        // stamps, keep software only
+        if (!hardware) return false;
+
+        std::printf("Warning: SO_TIMESTAMPING refused hardware stamps, software only\n");
+        hardware = false;
+        flags = software_flags;
+        if (::setsockopt(sock_fd, SOL_SOCKET, SO_TIMESTAMPING, &flags, sizeof(flags)) != 0) {
+            return false;
+        }
+    }
+
+    // OPT_ID counts bytes from here
+    tx_bytes = 0;
+    timestamping = true;
+    hardware_stamps = hardware;
+    return true;
+}
+
+bool StreamSocket::read_tx_timestamp(uint32_t& tx_key, SocketTimestamp& stamp) {
+    if (sock_fd < 0 || !timestamping) return false;
+
+    char control[256];
+    msghdr msg = {};
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+
+    while (true) {
+        ssize_t rc = ::recvmsg(sock_fd, &msg, MSG_ERRQUEUE | MSG_DONTWAIT);
+        if (rc < 0 && errno == EINTR) continue;
+        if (rc < 0) return false;
+        break;
+    }
+
+    stamp = SocketTimestamp();
+    bool has_key = false;
+
+    for (cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg != 0; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+        const bool is_ip_err =
+            (cmsg->cmsg_level == SOL_IP && cmsg->cmsg_type == IP_RECVERR) ||
+            (cmsg->cmsg_level == SOL_IPV6 && cmsg->cmsg_type == IPV6_RECVERR);
+        if (!is_ip_err) continue;
+
+        sock_extended_err err;
+        std::memcpy(&err, CMSG_DATA(cmsg), sizeof(err));
+        if (err.ee_origin == SO_EE_ORIGIN_TIMESTAMPING) {
+            tx_key = err.ee_data;
+            has_key = true;
+        }
+    }
+
+    return read_cmsg_timestamp(msg, stamp) && has_key;
+}
+
+bool StreamSocket::connect(const std::string& host, int port) {
     close();
 
-    sock_fd = ::socket(AF_INET, SOCK_STREAM, 0);
-    if (sock_fd < 0) {
-        sock_fd = -1;
+    char service[16];
+    std::snprintf(service, sizeof(service), "%d", port);
+
+    addrinfo hints = {};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+
+    addrinfo* addresses = 0;
+    if (::getaddrinfo(host.c_str(), service, &hints, &addresses) != 0) {
         return false;
     }
 
-    sockaddr_in addr = {};
-    addr.sin_family = AF_INET;
-    addr.sin_port = htons(port);
+    // First address that accepts
+    for (addrinfo* addr = addresses; addr != 0; addr = addr->ai_next) {
+        sock_fd = ::socket(addr->ai_family, addr->ai_socktype, addr->ai_protocol);
+        if (sock_fd < 0) {
+            continue;
+        }
 
-    // Convert IP string (e.g., "127.0.0.1") to binary
-    if (::inet_pton(AF_INET, host.c_str(), &addr.sin_addr) <= 0) {
+        if (::connect(sock_fd, addr->ai_addr, addr->ai_addrlen) == 0) {
+            break;
+        }
         close();
+    }
+
+    ::freeaddrinfo(addresses);
+    return sock_fd >= 0;
+}
+
+bool StreamSocket::connect_unix(const std::string& path) {
+    close();
+
+    sockaddr_un addr = {};
+    addr.sun_family = AF_UNIX;
+    if (path.empty() || path.size() >= sizeof(addr.sun_path)) {
+        return false;
+    }
+    std::memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+
+    sock_fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (sock_fd < 0) {
+        sock_fd = -1;
         return false;
     }
-    
+
     if (::connect(sock_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
         close();
         return false;
@@ -47,7 +262,29 @@ bool TcpSocket::connect(const std::string& host, int port) {
     return true;
 }
 
-bool TcpSocket::send_bytes(const std::string& data) {
+bool StreamSocket::set_receive_timeout(int timeout_millis) {
+    if (sock_fd < 0) return false;
+
+    timeval tv;
+    tv.tv_sec = timeout_millis / 1000;
+    tv.tv_usec = (timeout_millis % 1000) * 1000;
+
+    return ::setsockopt(sock_fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv)) == 0;
+}
+
+// False on timeout and on a poll error,
+// the caller's next read reports the latter
+bool StreamSocket::wait_readable(int timeout_millis) {
+    if (sock_fd < 0) return false;
+
+    pollfd pfd;
+    pfd.fd = sock_fd;
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+    return ::poll(&pfd, 1, timeout_millis) > 0;
+}
+
+bool StreamSocket::send_bytes(const std::string& data) {
     if (sock_fd < 0) return false;
 
     const char* ptr = data.data();
@@ -59,6 +296,7 @@ bool TcpSocket::send_bytes(const std::string& data) {
     while (remaining > 0) {
         ssize_t bytes_sent = ::send(sock_fd, ptr, remaining, 0);
         if (bytes_sent > 0) {
+            tx_bytes += static_cast<uint32_t>(bytes_sent);
             ptr += bytes_sent;
             remaining -= static_cast<size_t>(bytes_sent);
             continue;
@@ -80,7 +318,7 @@ bool TcpSocket::send_bytes(const std::string& data) {
     return true;
 }
 
-int TcpSocket::receive_bytes(char* buf, size_t max_bytes) {
+int StreamSocket::receive_bytes(char* buf, size_t max_bytes) {
     if (sock_fd < 0) {
         return -1;
     }
@@ -89,7 +327,30 @@ int TcpSocket::receive_bytes(char* buf, size_t max_bytes) {
         return -1;
     }
 
-    ssize_t bytes_read = ::recv(sock_fd, buf, max_bytes, 0);
+    ssize_t bytes_read = 0;
+
+    if (!timestamping) {
+        bytes_read = ::recv(sock_fd, buf, max_bytes, 0);
+    } else {
+        // Same as recv() but also collects
+        // the kernel RX stamp
+        iovec iov;
+        iov.iov_base = buf;
+        iov.iov_len = max_bytes;
+
+        char control[256];
+        msghdr msg = {};
+        msg.msg_iov = &iov;
+        msg.msg_iovlen = 1;
+        msg.msg_control = control;
+        msg.msg_controllen = sizeof(control);
+
+        bytes_read = ::recvmsg(sock_fd, &msg, 0);
+        if (bytes_read > 0) {
+            last_rx = SocketTimestamp();
+            read_cmsg_timestamp(msg, last_rx);
+        }
+    }
 
     if (bytes_read > 0) {
         return static_cast<int>(bytes_read);
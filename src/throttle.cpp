@@ -0,0 +1,286 @@
+#include "throttle.h"
+#include "utils.h"
+
+#include <cstdlib>
+
+TokenBucket::TokenBucket() : rate(0.0), capacity(0.0), tokens(0.0), last_ms(0) {}
+
+void TokenBucket::configure(double rate_per_sec, double burst, uint64_t now_ms) {
+    rate = rate_per_sec;
+    capacity = (burst >= 1.0) ? burst : 1.0;
+    tokens = capacity;
+    last_ms = now_ms;
+}
+
+void TokenBucket::refill(uint64_t now_ms) {
+    if (now_ms <= last_ms) {
+        return;
+    }
+
+    tokens += static_cast<double>(now_ms - last_ms) * rate / 1000.0;
+    if (tokens > capacity) {
+        tokens = capacity;
+    }
+    last_ms = now_ms;
+}
+
+bool TokenBucket::has_token(uint64_t now_ms) {
+    if (!enabled()) return true;
+
+    refill(now_ms);
+    return tokens >= 1.0;
+}
+
+void TokenBucket::take() {
+    if (!enabled()) return;
+    tokens -= 1.0;
+}
+
+void TokenBucket::borrow(uint64_t now_ms) {
+    if (!enabled()) return;
+
+    refill(now_ms);
+    tokens -= 1.0;
+    if (tokens < -capacity) {
+        tokens = -capacity;
+    }
+}
+
+uint64_t TokenBucket::wait_ms(uint64_t now_ms) {
+    if (!has_token(now_ms)) {
+        const double missing = 1.0 - tokens;
+        return static_cast<uint64_t>(missing * 1000.0 / rate) + 1;
+    }
+    return 0;
+}
+
+// "rate[/burst]"
+static bool parse_limit(const std::string& text, double& rate, double& burst) {
+    const std::string trimmed = utils::trim(text);
+    if (trimmed.empty()) return false;
+
+    char* end = 0;
+    rate = std::strtod(trimmed.c_str(), &end);
+    if (end == trimmed.c_str() || rate <= 0.0) return false;
+
+    burst = 1.0;
+    if (*end == '/') {
+        const char* burst_text = end + 1;
+        burst = std::strtod(burst_text, &end);
+        if (end == burst_text || burst < 1.0) return false;
+    }
+
+    return *end == '\0';
+}
+
+OutboundThrottle::OutboundThrottle() : is_enabled(false) {}
+
+OutboundThrottle::Priority OutboundThrottle::classify(const std::string& msg_type) {
+    if (msg_type.size() == 1) {
+        switch (msg_type[0]) {
+            case '0': case '1': case '2': case '3':
+            case '4': case '5': case 'A':
+                return priority_admin;
+            case 'F': case 'q': case 'u':
+                return priority_cancel;
+            default:
+                break;
+        }
+    }
+    return priority_order;
+}
+
+bool OutboundThrottle::configure(const SessionConfig& config) {
+    const uint64_t now_ms = utils::get_monotonic_millis();
+
+    is_enabled = false;
+    msg_type_buckets.clear();
+
+    if (!config.throttle_session.empty()) {
+        double rate = 0.0;
+        double burst = 0.0;
+        if (!parse_limit(config.throttle_session, rate, burst)) {
+            return false;
+        }
+        session_bucket.configure(rate, burst, now_ms);
+        is_enabled = true;
+    }
+
+    // D:50/5,F:20
+    const std::string& list = config.throttle_msg_types;
+    size_t pos = 0;
+    while (pos < list.size()) {
+        size_t end = list.find(',', pos);
+        if (end == std::string::npos) end = list.size();
+
+        const std::string item = utils::trim(list.substr(pos, end - pos));
+        pos = end + 1;
+        if (item.empty()) continue;
+
+        const size_t colon = item.find(':');
+        if (colon == std::string::npos || colon == 0) {
+            return false;
+        }
+
+        double rate = 0.0;
+        double burst = 0.0;
+        if (!parse_limit(item.substr(colon + 1), rate, burst)) {
+            return false;
+        }
+
+        msg_type_buckets[utils::trim(item.substr(0, colon))].configure(rate, burst, now_ms);
+        is_enabled = true;
+    }
+
+    return true;
+}
+
+TokenBucket* OutboundThrottle::find_bucket(const std::string& msg_type) {
+    std::map<std::string, TokenBucket>::iterator found = msg_type_buckets.find(msg_type);
+    return (found == msg_type_buckets.end()) ? 0 : &found->second;
+}
+
+bool OutboundThrottle::can_release(const std::string& msg_type, uint64_t now_ms) {
+    TokenBucket* bucket = find_bucket(msg_type);
+    return session_bucket.has_token(now_ms) && (!bucket || bucket->has_token(now_ms));
+}
+
+static const std::string* field_value(const FixMessage::FieldList& fields, int tag) {
+    for (size_t i = 0; i < fields.size(); ++i) {
+        if (fields[i].first == tag) return &fields[i].second;
+    }
+    return 0;
+}
+
+// OrigClOrdID(41) or OrigCrossID(551) of a
+// cancel/replace still in the order queue
+bool OutboundThrottle::waits_for_order(const Pending& pending) const {
+    int id_tag = 11;
+    const std::string* orig_id = field_value(pending.fields, 41);
+    if (!orig_id) {
+        id_tag = 548;
+        orig_id = field_value(pending.fields, 551);
+    }
+    if (!orig_id) return false;
+
+    const std::deque<Pending>& orders = queues[priority_order];
+    for (size_t i = 0; i < orders.size(); ++i) {
+        const std::string* id = field_value(orders[i].fields, id_tag);
+        if (id && *id == *orig_id) return true;
+    }
+    return false;
+}
+
+void OutboundThrottle::release(const std::string& msg_type, uint64_t waited_ms) {
+    session_bucket.take();
+    TokenBucket* bucket = find_bucket(msg_type);
+    if (bucket) bucket->take();
+
+    stats.sent++;
+    stats.total_wait_ms += waited_ms;
+    if (waited_ms > stats.max_wait_ms) {
+        stats.max_wait_ms = waited_ms;
+    }
+}
+
+void OutboundThrottle::enqueue(const std::string& msg_type,
+                               const FixMessage::FieldList& fields) {
+    Pending pending;
+    pending.msg_type = msg_type;
+    pending.fields = fields;
+    pending.enqueued_ms = utils::get_monotonic_millis();
+
+    // Unthrottled: plain FIFO, a cancel
+    // never overtakes its own order
+    queues[is_enabled ? classify(msg_type) : priority_order].push_back(pending);
+    stats.queued++;
+
+    const size_t current_depth = depth();
+    if (current_depth > stats.max_depth) {
+        stats.max_depth = current_depth;
+    }
+}
+
+bool OutboundThrottle::pop_ready(Pending& out) {
+    const uint64_t now_ms = utils::get_monotonic_millis();
+
+    for (int priority = 0; priority < priority_count; ++priority) {
+        std::deque<Pending>& queue = queues[priority];
+        if (queue.empty()) continue;
+
+        // Per class FIFO, a class blocked on its
+        // MsgType bucket or on its order still being
+        // queued lets the next class through
+        if (priority == priority_cancel && waits_for_order(queue.front())) {
+            continue;
+        }
+        if (!can_release(queue.front().msg_type, now_ms)) {
+            if (!session_bucket.has_token(now_ms)) return false;
+            continue;
+        }
+
+        out = queue.front();
+        queue.pop_front();
+        release(out.msg_type, now_ms - out.enqueued_ms);
+        return true;
+    }
+    return false;
+}
+
+uint64_t OutboundThrottle::next_ready_ms() {
+    const uint64_t now_ms = utils::get_monotonic_millis();
+
+    uint64_t best = 0;
+    bool found = false;
+    for (int priority = 0; priority < priority_count; ++priority) {
+        if (queues[priority].empty()) continue;
+        if (priority == priority_cancel && waits_for_order(queues[priority].front())) continue;
+
+        uint64_t wait = session_bucket.wait_ms(now_ms);
+        TokenBucket* bucket = find_bucket(queues[priority].front().msg_type);
+        if (bucket) {
+            const uint64_t type_wait = bucket->wait_ms(now_ms);
+            if (type_wait > wait) wait = type_wait;
+        }
+
+        if (!found || wait < best) {
+            best = wait;
+            found = true;
+        }
+    }
+    return best;
+}
+
+void OutboundThrottle::on_admin_sent() {
+    if (!is_enabled) return;
+    session_bucket.borrow(utils::get_monotonic_millis());
+}
+
+uint64_t OutboundThrottle::acquire(const std::string& msg_type) {
+    const uint64_t start_ms = utils::get_monotonic_millis();
+    if (!is_enabled) return 0;
+
+    while (true) {
+        const uint64_t now_ms = utils::get_monotonic_millis();
+        if (can_release(msg_type, now_ms)) {
+            const uint64_t waited_ms = now_ms - start_ms;
+            release(msg_type, waited_ms);
+            return waited_ms;
+        }
+
+        uint64_t wait = session_bucket.wait_ms(now_ms);
+        TokenBucket* bucket = find_bucket(msg_type);
+        if (bucket && bucket->wait_ms(now_ms) > wait) {
+            wait = bucket->wait_ms(now_ms);
+        }
+        utils::sleep_millis(wait);
+    }
+}
+
+size_t OutboundThrottle::depth() const {
+    size_t total = 0;
+    for (int priority = 0; priority < priority_count; ++priority) {
+        total += queues[priority].size();
+    }
+    return total;
+}
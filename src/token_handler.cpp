@@ -95,3 +95,55 @@ bool read_token(const std::string& token_dir,
     return true;
 }
 
+
+bool next_id_epoch(const std::string& token_dir,
+                   const std::string& sender_comp_id,
+                   uint32_t& epoch_out) {
+    epoch_out = 0;
+
+    if (sender_comp_id.empty()) {
+        return false;
+    }
+
+    const std::string dir = token_dir.empty() ? std::string("tokens") : token_dir;
+    const std::string epoch_path = dir + "/" + sender_comp_id + "_ids.token";
+
+    long value = 0;
+    std::FILE* file = std::fopen(epoch_path.c_str(), "r");
+    if (file) {
+        char buf[32];
+        const size_t bytes_read = std::fread(buf, 1, sizeof(buf) - 1, file);
+        std::fclose(file);
+
+        buf[bytes_read] = '\0';
+        value = std::strtol(buf, 0, 10);
+        if (value < 0) {
+            value = 0;
+        }
+    }
+
+    // Write first, an epoch is only
+    // used once it is on disk. Write-then-
+    // rename, a crash leaves the old or the
+    // new number, never an empty file
+    const long next_value = value + 1;
+    char suffix[32];
+    std::snprintf(suffix, sizeof(suffix), ".%d.tmp", static_cast<int>(::getpid()));
+    const std::string tmp_path = epoch_path + suffix;
+
+    file = std::fopen(tmp_path.c_str(), "w");
+    if (!file) {
+        return false;
+    }
+
+    std::fprintf(file, "%ld\n", next_value);
+    const bool synced = (std::fflush(file) == 0) && (::fsync(::fileno(file)) == 0);
+    const bool closed = std::fclose(file) == 0;
+    if (!synced || !closed || std::rename(tmp_path.c_str(), epoch_path.c_str()) != 0) {
+        ::unlink(tmp_path.c_str());
+        return false;
+    }
+
+    epoch_out = static_cast<uint32_t>(value);
+    return true;
+}
@@ -0,0 +1,21 @@
+#include "transport.h"
+
+TransportKind parse_transport_host(const std::string& host, std::string& address) {
+    if (host.compare(0, 5, "unix:") == 0) {
+        address = host.substr(5);
+        return transport_unix;
+    }
+
+    if (host.compare(0, 7, "inproc:") == 0) {
+        address = host.substr(7);
+        return transport_pipe;
+    }
+
+    if (host == "inproc") {
+        address.clear();
+        return transport_inproc;
+    }
+
+    address = host;
+    return transport_tcp;
+}
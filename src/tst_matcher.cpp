@@ -0,0 +1,183 @@
+#include "tst_matcher.h"
+#include "scenario_compiler.h"
+
+#include <algorithm>
+
+TstMatcher::TstMatcher() : max_tag(0), required_tags(0), has_absent(false) {}
+
+static bool tag_less(const TstMatcher::Entry& entry, int tag) {
+    return entry.tag < tag;
+}
+
+static bool entry_less(const std::pair<int, size_t>& lhs, const std::pair<int, size_t>& rhs) {
+    return lhs.first < rhs.first || (lhs.first == rhs.first && lhs.second < rhs.second);
+}
+
+void TstMatcher::compile(const FixMessage::FieldList& expected,
+                         const std::vector<uint16_t>& slots) {
+    entries.clear();
+    required.clear();
+    absent.clear();
+    ignored.clear();
+    max_tag = 0;
+    required_tags = 0;
+    has_absent = false;
+
+    std::vector<std::pair<int, size_t> > order;
+    for (size_t i = 0; i < expected.size(); ++i) {
+        order.push_back(std::make_pair(expected[i].first, i));
+    }
+    std::sort(order.begin(), order.end(), entry_less);
+
+    for (size_t k = 0; k < order.size(); ++k) {
+        const size_t i = order[k].second;
+        const std::string& exp_text = expected[i].second;
+
+        Entry entry;
+        entry.tag = expected[i].first;
+        entry.slot = (i < slots.size()) ? slots[i] : 0;
+        entry.field = i;
+        entry.has_decimal = false;
+
+        if (exp_text.empty() || exp_text == "IGNORE") {
+            entry.kind = expect_any;
+        } else if (exp_text == "NONE") {
+            entry.kind = expect_absent;
+        } else if (entry.slot >= 1 && entry.slot <= scenario_max_clr) {
+            entry.kind = expect_clr;
+        } else {
+            entry.kind = expect_equal;
+            entry.value = exp_text;
+
+            // Price/Qty compare by value
+            // e.g. 100 == 100.00
+            entry.has_decimal = fix_is_decimal_tag(entry.tag) &&
+                                fix_decimal_parse(exp_text, entry.decimal);
+        }
+
+        entries.push_back(entry);
+        if (entry.tag > max_tag) max_tag = entry.tag;
+    }
+
+    const size_t words = static_cast<size_t>(max_tag / 64) + 1;
+    required.assign(words, 0);
+    absent.assign(words, 0);
+    ignored.assign(words, 0);
+    for (size_t k = 0; k < entries.size(); ++k) {
+        const int tag = entries[k].tag;
+        if (tag < 0) continue;
+
+        std::vector<uint64_t>& bits = (entries[k].kind == expect_any) ? ignored
+                                    : (entries[k].kind == expect_absent) ? absent : required;
+        const uint64_t bit = uint64_t(1) << (tag % 64);
+        if (&bits == &required && !(required[tag / 64] & bit)) required_tags++;
+        if (&bits == &absent) has_absent = true;
+        bits[tag / 64] |= bit;
+    }
+}
+
+bool TstMatcher::match(const std::string& msg,
+                       const std::string* clr_values,
+                       std::vector<Verdict>& verdicts) const {
+    Verdict none;
+    none.found = false;
+    none.match = false;
+    none.value_pos = 0;
+    none.value_len = 0;
+    verdicts.assign(entries.size(), none);
+
+    // One pass over tag=value<SOH>, first
+    // occurrence of a tag wins
+    const char* data = msg.data();
+    const size_t size = msg.size();
+    size_t missing = required_tags;
+    size_t pos = 0;
+    while (pos < size && (missing > 0 || has_absent)) {
+        // Past 9 digits the tag is no FIX tag and
+        // would overflow, it is read as -1 and skipped
+        int tag = 0;
+        size_t eq = pos;
+        while (eq < size && data[eq] >= '0' && data[eq] <= '9') {
+            if (eq - pos < 9) {
+                tag = (tag * 10) + (data[eq] - '0');
+            } else {
+                tag = -1;
+            }
+            eq++;
+        }
+
+        if (eq >= size || data[eq] != '=') {
+            break;
+        }
+
+        const size_t value_start = eq + 1;
+        size_t value_end = value_start;
+        while (value_end < size && data[value_end] != '\x01') value_end++;
+        if (value_end >= size) {
+            break;
+        }
+
+        // Ignored tags (IGNORE or empty)
+        // are not looked up at all
+        const uint64_t bit = (tag >= 0 && tag <= max_tag) ? (uint64_t(1) << (tag % 64)) : 0;
+        if (bit && ((required[tag / 64] | absent[tag / 64]) & bit)) {
+            bool newly_found = false;
+            std::vector<Entry>::const_iterator it =
+                std::lower_bound(entries.begin(), entries.end(), tag, tag_less);
+            for (; it != entries.end() && it->tag == tag; ++it) {
+                if (it->kind == expect_any || verdicts[it->field].found) continue;
+
+                Verdict& verdict = verdicts[it->field];
+                verdict.found = true;
+                verdict.value_pos = value_start;
+                verdict.value_len = value_end - value_start;
+                newly_found = true;
+            }
+            if (newly_found && (required[tag / 64] & bit)) {
+                missing--;
+            }
+        }
+
+        pos = value_end + 1;
+    }
+
+    bool all_match = true;
+    for (size_t k = 0; k < entries.size(); ++k) {
+        const Entry& entry = entries[k];
+        Verdict& verdict = verdicts[entry.field];
+        const char* value = data + verdict.value_pos;
+
+        switch (entry.kind) {
+            case expect_any:
+                verdict.match = true;
+                break;
+
+            case expect_absent:
+                verdict.match = !verdict.found || verdict.value_len == 0 ||
+                                msg.compare(verdict.value_pos, verdict.value_len, "NONE") == 0;
+                break;
+
+            case expect_clr: {
+                const std::string& expected = clr_values[entry.slot];
+                verdict.match = verdict.found && verdict.value_len == expected.size() &&
+                                msg.compare(verdict.value_pos, verdict.value_len, expected) == 0;
+                break;
+            }
+
+            case expect_equal:
+                verdict.match = verdict.found && verdict.value_len == entry.value.size() &&
+                                msg.compare(verdict.value_pos, verdict.value_len, entry.value) == 0;
+
+                if (!verdict.match && verdict.found && entry.has_decimal) {
+                    FixDecimal received;
+                    verdict.match = fix_decimal_parse(value, verdict.value_len, received) &&
+                                    fix_decimal_compare(entry.decimal, received) == 0;
+                }
+                break;
+        }
+
+        if (!verdict.match) all_match = false;
+    }
+
+    return all_match;
+}
@@ -2,29 +2,80 @@
 
 #include <cstdio>
 #include <cstring>
-#include <sys/time.h>
 #include <time.h>
+#include <unistd.h>
 
 namespace utils {
 
-std::string get_utc_timestamp() {
-    timeval now;
-    ::gettimeofday(&now, 0);
+static bool virtual_clock = false;
+static uint64_t virtual_now_ns = 0;
+
+void use_virtual_clock(uint64_t start_realtime_ns) {
+    virtual_clock = true;
+    virtual_now_ns = start_realtime_ns;
+}
+
+bool is_virtual_clock() {
+    return virtual_clock;
+}
+
+void advance_clock_to(uint64_t realtime_ns) {
+    if (virtual_clock && realtime_ns > virtual_now_ns) {
+        virtual_now_ns = realtime_ns;
+    }
+}
+
+void sleep_millis(uint64_t millis) {
+    if (virtual_clock) {
+        virtual_now_ns += millis * 1000000ULL;
+        return;
+    }
+    ::usleep(static_cast<useconds_t>(millis * 1000));
+}
+
+void sleep_until_nanos(uint64_t realtime_ns) {
+    if (virtual_clock) {
+        advance_clock_to(realtime_ns);
+        return;
+    }
+
+    const uint64_t now_ns = get_realtime_nanos();
+    if (realtime_ns <= now_ns) return;
+
+    const uint64_t wait_ns = realtime_ns - now_ns;
+    timespec ts;
+    ts.tv_sec = static_cast<time_t>(wait_ns / 1000000000ULL);
+    ts.tv_nsec = static_cast<long>(wait_ns % 1000000000ULL);
+    ::nanosleep(&ts, 0);
+}
+
+std::string format_utc_timestamp(uint64_t realtime_ns) {
+    const time_t seconds = static_cast<time_t>(realtime_ns / 1000000000ULL);
 
     tm utc_time;
-    ::gmtime_r(&now.tv_sec, &utc_time);
+    ::gmtime_r(&seconds, &utc_time);
 
     char time_part[32];
     ::strftime(time_part, sizeof(time_part), "%Y%m%d-%H:%M:%S", &utc_time);
 
     char timestamp[64];
-    const long millis = now.tv_usec / 1000;
+    const long millis = static_cast<long>((realtime_ns / 1000000ULL) % 1000ULL);
     std::snprintf(timestamp, sizeof(timestamp), "%s.%03ld", time_part, millis);
 
     return std::string(timestamp);
 }
 
+std::string get_utc_timestamp() {
+    return format_utc_timestamp(get_realtime_nanos());
+}
+
+// Virtual mode: the virtual realtime, in
+// millis, is monotonic as well
 uint64_t get_monotonic_millis() {
+    if (virtual_clock) {
+        return virtual_now_ns / 1000000ULL;
+    }
+
     timespec ts;
     ::clock_gettime(CLOCK_MONOTONIC, &ts);
 
@@ -33,6 +84,18 @@ uint64_t get_monotonic_millis() {
     return sec_ms + nsec_ms;
 }
 
+uint64_t get_realtime_nanos() {
+    if (virtual_clock) {
+        return virtual_now_ns;
+    }
+
+    timespec ts;
+    ::clock_gettime(CLOCK_REALTIME, &ts);
+
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL +
+           static_cast<uint64_t>(ts.tv_nsec);
+}
+
 std::string to_pipe_delimited(const std::string& fix) {
     const char SOH = '\x01';
 
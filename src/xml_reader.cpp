@@ -0,0 +1,86 @@
+#include "xml_reader.h"
+#include "utils.h"
+
+#include <fstream>
+#include <sstream>
+
+static std::string local_name(const std::string& name) {
+    const size_t colon = name.find(':');
+    return colon == std::string::npos ? name : name.substr(colon + 1);
+}
+
+static bool is_space(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+bool xml_next_tag(const std::string& xml, size_t& pos, XmlTag& tag, std::string& error) {
+    tag = XmlTag();
+
+    while (true) {
+        const size_t open = xml.find('<', pos);
+        if (open == std::string::npos) {
+            tag.text_before += xml.substr(pos);
+            pos = xml.size();
+            return false;
+        }
+        tag.text_before += xml.substr(pos, open - pos);
+
+        if (xml.compare(open, 4, "<!--") == 0) {
+            const size_t close = xml.find("-->", open + 4);
+            if (close == std::string::npos) { error = "unterminated comment"; return false; }
+            pos = close + 3;
+            continue;
+        }
+        if (xml.compare(open, 2, "<?") == 0 || xml.compare(open, 2, "<!") == 0) {
+            const size_t close = xml.find('>', open);
+            if (close == std::string::npos) { error = "unterminated declaration"; return false; }
+            pos = close + 1;
+            continue;
+        }
+
+        const size_t close = xml.find('>', open);
+        if (close == std::string::npos) { error = "unterminated tag"; return false; }
+        pos = close + 1;
+
+        size_t p = open + 1;
+        size_t end = close;
+        if (xml[p] == '/') { tag.closing = true; ++p; }
+        if (end > p && xml[end - 1] == '/') { tag.self_closing = true; --end; }
+
+        const size_t name_begin = p;
+        while (p < end && !is_space(xml[p])) ++p;
+        tag.name = local_name(xml.substr(name_begin, p - name_begin));
+
+        while (p < end) {
+            while (p < end && is_space(xml[p])) ++p;
+            if (p >= end) break;
+
+            const size_t eq = xml.find('=', p);
+            if (eq == std::string::npos || eq >= end) { error = "bad attribute in <" + tag.name + ">"; return false; }
+            const std::string key = local_name(utils::trim(xml.substr(p, eq - p)));
+
+            size_t q = eq + 1;
+            while (q < end && is_space(xml[q])) ++q;
+            if (q >= end || (xml[q] != '"' && xml[q] != '\'')) { error = "unquoted attribute " + key; return false; }
+            const size_t value_end = xml.find(xml[q], q + 1);
+            if (value_end == std::string::npos || value_end >= end) { error = "bad attribute " + key; return false; }
+
+            tag.attrs[key] = xml.substr(q + 1, value_end - q - 1);
+            p = value_end + 1;
+        }
+        return true;
+    }
+}
+
+bool xml_read_file(const std::string& path, std::string& text, std::string& error) {
+    std::ifstream in(path.c_str());
+    if (!in) {
+        error = "cannot open " + path;
+        return false;
+    }
+
+    std::stringstream buffer;
+    buffer << in.rdbuf();
+    text = buffer.str();
+    return true;
+}
@@ -0,0 +1,428 @@
+// Reads a QuickFIX-style data dictionary and writes
+// one C++ struct per application message:
+//
+//     fix_codegen config/FIX44.xml fix44 include/fix44_messages.h src/fix44_messages.cpp
+//
+// Fields sit at fixed members, tag prefixes are
+// literals ("44=") and decode() fills the struct
+// in one scan. Session messages are left to
+// FixMessage. The output is checked in, rebuild
+// it with the generate_messages target after
+// editing the dictionary.
+
+#include "fix_dictionary.h"
+
+#include <cstdio>
+#include <cctype>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+struct GenField {
+    const FixFieldDef* def;
+    const FixGroupDef* group;       // NumInGroup only
+    std::string member;
+    bool required;
+    int bit;
+};
+
+struct GenMessage {
+    const FixMessageDef* def;
+    std::string type_name;          // struct name
+    std::string prefix;             // snake_case, for file-local helpers
+    std::vector<GenField> fields;
+};
+
+// ClOrdID -> cl_ord_id, MDReqID -> md_req_id
+static std::string snake_case(const std::string& name) {
+    std::string out;
+    for (size_t i = 0; i < name.size(); ++i) {
+        const char c = name[i];
+        if (std::isupper(static_cast<unsigned char>(c)) && i > 0) {
+            const char prev = name[i - 1];
+            const bool next_lower = i + 1 < name.size() && std::islower(static_cast<unsigned char>(name[i + 1]));
+            if (std::islower(static_cast<unsigned char>(prev)) || std::isdigit(static_cast<unsigned char>(prev)) ||
+                (std::isupper(static_cast<unsigned char>(prev)) && next_lower)) {
+                out += '_';
+            }
+        }
+        out += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+    return out;
+}
+
+static std::string member_type(const FixFieldDef& def) {
+    if (def.num_in_group) return "int64_t";
+    switch (def.type) {
+        case fix_type_char: return "char";
+        case fix_type_int: return "int64_t";
+        case fix_type_decimal: return "FixDecimal";
+        case fix_type_boolean: return "bool";
+        default: return "FixText";
+    }
+}
+
+static std::string member_init(const FixFieldDef& def) {
+    if (def.num_in_group) return "0";
+    switch (def.type) {
+        case fix_type_char: return "0";
+        case fix_type_int: return "0";
+        case fix_type_boolean: return "false";
+        default: return "";
+    }
+}
+
+// Argument type of the setter
+static std::string param_type(const FixFieldDef& def) {
+    const std::string type = member_type(def);
+    return (type == "FixText" || type == "FixDecimal") ? "const " + type + "&" : type;
+}
+
+// Bytes written for a non-text value, 0 for text
+static size_t fixed_value_size(const FixFieldDef& def) {
+    if (def.num_in_group) return 20;
+    switch (def.type) {
+        case fix_type_char:
+        case fix_type_boolean: return 1;
+        case fix_type_int: return 20;
+        case fix_type_decimal: return 21;
+        default: return 0;
+    }
+}
+
+static std::string bit_mask(int bit) {
+    std::ostringstream out;
+    out << "(uint64_t(1) << " << bit << ")";
+    return out.str();
+}
+
+static std::string prefix_literal(int tag) {
+    std::ostringstream out;
+    out << '"' << tag << "=\"";
+    return out.str();
+}
+
+static size_t prefix_size(int tag) {
+    std::ostringstream out;
+    out << tag << '=';
+    return out.str().size();
+}
+
+// Every tag of a group entry, nested groups
+// flattened, for finding where the entries end
+static void group_tags(const FixMessageDef& message, const FixGroupDef& group, std::vector<int>& tags) {
+    for (size_t i = 0; i < group.members.size(); ++i) {
+        const FixMemberDef& member = group.members[i];
+        bool seen = false;
+        for (size_t t = 0; t < tags.size(); ++t) seen = seen || tags[t] == member.tag;
+        if (!seen) tags.push_back(member.tag);
+        if (member.group >= 0) group_tags(message, message.groups[static_cast<size_t>(member.group)], tags);
+    }
+}
+
+static bool collect(const FixDictionary& dictionary, std::vector<GenMessage>& messages, std::string& error) {
+    for (size_t m = 0; m < dictionary.messages().size(); ++m) {
+        const FixMessageDef& def = dictionary.messages()[m];
+        if (def.admin) continue;
+
+        GenMessage message;
+        message.def = &def;
+        message.type_name = def.name;
+        message.prefix = snake_case(def.name);
+
+        for (size_t i = 0; i < def.members.size(); ++i) {
+            const FixMemberDef& member = def.members[i];
+            bool duplicate = false;
+            for (size_t f = 0; f < message.fields.size(); ++f) {
+                duplicate = duplicate || message.fields[f].def->tag == member.tag;
+            }
+            if (duplicate) continue;
+
+            GenField field;
+            field.def = dictionary.field(member.tag);
+            field.group = member.group >= 0 ? &def.groups[static_cast<size_t>(member.group)] : 0;
+            field.member = snake_case(field.def->name);
+            field.required = member.required;
+            field.bit = static_cast<int>(message.fields.size());
+            message.fields.push_back(field);
+        }
+        if (message.fields.size() > 64) {
+            error = def.name + ": more than 64 body fields";
+            return false;
+        }
+        messages.push_back(message);
+    }
+    return true;
+}
+
+static void write_struct(std::ostream& out, const GenMessage& message) {
+    const std::string& msg_type = message.def->msg_type;
+
+    uint64_t required = 0;
+    for (size_t i = 0; i < message.fields.size(); ++i) {
+        if (message.fields[i].required) required |= uint64_t(1) << message.fields[i].bit;
+    }
+
+    out << "// 35=" << msg_type << "\n";
+    out << "struct " << message.type_name << " {\n";
+    out << "    static const size_t msg_type_size = " << msg_type.size() << ";\n";
+    out << "    static char* put_msg_type(char* pos) { return fix_put_prefix(pos, \"35=" << msg_type << "\\x01\"); }\n\n";
+
+    out << "    uint64_t present;\n";
+    for (size_t i = 0; i < message.fields.size(); ++i) {
+        const GenField& field = message.fields[i];
+        std::ostringstream decl;
+        decl << "    " << member_type(*field.def) << " " << field.member << ";";
+        out << decl.str() << std::string(decl.str().size() < 44 ? 44 - decl.str().size() : 1, ' ')
+            << "// " << field.def->tag << " " << field.def->name << (field.required ? ", required" : "") << "\n";
+        if (field.group) {
+            std::ostringstream entries;
+            entries << "    FixText " << field.member << "_entries;";
+            out << entries.str() << std::string(entries.str().size() < 44 ? 44 - entries.str().size() : 1, ' ')
+                << "// entries after " << field.def->tag << ", as on the wire\n";
+        }
+    }
+
+    out << "\n    " << message.type_name << "() : present(0)";
+    for (size_t i = 0; i < message.fields.size(); ++i) {
+        const std::string init = member_init(*message.fields[i].def);
+        if (!init.empty()) out << ", " << message.fields[i].member << "(" << init << ")";
+    }
+    out << " {}\n\n";
+
+    out << "    static const uint64_t required_mask = 0x" << std::hex << required << std::dec << "ull;\n";
+    out << "    bool complete() const { return (present & required_mask) == required_mask; }\n";
+    out << "    void clear() { present = 0; }\n\n";
+
+    for (size_t i = 0; i < message.fields.size(); ++i) {
+        const GenField& field = message.fields[i];
+        const std::string mask = bit_mask(field.bit);
+        if (field.group) {
+            out << "    void set_" << field.member << "(int64_t count, const FixText& entries) { "
+                << field.member << " = count; " << field.member << "_entries = entries; present |= " << mask << "; }\n";
+        } else {
+            out << "    void set_" << field.member << "(" << param_type(*field.def) << " value) { "
+                << field.member << " = value; present |= " << mask << "; }\n";
+        }
+        out << "    bool has_" << field.member << "() const { return (present & " << mask << ") != 0; }\n";
+    }
+
+    out << "\n    size_t max_body_size() const;\n";
+    out << "    char* write_body(char* pos) const;\n\n";
+    out << "    // False on a value that does not parse as\n";
+    out << "    // its type. First occurrence wins, tags\n";
+    out << "    // outside the message are skipped.\n";
+    out << "    bool decode(const char* data, size_t size);\n";
+    out << "    bool decode(const std::string& msg) { return decode(msg.data(), msg.size()); }\n";
+    out << "};\n\n";
+}
+
+static void write_put(std::ostream& out, const GenField& field, const char* indent) {
+    out << indent << "pos = fix_put_prefix(pos, " << prefix_literal(field.def->tag) << ");\n";
+    if (field.group) {
+        out << indent << "pos = fix_put_int(pos, " << field.member << ");\n";
+        out << indent << "pos = fix_put_raw(pos, " << field.member << "_entries);\n";
+        return;
+    }
+    switch (field.def->type) {
+        case fix_type_char: out << indent << "pos = fix_put_char(pos, " << field.member << ");\n"; break;
+        case fix_type_int: out << indent << "pos = fix_put_int(pos, " << field.member << ");\n"; break;
+        case fix_type_decimal: out << indent << "pos = fix_put_decimal(pos, " << field.member << ");\n"; break;
+        case fix_type_boolean: out << indent << "pos = fix_put_bool(pos, " << field.member << ");\n"; break;
+        default: out << indent << "pos = fix_put_text(pos, " << field.member << ");\n"; break;
+    }
+}
+
+static void write_get(std::ostream& out, const GenField& field, const char* indent) {
+    const char* getter = 0;
+    if (field.group) {
+        getter = "fix_get_int";
+    } else {
+        switch (field.def->type) {
+            case fix_type_char: getter = "fix_get_char"; break;
+            case fix_type_int: getter = "fix_get_int"; break;
+            case fix_type_decimal: getter = "fix_get_decimal"; break;
+            case fix_type_boolean: getter = "fix_get_bool"; break;
+            default: break;
+        }
+    }
+    if (getter) {
+        out << indent << "if (!" << getter << "(value, " << field.member << ")) return false;\n";
+    } else {
+        out << indent << field.member << " = value;\n";
+    }
+}
+
+static void write_functions(std::ostream& out, const GenMessage& message) {
+    const std::string& name = message.type_name;
+
+    size_t fixed = 0;
+    for (size_t i = 0; i < message.fields.size(); ++i) {
+        const GenField& field = message.fields[i];
+        const size_t value = fixed_value_size(*field.def);
+        if (value > 0) fixed += prefix_size(field.def->tag) + value + 1;
+    }
+
+    out << "size_t " << name << "::max_body_size() const {\n";
+    out << "    size_t size = " << fixed << ";\n";
+    for (size_t i = 0; i < message.fields.size(); ++i) {
+        const GenField& field = message.fields[i];
+        if (field.group) {
+            out << "    if (present & " << bit_mask(field.bit) << ") size += " << field.member << "_entries.size;\n";
+        } else if (fixed_value_size(*field.def) == 0) {
+            out << "    if (present & " << bit_mask(field.bit) << ") size += "
+                << prefix_size(field.def->tag) + 1 << " + " << field.member << ".size;\n";
+        }
+    }
+    out << "    return size;\n}\n\n";
+
+    out << "char* " << name << "::write_body(char* pos) const {\n";
+    for (size_t i = 0; i < message.fields.size(); ++i) {
+        out << "    if (present & " << bit_mask(message.fields[i].bit) << ") {\n";
+        write_put(out, message.fields[i], "        ");
+        out << "    }\n";
+    }
+    out << "    return pos;\n}\n\n";
+
+    // Group membership tests, one per group
+    int group_count = 0;
+    for (size_t i = 0; i < message.fields.size(); ++i) {
+        const GenField& field = message.fields[i];
+        if (!field.group) continue;
+        ++group_count;
+
+        std::vector<int> tags;
+        group_tags(*message.def, *field.group, tags);
+        out << "static bool " << message.prefix << "_" << field.member << "_member(int tag) {\n";
+        out << "    switch (tag) {\n";
+        for (size_t t = 0; t < tags.size(); ++t) out << "        case " << tags[t] << ":\n";
+        out << "            return true;\n";
+        out << "        default:\n";
+        out << "            return false;\n";
+        out << "    }\n}\n\n";
+    }
+
+    out << "bool " << name << "::decode(const char* data, size_t size) {\n";
+    out << "    present = 0;\n";
+    out << "    const char* pos = data;\n";
+    out << "    const char* const end = data + size;\n";
+    out << "    int tag = 0;\n";
+    out << "    FixText value;\n";
+    if (group_count > 0) out << "    int group = 0;                  // entries being walked, 1-based\n";
+    out << "\n    while (fix_next_field(pos, end, tag, value)) {\n";
+
+    if (group_count > 0) {
+        out << "        if (group != 0) {\n";
+        int index = 0;
+        for (size_t i = 0; i < message.fields.size(); ++i) {
+            const GenField& field = message.fields[i];
+            if (!field.group) continue;
+            ++index;
+            out << "            if (group == " << index << " && " << message.prefix << "_" << field.member << "_member(tag)) {\n";
+            out << "                " << field.member << "_entries.size = static_cast<size_t>(pos - "
+                << field.member << "_entries.data);\n";
+            out << "                continue;\n";
+            out << "            }\n";
+        }
+        out << "            group = 0;\n";
+        out << "        }\n\n";
+    }
+
+    out << "        switch (tag) {\n";
+    int index = 0;
+    for (size_t i = 0; i < message.fields.size(); ++i) {
+        const GenField& field = message.fields[i];
+        const std::string mask = bit_mask(field.bit);
+        out << "            case " << field.def->tag << ":\n";
+        out << "                if (present & " << mask << ") break;\n";
+        write_get(out, field, "                ");
+        out << "                present |= " << mask << ";\n";
+        if (field.group) {
+            ++index;
+            out << "                " << field.member << "_entries = FixText(pos, 0);\n";
+            out << "                group = " << index << ";\n";
+        }
+        out << "                break;\n";
+    }
+    out << "            default:\n";
+    out << "                break;\n";
+    out << "        }\n";
+    out << "    }\n";
+    out << "    return pos == end;\n";
+    out << "}\n\n";
+}
+
+static std::string upper(const std::string& text) {
+    std::string out;
+    for (size_t i = 0; i < text.size(); ++i) out += static_cast<char>(std::toupper(static_cast<unsigned char>(text[i])));
+    return out;
+}
+
+// Path without directories, for #include
+static std::string base_name(const std::string& path) {
+    const size_t slash = path.find_last_of('/');
+    return slash == std::string::npos ? path : path.substr(slash + 1);
+}
+
+static bool write_file(const std::string& path, const std::string& text) {
+    std::ofstream out(path.c_str());
+    out << text;
+    out.close();
+    if (!out) {
+        std::fprintf(stderr, "Cannot write %s\n", path.c_str());
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc != 5) {
+        std::fprintf(stderr, "Usage: %s <dictionary.xml> <namespace> <header out> <source out>\n", argv[0]);
+        return 1;
+    }
+    const std::string dictionary_path = argv[1];
+    const std::string name_space = argv[2];
+    const std::string header_path = argv[3];
+    const std::string source_path = argv[4];
+
+    FixDictionary dictionary;
+    std::string error;
+    if (!dictionary.load(dictionary_path, error)) {
+        std::fprintf(stderr, "%s: %s\n", dictionary_path.c_str(), error.c_str());
+        return 1;
+    }
+
+    std::vector<GenMessage> messages;
+    if (!collect(dictionary, messages, error)) {
+        std::fprintf(stderr, "%s: %s\n", dictionary_path.c_str(), error.c_str());
+        return 1;
+    }
+
+    const std::string guard = upper(base_name(header_path).substr(0, base_name(header_path).find('.'))) + "_H";
+    const std::string banner = "// Generated by fix_codegen from " + dictionary_path + ", do not edit.\n"
+                               "// " + dictionary.begin_string() + " application messages, see fix_typed.h.\n\n";
+
+    std::ostringstream header;
+    header << banner;
+    header << "#ifndef " << guard << "\n#define " << guard << "\n\n";
+    header << "#include \"fix_typed.h\"\n\n";
+    header << "#include <string>\n#include <cstddef>\n#include <stdint.h>\n\n";
+    header << "namespace " << name_space << " {\n\n";
+    header << "static const char begin_string[] = \"" << dictionary.begin_string() << "\";\n\n";
+    for (size_t i = 0; i < messages.size(); ++i) write_struct(header, messages[i]);
+    header << "}\n\n#endif\n";
+
+    std::ostringstream source;
+    source << banner;
+    source << "#include \"" << base_name(header_path) << "\"\n\n";
+    source << "namespace " << name_space << " {\n\n";
+    for (size_t i = 0; i < messages.size(); ++i) write_functions(source, messages[i]);
+    source << "}\n";
+
+    if (!write_file(header_path, header.str()) || !write_file(source_path, source.str())) {
+        return 1;
+    }
+    std::printf("%zu messages from %s\n", messages.size(), dictionary_path.c_str());
+    return 0;
+}
@@ -0,0 +1,332 @@
+// Reads an SBE schema (the SbeSchema subset) and
+// writes one encoder and one decoder flyweight
+// per message into a header:
+//
+//     sbe_codegen config/sbe_orders.xml sbe_orders include/sbe_orders_messages.h
+//
+// Template id, block length and every offset are
+// constants in the generated code, so a setter is
+// a store at a fixed place and nothing is looked
+// up by tag as in SbeEncoder/SbeDecoder. The
+// output is checked in, rebuild it with the
+// generate_sbe_messages target after editing the
+// schema.
+
+#include "sbe_schema.h"
+#include "sbe_codec.h"
+
+#include <cstdio>
+#include <cctype>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// ClOrdID -> cl_ord_id, MDReqID -> md_req_id
+static std::string snake_case(const std::string& name) {
+    std::string out;
+    for (size_t i = 0; i < name.size(); ++i) {
+        const char c = name[i];
+        if (std::isupper(static_cast<unsigned char>(c)) && i > 0) {
+            const char prev = name[i - 1];
+            const bool next_lower = i + 1 < name.size() && std::islower(static_cast<unsigned char>(name[i + 1]));
+            if (std::islower(static_cast<unsigned char>(prev)) || std::isdigit(static_cast<unsigned char>(prev)) ||
+                (std::isupper(static_cast<unsigned char>(prev)) && next_lower)) {
+                out += '_';
+            }
+        }
+        out += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+    return out;
+}
+
+// "block + 12"
+static std::string at(const SbeField& field) {
+    std::ostringstream out;
+    out << "block + " << field.offset;
+    return out.str();
+}
+
+// Null test of an optional field,
+// true when the field carries a value
+static std::string present_test(const SbeField& field) {
+    std::ostringstream out;
+    switch (field.kind) {
+        case sbe_kind_int:
+            out << "sbe_load_le_signed(" << at(field) << ", " << field.size << ") != sbe_int_null(" << field.size << ")";
+            break;
+        case sbe_kind_uint:
+        case sbe_kind_timestamp:
+            out << "sbe_load_le(" << at(field) << ", " << field.size << ") != sbe_uint_null(" << field.size << ")";
+            break;
+        case sbe_kind_decimal:
+            out << "sbe_load_le_signed(" << at(field) << ", " << field.mantissa_size
+                << ") != sbe_int_null(" << field.mantissa_size << ")";
+            break;
+        default:
+            out << "block[" << field.offset << "] != '\\0'";
+            break;
+    }
+    return out.str();
+}
+
+static void write_field_comment(std::ostream& out, const SbeField& field) {
+    out << "    // " << field.tag << " " << field.name;
+    switch (field.kind) {
+        case sbe_kind_string: out << ", char[" << field.size << "]"; break;
+        case sbe_kind_timestamp: out << ", nanos since epoch"; break;
+        case sbe_kind_decimal:
+            if (field.constant_exponent) out << ", exponent " << field.exponent;
+            break;
+        default: break;
+    }
+    if (field.optional) out << ", optional";
+    out << "\n";
+}
+
+static void write_null(std::ostream& out, const SbeField& field) {
+    switch (field.kind) {
+        case sbe_kind_int:
+            out << "        sbe_store_le(" << at(field) << ", static_cast<uint64_t>(sbe_int_null(" << field.size
+                << ")), " << field.size << ");\n";
+            break;
+        case sbe_kind_uint:
+        case sbe_kind_timestamp:
+            out << "        sbe_store_le(" << at(field) << ", sbe_uint_null(" << field.size << "), " << field.size << ");\n";
+            break;
+        case sbe_kind_decimal:
+            out << "        sbe_store_le(" << at(field) << ", static_cast<uint64_t>(sbe_int_null(" << field.mantissa_size
+                << ")), " << field.mantissa_size << ");\n";
+            if (!field.constant_exponent) {
+                out << "        block[" << field.offset + field.mantissa_size << "] = static_cast<char>(-128);\n";
+            }
+            break;
+        default:
+            break;      // zero from the memset
+    }
+}
+
+static void write_setter(std::ostream& out, const SbeField& field, const std::string& member) {
+    write_field_comment(out, field);
+    switch (field.kind) {
+        case sbe_kind_int:
+            out << "    bool set_" << member << "(int64_t value) {\n";
+            out << "        if (!sbe_int_fits(value, " << field.size << ")) return false;\n";
+            out << "        sbe_store_le(" << at(field) << ", static_cast<uint64_t>(value), " << field.size << ");\n";
+            out << "        return true;\n";
+            out << "    }\n";
+            break;
+        case sbe_kind_uint:
+            out << "    bool set_" << member << "(uint64_t value) {\n";
+            if (field.size < 8) out << "        if (value >= sbe_uint_null(" << field.size << ")) return false;\n";
+            out << "        sbe_store_le(" << at(field) << ", value, " << field.size << ");\n";
+            out << "        return true;\n";
+            out << "    }\n";
+            break;
+        case sbe_kind_timestamp:
+            out << "    void set_" << member << "(uint64_t nanos) { sbe_store_le(" << at(field) << ", nanos, "
+                << field.size << "); }\n";
+            break;
+        case sbe_kind_char:
+            out << "    void set_" << member << "(char value) { block[" << field.offset << "] = value; }\n";
+            break;
+        case sbe_kind_string:
+            out << "    bool set_" << member << "(const FixText& value) {\n";
+            out << "        if (value.size > " << field.size << ") return false;\n";
+            out << "        std::memcpy(" << at(field) << ", value.data, value.size);\n";
+            out << "        std::memset(" << at(field) << " + value.size, 0, " << field.size << " - value.size);\n";
+            out << "        return true;\n";
+            out << "    }\n";
+            break;
+        case sbe_kind_decimal:
+            out << "    bool set_" << member << "(const FixDecimal& value) {\n";
+            if (field.constant_exponent) {
+                out << "        int64_t mantissa = 0;\n";
+                out << "        if (!sbe_decimal_rescale(value, " << field.exponent << ", mantissa) ||\n";
+                out << "            !sbe_int_fits(mantissa, " << field.mantissa_size << ")) {\n";
+                out << "            return false;\n";
+                out << "        }\n";
+                out << "        sbe_store_le(" << at(field) << ", static_cast<uint64_t>(mantissa), "
+                    << field.mantissa_size << ");\n";
+            } else {
+                out << "        if (value.scale > 127 || !sbe_int_fits(value.mantissa, " << field.mantissa_size
+                    << ")) return false;\n";
+                out << "        sbe_store_le(" << at(field) << ", static_cast<uint64_t>(value.mantissa), "
+                    << field.mantissa_size << ");\n";
+                out << "        block[" << field.offset + field.mantissa_size << "] = static_cast<char>(-value.scale);\n";
+            }
+            out << "        return true;\n";
+            out << "    }\n";
+            break;
+    }
+}
+
+static void write_getter(std::ostream& out, const SbeField& field, const std::string& member) {
+    write_field_comment(out, field);
+    if (field.optional) {
+        out << "    bool has_" << member << "() const { return " << present_test(field) << "; }\n";
+    }
+    switch (field.kind) {
+        case sbe_kind_int:
+            out << "    int64_t " << member << "() const { return sbe_load_le_signed(" << at(field) << ", "
+                << field.size << "); }\n";
+            break;
+        case sbe_kind_uint:
+        case sbe_kind_timestamp:
+            out << "    uint64_t " << member << "() const { return sbe_load_le(" << at(field) << ", "
+                << field.size << "); }\n";
+            break;
+        case sbe_kind_char:
+            out << "    char " << member << "() const { return block[" << field.offset << "]; }\n";
+            break;
+        case sbe_kind_string:
+            out << "    FixText " << member << "() const {\n";
+            out << "        const void* nul = std::memchr(" << at(field) << ", '\\0', " << field.size << ");\n";
+            out << "        return FixText(" << at(field) << ", nul ? static_cast<size_t>(static_cast<const char*>(nul) - ("
+                << at(field) << ")) : " << field.size << ");\n";
+            out << "    }\n";
+            break;
+        case sbe_kind_decimal: {
+            std::ostringstream exponent;
+            if (field.constant_exponent) {
+                exponent << field.exponent;
+            } else {
+                exponent << "static_cast<signed char>(block[" << field.offset + field.mantissa_size << "])";
+            }
+            out << "    // False when " << (field.optional ? "null or " : "") << "out of FixDecimal\n";
+            out << "    bool " << member << "(FixDecimal& value) const {\n";
+            out << "        return " << (field.optional ? "has_" + member + "() &&\n               " : "")
+                << "sbe_decimal_value(sbe_load_le_signed(" << at(field) << ", " << field.mantissa_size << "), "
+                << exponent.str() << ", value);\n";
+            out << "    }\n";
+            break;
+        }
+    }
+}
+
+static void write_message(std::ostream& out, const SbeMessageLayout& layout) {
+    const size_t frame_size = sofh_size + sbe_header_size + layout.block_length;
+
+    std::vector<std::string> members;
+    for (size_t i = 0; i < layout.fields.size(); ++i) members.push_back(snake_case(layout.fields[i].name));
+
+    out << "// 35=" << layout.msg_type << ", template " << layout.template_id << "\n";
+    out << "class " << layout.name << "Encoder {\n";
+    out << "public:\n";
+    out << "    static const uint16_t template_id = " << layout.template_id << ";\n";
+    out << "    static const uint16_t block_length = " << layout.block_length << ";\n";
+    out << "    static const size_t frame_size = " << frame_size << ";\n\n";
+    out << "    " << layout.name << "Encoder() : block(0) {}\n\n";
+
+    out << "    // SOFH, header and a zero block with\n";
+    out << "    // optional fields null. False if the\n";
+    out << "    // frame does not fit capacity.\n";
+    out << "    bool wrap(char* out, size_t capacity) {\n";
+    out << "        if (!out || capacity < frame_size) {\n";
+    out << "            block = 0;\n";
+    out << "            return false;\n";
+    out << "        }\n";
+    out << "        sbe_store_be(out, frame_size, 4);\n";
+    out << "        sbe_store_be(out + 4, sofh_sbe_le, 2);\n";
+    out << "        sbe_store_le(out + " << sofh_size << ", block_length, 2);\n";
+    out << "        sbe_store_le(out + " << sofh_size + 2 << ", template_id, 2);\n";
+    out << "        sbe_store_le(out + " << sofh_size + 4 << ", schema_id, 2);\n";
+    out << "        sbe_store_le(out + " << sofh_size + 6 << ", schema_version, 2);\n\n";
+    out << "        block = out + " << sofh_size + sbe_header_size << ";\n";
+    out << "        std::memset(block, 0, block_length);\n";
+    for (size_t i = 0; i < layout.fields.size(); ++i) {
+        if (layout.fields[i].optional) write_null(out, layout.fields[i]);
+    }
+    out << "        return true;\n";
+    out << "    }\n\n";
+    out << "    size_t size() const { return block ? frame_size : 0; }\n\n";
+    for (size_t i = 0; i < layout.fields.size(); ++i) write_setter(out, layout.fields[i], members[i]);
+    out << "\nprivate:\n";
+    out << "    char* block;\n";
+    out << "};\n\n";
+
+    out << "class " << layout.name << "Decoder {\n";
+    out << "public:\n";
+    out << "    static const uint16_t template_id = " << layout.template_id << ";\n";
+    out << "    static const uint16_t block_length = " << layout.block_length << ";\n\n";
+    out << "    " << layout.name << "Decoder() : block(0) {}\n\n";
+    out << "    // Header onwards, SOFH stripped. False on a\n";
+    out << "    // short buffer, another schema or another\n";
+    out << "    // template; a longer blockLength from a\n";
+    out << "    // newer version is skipped over.\n";
+    out << "    bool wrap(const char* data, size_t size) {\n";
+    out << "        block = 0;\n";
+    out << "        if (!data || size < " << sbe_header_size << ") return false;\n\n";
+    out << "        const size_t length = static_cast<size_t>(sbe_load_le(data, 2));\n";
+    out << "        if (sbe_load_le(data + 2, 2) != template_id || sbe_load_le(data + 4, 2) != schema_id ||\n";
+    out << "            length < block_length || size < " << sbe_header_size << " + length) {\n";
+    out << "            return false;\n";
+    out << "        }\n";
+    out << "        block = data + " << sbe_header_size << ";\n";
+    out << "        return true;\n";
+    out << "    }\n\n";
+    for (size_t i = 0; i < layout.fields.size(); ++i) write_getter(out, layout.fields[i], members[i]);
+    out << "\nprivate:\n";
+    out << "    const char* block;\n";
+    out << "};\n\n";
+}
+
+static std::string upper(const std::string& text) {
+    std::string out;
+    for (size_t i = 0; i < text.size(); ++i) out += static_cast<char>(std::toupper(static_cast<unsigned char>(text[i])));
+    return out;
+}
+
+// Path without directories, for the guard
+static std::string base_name(const std::string& path) {
+    const size_t slash = path.find_last_of('/');
+    return slash == std::string::npos ? path : path.substr(slash + 1);
+}
+
+static bool write_file(const std::string& path, const std::string& text) {
+    std::ofstream out(path.c_str());
+    out << text;
+    out.close();
+    if (!out) {
+        std::fprintf(stderr, "Cannot write %s\n", path.c_str());
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc != 4) {
+        std::fprintf(stderr, "Usage: %s <schema.xml> <namespace> <header out>\n", argv[0]);
+        return 1;
+    }
+    const std::string schema_path = argv[1];
+    const std::string name_space = argv[2];
+    const std::string header_path = argv[3];
+
+    SbeSchema schema;
+    std::string error;
+    if (!schema.load(schema_path, error)) {
+        std::fprintf(stderr, "%s: %s\n", schema_path.c_str(), error.c_str());
+        return 1;
+    }
+
+    const std::string guard = upper(base_name(header_path).substr(0, base_name(header_path).find('.'))) + "_H";
+
+    std::ostringstream header;
+    header << "// Generated by sbe_codegen from " << schema_path << ", do not edit.\n";
+    header << "// SBE flyweights over caller buffers, see sbe_codec.h.\n\n";
+    header << "#ifndef " << guard << "\n#define " << guard << "\n\n";
+    header << "#include \"sbe_codec.h\"\n#include \"fix_typed.h\"\n\n";
+    header << "#include <cstring>\n#include <cstddef>\n#include <stdint.h>\n\n";
+    header << "namespace " << name_space << " {\n\n";
+    header << "static const uint16_t schema_id = " << schema.id() << ";\n";
+    header << "static const uint16_t schema_version = " << schema.version() << ";\n\n";
+    for (size_t i = 0; i < schema.messages().size(); ++i) write_message(header, schema.messages()[i]);
+    header << "}\n\n#endif\n";
+
+    if (!write_file(header_path, header.str())) {
+        return 1;
+    }
+    std::printf("%zu messages from %s\n", schema.messages().size(), schema_path.c_str());
+    return 0;
+}